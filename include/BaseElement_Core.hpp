@@ -20,6 +20,8 @@
 
 namespace duckx
 {
+    class MutationJournal;
+
     /*!
      * @brief Abstract base class for all DOCX document elements
      * 
@@ -30,7 +32,7 @@ namespace duckx
     {
     public:
         DocxElement() = default;
-        DocxElement(pugi::xml_node parentNode, pugi::xml_node currentNode);
+        DocxElement(pugi::xml_node parentNode, pugi::xml_node currentNode, MutationJournal* journal = nullptr);
         DocxElement(const DocxElement&) = default;
         DocxElement& operator=(const DocxElement&) = default;
         DocxElement(DocxElement&&) = default;
@@ -49,6 +51,18 @@ namespace duckx
         pugi::xml_node get_node() const;
         bool has_next_sibling() const;
 
+        /*!
+         * @brief Journal of the document this element belongs to
+         *
+         * Elements obtained from a Document (its body, headers, footers or
+         * other elements of it) carry the document's journal and hand it on
+         * to the elements they create; their edits are recorded by
+         * transactions. Elements built directly from nodes have none.
+         */
+        MutationJournal* journal() const { return m_journal; }
+        /*! @brief Attach this element to the journal of the document owning its node */
+        void set_journal(MutationJournal* journal) { m_journal = journal; }
+
         /*! @brief Enumeration of document element types */
         enum class ElementType
         {
@@ -85,6 +99,7 @@ namespace duckx
 
         pugi::xml_node m_parentNode; // Parent node in the XML tree
         pugi::xml_node m_currentNode; // Current node in the XML tree
+        MutationJournal* m_journal = nullptr; // Journal of the owning document, if any
     };
 
     /*! @brief Convert points to twips (twentieths of a point) */
@@ -16,8 +16,33 @@
 namespace duckx
 {
     class Document;
+    class DocumentFragment;
     class StyleManager;
 
+    /*!
+     * @brief Paragraph properties decoded from w:pPr in a single pass
+     *
+     * Measurements are in points. The style string points into the XML
+     * tree and is never null.
+     */
+    struct DUCKX_API ParagraphProperties
+    {
+        Alignment alignment = Alignment::LEFT; //!< w:jc
+        double line_spacing = 1.0;             //!< w:spacing/@w:line as a multiple of single spacing
+        double spacing_before = 0.0;           //!< w:spacing/@w:before
+        double spacing_after = 0.0;            //!< w:spacing/@w:after
+        double indent_left = 0.0;              //!< w:ind/@w:left
+        double indent_right = 0.0;             //!< w:ind/@w:right
+        double indent_first_line = 0.0;        //!< w:ind/@w:firstLine, negative for w:hanging
+        int list_level = -1;                   //!< w:numPr/w:ilvl
+        int list_num_id = -1;                  //!< w:numPr/w:numId
+        const char* style = "";                //!< w:pStyle/@w:val
+        bool has_line_spacing = false;         //!< w:line is present
+        bool has_spacing = false;              //!< w:before or w:after is present
+        bool has_indentation = false;          //!< Any w:ind attribute is present
+        bool has_numbering = false;            //!< w:numPr is present
+    };
+
     /*!
      * @brief Paragraph element containing text runs and formatting
      * 
@@ -29,7 +54,7 @@ namespace duckx
     {
     public:
         Paragraph() = default;
-        Paragraph(pugi::xml_node, pugi::xml_node);
+        Paragraph(pugi::xml_node, pugi::xml_node, MutationJournal* journal = nullptr);
         Paragraph(const Paragraph&) = default;
         Paragraph& operator=(const Paragraph&) = default;
         Paragraph(Paragraph&&) = default;
@@ -47,6 +72,8 @@ namespace duckx
         Run& add_run(const char*, duckx::formatting_flag = duckx::none);
         /*! @brief Add a hyperlink run to the paragraph */
         Run add_hyperlink(const Document& doc, const std::string& text, const std::string& url);
+        /*! @brief Add a hyperlink run whose relationship is resolved when @p fragment is spliced */
+        Run add_hyperlink(DocumentFragment& fragment, const std::string& text, const std::string& url);
         /*! @brief Set paragraph text alignment */
         Paragraph& set_alignment(Alignment align);
         /*! @brief Set paragraph spacing before and after */
@@ -65,6 +92,9 @@ namespace duckx
         bool can_advance() const;
         bool move_to_next_paragraph();
 
+        /*! @brief Decode all paragraph properties with one scan of w:pPr */
+        ParagraphProperties properties() const;
+
         Alignment get_alignment() const;
         bool get_line_spacing(double& line_spacing) const;
         bool get_spacing(double& before_pts, double& after_pts) const;
@@ -81,6 +111,7 @@ namespace duckx
 
     private:
         pugi::xml_node get_or_create_pPr();
+        Run append_hyperlink(const std::string& relationship_id, const std::string& text);
 
         Run m_run;
     };
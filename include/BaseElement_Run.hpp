@@ -15,6 +15,26 @@ namespace duckx
 {
     class StyleManager;
 
+    /*!
+     * @brief Run properties decoded from w:rPr in a single pass
+     *
+     * String members point into the XML tree and stay valid only while the
+     * run's properties are not modified; they are never null.
+     */
+    struct DUCKX_API RunProperties
+    {
+        formatting_flag formatting = none;                //!< Bold, italic, underline, ... flags
+        HighlightColor highlight = HighlightColor::NONE;  //!< Highlight color
+        double font_size = 0.0;                           //!< Font size in points
+        const char* font = "";                            //!< w:rFonts/@w:ascii
+        const char* color = "";                           //!< w:color/@w:val, empty for "auto"
+        const char* style = "";                           //!< w:rStyle/@w:val
+        bool has_font = false;                            //!< font is set explicitly
+        bool has_font_size = false;                       //!< font_size is set explicitly
+        bool has_color = false;                           //!< color is an explicit RGB value
+        bool has_highlight = false;                       //!< highlight is a recognised color
+    };
+
     /*!
      * @brief Text run element within a paragraph
      * 
@@ -25,7 +45,7 @@ namespace duckx
     {
     public:
         Run() = default;
-        Run(pugi::xml_node, pugi::xml_node);
+        Run(pugi::xml_node, pugi::xml_node, MutationJournal* journal = nullptr);
         Run(const Run&) = default;
         Run& operator=(const Run&) = default;
         Run(Run&&) = default;
@@ -50,6 +70,9 @@ namespace duckx
         /*! @brief Get the text content of this run */
         std::string get_text() const;
 
+        /*! @brief Decode all run properties with one scan of w:rPr */
+        RunProperties properties() const;
+
         formatting_flag get_formatting() const;
         bool is_bold() const;
         bool is_italic() const;
@@ -28,7 +28,7 @@ namespace duckx
     {
     public:
         TableCell() = default;
-        TableCell(pugi::xml_node, pugi::xml_node);
+        TableCell(pugi::xml_node, pugi::xml_node, MutationJournal* journal = nullptr);
         void set_parent(pugi::xml_node) override;
         void set_current(pugi::xml_node) override;
         bool has_next() const override;
@@ -104,7 +104,7 @@ namespace duckx
     {
     public:
         TableRow() = default;
-        TableRow(pugi::xml_node, pugi::xml_node);
+        TableRow(pugi::xml_node, pugi::xml_node, MutationJournal* journal = nullptr);
         void set_parent(pugi::xml_node) override;
         void set_current(pugi::xml_node) override;
         bool has_next() const override;
@@ -163,7 +163,7 @@ namespace duckx
     {
     public:
         Table() = default;
-        Table(pugi::xml_node, pugi::xml_node);
+        Table(pugi::xml_node, pugi::xml_node, MutationJournal* journal = nullptr);
         Table(const Table&) = default;
         Table& operator=(const Table&) = default;
         Table(Table&&) = default;
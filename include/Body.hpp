@@ -11,6 +11,7 @@
 #pragma once
 #include "BaseElement.hpp"
 #include "Error.hpp"
+#include "OperationOptions.hpp"
 #include "duckx_export.h"
 
 namespace duckx
@@ -38,7 +39,11 @@ namespace duckx
     {
     public:
         Body() = default;
-        explicit Body(pugi::xml_node bodyNode);
+        /*!
+         * @param bodyNode The w:body element
+         * @param journal Journal of the owning document, handed to every element created from this body
+         */
+        explicit Body(pugi::xml_node bodyNode, MutationJournal* journal = nullptr);
 
         // Content access methods
         absl::enable_if_t<is_docx_element<Paragraph>::value, ElementRange<Paragraph>> paragraphs();
@@ -68,14 +73,28 @@ namespace duckx
          */
         Result<Table> add_table_safe(int rows, int cols);
 
+        /*!
+         * @brief Safely adds a table, polling @p operation after every row
+         * @param rows Number of table rows (must be > 0)
+         * @param cols Number of table columns (must be > 0)
+         * @param operation Cancellation token and progress callback; progress counts rows
+         * @return Result containing the Table, or ErrorCode::OPERATION_CANCELLED
+         *
+         * A cancelled build removes the partial table again.
+         */
+        Result<Table> add_table_safe(int rows, int cols, const OperationOptions& operation);
+
         /*!
          * @brief Get the underlying XML node
          * @return XML node for direct manipulation
          */
         pugi::xml_node get_body_node() const { return m_bodyNode; }
+        /*! @brief Journal of the owning document, null for a detached body */
+        MutationJournal* journal() const { return m_journal; }
 
     private:
         pugi::xml_node m_bodyNode;
+        MutationJournal* m_journal = nullptr;
         Paragraph m_paragraph;
         Table m_table;
     };
@@ -0,0 +1,153 @@
+/*!
+ * @file BookmarkIndex.hpp
+ * @brief Document-wide index of bookmarks and the fields referring to them
+ *
+ * One pass over a part records every bookmark (name, id, start and end
+ * node) and every REF, PAGEREF and internal HYPERLINK target, so resolving
+ * or validating all cross-references is linear in their number. An index
+ * tied to a document's journal notices edits made elsewhere and rebuilds
+ * itself before its next use.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class MutationJournal;
+
+    /*! @brief A bookmark delimited by w:bookmarkStart / w:bookmarkEnd */
+    struct DUCKX_API BookmarkRange
+    {
+        std::string name;     //!< w:name as written in the document
+        int id = -1;          //!< w:id
+        pugi::xml_node start; //!< w:bookmarkStart
+        pugi::xml_node end;   //!< w:bookmarkEnd, empty if the bookmark is not terminated
+    };
+
+    /*! @brief Kind of field pointing at a bookmark */
+    enum class DUCKX_API FieldKind
+    {
+        REF,      //!< REF bookmark
+        PAGEREF,  //!< PAGEREF bookmark
+        HYPERLINK //!< w:hyperlink/@w:anchor or HYPERLINK \l bookmark
+    };
+
+    /*! @brief A field or hyperlink referring to a bookmark */
+    struct DUCKX_API FieldReference
+    {
+        FieldKind kind = FieldKind::REF;
+        std::string target; //!< Bookmark name
+        pugi::xml_node node; //!< w:fldSimple, w:hyperlink, or the run holding the field's begin w:fldChar
+    };
+
+    /*!
+     * @brief Bookmarks by name and id, plus the cross-references to them
+     *
+     * Bookmark names are matched case-insensitively, as Word does. Pointers
+     * returned by find() stay valid until the next add or remove, or until
+     * the document is edited elsewhere.
+     *
+     * With a journal, the index stores the journal's generation after each
+     * build and each of its own edits. Any other edit reported to the
+     * journal (Body, Paragraph, splice, rollback, ...) bumps the generation,
+     * and the next call re-scans the roots passed to add(), so those roots
+     * must stay in the document. Without a journal, edits made elsewhere
+     * are not seen: rebuild the index with clear() and add() after them.
+     */
+    class DUCKX_API BookmarkIndex
+    {
+    public:
+        BookmarkIndex() = default;
+        /*! @brief Index whose edits are recorded by @p journal, see Document::index_bookmarks() */
+        explicit BookmarkIndex(MutationJournal* journal) : m_journal(journal) {}
+
+        /*! @brief Index all bookmarks and cross-reference fields below @p root */
+        void add(pugi::xml_node root);
+
+        /*! @brief Bookmark with the given name, or nullptr */
+        const BookmarkRange* find(absl::string_view name) const;
+        /*! @brief Bookmark with the given w:id, or nullptr */
+        const BookmarkRange* find_by_id(int id) const;
+        /*! @brief All indexed references, in the order they were indexed */
+        const std::vector<FieldReference>& references() const
+        {
+            refresh();
+            return m_references;
+        }
+        /*! @brief References whose target bookmark does not exist */
+        std::vector<const FieldReference*> unresolved_references() const;
+
+        /*! @brief Smallest w:id greater than every indexed one */
+        int next_id() const
+        {
+            refresh();
+            return m_next_id;
+        }
+        /*! @brief Allocate ids of new bookmarks from @p id upward, e.g. within a reserved range */
+        void set_next_id(const int id) { m_next_id = id; }
+        std::size_t size() const
+        {
+            refresh();
+            return m_by_name.size();
+        }
+        bool empty() const { return size() == 0; }
+        void clear();
+
+        /*!
+         * @brief Bookmark the content of a paragraph
+         * @throws std::invalid_argument if the name is empty or already used
+         *
+         * The start is placed after w:pPr and the end after the last run;
+         * the id is allocated from next_id().
+         */
+        const BookmarkRange& add_bookmark(pugi::xml_node paragraph, absl::string_view name);
+        /*! @brief Remove a bookmark's start and end markers, keeping the content */
+        bool remove_bookmark(absl::string_view name);
+
+        /*!
+         * @brief Append a cross-reference to a paragraph
+         * @param paragraph The w:p receiving the field
+         * @param kind REF/PAGEREF become w:fldSimple, HYPERLINK a w:hyperlink anchor
+         * @param bookmark Target bookmark name
+         * @param display_text Cached result shown until fields are updated
+         */
+        const FieldReference& add_reference(pugi::xml_node paragraph, FieldKind kind, absl::string_view bookmark,
+                                            absl::string_view display_text);
+
+        /*!
+         * @brief Delete @p node from the document and drop what it contained from the index
+         *
+         * Bookmarks starting inside the node are removed; a bookmark that
+         * only ends inside it is cut short just before the node.
+         */
+        void remove(pugi::xml_node node);
+
+    private:
+        void index_root(pugi::xml_node root) const;
+        void index_bookmark(pugi::xml_node start) const;
+        void refresh() const;
+        void sync();
+        static std::string key(absl::string_view name);
+
+        // 日志代数变化时由 const 查询重建，故声明为 mutable
+        mutable absl::flat_hash_map<std::string, BookmarkRange> m_by_name; //!< Keyed by lower-case name
+        mutable absl::flat_hash_map<int, std::string> m_key_by_id;
+        mutable std::vector<FieldReference> m_references;
+        mutable int m_next_id = 0;
+        mutable std::uint64_t m_generation = 0; //!< Journal generation the index was built against
+        std::vector<pugi::xml_node> m_roots;    //!< Roots passed to add(), re-scanned on rebuild
+        MutationJournal* m_journal = nullptr;
+    };
+} // namespace duckx
@@ -0,0 +1,365 @@
+/*!
+ * @file CompactDocument.hpp
+ * @brief Compact, immutable in-memory form of a document body for read-only use
+ *
+ * A pugixml tree spends several pointers per node and keeps every tag and
+ * attribute name once per occurrence, so a large word/document.xml takes
+ * many times its own size in memory. CompactDocument stores the same tree
+ * in contiguous arrays addressed by 32-bit indices: element and attribute
+ * names are interned atoms, and text and attribute values live in one
+ * shared arena. The Compact* views mirror the read API of Body, Paragraph,
+ * Run and Table for search, indexing and preview services that never edit.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "BaseElement_Paragraph.hpp"
+#include "BaseElement_Run.hpp"
+#include "constants.hpp"
+#include "duckx_export.h"
+
+namespace duckx
+{
+    class CompactDocument;
+
+    /*! @brief Interned element or attribute name of a CompactDocument */
+    using Atom = std::uint32_t;
+
+    /*!
+     * @brief Names interned by every CompactDocument at fixed ids
+     *
+     * Comparing atoms replaces the string comparisons of the pugixml-based
+     * elements; any other name gets an id above COUNT on first occurrence.
+     */
+    namespace atoms
+    {
+        enum : Atom
+        {
+            NONE = 0,
+            W_DOCUMENT, W_BODY, W_P, W_R, W_T, W_TBL, W_TR, W_TC,
+            W_PPR, W_JC, W_SPACING, W_IND, W_NUMPR, W_ILVL, W_NUMID, W_PSTYLE,
+            W_RPR, W_B, W_I, W_U, W_STRIKE, W_SMALLCAPS, W_SHADOW, W_VERTALIGN,
+            W_RFONTS, W_SZ, W_COLOR, W_HIGHLIGHT, W_RSTYLE,
+            W_VAL, W_LINE, W_BEFORE, W_AFTER, W_LEFT, W_RIGHT, W_FIRSTLINE, W_HANGING, W_ASCII,
+            COUNT
+        };
+    } // namespace atoms
+
+    /*!
+     * @brief Handle to an element of a CompactDocument
+     *
+     * A pair of document pointer and node index; cheap to copy, valid while
+     * the document object it came from is alive and has not been moved from.
+     * A default-constructed handle is null.
+     */
+    class DUCKX_API CompactNode
+    {
+    public:
+        CompactNode() = default;
+        CompactNode(const CompactDocument* doc, std::uint32_t index) : m_doc(doc), m_index(index) {}
+
+        explicit operator bool() const { return m_doc != nullptr; }
+        bool operator==(const CompactNode& other) const { return m_doc == other.m_doc && m_index == other.m_index; }
+        bool operator!=(const CompactNode& other) const { return !(*this == other); }
+
+        /*! @brief Position of the element in document order */
+        std::uint32_t index() const { return m_index; }
+        Atom atom() const;
+        /*! @brief Qualified name, e.g. "w:p"; empty for a null handle */
+        const char* name() const;
+        /*! @brief Character data directly inside the element, entities decoded; never null */
+        const char* text() const;
+
+        CompactNode parent() const;
+        CompactNode first_child() const;
+        CompactNode next_sibling() const;
+        /*! @brief First child element with the given name */
+        CompactNode child(Atom name) const;
+        /*! @brief Next sibling element with the given name */
+        CompactNode next_sibling(Atom name) const;
+
+        /*! @brief Attribute value, or nullptr if the attribute is missing */
+        const char* attribute(Atom name) const;
+        const char* attribute(absl::string_view name) const;
+
+    private:
+        const CompactDocument* m_doc = nullptr;
+        std::uint32_t m_index = 0;
+    };
+
+    /*!
+     * @brief Forward range over sibling elements of one kind
+     *
+     * Iterators yield const references to a view held by the iterator, so the
+     * range composes with the adaptors of RangeAdaptors.hpp.
+     */
+    template<typename T>
+    class CompactRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            explicit iterator(const CompactNode node) : m_value(node) {}
+
+            const T& operator*() const { return m_value; }
+            const T* operator->() const { return &m_value; }
+
+            iterator& operator++()
+            {
+                m_value = T(m_value.get_node().next_sibling(T::kAtom));
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const { return m_value.get_node() == other.m_value.get_node(); }
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        private:
+            T m_value;
+        };
+
+        CompactRange() = default;
+        explicit CompactRange(const CompactNode first) : m_first(first) {}
+
+        iterator begin() const { return iterator(m_first); }
+        iterator end() const { return iterator(); }
+        bool empty() const { return !m_first; }
+        /*! @brief Number of elements; walks the range */
+        std::size_t size() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+        /*! @brief First element, a null view if the range is empty */
+        T first() const { return T(m_first); }
+
+    private:
+        CompactNode m_first;
+    };
+
+    /*! @brief Read-only view of a w:r element, mirroring Run */
+    class DUCKX_API CompactRun
+    {
+    public:
+        static constexpr Atom kAtom = atoms::W_R;
+
+        CompactRun() = default;
+        explicit CompactRun(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_node() const { return m_node; }
+        explicit operator bool() const { return static_cast<bool>(m_node); }
+
+        std::string get_text() const;
+        /*! @brief Decode w:rPr in one pass; strings point into the document's arena */
+        RunProperties properties() const;
+        formatting_flag get_formatting() const;
+        bool is_bold() const;
+        bool is_italic() const;
+        bool is_underline() const;
+        bool get_font(std::string& font_name) const;
+        bool get_font_size(double& size) const;
+        bool get_color(std::string& color) const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*! @brief Read-only view of a w:p element, mirroring Paragraph */
+    class DUCKX_API CompactParagraph
+    {
+    public:
+        static constexpr Atom kAtom = atoms::W_P;
+
+        CompactParagraph() = default;
+        explicit CompactParagraph(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_node() const { return m_node; }
+        explicit operator bool() const { return static_cast<bool>(m_node); }
+
+        CompactRange<CompactRun> runs() const;
+        /*! @brief Decode w:pPr in one pass; strings point into the document's arena */
+        ParagraphProperties properties() const;
+        Alignment get_alignment() const;
+        /*! @brief Text of all runs, concatenated */
+        std::string get_text() const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*! @brief Read-only view of a w:tc element, mirroring TableCell */
+    class DUCKX_API CompactTableCell
+    {
+    public:
+        static constexpr Atom kAtom = atoms::W_TC;
+
+        CompactTableCell() = default;
+        explicit CompactTableCell(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_node() const { return m_node; }
+        explicit operator bool() const { return static_cast<bool>(m_node); }
+
+        CompactRange<CompactParagraph> paragraphs() const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*! @brief Read-only view of a w:tr element, mirroring TableRow */
+    class DUCKX_API CompactTableRow
+    {
+    public:
+        static constexpr Atom kAtom = atoms::W_TR;
+
+        CompactTableRow() = default;
+        explicit CompactTableRow(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_node() const { return m_node; }
+        explicit operator bool() const { return static_cast<bool>(m_node); }
+
+        CompactRange<CompactTableCell> cells() const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*! @brief Read-only view of a w:tbl element, mirroring Table */
+    class DUCKX_API CompactTable
+    {
+    public:
+        static constexpr Atom kAtom = atoms::W_TBL;
+
+        CompactTable() = default;
+        explicit CompactTable(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_node() const { return m_node; }
+        explicit operator bool() const { return static_cast<bool>(m_node); }
+
+        CompactRange<CompactTableRow> rows() const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*! @brief Read-only view of w:body, mirroring Body */
+    class DUCKX_API CompactBody
+    {
+    public:
+        CompactBody() = default;
+        explicit CompactBody(const CompactNode node) : m_node(node) {}
+
+        CompactNode get_body_node() const { return m_node; }
+
+        CompactRange<CompactParagraph> paragraphs() const;
+        CompactRange<CompactTable> tables() const;
+
+    private:
+        CompactNode m_node;
+    };
+
+    /*!
+     * @brief Immutable, compact parse of a DOCX main document part
+     *
+     * Elements are stored in document order as fixed 24-byte records
+     * (name, parent, first child, next sibling, first attribute, text) and
+     * attributes as 8-byte (name, value) pairs, all indexed by 32 bits.
+     * Short attribute values are shared in the arena, so repeated values
+     * such as w:val="24" are stored once. The parser builds these arrays
+     * directly from the XML text; no pugixml tree is created.
+     *
+     * Parsing follows pugixml's default options: entities and character
+     * references are decoded, line ends normalised, whitespace-only
+     * character data dropped and CDATA kept as text. Comments, processing
+     * instructions and the DOCTYPE are skipped.
+     *
+     * **Example:**
+     * @code
+     * const auto doc = CompactDocument::open("large.docx");
+     * for (const auto& p : doc.body().paragraphs())
+     *     index(p.get_text());
+     * @endcode
+     */
+    class DUCKX_API CompactDocument
+    {
+    public:
+        CompactDocument();
+        CompactDocument(CompactDocument&&) = default;
+        CompactDocument& operator=(CompactDocument&&) = default;
+        CompactDocument(const CompactDocument&) = delete;
+        CompactDocument& operator=(const CompactDocument&) = delete;
+
+        /*!
+         * @brief Read word/document.xml of a DOCX package
+         * @throws std::runtime_error if the package or the part cannot be read or parsed
+         */
+        static CompactDocument open(const std::string& path);
+        /*!
+         * @brief Parse an XML document
+         * @throws std::runtime_error if the XML is malformed
+         * @throws std::length_error if it exceeds 32-bit indexing
+         */
+        static CompactDocument parse(absl::string_view xml);
+
+        /*! @brief Document element (w:document for a main document part) */
+        CompactNode root() const;
+        /*! @brief w:document/w:body, a view over a null node if missing */
+        CompactBody body() const;
+
+        /*! @brief Atom of a name, atoms::NONE if the document never uses it */
+        Atom find_atom(absl::string_view name) const;
+        const char* atom_name(Atom atom) const;
+
+        std::size_t node_count() const { return m_nodes.size(); }
+        std::size_t attribute_count() const { return m_attributes.size(); }
+        /*! @brief Bytes held by the node, attribute, arena and atom tables */
+        std::size_t memory_usage() const;
+
+    private:
+        friend class CompactNode;
+        class Builder;
+
+        /*! @brief Element record; indices equal to kNull mean "none", text 0 is the empty string */
+        struct Node
+        {
+            Atom name;
+            std::uint32_t parent;
+            std::uint32_t first_child;
+            std::uint32_t next_sibling;
+            std::uint32_t first_attribute;
+            std::uint32_t text;
+        };
+
+        struct Attribute
+        {
+            Atom name;
+            std::uint32_t value; //!< Offset of a NUL-terminated string in m_arena
+        };
+
+        static constexpr std::uint32_t kNull = 0xFFFFFFFFu;
+
+        std::vector<Node> m_nodes;
+        std::vector<Attribute> m_attributes;
+        std::string m_arena;
+        std::vector<std::string> m_atom_names;
+        absl::flat_hash_map<std::string, Atom> m_atom_index;
+    };
+} // namespace duckx
@@ -0,0 +1,113 @@
+/*!
+ * @file ContentControls.hpp
+ * @brief Index and fill content controls (w:sdt) by tag or alias
+ *
+ * A single pass over a part records every structured document tag under
+ * its w:tag and w:alias values, so form filling looks each field up in
+ * constant time and only touches the nodes of the controls it fills.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class DocxFile;
+    class MutationJournal;
+
+    /*! @brief w:dataBinding of a content control, mapping it into a customXml part */
+    struct DUCKX_API ContentControlBinding
+    {
+        std::string store_item_id; //!< w:storeItemID, matches ds:itemID of a customXml item
+        std::string xpath;         //!< w:xpath locating the bound element or attribute
+    };
+
+    /*!
+     * @brief Content controls of one or more parts, keyed by tag and alias
+     *
+     * Nodes stay valid as long as the controls are not removed from the
+     * DOM, so an index can be reused for repeated fills of the same document.
+     * Filling a control can remove controls nested in its placeholder;
+     * Document::bind_content_controls calls prune() after every fill so
+     * those entries are dropped. Rebuild the index after other edits that
+     * remove controls.
+     */
+    class DUCKX_API ContentControlIndex
+    {
+    public:
+        /*! @brief Index all w:sdt elements below @p root (nested controls included) */
+        void add(pugi::xml_node root);
+        /*! @brief Controls whose tag or alias equals @p key, in document order */
+        const std::vector<pugi::xml_node>& find(absl::string_view key) const;
+        /*! @brief Whether @p sdt is indexed; compares handles only, so stale nodes are safe to pass */
+        bool contains(pugi::xml_node sdt) const;
+        /*!
+         * @brief Drop the controls nested in @p sdt that are no longer below it
+         *
+         * Call after changing the content of @p sdt. Only controls with
+         * indexed descendants walk their subtree.
+         */
+        void prune(pugi::xml_node sdt);
+        /*! @brief Number of indexed controls */
+        std::size_t size() const { return m_enclosing.size(); }
+        bool empty() const { return m_enclosing.empty(); }
+        void clear();
+
+    private:
+        absl::flat_hash_map<std::string, std::vector<pugi::xml_node>> m_by_key;
+        // 控件 -> 最近的外层已索引控件（顶层为 nullptr）
+        absl::flat_hash_map<const pugi::xml_node_struct*, const pugi::xml_node_struct*> m_enclosing;
+        // 含有已索引子控件的控件
+        absl::flat_hash_set<const pugi::xml_node_struct*> m_with_nested;
+    };
+
+    /*!
+     * @brief Replace the content of a control with plain text, keeping its formatting
+     * @param sdt The w:sdt element
+     * @param text New text; '\n' becomes a line break and '\t' a tab
+     * @param journal Journal of the document owning @p sdt, so transactions record the edit
+     *
+     * The first run (or the first paragraph's first run for block controls)
+     * keeps its run properties; the remaining placeholder runs/paragraphs are
+     * removed and the placeholder state (w:showingPlcHdr) is cleared.
+     */
+    DUCKX_API void set_content_control_text(pugi::xml_node sdt, absl::string_view text,
+                                            MutationJournal* journal = nullptr);
+
+    /*! @brief Read the data binding of a control, if it has one */
+    DUCKX_API bool get_content_control_binding(pugi::xml_node sdt, ContentControlBinding& binding);
+
+    /*!
+     * @brief Store a value in a customXml data part at a w:dataBinding XPath
+     * @return false if the path does not resolve to an element or attribute
+     *
+     * Supports the absolute location paths Word generates
+     * (/ns0:root[1]/ns0:field[1] and a final @attribute step); namespace
+     * prefixes are matched by local name.
+     */
+    DUCKX_API bool set_custom_xml_value(pugi::xml_document& data, absl::string_view xpath, absl::string_view value);
+
+    /*!
+     * @brief Write bound values into the customXml data parts of a package
+     * @param file Package holding customXml/itemN.xml and customXml/itemPropsN.xml
+     * @param values Bindings with the value to store
+     * @return Number of values stored
+     *
+     * Every data part is parsed and rewritten at most once, however many
+     * values target it.
+     */
+    DUCKX_API std::size_t update_custom_xml_parts(
+        DocxFile& file, const std::vector<std::pair<ContentControlBinding, std::string>>& values);
+} // namespace duckx
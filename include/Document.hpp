@@ -11,16 +11,28 @@
  */
 
 #pragma once
+#include <functional>
+#include <future>
 #include <memory>
 #include "duckx_export.h"
 #include "Error.hpp"
 
 #include "Body.hpp"
+#include "BookmarkIndex.hpp"
+#include "ContentControls.hpp"
+#include "DocumentFragment.hpp"
 #include "DocxFile.hpp"
+#include "Executor.hpp"
+#include "OperationOptions.hpp"
+#include "FieldEvaluator.hpp"
+#include "FormattingTable.hpp"
 #include "HeaderFooterManager.hpp"
 #include "HyperlinkManager.hpp"
 #include "MediaManager.hpp"
+#include "MutationJournal.hpp"
+#include "NumberingManager.hpp"
 #include "HeaderFooterBase.hpp"
+#include "PackageGarbageCollector.hpp"
 #include "StyleManager.hpp"
 #include "OutlineManager.hpp"
 #include "PageLayoutManager.hpp"
@@ -31,11 +43,43 @@ namespace duckx
     class MediaManager;
     class HeaderFooterManager;
     class HyperlinkManager;
+    class NumberingManager;
     class OutlineManager;
     class PageLayoutManager;
     class Header;
     class Footer;
 
+    /*!
+     * @brief Options for Document::open() / Document::open_safe()
+     */
+    struct DUCKX_API OpenOptions
+    {
+        /*! @brief Reject saving; suited to services that only read documents */
+        bool read_only = false;
+    };
+
+    /*!
+     * @brief Options for Document::save_async() and the synchronous save(const SaveOptions&)
+     */
+    struct DUCKX_API SaveOptions
+    {
+        /*!
+         * @brief Invoked on a task of Document::executor() with the result of save_async()
+         *
+         * Also used for saves that fail before any writing starts, such as
+         * on a read-only document, so it never runs on the calling thread
+         * unless the executor runs tasks inline. Synchronous saves return
+         * the result instead and ignore it.
+         */
+        std::function<void(const Result<void>&)> on_complete;
+        /*! @brief Run collect_garbage() before taking the snapshot */
+        bool collect_garbage = false;
+        /*! @brief Receives the collection report on the calling thread when collect_garbage is set */
+        std::function<void(const GarbageCollectionReport&)> on_garbage_collected;
+        /*! @brief Run update_fields() before serializing the parts */
+        bool update_fields = false;
+    };
+
     /*!
      * @brief Main document class for DOCX file operations
      * 
@@ -65,9 +109,24 @@ namespace duckx
         /*!
          * @brief Safely opens an existing DOCX document
          * @param path Path to the DOCX file to open
+         * @param options Open mode flags
          * @return Result containing Document instance or error details
+         *
+         * Only word/document.xml is parsed up front. Relationships, content
+         * types and the managers are loaded on first access, so parts that a
+         * read-only scan never touches are never inflated.
          */
-        static Result<Document> open_safe(const std::string& path);
+        static Result<Document> open_safe(const std::string& path, const OpenOptions& options = OpenOptions());
+
+        /*!
+         * @brief Safely opens a document, polling @p operation while word/document.xml is inflated
+         * @param path Path to the DOCX file to open
+         * @param options Open mode flags
+         * @param operation Cancellation token and progress callback; progress counts uncompressed bytes
+         * @return Result containing the Document, or ErrorCode::OPERATION_CANCELLED
+         */
+        static Result<Document> open_safe(const std::string& path, const OpenOptions& options,
+                                          const OperationOptions& operation);
         
         /*!
          * @brief Safely creates a new DOCX document
@@ -78,21 +137,170 @@ namespace duckx
          * until save_safe() is called.
          */
         static Result<Document> create_safe(const std::string& path);
+
+        /*!
+         * @brief Safely derives a variant of this document saved under another path
+         * @param path Output file path of the variant
+         * @return Result containing the new Document or error details
+         *
+         * Nothing is inflated or re-parsed: the variant shares the indexed
+         * archive, so parts it never touches are copied to its file still
+         * compressed. Unsaved edits of this document are carried over.
+         * Headers, footers, styles and the other parts are loaded from the
+         * shared archive only if the variant uses them. The two documents
+         * are independent afterwards; the variant is never read-only.
+         *
+         * pugixml trees cannot share nodes, so the main document tree is
+         * deep-copied: a fork costs time linear in the body, about a tenth
+         * of re-opening the file (roughly 10,000 forks/s of a 1,000-paragraph
+         * document in a Release build). Until its first save the variant
+         * keeps the shared archive open, so it still reads the original
+         * parts after this document saves over the file.
+         */
+        Result<Document> fork_safe(const std::string& path) const;
         
         /*!
          * @brief Safely saves the document to disk
          * @return Result indicating success or error details
          */
         Result<void> save_safe() const;
+
+        /*!
+         * @brief Safely saves the document, polling @p operation once per archive entry
+         * @param operation Cancellation token and progress callback; progress counts bytes written
+         * @return Result indicating success, or ErrorCode::OPERATION_CANCELLED
+         *
+         * A cancelled save leaves the file on disk untouched and keeps the
+         * changes pending for the next save.
+         */
+        Result<void> save_safe(const OperationOptions& operation) const;
+
+        /*!
+         * @brief Safely saves the document after the preparation steps of @p options
+         * @param options Field update and garbage collection to run first; on_complete is ignored
+         * @return Result indicating success or error details
+         */
+        Result<void> save_safe(const SaveOptions& options) const;
+
+        /*!
+         * @brief Saves the document without blocking on compression and file I/O
+         * @param options Completion callback and other save options
+         * @return Future resolving to the result of the write
+         *
+         * All XML parts are serialized into a snapshot on the calling thread;
+         * compressing and rewriting the archive then happens as a task of
+         * executor(), so the document can be edited again as soon as this
+         * returns. Consecutive saves are written in call order without any
+         * task blocking on another, and save() waits for pending background
+         * writes to finish.
+         */
+        std::shared_future<Result<void>> save_async(const SaveOptions& options = SaveOptions()) const;
+
+        /*!
+         * @brief Make subsequent saves byte-reproducible
+         * @param enabled Whether deterministic output is used
+         * @param timestamp UTC time stamped into ZIP headers and core properties
+         *
+         * Identical content then always yields identical archive bytes:
+         * canonical entry order, fixed timestamps and fixed compression level.
+         */
+        void set_deterministic(bool enabled, std::time_t timestamp = DocxFile::kDeterministicEpoch);
+
+        /*!
+         * @brief Make subsequent saves append to the file instead of rewriting it
+         * @param enabled Whether saves are incremental
+         * @param compaction_threshold Fraction of the file allowed to be dead space
+         *
+         * Suited to autosave: only the parts modified since the last save
+         * and a new central directory are written, after the end of the
+         * existing archive. Superseded parts remain as dead space until it
+         * exceeds @p compaction_threshold, when that save rewrites the file.
+         * Applies to save() and save_async(); see DocxFile::set_incremental().
+         */
+        void set_incremental_save(bool enabled, double compaction_threshold = 0.5);
+
+        /*!
+         * @brief Schedule this document's background and parallel work on @p executor
+         * @param executor Host executor; nullptr follows default_executor()
+         *
+         * Covers save_async() and the parallel compression of modified parts
+         * during save() and save_async(). Forks inherit the executor.
+         */
+        void set_executor(std::shared_ptr<Executor> executor);
+        /*! @brief Executor this document schedules work on */
+        std::shared_ptr<Executor> executor() const;
+
+        /*!
+         * @brief Hash identifying the content the next save would produce
+         * @return 64 hex digits (SHA-256), equal for documents with identical parts
+         *
+         * Serializes modified parts (without compressing them) and combines
+         * per-part SHA-256 digests, so identical renders can be detected and
+         * skipped before any compression or I/O happens. Digests are cached
+         * per part: unchanged parts are decompressed and hashed only on the
+         * first call.
+         */
+        std::string content_hash() const;
+
+        /*!
+         * @brief Drop parts, relationships and content-type overrides nothing refers to
+         * @return Counts of removed items and the archive bytes reclaimed
+         *
+         * Pending edits are serialized first; the removals take effect on the
+         * next save. Media left behind by replaced images, stale hyperlinks
+         * and headers no longer referenced from any section are collected.
+         */
+        GarbageCollectionReport collect_garbage() const;
+
+        /*!
+         * @brief Extract the formatting of every run and paragraph column-wise
+         * @return Table with interned fonts/colors/styles and fixed-point values
+         *
+         * The body is walked once; use the overload taking a table to reuse
+         * its allocations across many documents.
+         */
+        FormattingTable extract_formatting_table() const;
+        /*! @brief Clear @p table and fill it with this document's formatting */
+        void extract_formatting_table(FormattingTable& table) const;
+
+        /*!
+         * @brief Append the content of a fragment to the body
+         * @param fragment Fragment built independently, possibly on another thread
+         *
+         * The fragment's blocks are copied before the final section
+         * properties in time linear in their size. Its images and hyperlinks
+         * become relationships of this document and the references to them
+         * are rewritten during the copy. Drawing and bookmark ids are
+         * renumbered from a counter of this document, so a fragment may be
+         * spliced more than once; bookmark names are copied unchanged.
+         */
+        void splice(const DocumentFragment& fragment);
         
         // Legacy exception-based API (for backward compatibility)
-        static Document open(const std::string& path);
+        static Document open(const std::string& path, const OpenOptions& options = OpenOptions());
         static Document create(const std::string& path);
+        Document fork(const std::string& path) const;
         void save() const;
+        /*! @brief Save after the preparation steps of @p options; on_complete is ignored */
+        void save(const SaveOptions& options) const;
 
+        /*!
+         * @brief Take over another document's state in O(1)
+         *
+         * The state lives in one heap object, so managers, element handles
+         * and an open transaction obtained from @p other stay valid and now
+         * belong to this document.
+         *
+         * @p other is left without state: it may only be destroyed or
+         * assigned another document. Calling any other member on it is
+         * undefined, like dereferencing a moved-from std::unique_ptr.
+         */
         Document(Document&& other) noexcept;
         Document& operator=(Document&& other) noexcept;
-        ~Document() = default;
+        ~Document();
+
+        /*! @brief Check if the document was opened with OpenOptions::read_only */
+        bool is_read_only() const;
 
         Body& body();
         const Body& body() const;
@@ -101,6 +309,17 @@ namespace duckx
         StyleManager& styles() const;
         OutlineManager& outline() const;
         PageLayoutManager& page_layout() const;
+        /*! @brief Numbering definitions of word/numbering.xml, parsed on first access */
+        NumberingManager& numbering() const;
+
+        /*!
+         * @brief Compute the label of every list paragraph in the body
+         *
+         * One forward pass in document order, applying restart and
+         * start-override semantics, so exporters can print "3.2.1" without
+         * re-implementing numbering.
+         */
+        std::vector<ListLabel> list_labels() const;
         
         /*!
          * @brief Get page layout manager with safety check
@@ -111,9 +330,113 @@ namespace duckx
         std::string get_next_relationship_id();
         unsigned int get_unique_rid();
 
+        /*!
+         * @brief Flag a part as modified so the next save re-serializes it
+         *
+         * Mutating APIs report their edits to journal(), which flags the
+         * part; after editing the underlying XML through raw pugixml nodes,
+         * call this or the MutationJournal hooks with journal(). Reading
+         * parts never flags them.
+         */
+        void mark_dirty(DocumentPart part) const;
+        /*! @brief Check whether a part will be re-serialized on the next save */
+        bool is_dirty(DocumentPart part) const;
+
+        /*!
+         * @brief Open a transaction over the parsed parts of the document
+         * @throws std::logic_error if a transaction is already open
+         *
+         * Edits made through element and manager APIs until commit() or
+         * rollback() to the body, relationships, content types, numbering,
+         * headers and footers are recorded in journal(). Style definitions
+         * and media files already written to the package are not covered.
+         */
+        void begin_transaction();
+        /*! @brief Keep the edits of the open transaction; its journal stays readable */
+        void commit();
+        /*!
+         * @brief Undo the edits of the open transaction
+         *
+         * Costs time proportional to the number of edited blocks. Element
+         * handles obtained during the transaction must not be used afterwards.
+         */
+        void rollback();
+        /*! @brief Check whether a transaction is open */
+        bool in_transaction() const;
+        /*! @brief Mutations of the open or last committed transaction */
+        const MutationJournal& journal() const;
+        /*!
+         * @brief Journal to pass to MutationJournal hooks when editing raw nodes of this document
+         *
+         * Element and manager APIs report their edits themselves.
+         */
+        MutationJournal& journal();
+
         Header& get_header(HeaderFooterType type = HeaderFooterType::DEFAULT) const;
         Footer& get_footer(HeaderFooterType type = HeaderFooterType::DEFAULT) const;
+
+        /*!
+         * @brief Snapshot a header as a template shareable across documents
+         *
+         * Templates are interned by content hash, so documents generated from
+         * the same header reuse one copy of its serialized bytes.
+         */
+        std::shared_ptr<const HeaderFooterTemplate> header_template(
+            HeaderFooterType type = HeaderFooterType::DEFAULT) const;
+        /*! @brief Snapshot a footer as a template shareable across documents */
+        std::shared_ptr<const HeaderFooterTemplate> footer_template(
+            HeaderFooterType type = HeaderFooterType::DEFAULT) const;
+        /*! @brief Use a template (e.g. from another document) as the header of the specified type */
+        void set_header_template(HeaderFooterType type, std::shared_ptr<const HeaderFooterTemplate> tmpl) const;
+        /*! @brief Use a template (e.g. from another document) as the footer of the specified type */
+        void set_footer_template(HeaderFooterType type, std::shared_ptr<const HeaderFooterTemplate> tmpl) const;
         
+        /*!
+         * @brief Index the content controls of the body, headers and footers
+         *
+         * One pass over every part; existing headers and footers are parsed
+         * but only written back on save if a control in them is filled.
+         */
+        ContentControlIndex index_content_controls() const;
+        /*!
+         * @brief Fill content controls by tag or alias
+         * @param values Text per tag/alias; every control with that key is filled
+         * @return Number of controls filled
+         *
+         * Placeholder content is replaced in place keeping the run formatting.
+         * Controls bound to a customXml part (w:dataBinding) also get the
+         * value stored in that part.
+         */
+        std::size_t bind_content_controls(const std::map<std::string, std::string>& values);
+        /*!
+         * @brief Fill content controls using a prebuilt index, in O(fields + touched nodes)
+         *
+         * Nested controls removed by filling their parent are dropped from
+         * @p index and skipped, so the index stays valid for later fills.
+         */
+        std::size_t bind_content_controls(ContentControlIndex& index,
+                                          const std::map<std::string, std::string>& values);
+
+        /*!
+         * @brief Index the bookmarks of the body and the REF/PAGEREF/HYPERLINK fields targeting them
+         *
+         * Built in one pass. The index is tied to this document's journal:
+         * bookmarks and references added or removed through it keep it
+         * current, and after any other edit of the document it re-scans the
+         * body on its next use.
+         */
+        BookmarkIndex index_bookmarks() const;
+
+        /*!
+         * @brief Compute the cached results of TOC, REF, PAGEREF, SEQ, PAGE and NUMPAGES fields
+         *
+         * Headings, bookmarks, list labels and an estimated pagination are
+         * collected in one pass over the body; headers and footers are then
+         * evaluated against them. Only parts whose results changed are
+         * written back on save.
+         */
+        FieldEvaluationReport update_fields(const FieldEvaluationOptions& options = FieldEvaluationOptions()) const;
+
         // Style Set operations
         
         /*!
@@ -122,6 +445,19 @@ namespace duckx
          * @return Result indicating success or error
          */
         Result<void> apply_style_set_safe(const std::string& set_name);
+
+        /*!
+         * @brief Apply a style set, polling @p operation per table and paragraph
+         * @param set_name Name of the style set to apply
+         * @param operation Cancellation token and progress callback; progress counts elements
+         * @return Result indicating success, or the error that stopped it
+         *
+         * Runs inside a transaction unless one is already open, so a
+         * cancelled or failed application is rolled back completely. Within
+         * a caller's transaction only the changes of this call are undone;
+         * the caller's earlier edits and the transaction stay open.
+         */
+        Result<void> apply_style_set_safe(const std::string& set_name, const OperationOptions& operation);
         
         /*!
          * @brief Load style definitions from an XML file
@@ -155,21 +491,30 @@ namespace duckx
         Result<void> initialize_page_layout_structure_safe();
 
     private:
-        explicit Document(std::unique_ptr<DocxFile> file);
-        void load();
-
-        std::unique_ptr<DocxFile> m_file;
-        pugi::xml_document m_document_xml;
-        pugi::xml_document m_rels_xml;
-        pugi::xml_document m_content_types_xml;
-
-        Body m_body;
-        std::unique_ptr<MediaManager> m_media_manager;
-        std::unique_ptr<HeaderFooterManager> m_hf_manager;
-        std::unique_ptr<HyperlinkManager> m_link_manager;
-        std::unique_ptr<StyleManager> m_style_manager;
-        std::unique_ptr<OutlineManager> m_outline_manager;
-        std::unique_ptr<PageLayoutManager> m_page_layout_manager;
-        int m_rid_counter = 1;
+        class Impl;
+
+        /*! @brief Deletes the state unless the Document is the managers' non-owning handle */
+        struct ImplDeleter
+        {
+            bool owning = true;
+            void operator()(const Impl* impl) const;
+        };
+
+        explicit Document(std::unique_ptr<DocxFile> file, const OpenOptions& options = OpenOptions(),
+                          const OperationOptions* operation = nullptr);
+        /*! @brief Non-owning handle over @p state, see Impl::m_handle */
+        explicit Document(Impl* state) noexcept;
+        Document(std::unique_ptr<DocxFile> file, const pugi::xml_document& document_xml, const OpenOptions& options);
+        void load(const OperationOptions* operation = nullptr);
+        void save_package(const OperationOptions* operation) const;
+        void prepare_save(const SaveOptions& options) const;
+        void ensure_relationships() const;
+        void ensure_content_types() const;
+        StyleManager& style_manager() const;
+        HeaderFooterManager& header_footer_manager() const;
+        void serialize_parts() const;
+        void settle_pending_save(bool wait) const;
+
+        std::unique_ptr<Impl, ImplDeleter> m_impl; //!< All state; its address never changes
     };
 } // namespace duckx
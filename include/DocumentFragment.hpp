@@ -0,0 +1,114 @@
+/*!
+ * @file DocumentFragment.hpp
+ * @brief Body content built apart from any document and spliced in later
+ *
+ * A fragment owns its own XML tree, so independent sections of a report
+ * can be generated on separate threads and then spliced into one
+ * Document::body() in order. IDs that must be unique across the document
+ * and relationships (images, hyperlinks) are only placeholders inside the
+ * fragment; both are resolved against the target when the fragment is
+ * spliced.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "Body.hpp"
+#include "BookmarkIndex.hpp"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class Image;
+    class TextBox;
+
+    /*! @brief A relationship recorded by a fragment, created in the target document on splice */
+    struct DUCKX_API FragmentRelationship
+    {
+        std::string id;        //!< Placeholder rId used inside the fragment
+        bool image = false;    //!< Image part if true, external hyperlink otherwise
+        std::string target;    //!< Hyperlink URL
+        std::string content;   //!< Image bytes
+        std::string extension; //!< Lower-case image extension
+    };
+
+    /*!
+     * @brief Independently built body content
+     *
+     * A fragment is not thread-safe itself, but distinct fragments share no
+     * state and can be filled concurrently. Each one numbers its drawing
+     * (wp:docPr) and bookmark ids from a range of kIdsPerFragment ids at or
+     * above kFirstReservedId, which keeps them unique within the fragment.
+     * Document::splice() renumbers them from a counter of the target and
+     * rewrites the placeholder relationship ids, so a fragment can be
+     * spliced more than once and recycled ranges never collide.
+     *
+     * **Example:**
+     * @code
+     * std::vector<DocumentFragment> chapters(4);
+     * // fill chapters[i].body() on worker threads...
+     * for (const auto& chapter : chapters)
+     *     doc.splice(chapter);
+     * @endcode
+     */
+    class DUCKX_API DocumentFragment
+    {
+    public:
+        static constexpr std::uint32_t kIdsPerFragment = 1u << 16;
+        /*! @brief Fragment and spliced ids start here; documents number their own ids below it */
+        static constexpr std::uint32_t kFirstReservedId = 1u << 24;
+
+        DocumentFragment();
+        DocumentFragment(DocumentFragment&&) = default;
+        DocumentFragment& operator=(DocumentFragment&&) = default;
+        DocumentFragment(const DocumentFragment&) = delete;
+        DocumentFragment& operator=(const DocumentFragment&) = delete;
+
+        /*! @brief Content of the fragment; the full Body/Paragraph/Table API is available */
+        Body& body() { return m_body; }
+        const Body& body() const { return m_body; }
+
+        /*!
+         * @brief Add an image to a paragraph of this fragment
+         *
+         * The file is read now, on the calling thread; the media part is
+         * written to the target package on splice.
+         */
+        Run add_image(const Paragraph& p, const Image& image);
+        /*! @brief Add a textbox to a paragraph of this fragment */
+        Run add_textbox(const Paragraph& p, const TextBox& textbox);
+        /*!
+         * @brief Bookmark the content of a paragraph of this fragment
+         * @throws std::invalid_argument if the name is empty or already used in the fragment
+         *
+         * Names must also be unique in the target document.
+         */
+        const BookmarkRange& add_bookmark(const Paragraph& p, absl::string_view name);
+
+        /*! @brief Record a hyperlink relationship and return its placeholder ID */
+        std::string add_hyperlink_relationship(const std::string& url);
+
+        /*! @brief Relationships to create in the target document, in the order they were added */
+        const std::vector<FragmentRelationship>& relationships() const { return m_relationships; }
+        /*! @brief First id of the fragment's reserved drawing and bookmark range */
+        std::uint32_t first_id() const { return m_first_id; }
+
+    private:
+        std::uint32_t next_drawing_id();
+
+        pugi::xml_document m_xml;
+        Body m_body;
+        BookmarkIndex m_bookmarks;
+        std::vector<FragmentRelationship> m_relationships;
+        std::string m_rid_prefix;
+        std::uint32_t m_first_id = 0;
+        std::uint32_t m_next_drawing_id = 0;
+    };
+} // namespace duckx
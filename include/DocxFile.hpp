@@ -10,20 +10,53 @@
  */
 
 #pragma once
+#include <array>
+#include <cstdint>
+#include <ctime>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 #include "duckx_export.h"
 
 struct zip_t;
 
 namespace duckx
 {
+    class Executor;
+    struct OperationOptions;
+    class ZipReader;
+    struct ZipCompressedData;
+
+    /*!
+     * @brief Self-contained copy of the pending changes of a DocxFile
+     *
+     * Holds everything needed to rewrite the archive, so it can be written
+     * on another thread while the originating DocxFile keeps being edited.
+     */
+    struct DUCKX_API DocxSaveSnapshot
+    {
+        std::string path;                                  //!< Archive to rewrite
+        std::map<std::string, std::string> entries;        //!< Entries replacing or extending the archive
+        std::set<std::string> removed;                     //!< Archive entries to leave out
+        bool deterministic = false;                        //!< Write canonical order and fixed timestamps
+        std::time_t timestamp = 0;                         //!< Fixed timestamp for deterministic output
+        bool incremental = false;                          //!< Append to @c path instead of rewriting it
+        double compaction_threshold = 0.5;                 //!< Dead-space fraction that forces a rewrite
+        std::shared_ptr<ZipReader> source;                 //!< Archive to copy unchanged entries from, if not @c path
+        std::shared_ptr<Executor> executor;                //!< Compresses entries in parallel; null for default_executor()
+        const OperationOptions* operation = nullptr;       //!< Polled per entry by a synchronous save; never set on snapshots
+    };
+
     /*!
      * @brief Low-level DOCX file handler for ZIP archive operations
      * 
      * Manages DOCX files as ZIP archives, providing read/write access to
      * individual entries, file creation, and standard DOCX structure generation.
      * This class handles the underlying file system operations for Document.
+     * Archives beyond the classic ZIP limits (4 GB, 65,535 entries) are read
+     * and written with Zip64 records automatically.
      */
     class DUCKX_API DocxFile
     {
@@ -39,19 +72,108 @@ namespace duckx
         bool open(const std::string& path);
         /*! @brief Create a new DOCX file with basic structure */
         bool create(const std::string& path);
-        /*! @brief Save all changes to disk */
+        /*! @brief Save all changes to disk, unmodified entries are copied without recompression */
         void save();
+        /*!
+         * @brief Save, polling @p options once per archive entry
+         * @throws OperationCancelled if cancelled; the file on disk and the pending entries are unchanged
+         *
+         * Progress is reported in bytes of entry data written.
+         */
+        void save(const OperationOptions& options);
+        /*! @brief Take the changes since the last save for write_snapshot() and release the archive handle */
+        DocxSaveSnapshot snapshot();
+        /*! @brief Rewrite the archive of a snapshot, safe to call from any thread */
+        static void write_snapshot(const DocxSaveSnapshot& snapshot);
         /*! @brief Close the file and release resources */
         void close();
+        /*!
+         * @brief Copy the package to be saved under another path
+         * @param path Where the copy is written on save
+         *
+         * The copy shares the indexed archive, so unchanged entries are read
+         * and saved straight from the original compressed data. Pending
+         * entries are copied; the two packages are independent afterwards.
+         */
+        std::unique_ptr<DocxFile> fork(const std::string& path) const;
 
         /*! @brief Check if an entry exists in the archive */
         bool has_entry(const std::string& entry_name) const;
         /*! @brief Read content from an archive entry */
         std::string read_entry(const std::string& entry_name);
-        /*! @brief Write content to an archive entry */
+        /*!
+         * @brief Read an entry, polling @p options per inflated chunk
+         * @throws OperationCancelled if cancelled
+         *
+         * Progress is reported in uncompressed bytes.
+         */
+        std::string read_entry(const std::string& entry_name, const OperationOptions& options);
+        /*! @brief Write content to an archive entry, identical content is not marked as modified */
         void write_entry(const std::string& entry_name, const std::string& content);
+        /*!
+         * @brief Drop an entry from the package
+         * @return Bytes the entry occupied in the archive (compressed), or 0 if it did not exist
+         */
+        std::uint64_t remove_entry(const std::string& entry_name);
+        /*! @brief Names of all entries the next save would write, in archive order */
+        std::vector<std::string> entry_names() const;
+        /*! @brief Check if any entry changed since the last save */
+        bool is_modified() const;
+
+        /*!
+         * @brief Enable byte-reproducible output
+         * @param enabled Whether subsequent saves are deterministic
+         * @param timestamp UTC time written to ZIP headers and core properties
+         *
+         * Entries are written in canonical order ([Content_Types].xml first,
+         * then by name) with fixed timestamps and compression settings, and
+         * the created/modified dates in docProps/core.xml are pinned.
+         */
+        void set_deterministic(bool enabled, std::time_t timestamp = kDeterministicEpoch);
+        /*! @brief Check if deterministic output is enabled */
+        bool is_deterministic() const;
+        /*!
+         * @brief Append changes to the archive on disk instead of rewriting it
+         * @param enabled Whether subsequent saves are incremental
+         * @param compaction_threshold Fraction of the file allowed to be dead space
+         *
+         * An incremental save writes only the modified entries and a new
+         * central directory after the end of the existing file; superseded
+         * entries are left behind as dead space. When the dead space would
+         * exceed @p compaction_threshold of the file, that save rewrites the
+         * archive in full instead, compacting it. Deterministic output and
+         * the first save of a fork always rewrite.
+         */
+        void set_incremental(bool enabled, double compaction_threshold = 0.5);
+        /*! @brief Check if incremental saving is enabled */
+        bool is_incremental() const;
+        /*! @brief Bytes of the archive on disk no longer referenced by its central directory */
+        std::uint64_t dead_space() const;
+        /*!
+         * @brief Executor compressing modified entries in parallel on save
+         * @param executor Executor to use; nullptr follows default_executor()
+         */
+        void set_executor(std::shared_ptr<Executor> executor);
+        /*! @brief Executor saves schedule work on */
+        std::shared_ptr<Executor> executor() const;
+        /*!
+         * @brief Hash of the package content as it would be saved
+         *
+         * SHA-256 over the name, size and SHA-256 digest of every part. Part
+         * digests are cached: pending parts are hashed once per write, and
+         * archived parts are decompressed and hashed once, the cached digest
+         * being reused while the size and CRC-32 in the central directory
+         * still match.
+         * @return 64 hex digits
+         */
+        std::string content_hash();
+        /*! @brief Mark every written entry as modified again, e.g. after a failed background save */
+        void mark_all_modified();
 
     public:
+        /*! @brief Default deterministic timestamp, 1980-01-01T00:00:00Z (the earliest ZIP date) */
+        static constexpr std::time_t kDeterministicEpoch = 315532800;
+
         // Static methods for DOCX structure generation
         /*! @brief Create basic DOCX directory structure in ZIP archive */
         static void create_basic_structure(zip_t* zip);
@@ -79,5 +201,41 @@ namespace duckx
         std::string m_path;                                    //!< File system path
         zip_t* m_zip_handle = nullptr;                         //!< ZIP archive handle
         std::map<std::string, std::string> m_dirty_entries;    //!< Modified entries pending write
+
+    private:
+        /*! @brief Digest of one entry's uncompressed content, see content_hash() */
+        struct PartDigest
+        {
+            std::uint64_t size = 0;
+            std::uint32_t crc32 = 0;
+            std::array<std::uint8_t, 32> sha256{};
+        };
+
+        /*! @brief Get the indexed reader for the on-disk archive, opening it on first use */
+        ZipReader* archive() const;
+        /*! @brief Shared implementation of save(); @p operation may be null */
+        void save_package(const OperationOptions* operation);
+        /*! @brief Copy the entries changed since the last save */
+        std::map<std::string, std::string> modified_entries() const;
+        /*! @brief Compress the entries of @p target in parallel on its executor, keyed by name */
+        static std::map<std::string, ZipCompressedData> compress_entries(const DocxSaveSnapshot& target);
+        /*! @brief Write the entries of @p target over the contents of @p source, closing it if @p release_source */
+        static void write_archive(const DocxSaveSnapshot& target, ZipReader* source, bool release_source);
+        /*! @brief Append the entries of @p target to @p source in place; false if a full rewrite is due */
+        static bool append_archive(const DocxSaveSnapshot& target, ZipReader& source, bool release_source);
+        /*! @brief Pin the dates in docProps/core.xml to the deterministic timestamp */
+        void normalize_core_properties();
+
+        mutable std::shared_ptr<ZipReader> m_archive;          //!< Cached central directory index, shared with forks
+        bool m_inherited_archive = false;                      //!< m_archive is the original of a fork not yet saved
+        std::set<std::string> m_modified_entries;              //!< Entries changed since the last save
+        std::set<std::string> m_removed_entries;               //!< Archive entries dropped by remove_entry()
+        std::map<std::string, PartDigest> m_digests;           //!< Cached digests of pending and archived entries
+        bool m_deterministic = false;                          //!< Reproducible output enabled
+        std::time_t m_timestamp = kDeterministicEpoch;         //!< Timestamp for reproducible output
+        bool m_incremental = false;                            //!< Append-only saves enabled
+        double m_compaction_threshold = 0.5;                   //!< Dead-space fraction that forces a rewrite
+        bool m_rewrite_required = false;                       //!< Output settings changed since the last save
+        std::shared_ptr<Executor> m_executor;                  //!< Null to use default_executor()
     };
 } // namespace duckx
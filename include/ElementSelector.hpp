@@ -0,0 +1,144 @@
+/*!
+ * @file ElementSelector.hpp
+ * @brief Compiled selector queries over paragraphs, runs and tables
+ *
+ * A selector such as `tbl p[style=Heading2] r[bold]` is parsed once into a
+ * flat program of steps with pre-decoded property tests. Evaluation walks
+ * the tree once, carrying for every open element the set of steps matched
+ * so far, and decodes each element's properties at most once.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "BaseElement.hpp"
+#include "duckx_export.h"
+#include "Error.hpp"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class Body;
+
+    /*! @brief Element kinds a selector step can name */
+    enum class DUCKX_API SelectorElement : std::uint8_t
+    {
+        ANY,       //!< *
+        PARAGRAPH, //!< p
+        RUN,       //!< r
+        TABLE,     //!< tbl
+        ROW,       //!< tr
+        CELL       //!< tc
+    };
+
+    /*!
+     * @brief Lightweight handle to a matched element
+     *
+     * Converting to an element class is cheap; the node stays valid while
+     * the element is not removed.
+     */
+    struct DUCKX_API ElementMatch
+    {
+        pugi::xml_node node;
+        SelectorElement kind = SelectorElement::ANY;
+        MutationJournal* journal = nullptr; //!< Journal of the body searched, handed to the elements
+
+        Paragraph as_paragraph() const { return {node.parent(), node, journal}; }
+        Run as_run() const { return {node.parent(), node, journal}; }
+        Table as_table() const { return {node.parent(), node, journal}; }
+        TableRow as_row() const { return {node.parent(), node, journal}; }
+        TableCell as_cell() const { return {node.parent(), node, journal}; }
+    };
+
+    /*!
+     * @brief A compiled selector
+     *
+     * Grammar: steps separated by whitespace (descendant) or `>` (child).
+     * A step is an element name — `p`, `r`, `tbl`, `tr`, `tc` or `*` —
+     * followed by any number of property tests:
+     *
+     * - runs: `[bold]`, `[italic]`, `[underline]`, `[strike]`, `[smallcaps]`,
+     *   `[shadow]`, `[superscript]`, `[subscript]`, `[highlight]`,
+     *   `[style=Id]`, `[font=Name]`, `[color=FF0000]`, `[size=12]`
+     * - paragraphs: `[list]`, `[style=Id]`, `[align=center]`, `[level=1]`
+     * - tables: `[style=Id]`
+     *
+     * Flags may be negated (`[!bold]`), a bare `[style]` tests that a style
+     * is set, and values may be double-quoted. Parent/child relations skip
+     * wrappers such as w:hyperlink and w:sdt, so `p > r` matches hyperlink
+     * runs. Drawing and text box content is not searched.
+     */
+    class DUCKX_API ElementSelector
+    {
+    public:
+        /*! @brief Compile @p selector, reporting syntax errors as INVALID_ARGUMENT */
+        static Result<ElementSelector> compile_safe(absl::string_view selector);
+        /*!
+         * @brief Compile @p selector
+         * @throws std::invalid_argument on syntax errors
+         */
+        static ElementSelector compile(absl::string_view selector);
+
+        /*! @brief Matches below @p root in document order */
+        std::vector<ElementMatch> select(pugi::xml_node root) const;
+        /*! @brief Matches in the body in document order */
+        std::vector<ElementMatch> select(const Body& body) const;
+        /*! @brief Number of matches below @p root, without collecting them */
+        std::size_t count(pugi::xml_node root) const;
+
+        /*! @brief Number of steps in the compiled program */
+        std::size_t size() const { return m_steps.size(); }
+
+    private:
+        enum class Property : std::uint8_t
+        {
+            FORMATTING, //!< Run formatting flag, in flag
+            HIGHLIGHT,
+            STYLE,
+            FONT,
+            COLOR,
+            SIZE,
+            LIST,
+            ALIGN,
+            LEVEL
+        };
+
+        struct Test
+        {
+            Property property = Property::STYLE;
+            bool negate = false;
+            bool has_value = false;
+            formatting_flag flag = none;
+            Alignment alignment = Alignment::LEFT;
+            double number = 0.0;
+            std::string text;
+        };
+
+        struct Step
+        {
+            SelectorElement kind = SelectorElement::ANY;
+            bool child = false; //!< Must be the element child of the previous step's match
+            std::vector<Test> tests;
+        };
+
+        struct Decoded; //!< Properties of one element, decoded on first use
+
+        template <typename Visitor>
+        void walk(pugi::xml_node node, std::uint64_t at, std::uint64_t below, Visitor& visit) const;
+        static bool matches(const Step& step, SelectorElement kind, pugi::xml_node node, Decoded& decoded);
+
+        static constexpr std::size_t kMaxSteps = 63; //!< Matched-step sets are 64-bit masks
+        static constexpr std::size_t kElementKinds = 6;
+
+        std::vector<Step> m_steps;
+        std::uint64_t m_child_steps = 0;                //!< Bit k set if step k uses the child combinator
+        std::uint64_t m_kind_steps[kElementKinds] = {}; //!< Per SelectorElement, steps that can match it
+    };
+} // namespace duckx
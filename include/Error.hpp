@@ -562,6 +562,14 @@ namespace duckx
 
     namespace errors
     {
+        inline Error operation_cancelled(const absl::string_view operation, const ErrorContext& ctx = {})
+        {
+            return {
+                ErrorCategory::GENERAL, ErrorCode::OPERATION_CANCELLED,
+                absl::StrFormat("Operation cancelled: %s", operation), ctx
+            };
+        }
+
         inline Error file_not_found(const absl::string_view path, const ErrorContext& ctx = {})
         {
             return {
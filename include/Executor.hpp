@@ -0,0 +1,124 @@
+/*!
+ * @file Executor.hpp
+ * @brief Pluggable task executor used by every parallel path of the library
+ *
+ * duckx never starts threads of its own for background or parallel work:
+ * tasks are handed to an Executor. Hosts that run their own pool implement
+ * the interface (usually a thin adapter around submit) and install it with
+ * set_default_executor() or Document::set_executor(), keeping control over
+ * concurrency, affinity and priorities. Without one, a shared internal
+ * work-stealing pool sized to the hardware is created on first use.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "duckx_export.h"
+
+namespace duckx
+{
+    /*!
+     * @brief Counter that lets one thread wait for a set of tasks
+     *
+     * add() before handing work out, done() once per finished unit, wait()
+     * until the count drops to zero.
+     */
+    class DUCKX_API WaitGroup
+    {
+    public:
+        WaitGroup() = default;
+        WaitGroup(const WaitGroup&) = delete;
+        WaitGroup& operator=(const WaitGroup&) = delete;
+
+        void add(std::size_t count = 1);
+        void done();
+        void wait();
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_zero;
+        std::size_t m_count = 0;
+    };
+
+    /*!
+     * @brief Interface through which the library schedules tasks
+     *
+     * Implementations must be thread-safe. Tasks must not throw; library
+     * tasks catch their own exceptions.
+     */
+    class DUCKX_API Executor
+    {
+    public:
+        virtual ~Executor() = default;
+
+        /*! @brief Run @p task at some point, possibly on another thread */
+        virtual void submit(std::function<void()> task) = 0;
+        /*! @brief Number of tasks that can usefully run at the same time */
+        virtual std::size_t concurrency() const = 0;
+
+        /*!
+         * @brief Call @p body for every index in [begin, end) and return when all calls finished
+         * @param grain Indices claimed per step; larger values cut scheduling overhead
+         *
+         * The calling thread takes part in the loop, and it only waits for
+         * indices already claimed by helper tasks, never for a helper that
+         * has not started yet. Calling parallel_for from a task of the same
+         * executor is therefore safe, even on a single thread. The first
+         * exception thrown by @p body is rethrown here once the loop has
+         * stopped; indices not yet started are skipped.
+         */
+        void parallel_for(std::size_t begin, std::size_t end, const std::function<void(std::size_t)>& body,
+                          std::size_t grain = 1);
+    };
+
+    /*! @brief Executor running every task immediately on the submitting thread */
+    class DUCKX_API InlineExecutor : public Executor
+    {
+    public:
+        void submit(std::function<void()> task) override;
+        std::size_t concurrency() const override { return 1; }
+    };
+
+    /*!
+     * @brief Work-stealing thread pool
+     *
+     * Each worker owns a task deque: tasks submitted from a worker go to its
+     * own deque and are taken newest first, while idle workers steal the
+     * oldest tasks of the others. Tasks submitted from outside are spread
+     * round-robin. The destructor runs the tasks still queued, then joins.
+     */
+    class DUCKX_API ThreadPoolExecutor : public Executor
+    {
+    public:
+        /*! @param threads Number of workers; 0 uses std::thread::hardware_concurrency() */
+        explicit ThreadPoolExecutor(std::size_t threads = 0);
+        ~ThreadPoolExecutor() override;
+
+        ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+        ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+        void submit(std::function<void()> task) override;
+        std::size_t concurrency() const override;
+
+    private:
+        struct State;
+        std::unique_ptr<State> m_state;
+    };
+
+    /*! @brief Executor used where no per-document executor is set; the internal pool unless replaced */
+    DUCKX_API std::shared_ptr<Executor> default_executor();
+    /*!
+     * @brief Replace the library-wide executor
+     * @param executor New executor; nullptr restores the internal pool
+     *
+     * Work already submitted stays with the previous executor.
+     */
+    DUCKX_API void set_default_executor(std::shared_ptr<Executor> executor);
+} // namespace duckx
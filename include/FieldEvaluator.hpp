@@ -0,0 +1,158 @@
+/*!
+ * @file FieldEvaluator.hpp
+ * @brief Compute cached results of TOC, REF, PAGEREF, SEQ, PAGE and NUMPAGES fields
+ *
+ * Documents produced headless otherwise show empty or stale field results
+ * until Word updates them. The evaluator walks the body once, estimating
+ * pagination and collecting headings, bookmarks and sequence counters,
+ * then writes the results of fields that depend on what follows them.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "duckx_export.h"
+#include "NumberingManager.hpp"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class MutationJournal;
+
+    /*! @brief Layout parameters for the approximate pagination */
+    struct DUCKX_API FieldEvaluationOptions
+    {
+        double default_font_size = 11.0;  //!< Points, for runs without w:sz
+        double line_spacing = 1.15;       //!< Line height as a multiple of the font size
+        double average_char_width = 0.5; //!< Average Latin glyph width as a fraction of the font size
+    };
+
+    /*! @brief Outcome of a field evaluation */
+    struct DUCKX_API FieldEvaluationReport
+    {
+        std::size_t fields_updated = 0;        //!< Fields whose cached result was written
+        std::size_t unresolved_references = 0; //!< REF/PAGEREF fields naming a missing bookmark
+        int page_count = 1;                    //!< Estimated number of pages
+    };
+
+    /*!
+     * @brief Fills in field results without a layout engine
+     *
+     * Pagination is estimated from text length, font sizes, paragraph
+     * spacing, inline images, table rows and explicit page and section
+     * breaks, so page numbers are approximate. Headings are recognised by
+     * "Heading N" paragraph styles and, for TOC \\u, by w:outlineLvl.
+     */
+    class DUCKX_API FieldEvaluator
+    {
+    public:
+        explicit FieldEvaluator(const FieldEvaluationOptions& options = FieldEvaluationOptions());
+
+        /*! @brief Paragraph numbers used for headings in a TOC and by REF \\n, \\r and \\w */
+        void set_list_labels(const std::vector<ListLabel>& labels);
+        /*! @brief Report the results written to the journal of the document being evaluated */
+        void set_journal(MutationJournal* journal) { m_journal = journal; }
+
+        /*! @brief Evaluate all fields of a w:body */
+        FieldEvaluationReport evaluate(pugi::xml_node body);
+        /*!
+         * @brief Evaluate a header or footer after the body
+         *
+         * PAGE shows the first page; REF, PAGEREF and NUMPAGES use what was
+         * collected from the body.
+         */
+        FieldEvaluationReport evaluate_page_part(pugi::xml_node root);
+
+    private:
+        enum class Kind
+        {
+            OTHER,
+            PAGE,
+            NUMPAGES,
+            SEQ,
+            REF,
+            PAGEREF,
+            TOC
+        };
+
+        struct Field
+        {
+            Kind kind = Kind::OTHER;
+            std::string instruction;
+            pugi::xml_node simple;   //!< w:fldSimple
+            pugi::xml_node begin;    //!< Runs holding the w:fldChar of a complex field
+            pugi::xml_node separate;
+            pugi::xml_node end;
+            bool ignored = false;    //!< Nested in a result that is rewritten anyway
+        };
+
+        struct Bookmark
+        {
+            std::string name;
+            std::string text;
+            int page = 1;
+            pugi::xml_node paragraph;
+        };
+
+        struct Heading
+        {
+            pugi::xml_node paragraph;
+            int level = 1;
+            bool from_outline_level = false;
+            int page = 1;
+            std::string text;
+            std::string bookmark; //!< First bookmark starting in the heading
+        };
+
+        void reset();
+        void layout_blocks(pugi::xml_node container);
+        void visit_blocks(pugi::xml_node container);
+        void layout_table(pugi::xml_node table);
+        void layout_paragraph(pugi::xml_node paragraph, bool advance);
+        double measure_blocks(pugi::xml_node container, double width) const;
+        double measure_paragraph(pugi::xml_node paragraph, double width) const;
+        void new_page();
+
+        void visit_inline(pugi::xml_node root, Heading* heading);
+        void field_ready(std::size_t index);
+        bool write_result(Field& field, const std::string& text);
+        void fill(Field& field);
+        bool inside_rewritten_result() const;
+        bool build_toc(Field& field);
+        std::string format_value(const Field& field, int value) const;
+        const Bookmark* find_bookmark(const std::string& name) const;
+        std::string add_toc_bookmark(Heading& heading);
+
+        FieldEvaluationOptions m_options;
+        absl::flat_hash_map<const void*, std::string> m_labels; //!< w:p -> list label
+        MutationJournal* m_journal = nullptr;
+
+        // Page metrics in points, taken from the body's w:sectPr
+        double m_page_width = 468.0;
+        double m_page_height = 648.0;
+        double m_y = 0.0;
+        int m_page = 1;
+        int m_page_count = 1;
+        bool m_advancing = false;
+        pugi::xml_node m_paragraph; //!< Paragraph being visited
+        std::size_t m_updated = 0;
+        std::size_t m_unresolved = 0;
+
+        std::vector<Field> m_fields;
+        std::vector<std::size_t> m_open_fields;
+        absl::flat_hash_map<std::string, Bookmark> m_bookmarks; //!< Keyed by lower-case name
+        absl::flat_hash_map<int, std::string> m_open_bookmarks;  //!< w:id -> key, while collecting text
+        std::vector<Heading> m_headings;
+        absl::flat_hash_map<std::string, int> m_sequences;        //!< SEQ identifier -> last value
+        absl::flat_hash_map<std::string, int> m_sequence_section; //!< SEQ identifier -> heading serial at last use
+        int m_headings_by_level[10] = {};                         //!< Headings seen at level <= N
+        int m_next_bookmark_id = 0;
+        int m_next_toc_bookmark = 0;
+    };
+} // namespace duckx
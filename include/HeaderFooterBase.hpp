@@ -33,9 +33,10 @@ namespace duckx
         Table add_table(int rows, int cols);
 
     protected:
-        explicit HeaderFooterBase(pugi::xml_node rootNode);
+        explicit HeaderFooterBase(pugi::xml_node rootNode, MutationJournal* journal = nullptr);
 
         pugi::xml_node m_rootNode; //!< The <w:hdr> or <w:ftr> XML node
+        MutationJournal* m_journal = nullptr; //!< Journal of the owning document
         Paragraph m_paragraph;
         Table m_table;
     };
@@ -49,7 +50,7 @@ namespace duckx
     class DUCKX_API Header : public HeaderFooterBase
     {
     public:
-        explicit Header(pugi::xml_node rootNode);
+        explicit Header(pugi::xml_node rootNode, MutationJournal* journal = nullptr);
     };
 
     /*!
@@ -61,6 +62,6 @@ namespace duckx
     class DUCKX_API Footer : public HeaderFooterBase
     {
     public:
-        explicit Footer(pugi::xml_node rootNode);
+        explicit Footer(pugi::xml_node rootNode, MutationJournal* journal = nullptr);
     };
 }
@@ -15,8 +15,11 @@
 
 #include "constants.hpp"
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "pugixml.hpp"
 
@@ -32,12 +35,53 @@ namespace duckx
     class DocxFile;
     class Document;
 
+    /*!
+     * @brief Immutable serialized header or footer shared between documents
+     *
+     * Templates are interned by content hash: building the same header in
+     * many generated documents yields one template whose bytes are written
+     * as-is, without re-printing the XML for every document. Interning
+     * content already in the pool costs a hash and a byte comparison; only
+     * new content is parsed to validate it.
+     */
+    class DUCKX_API HeaderFooterTemplate
+    {
+    public:
+        /*!
+         * @brief Get the shared template for a serialized <w:hdr> or <w:ftr> part
+         * @param xml Complete part XML
+         * @throws std::invalid_argument if the XML is not a header or footer part
+         */
+        static std::shared_ptr<const HeaderFooterTemplate> intern(std::string xml);
+
+        /*! @brief Serialized part XML */
+        const std::string& xml() const { return m_xml; }
+        /*! @brief 64-bit FNV-1a hash of xml() */
+        std::uint64_t hash() const { return m_hash; }
+        /*! @brief true for <w:hdr>, false for <w:ftr> */
+        bool is_header() const { return m_is_header; }
+
+    private:
+        HeaderFooterTemplate(std::string xml, std::uint64_t hash, bool is_header);
+
+        std::string m_xml;
+        std::uint64_t m_hash;
+        bool m_is_header;
+    };
+
     /*!
      * @brief Manager for document headers and footers
      * 
      * Handles the creation, management, and XML serialization of headers
      * and footers. Supports different types like default, first page, and
      * even/odd page headers/footers.
+     *
+     * Parts referenced from the properties of every section are indexed on
+     * construction but only parsed when first requested, and only parts
+     * whose content changed are written back on save. get_header() and
+     * get_footer() return the part the final section uses for a type,
+     * inherited from an earlier section when the final one has none;
+     * load_all() covers the parts of all sections.
      */
     class DUCKX_API HeaderFooterManager
     {
@@ -54,19 +98,73 @@ namespace duckx
         HeaderFooterManager(HeaderFooterManager&&) = default;
         HeaderFooterManager& operator=(HeaderFooterManager&&) = default;
 
-        /*! @brief Save all headers and footers to the document */
-        void save_all() const;
+        /*! @brief Write headers and footers whose content changed since the last save */
+        void save_all();
         /*! @brief Get or create a header of the specified type */
         Header& get_header(HeaderFooterType type = HeaderFooterType::DEFAULT);
         /*! @brief Get or create a footer of the specified type */
         Footer& get_footer(HeaderFooterType type = HeaderFooterType::DEFAULT);
 
+        /*! @brief Parse the header and footer parts of all sections and return their root elements */
+        std::vector<pugi::xml_node> load_all();
+        /*!
+         * @brief Forget parts no relationship refers to any more
+         *
+         * Called after a rollback removed the relationships of parts created
+         * during the transaction; their Header and Footer objects are destroyed.
+         */
+        void drop_unreferenced_parts();
+
+        /*! @brief Check whether a header of the specified type exists, without loading it */
+        bool has_header(HeaderFooterType type) const;
+        /*! @brief Check whether a footer of the specified type exists, without loading it */
+        bool has_footer(HeaderFooterType type) const;
+
+        /*! @brief Snapshot a header as a shareable template (creates an empty header if missing) */
+        std::shared_ptr<const HeaderFooterTemplate> header_template(HeaderFooterType type);
+        /*! @brief Snapshot a footer as a shareable template (creates an empty footer if missing) */
+        std::shared_ptr<const HeaderFooterTemplate> footer_template(HeaderFooterType type);
+        /*!
+         * @brief Use a template's content for the header of the specified type
+         * @throws std::invalid_argument if the template is a footer
+         *
+         * Until the header is requested through get_header() the template's
+         * bytes are written unchanged on save.
+         */
+        void set_header_template(HeaderFooterType type, std::shared_ptr<const HeaderFooterTemplate> tmpl);
+        /*! @brief Use a template's content for the footer of the specified type */
+        void set_footer_template(HeaderFooterType type, std::shared_ptr<const HeaderFooterTemplate> tmpl);
+
     private:
+        /*! @brief One header or footer part and its load/save state */
+        struct Part
+        {
+            std::string entry;                                //!< Archive path, e.g. "word/header1.xml"
+            bool is_header = true;                            //!< <w:hdr> rather than <w:ftr>
+            std::unique_ptr<pugi::xml_document> xml;          //!< Parsed content, null until first access
+            std::shared_ptr<const HeaderFooterTemplate> shared; //!< Content source while xml is null
+            bool in_archive = false;                          //!< Archive already holds the current content
+            std::uint64_t archived_hash = 0;                  //!< Hash of the printed archived content
+        };
+        using PartMap = std::map<std::string, Part>;
+        using TypeMap = std::map<HeaderFooterType, std::string>;
+
+        /*! @brief Index header/footer references of all sections */
+        void discover_parts();
+        /*! @brief Part used by the final section for @p type, or nullptr */
+        Part* find_part(const TypeMap& types, HeaderFooterType type);
+        /*! @brief Parse a part on first access and return its root node */
+        pugi::xml_node materialize(Part& part, const char* root_tag) const;
+        /*! @brief Write a single part if its content changed */
+        void save_part(Part& part) const;
+        /*! @brief Snapshot a part's current content */
+        std::shared_ptr<const HeaderFooterTemplate> make_template(Part& part, const char* root_tag) const;
+        /*! @brief Replace a part's content with a template */
+        void apply_template(Part& part, const char* root_tag, std::shared_ptr<const HeaderFooterTemplate> tmpl) const;
+
         // Generic helper for creating header or footer parts
-        /*! @brief Create XML structure for header or footer part */
-        pugi::xml_node create_hf_part(const std::string& type_str, HeaderFooterType type_enum);
-        /*! @brief Generate part name based on type and keyword */
-        std::string get_part_name_for_type(HeaderFooterType type, const std::string& hf_keyword) const;
+        /*! @brief Register a new header or footer part in rels, content types and sectPr */
+        Part& create_hf_part(const std::string& type_str, HeaderFooterType type_enum);
 
         // Helper functions for XML manipulations
         /*! @brief Add relationship entry for header/footer */
@@ -79,22 +177,17 @@ namespace duckx
         /*! @brief Get or create section properties node */
         pugi::xml_node get_or_create_sect_pr() const;
 
-        // Helper to convert enum to string for XML
-        /*! @brief Convert HeaderFooterType enum to string */
-        static std::string hf_type_to_string(HeaderFooterType type);
-
         DocxFile* m_file = nullptr;                    //!< Reference to DOCX file handler
         Document* m_doc = nullptr;                     //!< Reference to parent document
         pugi::xml_document* m_doc_xml = nullptr;       //!< Document XML
         pugi::xml_document* m_rels_xml = nullptr;      //!< Relationships XML
         pugi::xml_document* m_content_types_xml = nullptr; //!< Content types XML
 
-        std::map<HeaderFooterType, std::unique_ptr<pugi::xml_document>> m_hf_docs; //!< XML documents for headers/footers
-        std::map<HeaderFooterType, std::unique_ptr<Header>> m_headers;             //!< Header instances by type
-        std::map<HeaderFooterType, std::unique_ptr<Footer>> m_footers;             //!< Footer instances by type
-
-        std::map<HeaderFooterType, std::string> m_header_filenames; //!< Header file names by type
-        std::map<HeaderFooterType, std::string> m_footer_filenames; //!< Footer file names by type
+        PartMap m_parts;          //!< Header and footer parts of all sections by entry (existing and new)
+        TypeMap m_header_entries; //!< Entry of the final section's header part by type
+        TypeMap m_footer_entries; //!< Entry of the final section's footer part by type
+        std::map<HeaderFooterType, std::unique_ptr<Header>> m_headers; //!< Header instances by type
+        std::map<HeaderFooterType, std::unique_ptr<Footer>> m_footers; //!< Footer instances by type
 
         int m_header_id_counter = 1; //!< Counter for generating header IDs
         int m_footer_id_counter = 1; //!< Counter for generating footer IDs
@@ -55,10 +55,26 @@ namespace duckx
         Run add_image(const Paragraph& p, const Image& image);
         /*! @brief Add a textbox to a paragraph and return the created run */
         Run add_textbox(const Paragraph& p, const TextBox& textbox);
+        /*!
+         * @brief Store encoded image bytes as a new media part
+         * @param content Image file bytes
+         * @param extension Lower-case file extension without the dot
+         * @return Relationship ID referring to the new part
+         */
+        std::string add_image_part(const std::string& content, const std::string& extension);
+
+        /*!
+         * @brief Read an image file for embedding
+         * @param file_path Path of the image file
+         * @param extension Receives the lower-case extension without the dot
+         * @return The file bytes
+         * @throws std::runtime_error if the file cannot be read or its type is unsupported
+         */
+        static std::string read_image_file(const std::string& file_path, std::string& extension);
 
     private:
-        /*! @brief Add media file to the DOCX archive */
-        std::string add_media_to_zip(const std::string& file_path);
+        /*! @brief Add media bytes to the DOCX archive and return the relationship target */
+        std::string add_media_to_zip(const std::string& content, const std::string& extension);
         /*! @brief Create relationship entry for image */
         std::string add_image_relationship(const std::string& media_target) const;
         /*! @brief Generate unique document property ID */
@@ -0,0 +1,199 @@
+/*!
+ * @file MutationJournal.hpp
+ * @brief Journal of DOM mutations backing Document transactions
+ *
+ * Element and manager mutators report node inserts and removals, changes
+ * to existing nodes and ID counter bumps through static hooks, passing the
+ * journal of the document they edit. Every reported edit flags its part as
+ * modified, which is how Document decides what to re-serialize on save.
+ * While a transaction is open the journal also keeps just enough to undo
+ * each edit, so rollback costs time proportional to the edits rather than
+ * to the document.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    /*!
+     * @brief Package parts owned by Document whose serialization is tracked
+     *
+     * Only parts flagged as modified are re-serialized on save; all other
+     * parts keep their original compressed bytes in the archive.
+     */
+    enum class DUCKX_API DocumentPart
+    {
+        MAIN_DOCUMENT, //!< word/document.xml
+        RELATIONSHIPS, //!< word/_rels/document.xml.rels
+        CONTENT_TYPES, //!< [Content_Types].xml
+        STYLES,        //!< word/styles.xml
+        NUMBERING,     //!< word/numbering.xml
+        HEADER_FOOTER  //!< word/header*.xml and word/footer*.xml
+    };
+
+    /*! @brief What a journal entry records */
+    enum class DUCKX_API MutationKind
+    {
+        NODE_INSERTED,      //!< A block (paragraph, table, relationship, ...) was added to its part
+        NODE_REMOVED,       //!< A block was removed from its part
+        NODE_CHANGED,       //!< Attributes, text or children inside an existing block changed
+        ATTRIBUTES_CHANGED, //!< Attributes of a part's root or of w:body changed
+        COUNTER_CHANGED     //!< An ID counter (relationship, drawing, media) advanced
+    };
+
+    /*!
+     * @brief One entry of the journal, as seen by downstream consumers
+     *
+     * Changes are recorded per block: a direct child of w:body or of the
+     * root element of any other part (relationship, numbering definition,
+     * header paragraph, ...). Edits inside a table cell are reported as a
+     * change of the table.
+     */
+    struct DUCKX_API Mutation
+    {
+        MutationKind kind = MutationKind::NODE_CHANGED;
+        DocumentPart part = DocumentPart::MAIN_DOCUMENT;
+        /*!
+         * @brief The affected block in the live tree
+         *
+         * For NODE_REMOVED, a read-only copy of the removed block. Empty for
+         * counters and for blocks removed again later in the transaction.
+         */
+        pugi::xml_node node;
+    };
+
+    /*!
+     * @brief Undo log of the transactions of one Document
+     *
+     * Every Document owns one journal, watching its parts from the start,
+     * and hands it to the elements and managers it creates. Only that
+     * document's mutators ever reach it, so documents edited on different
+     * threads never share any state. begin() opens a transaction; commit()
+     * keeps the recorded entries readable until the next transaction,
+     * rollback() undoes them in reverse order.
+     */
+    class DUCKX_API MutationJournal
+    {
+    public:
+        MutationJournal() = default;
+
+        MutationJournal(const MutationJournal&) = delete;
+        MutationJournal& operator=(const MutationJournal&) = delete;
+
+        /*! @brief Start recording; clears the entries of the previous transaction */
+        void begin();
+        /*! @brief Record mutations of nodes in @p doc as mutations of @p part */
+        void watch(pugi::xml_document& doc, DocumentPart part);
+        /*! @brief Stop recording mutations of @p doc, e.g. before destroying it */
+        void unwatch(const pugi::xml_document& doc);
+        /*! @brief Stop recording and keep the changes */
+        void commit();
+        /*! @brief Stop recording and undo every recorded change, newest first */
+        void rollback();
+        /*!
+         * @brief Mark the current state of the open transaction
+         * @return Position to pass to rollback_to()
+         *
+         * Blocks already recorded are recorded again when changed after the
+         * savepoint, so each savepoint costs one more copy per such block.
+         */
+        std::size_t savepoint();
+        /*! @brief Undo the changes recorded after @p savepoint and keep recording */
+        void rollback_to(std::size_t savepoint);
+
+        /*! @brief Check whether a transaction is open */
+        bool active() const { return m_active; }
+        /*! @brief Number of recorded entries */
+        std::size_t size() const { return m_records.size(); }
+        /*!
+         * @brief Entries of the open or last committed transaction, oldest first
+         *
+         * Nodes stay valid until the blocks they refer to are edited again
+         * outside a transaction.
+         */
+        std::vector<Mutation> mutations() const;
+        /*! @brief Check whether @p part was touched by the open or last committed transaction */
+        bool touched(DocumentPart part) const;
+
+        /*! @brief Check whether an edit of @p part was reported since clear_modified() */
+        bool modified(DocumentPart part) const;
+        /*! @brief Forget the modified flags, once the parts were written */
+        void clear_modified() { m_modified_parts = 0; }
+        /*!
+         * @brief Number of edits reported so far, rollbacks included
+         *
+         * Anything derived from the watched parts can store it and compare
+         * it later to find out whether it is stale.
+         */
+        std::uint64_t generation() const { return m_generation; }
+
+        // Hooks called by mutators with the journal of the document they
+        // edit. They do nothing for a null journal (elements not obtained
+        // from a Document, fragments) or a node outside the watched parts.
+
+        /*! @brief Call before changing @p node or anything below it */
+        static void before_change(MutationJournal* journal, pugi::xml_node node);
+        /*! @brief Call after inserting @p node */
+        static void after_insert(MutationJournal* journal, pugi::xml_node node);
+        /*! @brief Call before removing @p node */
+        static void before_remove(MutationJournal* journal, pugi::xml_node node);
+        /*! @brief Call before advancing an ID counter owned by the journal's document */
+        static void before_counter_change(MutationJournal* journal, int& counter);
+        /*! @copydoc before_counter_change(MutationJournal*, int&) */
+        static void before_counter_change(MutationJournal* journal, unsigned int& counter);
+
+    private:
+        struct Slot
+        {
+            pugi::xml_node node;
+            bool live = true;
+        };
+
+        struct Record
+        {
+            MutationKind kind = MutationKind::NODE_CHANGED;
+            DocumentPart part = DocumentPart::MAIN_DOCUMENT;
+            std::size_t slot = 0;      //!< Block (or container) the entry refers to
+            pugi::xml_node saved;      //!< Prior state, or the removed block, in m_saved
+            pugi::xml_node container;  //!< Parent of a removed block
+            std::size_t anchor = 0;    //!< Slot of the next sibling of a removed block, or kNoSlot
+            void* counter = nullptr;
+            bool counter_unsigned = false;
+            long long counter_value = 0;
+        };
+
+        static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+        bool note_edit(pugi::xml_node node, DocumentPart& part);
+        void record_change(pugi::xml_node node, DocumentPart part);
+        void record_insert(pugi::xml_node node, DocumentPart part);
+        void record_remove(pugi::xml_node node, DocumentPart part);
+        void record_counter(void* counter, bool is_unsigned, long long value);
+        std::size_t slot_for(pugi::xml_node node);
+        void undo_to(std::size_t savepoint);
+
+        bool m_active = false;
+        std::vector<Record> m_records;
+        std::vector<Slot> m_slots;
+        absl::flat_hash_map<const void*, std::size_t> m_slot_of; //!< Live block -> slot
+        absl::flat_hash_set<const void*> m_covered;              //!< Blocks whose prior state is already recorded
+        absl::flat_hash_set<const void*> m_counters;             //!< Counters whose prior value is recorded
+        std::vector<std::pair<const void*, DocumentPart>> m_parts; //!< Watched document roots
+        unsigned m_touched_parts = 0;                            //!< DocumentPart bits with entries
+        unsigned m_modified_parts = 0;                           //!< DocumentPart bits edited since clear_modified()
+        std::uint64_t m_generation = 0;
+        pugi::xml_document m_saved;                              //!< Copies of prior states and removed blocks
+    };
+} // namespace duckx
@@ -0,0 +1,147 @@
+/*!
+ * @file NumberingManager.hpp
+ * @brief Model of word/numbering.xml and list label computation
+ *
+ * Parses abstract numbering definitions, numbering instances and their
+ * level overrides into indexed tables, computes the label Word displays
+ * for every list paragraph ("3.2.1", "b)", "iv.") in one forward pass,
+ * and creates new list definitions without duplicating existing ones.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "constants.hpp"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    class Document;
+    class DocxFile;
+
+    /*! @brief One level (w:lvl) of a list definition */
+    struct DUCKX_API NumberingLevel
+    {
+        int start = 1;                    //!< w:start
+        std::string format = "decimal";   //!< w:numFmt (decimal, lowerLetter, upperRoman, bullet, none, ...)
+        std::string text = "%1.";         //!< w:lvlText, %N is replaced by the counter of level N
+        int restart_after = -1;           //!< w:lvlRestart; -1 restarts after any higher level, 0 never
+        bool legal = false;               //!< w:isLgl, show all referenced levels as decimal
+        double indent_left = 0.0;         //!< w:pPr/w:ind/@w:left in points
+        double hanging = 0.0;             //!< w:pPr/w:ind/@w:hanging in points
+    };
+
+    /*! @brief Label of a list paragraph */
+    struct DUCKX_API ListLabel
+    {
+        pugi::xml_node paragraph; //!< The w:p element
+        int num_id = 0;           //!< w:numPr/w:numId
+        int level = 0;            //!< w:numPr/w:ilvl
+        std::string text;         //!< Displayed label, e.g. "2.1." or the bullet character
+    };
+
+    /*!
+     * @brief Indexed numbering definitions of a document
+     *
+     * Counters follow Word: numbering instances that share an abstract
+     * definition continue each other unless an instance carries a
+     * w:startOverride, and a level restarts after higher levels according
+     * to w:lvlRestart.
+     */
+    class DUCKX_API NumberingManager
+    {
+    public:
+        static constexpr int kLevelCount = 9;
+
+        NumberingManager(Document* owner_doc, DocxFile* file, pugi::xml_document* rels_xml,
+                         pugi::xml_document* content_types_xml);
+
+        NumberingManager(const NumberingManager&) = delete;
+        NumberingManager& operator=(const NumberingManager&) = delete;
+
+        /*!
+         * @brief Labels of all numbered paragraphs below @p root, in document order
+         *
+         * Only direct numbering (w:pPr/w:numPr) is considered; paragraphs
+         * numbered through their paragraph style get no label.
+         */
+        std::vector<ListLabel> compute_labels(pugi::xml_node root) const;
+
+        /*!
+         * @brief Get a numbering instance for the given levels
+         * @return w:numId to put in w:numPr
+         *
+         * An identical abstract definition and an override-free instance of
+         * it are reused if they exist, so repeated calls never grow the part.
+         */
+        int define_list(const std::vector<NumberingLevel>& levels);
+        /*! @brief Get a numbering instance for a built-in bullet or decimal list */
+        int define_list(ListType type);
+        /*!
+         * @brief Create an instance that continues the definition of @p num_id but restarts at @p start
+         * @return New w:numId, or 0 if @p num_id does not exist
+         */
+        int restart_list(int num_id, int start = 1);
+
+        /*! @brief Effective level definition of a numbering instance (overrides applied) */
+        const NumberingLevel* level(int num_id, int level) const;
+        /*! @brief Classify a list level as bullet or numbered */
+        ListType list_type(int num_id, int level) const;
+        /*! @brief Format a counter value in a w:numFmt style ("lowerRoman", "upperLetter", ...) */
+        static std::string format_number(int value, const std::string& format);
+        /*! @brief Check whether a numbering instance exists */
+        bool has_num(int num_id) const { return m_nums.count(num_id) != 0; }
+
+        /*! @brief Write word/numbering.xml if definitions were added */
+        void save();
+        /*!
+         * @brief Rebuild the indexed tables from the XML
+         *
+         * Called after a rollback restored definitions added during a
+         * transaction; the part is written again on the next save.
+         */
+        void reload();
+
+    private:
+        struct AbstractNum
+        {
+            std::array<NumberingLevel, kLevelCount> levels;
+            int level_count = 0; //!< Levels actually defined
+        };
+
+        struct Num
+        {
+            int abstract_id = 0;
+            std::array<int, kLevelCount> start_override; //!< -1 if none
+            std::array<bool, kLevelCount> has_level_override;
+            std::array<NumberingLevel, kLevelCount> level_override;
+            bool has_overrides = false;
+        };
+
+        void parse();
+        void ensure_part();
+        static std::string signature(const std::vector<NumberingLevel>& levels);
+        static std::string signature(const AbstractNum& abstract_num);
+
+        Document* m_doc = nullptr;
+        DocxFile* m_file = nullptr;
+        pugi::xml_document* m_rels_xml = nullptr;
+        pugi::xml_document* m_content_types_xml = nullptr;
+
+        pugi::xml_document m_numbering_xml;
+        absl::flat_hash_map<int, AbstractNum> m_abstracts;
+        absl::flat_hash_map<int, Num> m_nums;
+        absl::flat_hash_map<std::string, int> m_abstract_by_signature; //!< Level signature -> abstractNumId
+        int m_next_abstract_id = 0;
+        int m_next_num_id = 1;
+        bool m_has_part = false;
+        bool m_dirty = false;
+    };
+} // namespace duckx
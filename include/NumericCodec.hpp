@@ -0,0 +1,90 @@
+/*!
+ * @file NumericCodec.hpp
+ * @brief Locale-free parsing and formatting of numeric OOXML attributes
+ *
+ * Integer and fixed-point attribute values (twips, half-points, eighths of
+ * a point, EMUs) are parsed and formatted without std::locale, streams or
+ * heap allocation. Formatting writes into a small stack buffer whose
+ * c_str() can be handed straight to pugixml.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+#include "duckx_export.h"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    namespace numeric
+    {
+        // Fixed-point scales: number of attribute units per point
+        constexpr long long kTwipsPerPoint = 20;      //!< w:spacing, w:ind, w:tcW, w:pgMar, ...
+        constexpr long long kHalfPointsPerPoint = 2;  //!< w:sz, w:szCs
+        constexpr long long kEighthsPerPoint = 8;     //!< Border w:sz
+        constexpr long long kEmuPerPoint = 12700;     //!< DrawingML extents and offsets
+        constexpr long long kLineSpacingUnit = 240;   //!< w:spacing/@w:line per single line
+
+        /*! @brief Stack buffer holding a formatted number */
+        struct DUCKX_API NumberBuffer
+        {
+            char data[24];    //!< NUL-terminated digits
+            std::size_t size; //!< Number of characters before the terminator
+
+            const char* c_str() const { return data; }
+            absl::string_view view() const { return absl::string_view(data, size); }
+        };
+
+        /*! @brief Format an integer in base 10 */
+        DUCKX_API NumberBuffer format_int(long long value);
+
+        /*!
+         * @brief Parse a whole string as a base-10 integer
+         * @return false on empty input, stray characters or overflow; @p value is then untouched
+         *
+         * Accepts an optional sign followed by digits, like std::from_chars.
+         */
+        DUCKX_API bool parse_int(absl::string_view text, long long& value);
+        /*! @brief Parse a whole string as an unsigned base-10 integer (no sign allowed) */
+        DUCKX_API bool parse_uint(absl::string_view text, unsigned long long& value);
+        /*!
+         * @brief Parse a whole string as a decimal number, always with '.' as separator
+         *
+         * Accepts [+-]digits[.digits][e[+-]digits]. Unlike strtod/as_double
+         * the result does not depend on the global C locale.
+         */
+        DUCKX_API bool parse_decimal(absl::string_view text, double& value);
+
+        /*! @brief Convert points to a fixed-point unit, rounding half away from zero */
+        DUCKX_API long long to_fixed(double points, long long scale);
+        /*! @brief Convert a fixed-point unit back to points */
+        inline double from_fixed(const long long units, const long long scale)
+        {
+            return static_cast<double>(units) / static_cast<double>(scale);
+        }
+
+        /*! @brief Parse fixed-point text (e.g. twips or half-points) as points */
+        DUCKX_API bool parse_points(absl::string_view text, long long scale, double& points);
+
+        /*!
+         * @brief Read a fixed-point attribute as points
+         * @param attr Attribute holding e.g. twips or half-points
+         * @param scale Units per point (kTwipsPerPoint, ...)
+         * @param points Receives the value; untouched if the attribute is missing or malformed
+         */
+        DUCKX_API bool read_points(const pugi::xml_attribute& attr, long long scale, double& points);
+        /*! @brief Read a fixed-point attribute as points, or @p fallback */
+        DUCKX_API double read_points_or(const pugi::xml_attribute& attr, long long scale, double fallback);
+        /*! @brief Read an integer attribute, or @p fallback if missing or malformed */
+        DUCKX_API long long read_int_or(const pugi::xml_attribute& attr, long long fallback);
+
+        /*! @brief Store an integer in an attribute */
+        DUCKX_API void write_int(pugi::xml_attribute attr, long long value);
+        /*! @brief Store a point value as a fixed-point attribute */
+        DUCKX_API void write_points(pugi::xml_attribute attr, double points, long long scale);
+    } // namespace numeric
+} // namespace duckx
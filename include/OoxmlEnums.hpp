@@ -0,0 +1,220 @@
+/*!
+ * @file OoxmlEnums.hpp
+ * @brief Allocation-free conversions between enumerations and OOXML attribute values
+ *
+ * Every enumeration that the library reads from or writes to WordprocessingML
+ * is described by one table of (name, value) pairs. The tables are turned into
+ * collision-free hash tables at compile time, so parsing a value costs one
+ * hash and one string compare, and converting an enumerator back to its
+ * attribute value is a plain array access returning a string literal.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "absl/strings/string_view.h"
+#include "constants.hpp"
+#include "DrawingElement.hpp"
+#include "duckx_export.h"
+#include "PageLayoutManager.hpp"
+
+namespace duckx
+{
+    namespace ooxml
+    {
+        namespace detail
+        {
+            /*! @brief A (attribute value, enumerator) pair of a conversion table */
+            template <typename T>
+            struct Entry
+            {
+                const char* name;
+                T value;
+            };
+
+            /*! @brief Seeded FNV-1a with a murmur3 finalizer, usable in constant expressions */
+            constexpr std::uint32_t hash(const char* data, const std::size_t size, const std::uint32_t seed)
+            {
+                std::uint32_t h = 2166136261u ^ seed;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    h ^= static_cast<unsigned char>(data[i]);
+                    h *= 16777619u;
+                }
+                // Final avalanche so the seed also reaches the low bits used as slot index
+                h ^= h >> 16;
+                h *= 0x85ebca6bu;
+                h ^= h >> 13;
+                h *= 0xc2b2ae35u;
+                h ^= h >> 16;
+                return h;
+            }
+
+            constexpr std::size_t length(const char* str)
+            {
+                std::size_t n = 0;
+                while (str[n] != '\0') ++n;
+                return n;
+            }
+
+            /*! @brief Smallest power of two with at least twice as many slots as keys */
+            constexpr std::size_t slot_count(const std::size_t keys)
+            {
+                std::size_t slots = 1;
+                while (slots < 2 * keys) slots <<= 1;
+                return slots;
+            }
+
+            template <typename T>
+            constexpr std::size_t ordinal(const T value, std::true_type /*is_enum*/)
+            {
+                return static_cast<std::size_t>(value);
+            }
+
+            template <typename T>
+            constexpr std::size_t ordinal(const T&, std::false_type /*is_enum*/)
+            {
+                return static_cast<std::size_t>(-1);
+            }
+
+            /*!
+             * @brief Perfect hash table built in a constant expression
+             *
+             * The constructor searches for a seed under which no two names
+             * share a slot, so a lookup probes exactly one slot. For enum
+             * tables the first entry naming each enumerator is also indexed
+             * by value; later entries act as parse-only aliases.
+             */
+            template <typename T, std::size_t N>
+            class PerfectHashTable
+            {
+                static_assert(N > 0 && N < 255, "table size must fit the 8-bit slot index");
+
+            public:
+                static constexpr std::size_t kSlots = slot_count(N);
+                static constexpr std::uint8_t kEmpty = 0xFF;
+
+                constexpr explicit PerfectHashTable(const Entry<T> (&entries)[N])
+                {
+                    for (std::size_t i = 0; i < N; ++i) m_by_value[i] = kEmpty;
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        m_names[i] = entries[i].name;
+                        m_sizes[i] = length(entries[i].name);
+                        m_values[i] = entries[i].value;
+
+                        const std::size_t index = ordinal(entries[i].value, std::is_enum<T>());
+                        if (index < N && m_by_value[index] == kEmpty)
+                            m_by_value[index] = static_cast<std::uint8_t>(i);
+                    }
+
+                    while (!try_seed(m_seed))
+                    {
+                        // Not a constant expression: fails the build if no seed is found
+                        if (++m_seed == 0x10000u) throw "no collision-free seed";
+                    }
+                }
+
+                /*! @brief Look up @p name; leaves @p value untouched if it is not in the table */
+                bool find(const absl::string_view name, T& value) const
+                {
+                    const std::uint8_t index = m_slots[hash(name.data(), name.size(), m_seed) & (kSlots - 1)];
+                    if (index == kEmpty || m_sizes[index] != name.size()) return false;
+
+                    for (std::size_t i = 0; i < name.size(); ++i)
+                    {
+                        if (m_names[index][i] != name[i]) return false;
+                    }
+                    value = m_values[index];
+                    return true;
+                }
+
+                bool contains(const absl::string_view name) const
+                {
+                    T ignored{};
+                    return find(name, ignored);
+                }
+
+                /*! @brief Attribute value of an enumerator, or @p fallback if it has none */
+                constexpr const char* name_of(const T value, const char* fallback) const
+                {
+                    const std::size_t index = ordinal(value, std::is_enum<T>());
+                    return index < N && m_by_value[index] != kEmpty ? m_names[m_by_value[index]] : fallback;
+                }
+
+            private:
+                constexpr bool try_seed(const std::uint32_t seed)
+                {
+                    for (std::size_t s = 0; s < kSlots; ++s) m_slots[s] = kEmpty;
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        const std::size_t slot = hash(m_names[i], m_sizes[i], seed) & (kSlots - 1);
+                        if (m_slots[slot] != kEmpty) return false;
+                        m_slots[slot] = static_cast<std::uint8_t>(i);
+                    }
+                    return true;
+                }
+
+                const char* m_names[N] = {};
+                std::size_t m_sizes[N] = {};
+                T m_values[N] = {};
+                std::uint8_t m_by_value[N] = {};
+                std::uint8_t m_slots[kSlots] = {};
+                std::uint32_t m_seed = 0;
+            };
+
+            /*! @brief Build a PerfectHashTable from an entry array, deducing its size */
+            template <typename T, std::size_t N>
+            constexpr PerfectHashTable<T, N> make_table(const Entry<T> (&entries)[N])
+            {
+                return PerfectHashTable<T, N>(entries);
+            }
+        } // namespace detail
+
+        // Enumerator -> attribute value. The returned pointer is a string literal.
+
+        DUCKX_API const char* to_string(Alignment value);             //!< w:jc/@w:val
+        DUCKX_API const char* to_string(HighlightColor value);        //!< w:highlight/@w:val, "none" for NONE
+        DUCKX_API const char* to_string(HeaderFooterType value);      //!< w:headerReference/@w:type
+        DUCKX_API const char* to_string(SectionBreakType value);      //!< w:type/@w:val in w:sectPr
+        DUCKX_API const char* to_string(PageOrientation value);       //!< w:pgSz/@w:orient
+        DUCKX_API const char* to_string(RelativeFrom value);          //!< wp:positionH/@relativeFrom
+
+        // Attribute value -> enumerator. Returns false and leaves @p value unchanged for unknown names.
+
+        DUCKX_API bool parse(absl::string_view name, Alignment& value);
+        DUCKX_API bool parse(absl::string_view name, HighlightColor& value);
+        DUCKX_API bool parse(absl::string_view name, HeaderFooterType& value);
+        DUCKX_API bool parse(absl::string_view name, SectionBreakType& value);
+        DUCKX_API bool parse(absl::string_view name, PageOrientation& value);
+        DUCKX_API bool parse(absl::string_view name, RelativeFrom& value);
+
+        /*! @brief Map w:vertAlign/@w:val to superscript, subscript or none */
+        DUCKX_API bool parse_vertical_text_alignment(absl::string_view name, formatting_flag& value);
+
+        // Closed value sets the library validates against
+
+        /*! @brief Check a border style accepted by the table APIs */
+        DUCKX_API bool is_border_style(absl::string_view name);
+        /*! @brief Check a w:vAlign value accepted for table cells */
+        DUCKX_API bool is_cell_vertical_alignment(absl::string_view name);
+        /*! @brief Check a w:jc value accepted for tables */
+        DUCKX_API bool is_table_alignment(absl::string_view name);
+        /*! @brief Check a w:textDirection value accepted for table cells */
+        DUCKX_API bool is_text_direction(absl::string_view name);
+        /*! @brief Check a w:tcW/@w:type width unit */
+        DUCKX_API bool is_width_type(absl::string_view name);
+
+        /*!
+         * @brief Content type registered for an image file extension
+         * @param extension Lower-case extension without the dot
+         * @return MIME type literal, or nullptr if the extension is unsupported
+         */
+        DUCKX_API const char* image_content_type(absl::string_view extension);
+    } // namespace ooxml
+} // namespace duckx
@@ -0,0 +1,111 @@
+/*!
+ * @file OperationOptions.hpp
+ * @brief Cancellation and progress reporting for long-running operations
+ *
+ * Opening and saving large packages, generating outlines, applying style
+ * sets and building large tables accept an OperationOptions. They poll the
+ * cancellation token at chunk boundaries (zip chunks, entries, paragraphs,
+ * table rows) and report how much of the work is done. A cancelled
+ * operation returns ErrorCode::OPERATION_CANCELLED and leaves the document
+ * as it was before the call.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "duckx_export.h"
+
+namespace duckx
+{
+    /*!
+     * @brief Shared flag through which a caller asks an operation to stop
+     *
+     * Copies share the flag, so a request handler keeps one copy and hands
+     * another to the operation; cancel() may be called from any thread.
+     */
+    class DUCKX_API CancellationToken
+    {
+    public:
+        CancellationToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void cancel() const { m_flag->store(true, std::memory_order_relaxed); }
+        bool is_cancelled() const { return m_flag->load(std::memory_order_relaxed); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    /*!
+     * @brief Receives (processed, total) in the unit of the operation
+     *
+     * Bytes for open and save, elements for outlines, style sets and
+     * tables. Called on the thread running the operation.
+     */
+    using ProgressCallback = std::function<void(std::uint64_t processed, std::uint64_t total)>;
+
+    /*!
+     * @brief Cancellation token and progress callback of one operation
+     */
+    struct DUCKX_API OperationOptions
+    {
+        /*! @brief Polled at chunk boundaries; the operation stops once it is cancelled */
+        CancellationToken cancellation;
+        /*! @brief Optional progress sink, called at the same boundaries */
+        ProgressCallback on_progress;
+    };
+
+    /*!
+     * @brief Thrown inside exception-based code paths to unwind a cancelled operation
+     *
+     * The _safe entry points catch it and return ErrorCode::OPERATION_CANCELLED.
+     */
+    class DUCKX_API OperationCancelled : public std::runtime_error
+    {
+    public:
+        OperationCancelled() : std::runtime_error("Operation cancelled") {}
+    };
+
+    /*!
+     * @brief Poller used by long operations at their chunk boundaries
+     *
+     * Holds a reference to the options; it must not outlive them.
+     */
+    class OperationProgress
+    {
+    public:
+        OperationProgress(const OperationOptions& options, const std::uint64_t total)
+            : m_options(options), m_total(total)
+        {
+        }
+
+        void set_total(const std::uint64_t total) { m_total = total; }
+        std::uint64_t total() const { return m_total; }
+        bool cancelled() const { return m_options.cancellation.is_cancelled(); }
+
+        /*! @brief Report @p processed units; false once the operation was cancelled */
+        bool report(const std::uint64_t processed) const
+        {
+            if (m_options.on_progress)
+                m_options.on_progress(processed, m_total);
+            return !cancelled();
+        }
+
+        /*! @brief Report @p processed units and throw OperationCancelled if cancelled */
+        void checkpoint(const std::uint64_t processed) const
+        {
+            if (!report(processed))
+                throw OperationCancelled();
+        }
+
+    private:
+        const OperationOptions& m_options;
+        std::uint64_t m_total;
+    };
+} // namespace duckx
@@ -22,6 +22,7 @@
 
 #include "duckx_export.h"
 #include "Error.hpp"
+#include "OperationOptions.hpp"
 #include "constants.hpp"
 
 // Forward declarations for pugixml
@@ -212,6 +213,15 @@ namespace duckx {
          * @return Result containing outline entries or error
          */
         Result<std::vector<OutlineEntry>> generate_outline_safe();
+
+        /*!
+         * @brief Generate the outline, polling @p operation per paragraph and outline entry
+         * @param operation Cancellation token and progress callback; progress counts outline entries
+         * @return Result containing outline entries, or ErrorCode::OPERATION_CANCELLED
+         *
+         * A cancelled generation keeps the previously cached outline.
+         */
+        Result<std::vector<OutlineEntry>> generate_outline_safe(const OperationOptions& operation);
         
         /*!
          * @brief Generate outline with custom heading detection
@@ -394,14 +404,15 @@ namespace duckx {
          * @brief Scan document for headings (cross-platform safe implementation)
          * @return Result indicating success or error
          */
-        Result<void> scan_document_for_headings_safe();
+        Result<void> scan_document_for_headings_safe(const OperationProgress* progress = nullptr);
         
         /*!
          * @brief Build hierarchical structure from flat list
          * @param entries Flat list of entries to organize
          * @return Result indicating success or error
          */
-        Result<void> build_hierarchy_safe(std::vector<OutlineEntry>& entries);
+        Result<void> build_hierarchy_safe(std::vector<OutlineEntry>& entries,
+                                          const OperationProgress* progress = nullptr);
         
         /*!
          * @brief Create TOC paragraph with formatting
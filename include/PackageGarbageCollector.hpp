@@ -0,0 +1,42 @@
+/*!
+ * @file PackageGarbageCollector.hpp
+ * @brief Removal of unreachable parts, relationships and content-type overrides
+ *
+ * Walks the package relationship graph from _rels/.rels, drops explicit
+ * relationships (images, hyperlinks, headers, footers, ...) whose id is no
+ * longer referenced from their source part, and removes every entry that is
+ * then unreachable. Each part and relationship file is parsed at most once.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "duckx_export.h"
+
+namespace duckx
+{
+    class DocxFile;
+
+    /*! @brief What a garbage collection pass removed */
+    struct DUCKX_API GarbageCollectionReport
+    {
+        std::size_t parts_removed = 0;         //!< Archive entries dropped
+        std::size_t relationships_removed = 0; //!< Unreferenced or dangling relationships dropped
+        std::size_t overrides_removed = 0;     //!< Content-type overrides for missing parts dropped
+        std::uint64_t bytes_reclaimed = 0;     //!< Archive bytes (compressed) of the dropped entries
+    };
+
+    /*!
+     * @brief Remove everything not reachable from the package root
+     * @param file Package to clean; changes take effect on its next save
+     *
+     * Relationships that Word resolves by type rather than by id (styles,
+     * settings, numbering, theme, ...) are always kept, as are unknown ones.
+     * Pending XML edits must be written to @p file before calling this.
+     */
+    DUCKX_API GarbageCollectionReport collect_package_garbage(DocxFile& file);
+} // namespace duckx
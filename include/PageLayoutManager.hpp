@@ -24,6 +24,7 @@ namespace duckx {
     
     // Forward declarations
     class Document;
+    class MutationJournal;
     class HeaderFooterManager;
     
     /*!
@@ -110,10 +111,13 @@ namespace duckx {
     
     /*!
      * @brief Document section representation
+     *
+     * Sections obtained from a PageLayoutManager report their edits to the
+     * document's journal.
      */
     class DUCKX_API DocumentSection {
     public:
-        DocumentSection(pugi::xml_node section_node);
+        DocumentSection(pugi::xml_node section_node, MutationJournal* journal = nullptr);
         ~DocumentSection() = default;
         
         // Section properties
@@ -140,6 +144,7 @@ namespace duckx {
         
     private:
         pugi::xml_node m_section_node;
+        MutationJournal* m_journal = nullptr;
         
         Result<pugi::xml_node> get_or_create_page_size_node_safe();
         Result<pugi::xml_node> get_or_create_margins_node_safe();
@@ -370,10 +375,6 @@ namespace duckx {
         Result<pugi::xml_node> get_or_create_page_size_node_safe(pugi::xml_node sect_pr);
         Result<pugi::xml_node> get_or_create_page_margins_node_safe(pugi::xml_node sect_pr);
         Result<pugi::xml_node> get_or_create_columns_node_safe(pugi::xml_node sect_pr);
-        
-        static std::string section_break_type_to_string(SectionBreakType type);
-        static std::string page_orientation_to_string(PageOrientation orientation);
-        static PageOrientation string_to_page_orientation(const std::string& str);
     };
     
 } // namespace duckx
\ No newline at end of file
@@ -0,0 +1,275 @@
+/*!
+ * @file PropertyDecoder.hpp
+ * @brief Single-pass decoding of w:rPr and w:pPr shared by every node representation
+ *
+ * Run and Paragraph read properties from pugixml nodes, CompactRun and
+ * CompactParagraph from CompactDocument nodes. Both go through the
+ * decoders below, templated over a node accessor, so the decoding rules
+ * (first child of each name wins, toggle values, hanging indents) exist
+ * once.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "BaseElement_Paragraph.hpp"
+#include "BaseElement_Run.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    namespace properties
+    {
+        /*! @brief Children of w:rPr and w:pPr the decoders understand */
+        enum class Tag : std::uint8_t
+        {
+            OTHER, BOLD, ITALIC, UNDERLINE, STRIKE, SMALL_CAPS, SHADOW, VERT_ALIGN,
+            FONTS, SIZE, COLOR, HIGHLIGHT, RUN_STYLE,
+            JC, SPACING, IND, NUM_PR, ILVL, NUM_ID, PARAGRAPH_STYLE,
+            COUNT
+        };
+
+        /*! @brief Attributes the decoders read */
+        enum class Attr : std::uint8_t
+        {
+            VAL, ASCII, LINE, BEFORE, AFTER, LEFT, RIGHT, FIRST_LINE, HANGING
+        };
+
+        /*! @brief A toggle property is on unless w:val is "false" or "0" */
+        inline bool is_toggle_on(const char* val)
+        {
+            return !val || (std::strcmp(val, "false") != 0 && std::strcmp(val, "0") != 0);
+        }
+
+        inline bool read_points(const char* value, const long long scale, double& points)
+        {
+            return value && numeric::parse_points(value, scale, points);
+        }
+
+        inline int read_int_or(const char* value, const long long fallback)
+        {
+            long long result = fallback;
+            if (value) numeric::parse_int(value, result);
+            return static_cast<int>(result);
+        }
+
+        /*!
+         * @brief Decode w:rPr
+         *
+         * @p Access provides, for its Node type (contextually convertible to
+         * bool, with first_child() and next_sibling()):
+         *   - static Tag tag(const Node&)
+         *   - static const char* attribute(const Node&, Attr), null if absent
+         *   - static Node child(const Node&, Tag)
+         */
+        template <typename Access>
+        RunProperties decode_run(const typename Access::Node& rPr)
+        {
+            RunProperties props;
+            if (!rPr) return props;
+
+            // 与逐个 child() 查询保持一致：同名子节点只取第一个
+            std::uint32_t seen = 0;
+            for (typename Access::Node child = rPr.first_child(); child; child = child.next_sibling())
+            {
+                const Tag tag = Access::tag(child);
+                const std::uint32_t bit = 1u << static_cast<unsigned>(tag);
+                if (tag == Tag::OTHER || (seen & bit)) continue;
+                seen |= bit;
+
+                const char* val = Access::attribute(child, Attr::VAL);
+                switch (tag)
+                {
+                    case Tag::BOLD:
+                        if (is_toggle_on(val)) props.formatting |= bold;
+                        break;
+                    case Tag::ITALIC:
+                        if (is_toggle_on(val)) props.formatting |= italic;
+                        break;
+                    case Tag::UNDERLINE:
+                        // Underline can be turned off with w:val="none"
+                        if (!val || std::strcmp(val, "none") != 0) props.formatting |= underline;
+                        break;
+                    case Tag::STRIKE:
+                        if (is_toggle_on(val)) props.formatting |= strikethrough;
+                        break;
+                    case Tag::SMALL_CAPS:
+                        if (is_toggle_on(val)) props.formatting |= smallcaps;
+                        break;
+                    case Tag::SHADOW:
+                        if (is_toggle_on(val)) props.formatting |= shadow;
+                        break;
+                    case Tag::VERT_ALIGN:
+                    {
+                        formatting_flag position = none;
+                        if (ooxml::parse_vertical_text_alignment(val ? val : "", position))
+                            props.formatting |= position;
+                        break;
+                    }
+                    case Tag::FONTS:
+                        // The "ascii" attribute is typically the one to use for standard characters.
+                        if (const char* font = Access::attribute(child, Attr::ASCII))
+                        {
+                            props.font = font;
+                            props.has_font = true;
+                        }
+                        break;
+                    case Tag::SIZE:
+                        // Font size in docx is stored in "half-points"
+                        props.has_font_size = read_points(val, numeric::kHalfPointsPerPoint, props.font_size);
+                        break;
+                    case Tag::COLOR:
+                        // Don't report "auto" colors as they are not explicit RGB values
+                        if (val && std::strcmp(val, "auto") != 0)
+                        {
+                            props.color = val;
+                            props.has_color = true;
+                        }
+                        break;
+                    case Tag::HIGHLIGHT:
+                        if (val)
+                        {
+                            props.has_highlight = ooxml::parse(val, props.highlight) &&
+                                                  props.highlight != HighlightColor::NONE;
+                        }
+                        break;
+                    case Tag::RUN_STYLE:
+                        props.style = val ? val : "";
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return props;
+        }
+
+        /*! @brief Decode w:pPr; see decode_run() for the accessor */
+        template <typename Access>
+        ParagraphProperties decode_paragraph(const typename Access::Node& pPr)
+        {
+            ParagraphProperties props;
+            if (!pPr) return props;
+
+            // 与逐个 child() 查询保持一致：同名子节点只取第一个
+            std::uint32_t seen = 0;
+            for (typename Access::Node child = pPr.first_child(); child; child = child.next_sibling())
+            {
+                const Tag tag = Access::tag(child);
+                const std::uint32_t bit = 1u << static_cast<unsigned>(tag);
+                if (tag == Tag::OTHER || (seen & bit)) continue;
+                seen |= bit;
+
+                switch (tag)
+                {
+                    case Tag::JC:
+                        if (const char* val = Access::attribute(child, Attr::VAL)) ooxml::parse(val, props.alignment);
+                        break;
+                    case Tag::SPACING:
+                        props.has_line_spacing = read_points(Access::attribute(child, Attr::LINE),
+                                                             numeric::kLineSpacingUnit, props.line_spacing);
+                        props.has_spacing |= read_points(Access::attribute(child, Attr::BEFORE),
+                                                         numeric::kTwipsPerPoint, props.spacing_before);
+                        props.has_spacing |= read_points(Access::attribute(child, Attr::AFTER),
+                                                         numeric::kTwipsPerPoint, props.spacing_after);
+                        break;
+                    case Tag::IND:
+                    {
+                        props.has_indentation |= read_points(Access::attribute(child, Attr::LEFT),
+                                                             numeric::kTwipsPerPoint, props.indent_left);
+                        props.has_indentation |= read_points(Access::attribute(child, Attr::RIGHT),
+                                                             numeric::kTwipsPerPoint, props.indent_right);
+                        props.has_indentation |= read_points(Access::attribute(child, Attr::FIRST_LINE),
+                                                             numeric::kTwipsPerPoint, props.indent_first_line);
+                        // A hanging indent overrides firstLine regardless of attribute order
+                        double hanging_pts = 0.0;
+                        if (read_points(Access::attribute(child, Attr::HANGING), numeric::kTwipsPerPoint, hanging_pts))
+                        {
+                            props.indent_first_line = -hanging_pts;
+                            props.has_indentation = true;
+                        }
+                        break;
+                    }
+                    case Tag::NUM_PR:
+                        props.has_numbering = true;
+                        props.list_level = read_int_or(Access::attribute(Access::child(child, Tag::ILVL), Attr::VAL), -1);
+                        props.list_num_id =
+                            read_int_or(Access::attribute(Access::child(child, Tag::NUM_ID), Attr::VAL), -1);
+                        break;
+                    case Tag::PARAGRAPH_STYLE:
+                        if (const char* val = Access::attribute(child, Attr::VAL)) props.style = val;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return props;
+        }
+
+        /*! @brief Accessor over pugixml nodes, used by Run and Paragraph */
+        struct XmlNodeAccess
+        {
+            using Node = pugi::xml_node;
+
+            /*! @brief Map an element name to its tag without building strings */
+            static Tag tag(const pugi::xml_node& node)
+            {
+                const char* name = node.name();
+                if (name[0] != 'w' || name[1] != ':')
+                    return Tag::OTHER;
+                const char* local = name + 2;
+                switch (local[0])
+                {
+                    case 'b': return local[1] == '\0' ? Tag::BOLD : Tag::OTHER;
+                    case 'i':
+                        if (local[1] == '\0') return Tag::ITALIC;
+                        if (std::strcmp(local, "ind") == 0) return Tag::IND;
+                        if (std::strcmp(local, "ilvl") == 0) return Tag::ILVL;
+                        return Tag::OTHER;
+                    case 'u': return local[1] == '\0' ? Tag::UNDERLINE : Tag::OTHER;
+                    case 's':
+                        if (std::strcmp(local, "sz") == 0) return Tag::SIZE;
+                        if (std::strcmp(local, "spacing") == 0) return Tag::SPACING;
+                        if (std::strcmp(local, "strike") == 0) return Tag::STRIKE;
+                        if (std::strcmp(local, "smallCaps") == 0) return Tag::SMALL_CAPS;
+                        if (std::strcmp(local, "shadow") == 0) return Tag::SHADOW;
+                        return Tag::OTHER;
+                    case 'v': return std::strcmp(local, "vertAlign") == 0 ? Tag::VERT_ALIGN : Tag::OTHER;
+                    case 'r':
+                        if (std::strcmp(local, "rFonts") == 0) return Tag::FONTS;
+                        if (std::strcmp(local, "rStyle") == 0) return Tag::RUN_STYLE;
+                        return Tag::OTHER;
+                    case 'c': return std::strcmp(local, "color") == 0 ? Tag::COLOR : Tag::OTHER;
+                    case 'h': return std::strcmp(local, "highlight") == 0 ? Tag::HIGHLIGHT : Tag::OTHER;
+                    case 'j': return std::strcmp(local, "jc") == 0 ? Tag::JC : Tag::OTHER;
+                    case 'n':
+                        if (std::strcmp(local, "numPr") == 0) return Tag::NUM_PR;
+                        if (std::strcmp(local, "numId") == 0) return Tag::NUM_ID;
+                        return Tag::OTHER;
+                    case 'p': return std::strcmp(local, "pStyle") == 0 ? Tag::PARAGRAPH_STYLE : Tag::OTHER;
+                    default: return Tag::OTHER;
+                }
+            }
+
+            static const char* attribute(const pugi::xml_node& node, const Attr attr)
+            {
+                static const char* const kNames[] = {
+                    "w:val", "w:ascii", "w:line", "w:before", "w:after", "w:left", "w:right", "w:firstLine", "w:hanging",
+                };
+                const pugi::xml_attribute found = node.attribute(kNames[static_cast<unsigned>(attr)]);
+                return found ? found.value() : nullptr;
+            }
+
+            static pugi::xml_node child(const pugi::xml_node& node, const Tag tag)
+            {
+                // 只有 numPr 的子节点按标签查找
+                return node.child(tag == Tag::ILVL ? "w:ilvl" : tag == Tag::NUM_ID ? "w:numId" : "");
+            }
+        };
+    } // namespace properties
+} // namespace duckx
@@ -0,0 +1,495 @@
+/*!
+ * @file RangeAdaptors.hpp
+ * @brief Lazy, composable adaptors over element ranges
+ *
+ * Adaptors wrap any range with begin()/end() — ElementRange from
+ * Body::paragraphs(), Paragraph::runs(), Table::rows(), TableRow::cells(),
+ * or another adaptor — and are combined with `|`:
+ *
+ * @code
+ * for (const std::string& text : body.paragraphs()
+ *          | views::filter([](const Paragraph& p) { return !p.runs().empty(); })
+ *          | views::take(100)
+ *          | views::transform([](Paragraph& p) { return p.runs().first().get_text(); }))
+ * @endcode
+ *
+ * Nothing is evaluated until iteration, nothing is allocated and no call is
+ * virtual. Each element of the underlying range is visited at most once,
+ * and take() stops advancing as soon as it has produced its elements.
+ *
+ * Views hold their underlying range and callables by value; iterators
+ * refer to the view they came from and must not outlive it.
+ *
+ * @date 2025.07
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "absl/meta/type_traits.h"
+
+namespace duckx
+{
+    namespace views
+    {
+        namespace detail
+        {
+            template<typename R>
+            using iterator_t = decltype(std::declval<const R&>().begin());
+
+            template<typename R>
+            using reference_t = decltype(*std::declval<iterator_t<R>&>());
+
+            /*! @brief Common typedefs of the single-pass iterators below */
+            template<typename Reference>
+            struct InputIteratorBase
+            {
+                using iterator_category = std::input_iterator_tag;
+                using value_type = absl::decay_t<Reference>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = Reference;
+            };
+        } // namespace detail
+
+        // ============================================================================
+        // filter
+        // ============================================================================
+
+        /*! @brief Elements of @p R for which the predicate returns true */
+        template<typename R, typename Pred>
+        class FilterView
+        {
+            using base_iterator = detail::iterator_t<R>;
+
+        public:
+            class iterator : public detail::InputIteratorBase<detail::reference_t<R>>
+            {
+            public:
+                iterator() = default;
+                iterator(base_iterator it, base_iterator end, const Pred* pred)
+                    : m_it(std::move(it)), m_end(std::move(end)), m_pred(pred)
+                {
+                    satisfy();
+                }
+
+                detail::reference_t<R> operator*() { return *m_it; }
+
+                iterator& operator++()
+                {
+                    ++m_it;
+                    satisfy();
+                    return *this;
+                }
+
+                friend bool operator==(const iterator& a, const iterator& b) { return a.m_it == b.m_it; }
+                friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+            private:
+                void satisfy()
+                {
+                    while (m_it != m_end && !(*m_pred)(*m_it))
+                        ++m_it;
+                }
+
+                base_iterator m_it;
+                base_iterator m_end;
+                const Pred* m_pred = nullptr;
+            };
+
+            FilterView(R base, Pred pred)
+                : m_base(std::move(base)), m_pred(std::move(pred)) {}
+
+            iterator begin() const { return iterator(m_base.begin(), m_base.end(), &m_pred); }
+            iterator end() const { return iterator(m_base.end(), m_base.end(), &m_pred); }
+
+        private:
+            R m_base;
+            Pred m_pred;
+        };
+
+        // ============================================================================
+        // transform
+        // ============================================================================
+
+        /*! @brief Result of applying a function to each element of @p R */
+        template<typename R, typename F>
+        class TransformView
+        {
+            using base_iterator = detail::iterator_t<R>;
+            using result_type = decltype(std::declval<const F&>()(std::declval<detail::reference_t<R>>()));
+
+        public:
+            class iterator : public detail::InputIteratorBase<result_type>
+            {
+            public:
+                iterator() = default;
+                iterator(base_iterator it, const F* f)
+                    : m_it(std::move(it)), m_f(f) {}
+
+                result_type operator*() { return (*m_f)(*m_it); }
+
+                iterator& operator++()
+                {
+                    ++m_it;
+                    return *this;
+                }
+
+                friend bool operator==(const iterator& a, const iterator& b) { return a.m_it == b.m_it; }
+                friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+            private:
+                base_iterator m_it;
+                const F* m_f = nullptr;
+            };
+
+            TransformView(R base, F f)
+                : m_base(std::move(base)), m_f(std::move(f)) {}
+
+            iterator begin() const { return iterator(m_base.begin(), &m_f); }
+            iterator end() const { return iterator(m_base.end(), &m_f); }
+
+        private:
+            R m_base;
+            F m_f;
+        };
+
+        // ============================================================================
+        // take / skip
+        // ============================================================================
+
+        /*! @brief At most the first @p count elements of @p R */
+        template<typename R>
+        class TakeView
+        {
+            using base_iterator = detail::iterator_t<R>;
+
+        public:
+            class iterator : public detail::InputIteratorBase<detail::reference_t<R>>
+            {
+            public:
+                iterator() = default;
+                iterator(base_iterator it, base_iterator end, const std::size_t left)
+                    : m_it(std::move(it)), m_end(std::move(end)), m_left(left) {}
+
+                detail::reference_t<R> operator*() { return *m_it; }
+
+                iterator& operator++()
+                {
+                    // 取满后不再推进底层迭代器，后续元素一个也不访问
+                    if (--m_left != 0)
+                        ++m_it;
+                    return *this;
+                }
+
+                friend bool operator==(const iterator& a, const iterator& b)
+                {
+                    const bool a_done = a.done();
+                    const bool b_done = b.done();
+                    return a_done || b_done ? a_done == b_done : a.m_it == b.m_it;
+                }
+
+                friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+            private:
+                bool done() const { return m_left == 0 || m_it == m_end; }
+
+                base_iterator m_it;
+                base_iterator m_end;
+                std::size_t m_left = 0;
+            };
+
+            TakeView(R base, const std::size_t count)
+                : m_base(std::move(base)), m_count(count) {}
+
+            iterator begin() const { return iterator(m_base.begin(), m_base.end(), m_count); }
+            iterator end() const { return iterator(m_base.end(), m_base.end(), 0); }
+
+        private:
+            R m_base;
+            std::size_t m_count;
+        };
+
+        /*! @brief Elements of @p R after the first @p count */
+        template<typename R>
+        class SkipView
+        {
+        public:
+            using iterator = detail::iterator_t<R>;
+
+            SkipView(R base, const std::size_t count)
+                : m_base(std::move(base)), m_count(count) {}
+
+            iterator begin() const
+            {
+                iterator it = m_base.begin();
+                const iterator end = m_base.end();
+                for (std::size_t i = 0; i < m_count && it != end; ++i)
+                    ++it;
+                return it;
+            }
+
+            iterator end() const { return m_base.end(); }
+
+        private:
+            R m_base;
+            std::size_t m_count;
+        };
+
+        // ============================================================================
+        // chunk
+        // ============================================================================
+
+        /*!
+         * @brief Consecutive groups of up to @p size elements of @p R
+         *
+         * Each chunk is itself a range that advances the shared underlying
+         * iterator, so the elements are still visited once. Elements of a
+         * chunk that are not consumed are skipped when moving to the next
+         * chunk; a chunk can be iterated only once.
+         */
+        template<typename R>
+        class ChunkView
+        {
+            using base_iterator = detail::iterator_t<R>;
+
+        public:
+            class iterator;
+
+            /*! @brief One group of elements, valid until its iterator is advanced */
+            class Chunk
+            {
+            public:
+                class iterator : public detail::InputIteratorBase<detail::reference_t<R>>
+                {
+                public:
+                    iterator() = default;
+                    explicit iterator(ChunkView::iterator* outer)
+                        : m_outer(outer) {}
+
+                    detail::reference_t<R> operator*() { return *m_outer->m_it; }
+
+                    iterator& operator++()
+                    {
+                        ++m_outer->m_it;
+                        --m_outer->m_left;
+                        return *this;
+                    }
+
+                    friend bool operator==(const iterator& a, const iterator& b) { return a.done() == b.done(); }
+                    friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+                private:
+                    bool done() const { return !m_outer || m_outer->m_left == 0 || m_outer->m_it == m_outer->m_end; }
+
+                    ChunkView::iterator* m_outer = nullptr;
+                };
+
+                explicit Chunk(ChunkView::iterator* outer)
+                    : m_outer(outer) {}
+
+                iterator begin() const { return iterator(m_outer); }
+                iterator end() const { return iterator(); }
+
+            private:
+                ChunkView::iterator* m_outer;
+            };
+
+            class iterator : public detail::InputIteratorBase<Chunk>
+            {
+            public:
+                iterator() = default;
+                iterator(base_iterator it, base_iterator end, const std::size_t size)
+                    : m_it(std::move(it)), m_end(std::move(end)), m_size(size), m_left(size) {}
+
+                Chunk operator*() { return Chunk(this); }
+
+                iterator& operator++()
+                {
+                    for (; m_left != 0 && m_it != m_end; --m_left)
+                        ++m_it;
+                    m_left = m_size;
+                    return *this;
+                }
+
+                friend bool operator==(const iterator& a, const iterator& b) { return a.m_it == b.m_it; }
+                friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+            private:
+                friend class Chunk::iterator;
+
+                base_iterator m_it;
+                base_iterator m_end;
+                std::size_t m_size = 0;
+                std::size_t m_left = 0; //!< Elements of the current chunk not consumed yet
+            };
+
+            ChunkView(R base, const std::size_t size)
+                : m_base(std::move(base)), m_size(size == 0 ? 1 : size) {}
+
+            iterator begin() const { return iterator(m_base.begin(), m_base.end(), m_size); }
+            iterator end() const { return iterator(m_base.end(), m_base.end(), m_size); }
+
+        private:
+            R m_base;
+            std::size_t m_size;
+        };
+
+        // ============================================================================
+        // enumerate
+        // ============================================================================
+
+        /*! @brief An element paired with its position in the enumerated range */
+        template<typename Reference>
+        struct Indexed
+        {
+            std::size_t index;
+            Reference value;
+        };
+
+        /*! @brief Elements of @p R paired with their zero-based index */
+        template<typename R>
+        class EnumerateView
+        {
+            using base_iterator = detail::iterator_t<R>;
+            using value_type = Indexed<detail::reference_t<R>>;
+
+        public:
+            class iterator : public detail::InputIteratorBase<value_type>
+            {
+            public:
+                iterator() = default;
+                explicit iterator(base_iterator it)
+                    : m_it(std::move(it)) {}
+
+                value_type operator*() { return value_type{m_index, *m_it}; }
+
+                iterator& operator++()
+                {
+                    ++m_it;
+                    ++m_index;
+                    return *this;
+                }
+
+                friend bool operator==(const iterator& a, const iterator& b) { return a.m_it == b.m_it; }
+                friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+            private:
+                base_iterator m_it;
+                std::size_t m_index = 0;
+            };
+
+            explicit EnumerateView(R base)
+                : m_base(std::move(base)) {}
+
+            iterator begin() const { return iterator(m_base.begin()); }
+            iterator end() const { return iterator(m_base.end()); }
+
+        private:
+            R m_base;
+        };
+
+        // ============================================================================
+        // Adaptor objects and pipe syntax
+        // ============================================================================
+
+        namespace detail
+        {
+            template<typename Pred>
+            struct FilterAdaptor
+            {
+                Pred pred;
+            };
+
+            template<typename F>
+            struct TransformAdaptor
+            {
+                F f;
+            };
+
+            struct TakeAdaptor
+            {
+                std::size_t count;
+            };
+
+            struct SkipAdaptor
+            {
+                std::size_t count;
+            };
+
+            struct ChunkAdaptor
+            {
+                std::size_t size;
+            };
+
+            struct EnumerateAdaptor
+            {
+            };
+        } // namespace detail
+
+        /*! @brief Keep the elements for which @p pred returns true */
+        template<typename Pred>
+        detail::FilterAdaptor<absl::decay_t<Pred>> filter(Pred&& pred)
+        {
+            return {std::forward<Pred>(pred)};
+        }
+
+        /*! @brief Map each element through @p f */
+        template<typename F>
+        detail::TransformAdaptor<absl::decay_t<F>> transform(F&& f)
+        {
+            return {std::forward<F>(f)};
+        }
+
+        /*! @brief Stop after @p count elements */
+        inline detail::TakeAdaptor take(const std::size_t count) { return {count}; }
+        /*! @brief Drop the first @p count elements */
+        inline detail::SkipAdaptor skip(const std::size_t count) { return {count}; }
+        /*! @brief Group elements by @p size (a size of 0 is treated as 1) */
+        inline detail::ChunkAdaptor chunk(const std::size_t size) { return {size}; }
+        /*! @brief Pair each element with its index */
+        inline detail::EnumerateAdaptor enumerate() { return {}; }
+
+        // Found by argument-dependent lookup on the adaptor objects
+        namespace detail
+        {
+            template<typename R, typename Pred>
+            FilterView<absl::decay_t<R>, Pred> operator|(R&& range, FilterAdaptor<Pred> adaptor)
+            {
+                return {std::forward<R>(range), std::move(adaptor.pred)};
+            }
+
+            template<typename R, typename F>
+            TransformView<absl::decay_t<R>, F> operator|(R&& range, TransformAdaptor<F> adaptor)
+            {
+                return {std::forward<R>(range), std::move(adaptor.f)};
+            }
+
+            template<typename R>
+            TakeView<absl::decay_t<R>> operator|(R&& range, const TakeAdaptor adaptor)
+            {
+                return {std::forward<R>(range), adaptor.count};
+            }
+
+            template<typename R>
+            SkipView<absl::decay_t<R>> operator|(R&& range, const SkipAdaptor adaptor)
+            {
+                return {std::forward<R>(range), adaptor.count};
+            }
+
+            template<typename R>
+            ChunkView<absl::decay_t<R>> operator|(R&& range, const ChunkAdaptor adaptor)
+            {
+                return {std::forward<R>(range), adaptor.size};
+            }
+
+            template<typename R>
+            EnumerateView<absl::decay_t<R>> operator|(R&& range, EnumerateAdaptor)
+            {
+                return EnumerateView<absl::decay_t<R>>(std::forward<R>(range));
+            }
+        } // namespace detail
+    } // namespace views
+} // namespace duckx
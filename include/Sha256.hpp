@@ -0,0 +1,49 @@
+/*!
+ * @file Sha256.hpp
+ * @brief SHA-256 digests of package parts
+ *
+ * Used where a collision must not make two different packages look equal,
+ * such as DocxFile::content_hash(). CRC-32 remains the checksum stored in
+ * ZIP headers and serves only as a cheap pre-check.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "duckx_export.h"
+
+namespace duckx
+{
+    /*! @brief Incremental SHA-256 (FIPS 180-4) */
+    class DUCKX_API Sha256
+    {
+    public:
+        using Digest = std::array<std::uint8_t, 32>;
+
+        Sha256();
+
+        /*! @brief Feed @p size bytes of @p data */
+        void update(const void* data, std::size_t size);
+        /*! @brief Pad the message and return its digest; the object must not be fed afterwards */
+        Digest finish();
+
+        /*! @brief Digest of a single buffer */
+        static Digest digest(const void* data, std::size_t size);
+        /*! @brief Lower-case hex representation of a digest, 64 characters */
+        static std::string to_hex(const Digest& digest);
+
+    private:
+        void compress(const std::uint8_t* block);
+
+        std::uint32_t m_state[8];
+        std::uint8_t m_buffer[64];
+        std::size_t m_buffered = 0;
+        std::uint64_t m_length = 0; //!< Message length in bytes
+    };
+} // namespace duckx
@@ -18,6 +18,7 @@
 #include <unordered_set>
 
 #include "Error.hpp"
+#include "OperationOptions.hpp"
 #include "constants.hpp"
 #include "duckx_export.h"
 #include "pugixml.hpp"
@@ -485,6 +486,19 @@ namespace duckx
          * @return Result indicating success or error
          */
         Result<void> apply_style_set_safe(const std::string& set_name, class Document& doc);
+
+        /*!
+         * @brief Apply a style set, polling @p operation per table and paragraph
+         * @param set_name Name of the style set to apply
+         * @param doc Document to apply styles to
+         * @param operation Cancellation token and progress callback; progress counts elements
+         * @return Result indicating success, or ErrorCode::OPERATION_CANCELLED
+         *
+         * Elements styled before the cancellation keep their style here;
+         * Document::apply_style_set_safe() rolls them back.
+         */
+        Result<void> apply_style_set_safe(const std::string& set_name, class Document& doc,
+                                          const OperationOptions& operation);
         
         /*!
          * @brief Get a registered style set by name
@@ -0,0 +1,220 @@
+/*!
+ * @file ZipArchive.hpp
+ * @brief Streaming ZIP container reader and writer with Zip64 support
+ *
+ * Provides the low-level ZIP container layer used by DocxFile. Entries are
+ * indexed from the central directory once, read or extracted in streaming
+ * fashion, and can be copied verbatim (still compressed) into a new archive.
+ * Zip64 sizes, offsets and entry counts are handled transparently and are
+ * only emitted when the archive actually needs them.
+ *
+ * @date 2025.07
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "duckx_export.h"
+
+namespace duckx
+{
+    /*! @brief Central directory information for a single archive entry */
+    struct DUCKX_API ZipEntryInfo
+    {
+        std::string name;                  //!< Entry name inside the archive
+        std::uint16_t method = 0;          //!< Compression method (0 = stored, 8 = deflate)
+        std::uint16_t flags = 0;           //!< General purpose bit flags
+        std::uint16_t dos_time = 0;        //!< Last modification time (MS-DOS format)
+        std::uint16_t dos_date = 0;        //!< Last modification date (MS-DOS format)
+        std::uint32_t crc32 = 0;           //!< CRC-32 of the uncompressed data
+        std::uint64_t compressed_size = 0; //!< Size of the stored (compressed) data
+        std::uint64_t uncompressed_size = 0; //!< Size of the uncompressed data
+        std::uint64_t local_header_offset = 0; //!< Offset of the local file header
+    };
+
+    /*! @brief Entry data compressed ahead of ZipWriter::add_compressed_entry(), possibly on another thread */
+    struct DUCKX_API ZipCompressedData
+    {
+        std::string data;                    //!< Stored bytes (deflated unless method is 0)
+        std::uint16_t method = 0;            //!< Compression method (0 = stored, 8 = deflate)
+        std::uint32_t crc32 = 0;             //!< CRC-32 of the uncompressed data
+        std::uint64_t uncompressed_size = 0; //!< Size of the uncompressed data
+    };
+
+    /*! @brief Update a CRC-32 (as stored in ZIP headers) with @p size bytes of @p data */
+    DUCKX_API std::uint32_t zip_crc32(const void* data, size_t size, std::uint32_t crc = 0);
+
+    /*!
+     * @brief Bytes an entry's local header and data occupy, as ZipWriter lays them out
+     *
+     * Computed from the central directory alone, so it is exact only for
+     * entries written by ZipWriter. Use ZipReader::local_record_size() for
+     * entries of an existing archive.
+     */
+    DUCKX_API std::uint64_t zip_local_record_size(const ZipEntryInfo& entry);
+
+    /*!
+     * @brief Random-access reader for ZIP archives
+     *
+     * Parses the end of central directory (including the Zip64 end records)
+     * and builds a name index of all entries. The underlying file stays open
+     * until close() is called so repeated reads do not re-parse the archive.
+     * Reads are serialized internally, so one reader can back several
+     * packages (see DocxFile::fork()) used from different threads.
+     */
+    class DUCKX_API ZipReader
+    {
+    public:
+        /*! @brief Callback receiving consecutive chunks of entry data; return false to abort */
+        using DataSink = std::function<bool(const char* data, size_t size)>;
+
+        ZipReader() = default;
+        ~ZipReader();
+
+        ZipReader(const ZipReader&) = delete;
+        ZipReader& operator=(const ZipReader&) = delete;
+
+        /*! @brief Open an archive and index its central directory */
+        bool open(const std::string& path);
+        /*! @brief Close the archive and drop the index */
+        void close();
+        /*! @brief Check if an archive is currently open */
+        bool is_open() const { return m_fp != nullptr; }
+        /*! @brief Check if the archive uses Zip64 end of central directory records */
+        bool is_zip64() const { return m_zip64; }
+        /*! @brief Size of the archive file in bytes */
+        std::uint64_t file_size() const { return m_file_size; }
+        /*!
+         * @brief Bytes before the central directory not belonging to any indexed entry
+         *
+         * Superseded entries and central directories left behind by
+         * ZipWriter::open_append() show up here.
+         */
+        std::uint64_t unreferenced_bytes() const;
+        /*!
+         * @brief Bytes an entry occupies before the central directory
+         *
+         * Reads the local header, so extra fields and a trailing data
+         * descriptor (general purpose bit 3) written by other tools are
+         * counted. Falls back to zip_local_record_size() if the header
+         * cannot be read.
+         */
+        std::uint64_t local_record_size(const ZipEntryInfo& entry) const;
+
+        /*! @brief Get all entries in central directory order */
+        const std::vector<ZipEntryInfo>& entries() const { return m_entries; }
+        /*! @brief Find an entry by name, returns nullptr if missing */
+        const ZipEntryInfo* find(const std::string& name) const;
+
+        /*! @brief Decompress an entry into a string */
+        bool read(const ZipEntryInfo& entry, std::string& out);
+        /*! @brief Decompress an entry chunk by chunk, verifying its CRC-32 */
+        bool extract(const ZipEntryInfo& entry, const DataSink& sink);
+        /*! @brief Stream the stored (still compressed) bytes of an entry */
+        bool read_raw(const ZipEntryInfo& entry, const DataSink& sink);
+
+    private:
+        bool read_central_directory();
+        bool locate_data(const ZipEntryInfo& entry, std::uint64_t& data_offset);
+        bool copy_raw(const ZipEntryInfo& entry, const DataSink& sink);
+
+        mutable std::mutex m_mutex; //!< Guards the file position during reads
+        std::FILE* m_fp = nullptr;
+        std::uint64_t m_file_size = 0;
+        std::uint64_t m_cd_offset = 0;
+        bool m_zip64 = false;
+        std::vector<ZipEntryInfo> m_entries;
+        std::unordered_map<std::string, size_t> m_index;
+    };
+
+    /*!
+     * @brief Sequential writer for ZIP archives
+     *
+     * Writes local headers and data as entries are added and emits the
+     * central directory on close(). Zip64 extra fields and end records are
+     * added automatically for entries or archives that exceed the classic
+     * 4 GB / 65,535-entry limits.
+     */
+    class DUCKX_API ZipWriter
+    {
+    public:
+        /*! @brief Callback filling @p buf with up to @p capacity bytes, returns bytes produced */
+        using DataSource = std::function<size_t(char* buf, size_t capacity)>;
+
+        ZipWriter() = default;
+        ~ZipWriter();
+
+        ZipWriter(const ZipWriter&) = delete;
+        ZipWriter& operator=(const ZipWriter&) = delete;
+
+        /*! @brief Create (truncate) an archive for writing */
+        bool open(const std::string& path, int level = 6);
+        /*!
+         * @brief Open an existing archive to add entries after its end
+         * @param path Archive to extend
+         * @param kept Entries of its central directory to carry into the new one
+         * @param expected_size Current size of the file; opening fails if it differs
+         * @param level Compression level of added entries
+         *
+         * Nothing already in the file is overwritten: new entries and the new
+         * central directory follow the old end record, so the archive stays
+         * readable as it was until close() completes.
+         */
+        bool open_append(const std::string& path, std::vector<ZipEntryInfo> kept, std::uint64_t expected_size,
+                         int level = 6);
+        /*! @brief Write the central directory and close the file */
+        bool close();
+        /*! @brief Close without a central directory, truncating an appended archive back to its original size */
+        void discard();
+        /*! @brief Check if an archive is currently open */
+        bool is_open() const { return m_fp != nullptr; }
+
+        /*! @brief Add an entry from memory, compressed with the writer's level */
+        bool add_entry(const std::string& name, const void* data, size_t size);
+        /*!
+         * @brief Compress entry data without a writer
+         * @param level Compression level; 0 stores the data
+         *
+         * Thread-safe, so entries can be compressed in parallel and then
+         * added in order with add_compressed_entry().
+         */
+        static bool compress(const void* data, size_t size, int level, ZipCompressedData& out);
+        /*! @brief Add an entry compressed by compress() */
+        bool add_compressed_entry(const std::string& name, const ZipCompressedData& data);
+        /*! @brief Add an entry of known size produced chunk by chunk */
+        bool add_entry_stream(const std::string& name, std::uint64_t size, const DataSource& source);
+        /*! @brief Copy an entry from another archive without recompressing it */
+        bool add_raw_entry(ZipReader& source, const ZipEntryInfo& entry);
+
+        /*! @brief Stamp every entry, copied ones included, with a fixed UTC modification time */
+        void set_fixed_time(std::time_t timestamp);
+        /*! @brief Always emit Zip64 records, even for small archives */
+        void set_force_zip64(bool force) { m_force_zip64 = force; }
+        /*! @brief Number of entries written so far */
+        size_t entry_count() const { return m_entries.size(); }
+
+    private:
+        bool write_local_header(const ZipEntryInfo& entry, bool zip64);
+        bool write_central_directory();
+        void stamp_time(ZipEntryInfo& entry) const;
+
+        std::FILE* m_fp = nullptr;
+        int m_level = 6;
+        bool m_force_zip64 = false;
+        bool m_fixed_time = false;
+        std::uint16_t m_fixed_dos_time = 0;
+        std::uint16_t m_fixed_dos_date = 0;
+        std::uint64_t m_offset = 0;
+        std::uint64_t m_append_base = 0; //!< Original file size when opened with open_append()
+        bool m_appending = false;
+        std::vector<ZipEntryInfo> m_entries;
+    };
+} // namespace duckx
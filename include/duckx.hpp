@@ -12,7 +12,13 @@
 
 #pragma once
 
+#include "CompactDocument.hpp"
 #include "Document.hpp"
+#include "DocumentFragment.hpp"
+#include "ElementSelector.hpp"
+#include "Executor.hpp"
+#include "OperationOptions.hpp"
+#include "FormattingTable.hpp"
 #include "Image.hpp"
 #include "TextBox.hpp"
 #include "StyleManager.hpp"
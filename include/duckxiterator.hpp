@@ -12,6 +12,7 @@
 #include <iterator>
 
 #include "absl/meta/type_traits.h"
+#include "RangeAdaptors.hpp"
 
 namespace pugi
 {
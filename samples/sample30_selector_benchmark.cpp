@@ -0,0 +1,109 @@
+/*!
+ * @file sample30_selector_benchmark.cpp
+ * @brief Compiled selector queries compared with hand-written loops
+ *
+ * This sample demonstrates:
+ * - Compiling a selector such as "tbl p[style=Heading2] r[bold]" once
+ * - Evaluating it in a single traversal of the body
+ * - Timing it against the equivalent nested tables()/rows()/cells()/
+ *   paragraphs()/runs() loops
+ *
+ * @date 2025.07
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Document.hpp"
+#include "ElementSelector.hpp"
+#include "test_utils.hpp"
+
+using namespace duckx;
+
+namespace
+{
+    template <typename F>
+    double time_ms(const int iterations, F&& run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            run();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    void style_paragraph(Paragraph& paragraph, const char* style)
+    {
+        pugi::xml_node ppr = paragraph.get_node().prepend_child("w:pPr");
+        ppr.append_child("w:pStyle").append_attribute("w:val").set_value(style);
+    }
+} // namespace
+
+int main()
+{
+    try {
+        std::cout << "=== Selector Benchmark ===" << std::endl;
+
+        const std::string output_path = test_utils::get_temp_path("sample30_selector_benchmark.docx");
+        auto doc = Document::create(output_path);
+        auto& body = doc.body();
+
+        // 200 tables of 4x4 cells, each cell holding a heading and a body paragraph
+        for (int t = 0; t < 200; ++t) {
+            auto table = body.add_table(4, 4);
+            for (auto& row : table.rows()) {
+                for (auto& cell : row.cells()) {
+                    auto heading = cell.add_paragraph("Heading ", bold);
+                    style_paragraph(heading, (t % 2 == 0) ? "Heading2" : "Heading3");
+                    heading.add_run("text");
+                    cell.add_paragraph("Body text", italic);
+                }
+            }
+            body.add_paragraph("Between tables", bold);
+        }
+
+        const int iterations = 20;
+        std::size_t loop_count = 0;
+        const double loop_ms = time_ms(iterations, [&]() {
+            loop_count = 0;
+            for (auto& table : body.tables())
+                for (auto& row : table.rows())
+                    for (auto& cell : row.cells())
+                        for (auto& paragraph : cell.paragraphs()) {
+                            if (std::strcmp(paragraph.properties().style, "Heading2") != 0)
+                                continue;
+                            for (auto& run : paragraph.runs())
+                                loop_count += run.is_bold() ? 1 : 0;
+                        }
+        });
+
+        const auto selector = ElementSelector::compile("tbl p[style=Heading2] r[bold]");
+        std::size_t selector_count = 0;
+        const double selector_ms = time_ms(iterations, [&]() {
+            selector_count = selector.count(body.get_body_node());
+        });
+
+        std::size_t collected = 0;
+        const double collect_ms = time_ms(iterations, [&]() {
+            collected = selector.select(body).size();
+        });
+
+        std::cout << "Hand-written loops:  " << loop_count << " runs, " << loop_ms << " ms" << std::endl;
+        std::cout << "Selector count():    " << selector_count << " runs, " << selector_ms << " ms" << std::endl;
+        std::cout << "Selector select():   " << collected << " runs, " << collect_ms << " ms" << std::endl;
+
+        if (loop_count != selector_count || selector_count != collected) {
+            std::cerr << "Mismatch between selector and loops" << std::endl;
+            return 1;
+        }
+
+        doc.save();
+        std::cout << "Saved: " << output_path << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
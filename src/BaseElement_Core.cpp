@@ -6,6 +6,7 @@
  * used throughout the document element hierarchy.
  */
 #include "BaseElement_Core.hpp"
+#include "NumericCodec.hpp"
 
 #include <cctype>
 #include <map>
@@ -22,8 +23,9 @@ namespace duckx
         {"w:tc", 4}   // Table cell
     };
 
-    DocxElement::DocxElement(const pugi::xml_node parentNode, const pugi::xml_node currentNode)
-        : m_parentNode(parentNode), m_currentNode(currentNode) {}
+    DocxElement::DocxElement(const pugi::xml_node parentNode, const pugi::xml_node currentNode,
+                             MutationJournal* journal)
+        : m_parentNode(parentNode), m_currentNode(currentNode), m_journal(journal) {}
 
     pugi::xml_node DocxElement::get_node() const
     {
@@ -102,7 +104,7 @@ namespace duckx
     /*! @brief Convert points to twips (twentieths of a point) */
     long long points_to_twips(const double pts)
     {
-        return static_cast<long long>(pts * 20.0);
+        return numeric::to_fixed(pts, numeric::kTwipsPerPoint);
     }
 
 } // namespace duckx
\ No newline at end of file
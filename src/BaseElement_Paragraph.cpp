@@ -11,7 +11,12 @@
 #include <cstring>
 
 #include "Document.hpp"
+#include "DocumentFragment.hpp"
 #include "HyperlinkManager.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+#include "PropertyDecoder.hpp"
 #include "StyleManager.hpp"
 
 namespace duckx
@@ -19,11 +24,11 @@ namespace duckx
     /*! @brief Convert line spacing to OOXML format */
     long long line_spacing_to_ooxml(const double spacing)
     {
-        return static_cast<long long>(spacing * 240.0);
+        return numeric::to_fixed(spacing, numeric::kLineSpacingUnit);
     }
 
-    Paragraph::Paragraph(const pugi::xml_node parent, const pugi::xml_node current)
-        : DocxElement(parent, current) {}
+    Paragraph::Paragraph(const pugi::xml_node parent, const pugi::xml_node current, MutationJournal* journal)
+        : DocxElement(parent, current, journal) {}
 
     void Paragraph::set_parent(const pugi::xml_node node)
     {
@@ -86,153 +91,53 @@ namespace duckx
         return true;
     }
 
+    ParagraphProperties Paragraph::properties() const
+    {
+        return properties::decode_paragraph<properties::XmlNodeAccess>(m_currentNode.child("w:pPr"));
+    }
+
     Alignment Paragraph::get_alignment() const
     {
-        const auto pPr = m_currentNode.child("w:pPr");
-        if (pPr)
-        {
-            const auto jc = pPr.child("w:jc");
-            if (jc)
-            {
-                const std::string val = jc.attribute("w:val").as_string();
-                if (val == "center") return Alignment::CENTER;
-                if (val == "right") return Alignment::RIGHT;
-                if (val == "both") return Alignment::BOTH;
-            }
-        }
-        return Alignment::LEFT;
+        return properties().alignment;
     }
 
     bool Paragraph::get_line_spacing(double& line_spacing) const
     {
-        line_spacing = 1.0; // Default line spacing is 1.0 (single spacing)
-        
-        const auto pPr = m_currentNode.child("w:pPr");
-        if (pPr)
-        {
-            const auto spacingNode = pPr.child("w:spacing");
-            if (spacingNode)
-            {
-                const auto line = spacingNode.attribute("w:line");
-                if (line)
-                {
-                    line_spacing = line.as_double() / 240.0;
-                    return true;
-                }
-            }
-        }
-        return false;
+        const ParagraphProperties props = properties();
+        line_spacing = props.line_spacing; // 1.0 (single spacing) unless set explicitly
+        return props.has_line_spacing;
     }
 
     bool Paragraph::get_spacing(double& before_pts, double& after_pts) const
     {
-        before_pts = 0.0;
-        after_pts = 0.0;
-        
-        const auto pPr = m_currentNode.child("w:pPr");
-        if (pPr)
-        {
-            const auto spacingNode = pPr.child("w:spacing");
-            if (spacingNode)
-            {
-                bool found = false;
-                const auto before = spacingNode.attribute("w:before");
-                if (before)
-                {
-                    before_pts = before.as_double() / 20.0;
-                    found = true;
-                }
-                const auto after = spacingNode.attribute("w:after");
-                if (after)
-                {
-                    after_pts = after.as_double() / 20.0;
-                    found = true;
-                }
-                return found;
-            }
-        }
-        return false;
+        const ParagraphProperties props = properties();
+        before_pts = props.spacing_before;
+        after_pts = props.spacing_after;
+        return props.has_spacing;
     }
 
     bool Paragraph::get_indentation(double& left_pts, double& right_pts, double& first_line_pts) const
     {
-        left_pts = 0.0;
-        right_pts = 0.0;
-        first_line_pts = 0.0;
-        
-        const auto pPr = m_currentNode.child("w:pPr");
-        if (pPr)
-        {
-            const auto indNode = pPr.child("w:ind");
-            if (indNode)
-            {
-                bool found = false;
-                const auto left = indNode.attribute("w:left");
-                if (left)
-                {
-                    left_pts = left.as_double() / 20.0;
-                    found = true;
-                }
-                const auto right = indNode.attribute("w:right");
-                if (right)
-                {
-                    right_pts = right.as_double() / 20.0;
-                    found = true;
-                }
-                const auto firstLine = indNode.attribute("w:firstLine");
-                if (firstLine)
-                {
-                    first_line_pts = firstLine.as_double() / 20.0;
-                    found = true;
-                }
-                const auto hanging = indNode.attribute("w:hanging");
-                if (hanging)
-                {
-                    first_line_pts = -hanging.as_double() / 20.0;
-                    found = true;
-                }
-                return found;
-            }
-        }
-        return false;
+        const ParagraphProperties props = properties();
+        left_pts = props.indent_left;
+        right_pts = props.indent_right;
+        first_line_pts = props.indent_first_line;
+        return props.has_indentation;
     }
 
     bool Paragraph::get_list_style(ListType& type, int& level, int& numId) const
     {
-        const auto pPr = m_currentNode.child("w:pPr");
-        if (pPr)
-        {
-            const auto numPr = pPr.child("w:numPr");
-            if (numPr)
-            {
-                const auto ilvl = numPr.child("w:ilvl");
-                if (ilvl)
-                {
-                    level = ilvl.attribute("w:val").as_int(-1);
-                }
-                else
-                {
-                    level = -1;
-                }
-
-                const auto id = numPr.child("w:numId");
-                if (id)
-                {
-                    numId = id.attribute("w:val").as_int(-1);
-                }
-                else
-                {
-                    numId = -1;
-                }
-
-                // As before, we can't easily determine the type (BULLET/NUMBER)
-                // without parsing the numbering.xml, so we'll default to BULLET
-                type = ListType::BULLET;
-
-                return numId > 0;
-            }
-        }
-        return false;
+        const ParagraphProperties props = properties();
+        if (!props.has_numbering) return false;
+
+        level = props.list_level;
+        numId = props.list_num_id;
+
+        // As before, we can't easily determine the type (BULLET/NUMBER)
+        // without parsing the numbering.xml, so we'll default to BULLET
+        type = ListType::BULLET;
+
+        return numId > 0;
     }
 
     absl::enable_if_t<is_docx_element<Run>::value, ElementRange<Run>> Paragraph::runs()
@@ -247,6 +152,7 @@ namespace duckx
         }
 
         m_run.set_parent(m_currentNode);
+        m_run.set_journal(m_journal);
 
         return make_element_range(m_run);
     }
@@ -265,6 +171,7 @@ namespace duckx
         }
 
         temp_run.set_parent(m_currentNode);
+        temp_run.set_journal(m_journal);
 
         return make_element_range(temp_run);
     }
@@ -276,6 +183,7 @@ namespace duckx
 
     Run& Paragraph::add_run(const char* text, formatting_flag f)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         // Add new run
         pugi::xml_node new_run = m_currentNode.append_child("w:r");
         // Insert meta to new run
@@ -318,15 +226,24 @@ namespace duckx
         }
         new_run_text.text().set(text ? text : "");
 
-        return *new Run(m_currentNode, new_run);
+        return *new Run(m_currentNode, new_run, m_journal);
     }
 
     Run Paragraph::add_hyperlink(const Document& doc, const std::string& text, const std::string& url)
     {
         const HyperlinkManager& link_manager = doc.links();
 
-        const std::string rId = link_manager.add_relationship(url);
+        return append_hyperlink(link_manager.add_relationship(url), text);
+    }
+
+    Run Paragraph::add_hyperlink(DocumentFragment& fragment, const std::string& text, const std::string& url)
+    {
+        return append_hyperlink(fragment.add_hyperlink_relationship(url), text);
+    }
 
+    Run Paragraph::append_hyperlink(const std::string& rId, const std::string& text)
+    {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node hyperlink_node = m_currentNode.append_child("w:hyperlink");
         hyperlink_node.append_attribute("r:id").set_value(rId.c_str());
 
@@ -349,7 +266,7 @@ namespace duckx
             text_node.append_attribute("xml:space").set_value("preserve");
         }
 
-        return {hyperlink_node, run_node};
+        return {hyperlink_node, run_node, m_journal};
     }
 
     Paragraph& Paragraph::set_alignment(const Alignment align)
@@ -363,29 +280,12 @@ namespace duckx
             jc_node = pPr_node.append_child("w:jc");
         }
 
-        auto align_str = "left";
-        switch (align)
-        {
-            case Alignment::LEFT:
-                align_str = "left";
-                break;
-            case Alignment::CENTER:
-                align_str = "center";
-                break;
-            case Alignment::RIGHT:
-                align_str = "right";
-                break;
-            case Alignment::BOTH:
-                align_str = "both";
-                break;
-        }
-
         pugi::xml_attribute val_attr = jc_node.attribute("w:val");
         if (!val_attr)
         {
             val_attr = jc_node.append_attribute("w:val");
         }
-        val_attr.set_value(align_str);
+        val_attr.set_value(ooxml::to_string(align));
 
         return *this;
     }
@@ -536,9 +436,11 @@ namespace duckx
     Paragraph& Paragraph::insert_paragraph_after(const std::string& text, formatting_flag f)
     {
         const pugi::xml_node new_para = m_parentNode.insert_child_after("w:p", m_currentNode);
+        MutationJournal::after_insert(m_journal, new_para);
 
         const auto p = new Paragraph();
         p->set_current(new_para);
+        p->set_journal(m_journal);
         p->add_run(text, f);
 
         return *p;
@@ -546,6 +448,7 @@ namespace duckx
 
     pugi::xml_node Paragraph::get_or_create_pPr()
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node pPr_node = m_currentNode.child("w:pPr");
         if (!pPr_node)
         {
@@ -628,6 +531,7 @@ namespace duckx
         
         pugi::xml_node style_ref = ppr.child("w:pStyle");
         if (style_ref) {
+            MutationJournal::before_change(m_journal, m_currentNode);
             ppr.remove_child(style_ref);
         }
         
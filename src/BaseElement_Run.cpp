@@ -8,61 +8,18 @@
 #include "BaseElement_Run.hpp"
 
 #include <cctype>
-#include <map>
-#include <cmath>
+#include <cstring>
 
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+#include "PropertyDecoder.hpp"
 #include "StyleManager.hpp"
 
 namespace duckx
 {
-    /*! @brief Convert highlight color enum to string */
-    static std::string highlight_color_to_string(const HighlightColor color)
-    {
-        static const std::map<HighlightColor, std::string> color_map = {
-            {HighlightColor::BLACK, "black"},
-            {HighlightColor::BLUE, "blue"},
-            {HighlightColor::CYAN, "cyan"},
-            {HighlightColor::GREEN, "green"},
-            {HighlightColor::MAGENTA, "magenta"},
-            {HighlightColor::RED, "red"},
-            {HighlightColor::YELLOW, "yellow"},
-            {HighlightColor::WHITE, "white"},
-            {HighlightColor::DARK_BLUE, "darkBlue"},
-            {HighlightColor::DARK_CYAN, "darkCyan"},
-            {HighlightColor::DARK_GREEN, "darkGreen"},
-            {HighlightColor::DARK_MAGENTA, "darkMagenta"},
-            {HighlightColor::DARK_RED, "darkRed"},
-            {HighlightColor::DARK_YELLOW, "darkYellow"},
-            {HighlightColor::LIGHT_GRAY, "lightGray"}
-        };
-
-        const auto it = color_map.find(color);
-        if (it != color_map.end())
-        {
-            return it->second;
-        }
-        return ""; // Return an empty string if not found
-    }
-
-    static bool check_boolean_property(const pugi::xml_node& rPr, const char* tag_name)
-    {
-        if (!rPr) return false;
-
-        const auto tag = rPr.child(tag_name);
-        if (!tag) return false;
-
-        // The property is present. Now check if it's explicitly set to false.
-        const auto val_attr = tag.attribute("w:val");
-        if (val_attr && (std::string(val_attr.as_string()) == "false" || std::string(val_attr.as_string()) == "0"))
-        {
-            return false;
-        }
-
-        return true;
-    }
-
-    Run::Run(const pugi::xml_node parent, const pugi::xml_node current)
-        : DocxElement(parent, current) {}
+    Run::Run(const pugi::xml_node parent, const pugi::xml_node current, MutationJournal* journal)
+        : DocxElement(parent, current, journal) {}
 
     bool Run::has_next() const
     {
@@ -94,160 +51,76 @@ namespace duckx
         return m_currentNode.child("w:t").text().get();
     }
 
+    RunProperties Run::properties() const
+    {
+        return properties::decode_run<properties::XmlNodeAccess>(m_currentNode.child("w:rPr"));
+    }
+
     bool Run::is_bold() const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        return check_boolean_property(rPr, "w:b");
+        return (properties().formatting & bold) != 0;
     }
 
     bool Run::is_italic() const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        return check_boolean_property(rPr, "w:i");
+        return (properties().formatting & italic) != 0;
     }
 
     bool Run::is_underline() const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (!rPr) return false;
-
-        const auto tag = rPr.child("w:u");
-        if (!tag) return false;
-
-        // Underline can be turned off with w:val="none"
-        const auto val_attr = tag.attribute("w:val");
-        if (val_attr && std::string(val_attr.as_string()) == "none")
-        {
-            return false;
-        }
-
-        return true;
+        return (properties().formatting & underline) != 0;
     }
 
     bool Run::get_font(std::string& font_name) const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (!rPr) return false;
-
-        const auto rFonts = rPr.child("w:rFonts");
-        if (!rFonts) return false;
+        const RunProperties props = properties();
+        if (!props.has_font) return false;
 
-        // The "ascii" attribute is typically the one to use for standard characters.
-        const auto font_attr = rFonts.attribute("w:ascii");
-        if (font_attr)
-        {
-            font_name = font_attr.as_string();
-            return true;
-        }
-
-        return false;
+        font_name = props.font;
+        return true;
     }
 
     bool Run::get_font_size(double& size) const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (!rPr) return false;
-
-        const auto sz = rPr.child("w:sz");
-        if (!sz) return false;
-
-        const auto val_attr = sz.attribute("w:val");
-        if (val_attr)
-        {
-            // Font size in docx is stored in "half-points"
-            size = val_attr.as_double() / 2.0;
-            return true;
-        }
+        const RunProperties props = properties();
+        if (!props.has_font_size) return false;
 
-        return false;
+        size = props.font_size;
+        return true;
     }
 
     bool Run::get_color(std::string& color) const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (!rPr) return false;
+        const RunProperties props = properties();
+        if (!props.has_color) return false;
 
-        const auto color_node = rPr.child("w:color");
-        if (!color_node) return false;
-
-        const auto val_attr = color_node.attribute("w:val");
-        if (val_attr)
-        {
-            color = val_attr.as_string();
-            // Don't return "auto" colors as they are not explicit RGB values
-            if (color == "auto") return false;
-            return true;
-        }
-
-        return false;
+        color = props.color;
+        return true;
     }
 
     bool Run::get_highlight(HighlightColor& color) const
     {
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (!rPr) return false;
-
-        const auto highlight_node = rPr.child("w:highlight");
-        if (!highlight_node) return false;
-
-        const auto val_attr = highlight_node.attribute("w:val");
-        if (!val_attr) return false;
-
-        const std::string val_str = val_attr.as_string();
-
-        static const std::map<std::string, HighlightColor> color_map = {
-            {"black", HighlightColor::BLACK}, {"blue", HighlightColor::BLUE},
-            {"cyan", HighlightColor::CYAN}, {"green", HighlightColor::GREEN},
-            {"magenta", HighlightColor::MAGENTA}, {"red", HighlightColor::RED},
-            {"yellow", HighlightColor::YELLOW}, {"white", HighlightColor::WHITE},
-            {"darkBlue", HighlightColor::DARK_BLUE}, {"darkCyan", HighlightColor::DARK_CYAN},
-            {"darkGreen", HighlightColor::DARK_GREEN}, {"darkMagenta", HighlightColor::DARK_MAGENTA},
-            {"darkRed", HighlightColor::DARK_RED}, {"darkYellow", HighlightColor::DARK_YELLOW},
-            {"lightGray", HighlightColor::LIGHT_GRAY}
-        };
-
-        const auto it = color_map.find(val_str);
-        if (it != color_map.end())
-        {
-            color = it->second;
-            return true;
-        }
+        const RunProperties props = properties();
+        if (!props.has_highlight) return false;
 
-        return false;
+        color = props.highlight;
+        return true;
     }
 
     formatting_flag Run::get_formatting() const
     {
-        formatting_flag flag = none;
-        if (is_bold()) flag |= bold;
-        if (is_italic()) flag |= italic;
-        if (is_underline()) flag |= underline;
-
-        const auto rPr = m_currentNode.child("w:rPr");
-        if (rPr)
-        {
-            if (check_boolean_property(rPr, "w:strike")) flag |= strikethrough;
-            if (check_boolean_property(rPr, "w:smallCaps")) flag |= smallcaps;
-            if (check_boolean_property(rPr, "w:shadow")) flag |= shadow;
-
-            if (const auto vertAlign = rPr.child("w:vertAlign"))
-            {
-                const std::string val = vertAlign.attribute("w:val").as_string();
-                if (val == "superscript") flag |= superscript;
-                else if (val == "subscript") flag |= subscript;
-            }
-        }
-
-        return flag;
+        return properties().formatting;
     }
 
     bool Run::set_text(const std::string& text) const
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         return m_currentNode.child("w:t").text().set(text.c_str());
     }
 
     bool Run::set_text(const char* text) const
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         return m_currentNode.child("w:t").text().set(text);
     }
 
@@ -298,14 +171,15 @@ namespace duckx
         }
 
         // 字号单位是 "half-points"，所以需要乘以2
-        const int half_points = static_cast<int>(std::round(size * 2.0));
+        const numeric::NumberBuffer half_points =
+            numeric::format_int(numeric::to_fixed(size, numeric::kHalfPointsPerPoint));
         
         // 更新现有属性而不是重复添加
         pugi::xml_attribute sz_val_attr = sz_node.attribute("w:val");
         if (!sz_val_attr) {
             sz_val_attr = sz_node.append_attribute("w:val");
         }
-        sz_val_attr.set_value(std::to_string(half_points).c_str());
+        sz_val_attr.set_value(half_points.c_str());
 
         // 还有一个 <w:szCs> 节点用于复杂字符（如亚洲语言），最好也设置一下
         pugi::xml_node szCs_node = rPr_node.child("w:szCs");
@@ -318,7 +192,7 @@ namespace duckx
         if (!szCs_val_attr) {
             szCs_val_attr = szCs_node.append_attribute("w:val");
         }
-        szCs_val_attr.set_value(std::to_string(half_points).c_str());
+        szCs_val_attr.set_value(half_points.c_str());
 
         return *this;
     }
@@ -357,21 +231,17 @@ namespace duckx
         }
         else
         {
-            const std::string color_str = highlight_color_to_string(color);
-            if (!color_str.empty())
+            if (!highlight_node)
+            {
+                highlight_node = rPr.append_child("w:highlight");
+            }
+
+            pugi::xml_attribute val_attr = highlight_node.attribute("w:val");
+            if (!val_attr)
             {
-                if (!highlight_node)
-                {
-                    highlight_node = rPr.append_child("w:highlight");
-                }
-
-                pugi::xml_attribute val_attr = highlight_node.attribute("w:val");
-                if (!val_attr)
-                {
-                    val_attr = highlight_node.append_attribute("w:val");
-                }
-                val_attr.set_value(color_str.c_str());
+                val_attr = highlight_node.append_attribute("w:val");
             }
+            val_attr.set_value(ooxml::to_string(color));
         }
 
         return *this;
@@ -411,6 +281,7 @@ namespace duckx
 
     pugi::xml_node Run::get_or_create_rPr()
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node rPr_node = m_currentNode.child("w:rPr");
         if (!rPr_node)
         {
@@ -484,6 +355,7 @@ namespace duckx
         
         pugi::xml_node style_ref = rpr.child("w:rStyle");
         if (style_ref) {
+            MutationJournal::before_change(m_journal, m_currentNode);
             rpr.remove_child(style_ref);
         }
         
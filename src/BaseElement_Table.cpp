@@ -15,6 +15,9 @@
 
 #include "Document.hpp"
 #include "HyperlinkManager.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
 #include "StyleManager.hpp"
 
 namespace duckx
@@ -23,8 +26,8 @@ namespace duckx
     // TableCell implementations (Core navigation and properties)
     // ============================================================================
 
-    TableCell::TableCell(const pugi::xml_node parent, const pugi::xml_node current)
-        : DocxElement(parent, current) {}
+    TableCell::TableCell(const pugi::xml_node parent, const pugi::xml_node current, MutationJournal* journal)
+        : DocxElement(parent, current, journal) {}
 
     void TableCell::set_parent(const pugi::xml_node node)
     {
@@ -65,6 +68,7 @@ namespace duckx
         }
 
         m_paragraph.set_parent(m_currentNode);
+        m_paragraph.set_journal(m_journal);
 
         return make_element_range(m_paragraph);
     }
@@ -100,8 +104,9 @@ namespace duckx
 
     Paragraph TableCell::add_paragraph(const std::string& text, formatting_flag f)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         const pugi::xml_node p_node = m_currentNode.append_child("w:p");
-        Paragraph new_para(m_currentNode, p_node);
+        Paragraph new_para(m_currentNode, p_node, m_journal);
         
         if (!text.empty()) {
             new_para.add_run(text, f);
@@ -118,9 +123,9 @@ namespace duckx
             tc_w = tc_pr.append_child("w:tcW");
         }
         
-        const long long width_twips = static_cast<long long>(width_pts * 20.0);
-        tc_w.attribute("w:w") ? tc_w.attribute("w:w").set_value(std::to_string(width_twips).c_str())
-                              : tc_w.append_attribute("w:w").set_value(std::to_string(width_twips).c_str());
+        const long long width_twips = numeric::to_fixed(width_pts, numeric::kTwipsPerPoint);
+        tc_w.attribute("w:w") ? tc_w.attribute("w:w").set_value(numeric::format_int(width_twips).c_str())
+                              : tc_w.append_attribute("w:w").set_value(numeric::format_int(width_twips).c_str());
         tc_w.attribute("w:type") ? tc_w.attribute("w:type").set_value("dxa")
                                  : tc_w.append_attribute("w:type").set_value("dxa");
         return *this;
@@ -200,9 +205,9 @@ namespace duckx
             if (!margin_node) {
                 margin_node = tc_mar.append_child(margin.name);
             }
-            const long long margin_twips = static_cast<long long>(margin.value * 20.0);
-            margin_node.attribute("w:w") ? margin_node.attribute("w:w").set_value(std::to_string(margin_twips).c_str())
-                                         : margin_node.append_attribute("w:w").set_value(std::to_string(margin_twips).c_str());
+            const long long margin_twips = numeric::to_fixed(margin.value, numeric::kTwipsPerPoint);
+            margin_node.attribute("w:w") ? margin_node.attribute("w:w").set_value(numeric::format_int(margin_twips).c_str())
+                                         : margin_node.append_attribute("w:w").set_value(numeric::format_int(margin_twips).c_str());
             margin_node.attribute("w:type") ? margin_node.attribute("w:type").set_value("dxa")
                                             : margin_node.append_attribute("w:type").set_value("dxa");
         }
@@ -231,8 +236,8 @@ namespace duckx
         pugi::xml_node tc_pr = get_or_create_tc_pr();
         pugi::xml_node tc_borders = get_or_create_tc_borders(tc_pr);
         
-        const long long width_eighth_pts = static_cast<long long>(width_pts * 8.0);
-        const std::string width_str = std::to_string(width_eighth_pts);
+        const numeric::NumberBuffer width_str =
+            numeric::format_int(numeric::to_fixed(width_pts, numeric::kEighthsPerPoint));
         
         const char* border_names[] = {"w:top", "w:left", "w:bottom", "w:right"};
         for (const char* border_name : border_names) {
@@ -271,7 +276,7 @@ namespace duckx
             if (tc_w) {
                 const auto w_attr = tc_w.attribute("w:w");
                 if (w_attr) {
-                    return w_attr.as_double() / 20.0;
+                    return numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                 }
             }
         }
@@ -350,28 +355,28 @@ namespace duckx
                 if (top) {
                     const auto w_attr = top.attribute("w:w");
                     if (w_attr) {
-                        margins[0] = w_attr.as_double() / 20.0;
+                        margins[0] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto right = tc_mar.child("w:right");
                 if (right) {
                     const auto w_attr = right.attribute("w:w");
                     if (w_attr) {
-                        margins[1] = w_attr.as_double() / 20.0;
+                        margins[1] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto bottom = tc_mar.child("w:bottom");
                 if (bottom) {
                     const auto w_attr = bottom.attribute("w:w");
                     if (w_attr) {
-                        margins[2] = w_attr.as_double() / 20.0;
+                        margins[2] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto left = tc_mar.child("w:left");
                 if (left) {
                     const auto w_attr = left.attribute("w:w");
                     if (w_attr) {
-                        margins[3] = w_attr.as_double() / 20.0;
+                        margins[3] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 return Result<std::array<double, 4>>(margins);
@@ -408,7 +413,7 @@ namespace duckx
                 if (top_border) {
                     const auto sz_attr = top_border.attribute("w:sz");
                     if (sz_attr) {
-                        return sz_attr.as_double() / 8.0;
+                        return numeric::read_points_or(sz_attr, numeric::kEighthsPerPoint, 0.0);
                     }
                 }
             }
@@ -436,6 +441,7 @@ namespace duckx
 
     pugi::xml_node TableCell::get_or_create_tc_pr()
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tc_pr = m_currentNode.child("w:tcPr");
         if (!tc_pr) {
             tc_pr = m_currentNode.prepend_child("w:tcPr");
@@ -477,7 +483,7 @@ namespace duckx
             return Result<TableCell*>(errors::invalid_argument("type", "Width type cannot be empty"));
         }
         
-        if (type != "dxa" && type != "pct" && type != "auto") {
+        if (!ooxml::is_width_type(type)) {
             return Result<TableCell*>(errors::validation_failed("type", "Invalid width type",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_type", type)
@@ -494,7 +500,7 @@ namespace duckx
             return Result<TableCell*>(errors::invalid_argument("alignment", "Alignment cannot be empty"));
         }
         
-        if (alignment != "top" && alignment != "center" && alignment != "bottom") {
+        if (!ooxml::is_cell_vertical_alignment(alignment)) {
             return Result<TableCell*>(errors::validation_failed("alignment", "Invalid vertical alignment",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_alignment", alignment)
@@ -529,8 +535,7 @@ namespace duckx
             return Result<TableCell*>(errors::invalid_argument("direction", "Text direction cannot be empty"));
         }
         
-        const std::vector<std::string> valid_directions = {"lrTb", "tbRl", "btLr", "lrTbV", "tbRlV", "tbLrV"};
-        if (std::find(valid_directions.begin(), valid_directions.end(), direction) == valid_directions.end()) {
+        if (!ooxml::is_text_direction(direction)) {
             return Result<TableCell*>(errors::validation_failed("direction", "Invalid text direction",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_direction", direction)
@@ -564,8 +569,7 @@ namespace duckx
             return Result<TableCell*>(errors::invalid_argument("style", "Border style cannot be empty"));
         }
         
-        const std::vector<std::string> valid_styles = {"single", "double", "dashed", "dotted", "none"};
-        if (std::find(valid_styles.begin(), valid_styles.end(), style) == valid_styles.end()) {
+        if (!ooxml::is_border_style(style)) {
             return Result<TableCell*>(errors::validation_failed("style", "Invalid border style",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_style", style)
@@ -675,7 +679,7 @@ namespace duckx
             return Result<Table*>(errors::invalid_argument("alignment", "Alignment cannot be empty"));
         }
         
-        if (alignment != "left" && alignment != "center" && alignment != "right") {
+        if (!ooxml::is_table_alignment(alignment)) {
             return Result<Table*>(errors::validation_failed("alignment", "Invalid table alignment",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_alignment", alignment)
@@ -711,8 +715,7 @@ namespace duckx
             return Result<Table*>(errors::invalid_argument("style", "Border style cannot be empty"));
         }
         
-        const std::vector<std::string> valid_styles = {"single", "double", "dashed", "dotted", "none"};
-        if (std::find(valid_styles.begin(), valid_styles.end(), style) == valid_styles.end()) {
+        if (!ooxml::is_border_style(style)) {
             return Result<Table*>(errors::validation_failed("style", "Invalid border style",
                 ErrorContext(__FILE__, __func__, __LINE__)
                     .with_info("provided_style", style)
@@ -804,7 +807,7 @@ namespace duckx
             if (tbl_w) {
                 const auto w_attr = tbl_w.attribute("w:w");
                 if (w_attr) {
-                    return w_attr.as_double() / 20.0; // Convert from twips to points
+                    return numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
                 }
             }
         }
@@ -839,7 +842,7 @@ namespace duckx
                 if (top_border) {
                     const auto sz_attr = top_border.attribute("w:sz");
                     if (sz_attr) {
-                        return sz_attr.as_double() / 8.0; // Convert from eighths of a point
+                        return numeric::read_points_or(sz_attr, numeric::kEighthsPerPoint, 0.0); // Convert from eighths of a point
                     }
                 }
             }
@@ -877,28 +880,28 @@ namespace duckx
                 if (top) {
                     const auto w_attr = top.attribute("w:w");
                     if (w_attr) {
-                        margins[0] = w_attr.as_double() / 20.0;
+                        margins[0] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto right = tbl_cell_mar.child("w:right");
                 if (right) {
                     const auto w_attr = right.attribute("w:w");
                     if (w_attr) {
-                        margins[1] = w_attr.as_double() / 20.0;
+                        margins[1] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto bottom = tbl_cell_mar.child("w:bottom");
                 if (bottom) {
                     const auto w_attr = bottom.attribute("w:w");
                     if (w_attr) {
-                        margins[2] = w_attr.as_double() / 20.0;
+                        margins[2] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 const auto left = tbl_cell_mar.child("w:left");
                 if (left) {
                     const auto w_attr = left.attribute("w:w");
                     if (w_attr) {
-                        margins[3] = w_attr.as_double() / 20.0;
+                        margins[3] = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0);
                     }
                 }
                 return Result<std::array<double, 4>>(margins);
@@ -913,6 +916,7 @@ namespace duckx
 
     Table& Table::set_alignment(const std::string& alignment)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -930,6 +934,7 @@ namespace duckx
 
     Table& Table::set_width(double width_pts)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -942,13 +947,14 @@ namespace duckx
         
         tbl_w.remove_attribute("w:w");
         tbl_w.remove_attribute("w:type");
-        tbl_w.append_attribute("w:w").set_value(static_cast<int>(width_pts * 20)); // Convert to twips
+        numeric::write_points(tbl_w.append_attribute("w:w"), width_pts, numeric::kTwipsPerPoint); // Convert to twips
         tbl_w.append_attribute("w:type").set_value("dxa");
         return *this;
     }
 
     Table& Table::set_border_style(const std::string& style)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -973,6 +979,7 @@ namespace duckx
 
     Table& Table::set_border_width(double width_pts)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -990,13 +997,14 @@ namespace duckx
                 border = tbl_borders.append_child(border_name);
             }
             border.remove_attribute("w:sz");
-            border.append_attribute("w:sz").set_value(static_cast<int>(width_pts * 8)); // Convert to eighths of a point
+            numeric::write_points(border.append_attribute("w:sz"), width_pts, numeric::kEighthsPerPoint); // Convert to eighths of a point
         }
         return *this;
     }
 
     Table& Table::set_border_color(const std::string& color)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -1021,6 +1029,7 @@ namespace duckx
 
     Table& Table::set_cell_margins(double top_pts, double right_pts, double bottom_pts, double left_pts)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tbl_pr = m_currentNode.child("w:tblPr");
         if (!tbl_pr) {
             tbl_pr = m_currentNode.prepend_child("w:tblPr");
@@ -1039,9 +1048,9 @@ namespace duckx
             if (!margin) {
                 margin = tbl_cell_mar.append_child(margin_names[i]);
             }
-            const long long margin_twips = static_cast<long long>(margins[i] * 20.0);
-            margin.attribute("w:w") ? margin.attribute("w:w").set_value(std::to_string(margin_twips).c_str())
-                                    : margin.append_attribute("w:w").set_value(std::to_string(margin_twips).c_str());
+            const long long margin_twips = numeric::to_fixed(margins[i], numeric::kTwipsPerPoint);
+            margin.attribute("w:w") ? margin.attribute("w:w").set_value(numeric::format_int(margin_twips).c_str())
+                                    : margin.append_attribute("w:w").set_value(numeric::format_int(margin_twips).c_str());
             margin.attribute("w:type") ? margin.attribute("w:type").set_value("dxa")
                                         : margin.append_attribute("w:type").set_value("dxa");
         }
@@ -1054,6 +1063,7 @@ namespace duckx
 
     TableRow& TableRow::set_height(double height_pts)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tr_pr = m_currentNode.child("w:trPr");
         if (!tr_pr) {
             tr_pr = m_currentNode.prepend_child("w:trPr");
@@ -1065,12 +1075,13 @@ namespace duckx
         }
         
         tr_height.remove_attribute("w:val");
-        tr_height.append_attribute("w:val").set_value(static_cast<int>(height_pts * 20)); // Convert to twips
+        numeric::write_points(tr_height.append_attribute("w:val"), height_pts, numeric::kTwipsPerPoint); // Convert to twips
         return *this;
     }
 
     TableRow& TableRow::set_height_rule(const std::string& rule)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tr_pr = m_currentNode.child("w:trPr");
         if (!tr_pr) {
             tr_pr = m_currentNode.prepend_child("w:trPr");
@@ -1088,6 +1099,7 @@ namespace duckx
 
     TableRow& TableRow::set_header_row(bool is_header)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tr_pr = m_currentNode.child("w:trPr");
         if (!tr_pr) {
             tr_pr = m_currentNode.prepend_child("w:trPr");
@@ -1108,6 +1120,7 @@ namespace duckx
 
     TableRow& TableRow::set_cant_split(bool cant_split)
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tr_pr = m_currentNode.child("w:trPr");
         if (!tr_pr) {
             tr_pr = m_currentNode.prepend_child("w:trPr");
@@ -1138,7 +1151,7 @@ namespace duckx
             if (tr_height) {
                 const auto val_attr = tr_height.attribute("w:val");
                 if (val_attr) {
-                    return val_attr.as_double() / 20.0; // Convert from twips to points
+                    return numeric::read_points_or(val_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
                 }
             }
         }
@@ -1184,8 +1197,10 @@ namespace duckx
     // Table Basic implementations (Navigation and Element Management)
     // ============================================================================
 
-    Table::Table(pugi::xml_node parent, pugi::xml_node current) : DocxElement(parent, current)
+    Table::Table(pugi::xml_node parent, pugi::xml_node current, MutationJournal* journal)
+        : DocxElement(parent, current, journal)
     {
+        m_tableRow.set_journal(m_journal);
         m_tableRow.set_parent(m_currentNode);
         m_tableRow.set_current(m_currentNode.child("w:tr"));
     }
@@ -1244,12 +1259,13 @@ namespace duckx
 
     absl::enable_if_t<is_docx_element<TableRow>::value, ElementRange<TableRow>> Table::rows()
     {
-        TableRow first_row(m_currentNode, m_currentNode.child("w:tr"));
+        TableRow first_row(m_currentNode, m_currentNode.child("w:tr"), m_journal);
         return ElementRange<TableRow>(first_row);
     }
 
     TableRow& Table::add_row()
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node new_row = m_currentNode.append_child("w:tr");
         
         // Add a default cell to the new row
@@ -1257,6 +1273,7 @@ namespace duckx
         pugi::xml_node new_p = new_cell.append_child("w:p");
         
         // Update the TableRow to point to the new row
+        m_tableRow.set_journal(m_journal);
         m_tableRow.set_current(new_row);
         return m_tableRow;
     }
@@ -1269,6 +1286,7 @@ namespace duckx
         }
         
         if (row) {
+            m_tableRow.set_journal(m_journal);
             m_tableRow.set_current(row);
         }
         return m_tableRow;
@@ -1287,8 +1305,10 @@ namespace duckx
     // TableRow Basic implementations (Navigation and Element Management)
     // ============================================================================
 
-    TableRow::TableRow(pugi::xml_node parent, pugi::xml_node current) : DocxElement(parent, current)
+    TableRow::TableRow(pugi::xml_node parent, pugi::xml_node current, MutationJournal* journal)
+        : DocxElement(parent, current, journal)
     {
+        m_tableCell.set_journal(m_journal);
         m_tableCell.set_parent(m_currentNode);
         m_tableCell.set_current(m_currentNode.child("w:tc"));
     }
@@ -1347,16 +1367,18 @@ namespace duckx
 
     absl::enable_if_t<is_docx_element<TableCell>::value, ElementRange<TableCell>> TableRow::cells()
     {
-        TableCell first_cell(m_currentNode, m_currentNode.child("w:tc"));
+        TableCell first_cell(m_currentNode, m_currentNode.child("w:tc"), m_journal);
         return ElementRange<TableCell>(first_cell);
     }
 
     TableCell& TableRow::add_cell()
     {
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node new_cell = m_currentNode.append_child("w:tc");
         pugi::xml_node new_p = new_cell.append_child("w:p");
         
         // Update the TableCell to point to the new cell
+        m_tableCell.set_journal(m_journal);
         m_tableCell.set_current(new_cell);
         return m_tableCell;
     }
@@ -1369,6 +1391,7 @@ namespace duckx
         }
         
         if (cell) {
+            m_tableCell.set_journal(m_journal);
             m_tableCell.set_current(cell);
         }
         return m_tableCell;
@@ -1404,6 +1427,7 @@ namespace duckx
         }
         
         // Get or create table properties node
+        MutationJournal::before_change(m_journal, m_currentNode);
         pugi::xml_node tblpr = m_currentNode.child("w:tblPr");
         if (!tblpr) {
             tblpr = m_currentNode.prepend_child("w:tblPr");
@@ -1456,6 +1480,7 @@ namespace duckx
         
         pugi::xml_node style_ref = tblpr.child("w:tblStyle");
         if (style_ref) {
+            MutationJournal::before_change(m_journal, m_currentNode);
             tblpr.remove_child(style_ref);
         }
         
@@ -6,12 +6,15 @@
  * creation, iteration, and the modern Result<T> API implementations.
  */
 #include "../include/Body.hpp"
+#include "../include/MutationJournal.hpp"
 
 namespace duckx
 {
-    Body::Body(const pugi::xml_node bodyNode)
-        : m_bodyNode(bodyNode)
+    Body::Body(const pugi::xml_node bodyNode, MutationJournal* journal)
+        : m_bodyNode(bodyNode), m_journal(journal)
     {
+        m_paragraph.set_journal(m_journal);
+        m_table.set_journal(m_journal);
         if (m_bodyNode)
         {
             m_paragraph.set_parent(m_bodyNode);
@@ -50,6 +53,7 @@ namespace duckx
             temp_para.set_current(pugi::xml_node());
         }
         temp_para.set_parent(m_bodyNode);
+        temp_para.set_journal(m_journal);
 
         return make_element_range(temp_para);
     }
@@ -83,6 +87,7 @@ namespace duckx
         }
 
         temp_table.set_parent(m_bodyNode);
+        temp_table.set_journal(m_journal);
 
         return make_element_range(temp_table);
     }
@@ -90,7 +95,8 @@ namespace duckx
     Paragraph Body::add_paragraph(const std::string& text, const formatting_flag f)
     {
         const pugi::xml_node pNode = m_bodyNode.append_child("w:p");
-        Paragraph newPara(m_bodyNode, pNode);
+        MutationJournal::after_insert(m_journal, pNode);
+        Paragraph newPara(m_bodyNode, pNode, m_journal);
         if (!text.empty())
         {
             newPara.add_run(text, f);
@@ -102,6 +108,7 @@ namespace duckx
     {
         // Create table structure following DOCX specification requirements
         pugi::xml_node new_tbl_node = m_bodyNode.append_child("w:tbl");
+        MutationJournal::after_insert(m_journal, new_tbl_node);
 
         // Add table properties with default borders for visibility
         pugi::xml_node tbl_pr_node = new_tbl_node.append_child("w:tblPr");
@@ -134,7 +141,7 @@ namespace duckx
         }
 
         // Return Table wrapper for the created XML structure
-        return {m_bodyNode, new_tbl_node};
+        return {m_bodyNode, new_tbl_node, m_journal};
     }
 
     Result<Paragraph> Body::add_paragraph_safe(const std::string& text, const formatting_flag f)
@@ -166,9 +173,10 @@ namespace duckx
                            "Failed to create paragraph XML node",
                            DUCKX_ERROR_CONTEXT_OP("add_paragraph_safe")));
             }
+            MutationJournal::after_insert(m_journal, pNode);
 
             // Create paragraph object
-            Paragraph newPara(m_bodyNode, pNode);
+            Paragraph newPara(m_bodyNode, pNode, m_journal);
             
             // Add text content if provided
             if (!text.empty()) {
@@ -194,6 +202,11 @@ namespace duckx
     }
 
     Result<Table> Body::add_table_safe(const int rows, const int cols)
+    {
+        return add_table_safe(rows, cols, OperationOptions());
+    }
+
+    Result<Table> Body::add_table_safe(const int rows, const int cols, const OperationOptions& operation)
     {
         try {
             // Validate body node
@@ -233,6 +246,7 @@ namespace duckx
                            "Failed to create table XML node",
                            DUCKX_ERROR_CONTEXT_OP("add_table_safe")));
             }
+            MutationJournal::after_insert(m_journal, new_tbl_node);
 
             // Add table properties <w:tblPr> and default borders
             pugi::xml_node tbl_pr_node = new_tbl_node.append_child("w:tblPr");
@@ -281,7 +295,16 @@ namespace duckx
             }
 
             // Create rows <w:tr> and cells <w:tc>
+            const OperationProgress progress(operation, static_cast<std::uint64_t>(rows));
             for (int r = 0; r < rows; ++r) {
+                if (!progress.report(static_cast<std::uint64_t>(r))) {
+                    // 移除未完成的表格，正文保持调用前的状态
+                    MutationJournal::before_remove(m_journal, new_tbl_node);
+                    m_bodyNode.remove_child(new_tbl_node);
+                    return Result<Table>(errors::operation_cancelled("add_table_safe",
+                               DUCKX_ERROR_CONTEXT_OP("add_table_safe")
+                               .with_info("rows_built", std::to_string(r))));
+                }
                 pugi::xml_node tr_node = new_tbl_node.append_child("w:tr");
                 if (!tr_node) {
                     return Result<Table>(Error(ErrorCategory::ELEMENT_OPERATION,
@@ -315,8 +338,10 @@ namespace duckx
                 }
             }
 
+            progress.report(static_cast<std::uint64_t>(rows));
+
             // Return a Table object pointing to the newly created table
-            return Result<Table>(Table{m_bodyNode, new_tbl_node});
+            return Result<Table>(Table{m_bodyNode, new_tbl_node, m_journal});
         }
         catch (const std::exception& e) {
             return Result<Table>(Error(ErrorCategory::ELEMENT_OPERATION,
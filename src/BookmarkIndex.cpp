@@ -0,0 +1,405 @@
+/*!
+ * @file BookmarkIndex.cpp
+ * @brief Implementation of the bookmark and cross-reference index
+ */
+#include "BookmarkIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        // 按空白切分域代码，双引号内的内容视为一个参数
+        std::vector<absl::string_view> tokenize(const absl::string_view instr)
+        {
+            std::vector<absl::string_view> tokens;
+            size_t i = 0;
+            while (i < instr.size())
+            {
+                if (absl::ascii_isspace(static_cast<unsigned char>(instr[i])))
+                {
+                    ++i;
+                    continue;
+                }
+                if (instr[i] == '"')
+                {
+                    const size_t close = instr.find('"', i + 1);
+                    const size_t end = close == absl::string_view::npos ? instr.size() : close;
+                    tokens.push_back(instr.substr(i + 1, end - i - 1));
+                    i = end + 1;
+                    continue;
+                }
+                const size_t begin = i;
+                while (i < instr.size() && !absl::ascii_isspace(static_cast<unsigned char>(instr[i])))
+                    ++i;
+                tokens.push_back(instr.substr(begin, i - begin));
+            }
+            return tokens;
+        }
+
+        // 只识别指向书签的 REF / PAGEREF / HYPERLINK \l，其余域忽略
+        bool parse_instruction(const absl::string_view instr, FieldReference& ref)
+        {
+            const std::vector<absl::string_view> tokens = tokenize(instr);
+            if (tokens.size() < 2)
+                return false;
+
+            const std::string keyword = absl::AsciiStrToUpper(tokens[0]);
+            if (keyword == "REF" || keyword == "PAGEREF")
+            {
+                if (tokens[1].empty() || tokens[1].front() == '\\')
+                    return false;
+                ref.kind = keyword == "REF" ? FieldKind::REF : FieldKind::PAGEREF;
+                ref.target = std::string(tokens[1]);
+                return true;
+            }
+            if (keyword == "HYPERLINK")
+            {
+                for (size_t i = 1; i + 1 < tokens.size(); ++i)
+                {
+                    if (tokens[i] == "\\l")
+                    {
+                        ref.kind = FieldKind::HYPERLINK;
+                        ref.target = std::string(tokens[i + 1]);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        int bookmark_id(const pugi::xml_node marker)
+        {
+            return static_cast<int>(numeric::read_int_or(marker.attribute("w:id"), -1));
+        }
+
+        template <typename Visit>
+        void walk(const pugi::xml_node root, Visit visit)
+        {
+            pugi::xml_node node = root;
+            while (node)
+            {
+                visit(node);
+                if (node.first_child())
+                {
+                    node = node.first_child();
+                    continue;
+                }
+                while (node && node != root && !node.next_sibling())
+                    node = node.parent();
+                node = (node && node != root) ? node.next_sibling() : pugi::xml_node();
+            }
+        }
+    } // namespace
+
+    std::string BookmarkIndex::key(const absl::string_view name)
+    {
+        return absl::AsciiStrToLower(name);
+    }
+
+    void BookmarkIndex::index_bookmark(const pugi::xml_node start) const
+    {
+        const int id = bookmark_id(start);
+        m_next_id = std::max(m_next_id, id + 1);
+
+        const absl::string_view name = start.attribute("w:name").value();
+        if (name.empty())
+            return;
+
+        BookmarkRange range;
+        range.name = std::string(name);
+        range.id = id;
+        range.start = start;
+        std::string name_key = key(name);
+        // 重名书签只保留第一个，与 Word 的解析行为一致
+        if (m_by_name.emplace(name_key, std::move(range)).second)
+            m_key_by_id[id] = std::move(name_key);
+    }
+
+    void BookmarkIndex::refresh() const
+    {
+        if (!m_journal || m_journal->generation() == m_generation)
+            return;
+
+        // 文档在索引之外被修改过，节点可能已释放，重新扫描全部根节点
+        m_by_name.clear();
+        m_key_by_id.clear();
+        m_references.clear();
+        for (const pugi::xml_node root: m_roots)
+            index_root(root);
+        m_generation = m_journal->generation();
+    }
+
+    void BookmarkIndex::sync()
+    {
+        // 自身的修改经过日志钩子，同样会推进代数
+        if (m_journal)
+            m_generation = m_journal->generation();
+    }
+
+    void BookmarkIndex::add(const pugi::xml_node root)
+    {
+        refresh();
+        m_roots.push_back(root);
+        index_root(root);
+        sync();
+    }
+
+    void BookmarkIndex::index_root(const pugi::xml_node root) const
+    {
+        // 复杂域可嵌套：begin 入栈，separate/end 时域代码完整
+        struct OpenField
+        {
+            std::string instr;
+            pugi::xml_node run;
+            bool done = false;
+        };
+        std::vector<OpenField> open_fields;
+
+        const auto finish = [this](OpenField& field) {
+            if (field.done)
+                return;
+            field.done = true;
+            FieldReference ref;
+            if (parse_instruction(field.instr, ref))
+            {
+                ref.node = field.run;
+                m_references.push_back(std::move(ref));
+            }
+        };
+
+        walk(root, [&](const pugi::xml_node node) {
+            const char* name = node.name();
+            if (std::strcmp(name, "w:bookmarkStart") == 0)
+            {
+                index_bookmark(node);
+            }
+            else if (std::strcmp(name, "w:bookmarkEnd") == 0)
+            {
+                const auto found = m_key_by_id.find(bookmark_id(node));
+                if (found != m_key_by_id.end())
+                {
+                    BookmarkRange& range = m_by_name[found->second];
+                    if (!range.end)
+                        range.end = node;
+                }
+            }
+            else if (std::strcmp(name, "w:fldSimple") == 0)
+            {
+                FieldReference ref;
+                if (parse_instruction(node.attribute("w:instr").value(), ref))
+                {
+                    ref.node = node;
+                    m_references.push_back(std::move(ref));
+                }
+            }
+            else if (std::strcmp(name, "w:hyperlink") == 0)
+            {
+                const absl::string_view anchor = node.attribute("w:anchor").value();
+                if (!anchor.empty())
+                {
+                    FieldReference ref;
+                    ref.kind = FieldKind::HYPERLINK;
+                    ref.target = std::string(anchor);
+                    ref.node = node;
+                    m_references.push_back(std::move(ref));
+                }
+            }
+            else if (std::strcmp(name, "w:fldChar") == 0)
+            {
+                const absl::string_view type = node.attribute("w:fldCharType").value();
+                if (type == "begin")
+                {
+                    open_fields.emplace_back();
+                    open_fields.back().run = node.parent();
+                }
+                else if (!open_fields.empty() && (type == "separate" || type == "end"))
+                {
+                    finish(open_fields.back());
+                    if (type == "end")
+                        open_fields.pop_back();
+                }
+            }
+            else if (std::strcmp(name, "w:instrText") == 0 && !open_fields.empty() && !open_fields.back().done)
+            {
+                open_fields.back().instr += node.text().get();
+            }
+        });
+
+        // 缺少 end 的域在部件结尾处视为结束
+        for (OpenField& field: open_fields)
+            finish(field);
+    }
+
+    const BookmarkRange* BookmarkIndex::find(const absl::string_view name) const
+    {
+        refresh();
+        const auto found = m_by_name.find(key(name));
+        return found == m_by_name.end() ? nullptr : &found->second;
+    }
+
+    const BookmarkRange* BookmarkIndex::find_by_id(const int id) const
+    {
+        refresh();
+        const auto found = m_key_by_id.find(id);
+        return found == m_key_by_id.end() ? nullptr : &m_by_name.find(found->second)->second;
+    }
+
+    std::vector<const FieldReference*> BookmarkIndex::unresolved_references() const
+    {
+        refresh();
+        std::vector<const FieldReference*> unresolved;
+        for (const FieldReference& ref: m_references)
+        {
+            if (!find(ref.target))
+                unresolved.push_back(&ref);
+        }
+        return unresolved;
+    }
+
+    void BookmarkIndex::clear()
+    {
+        m_by_name.clear();
+        m_key_by_id.clear();
+        m_references.clear();
+        m_roots.clear();
+        m_next_id = 0;
+        sync();
+    }
+
+    const BookmarkRange& BookmarkIndex::add_bookmark(pugi::xml_node paragraph, const absl::string_view name)
+    {
+        if (name.empty())
+            throw std::invalid_argument("Bookmark name must not be empty");
+        refresh();
+        std::string name_key = key(name);
+        if (m_by_name.contains(name_key))
+            throw std::invalid_argument(absl::StrCat("Bookmark already exists: ", name));
+
+        const int id = m_next_id++;
+        MutationJournal::before_change(m_journal, paragraph);
+        const pugi::xml_node props = paragraph.child("w:pPr");
+        pugi::xml_node start =
+            props ? paragraph.insert_child_after("w:bookmarkStart", props) : paragraph.prepend_child("w:bookmarkStart");
+        numeric::write_int(start.append_attribute("w:id"), id);
+        start.append_attribute("w:name").set_value(std::string(name).c_str());
+        pugi::xml_node end = paragraph.append_child("w:bookmarkEnd");
+        numeric::write_int(end.append_attribute("w:id"), id);
+
+        BookmarkRange& range = m_by_name[name_key];
+        range.name = std::string(name);
+        range.id = id;
+        range.start = start;
+        range.end = end;
+        m_key_by_id[id] = std::move(name_key);
+        sync();
+        return range;
+    }
+
+    bool BookmarkIndex::remove_bookmark(const absl::string_view name)
+    {
+        refresh();
+        const auto found = m_by_name.find(key(name));
+        if (found == m_by_name.end())
+            return false;
+
+        BookmarkRange& range = found->second;
+        MutationJournal::before_change(m_journal, range.start);
+        range.start.parent().remove_child(range.start);
+        if (range.end)
+        {
+            MutationJournal::before_change(m_journal, range.end);
+            range.end.parent().remove_child(range.end);
+        }
+        m_key_by_id.erase(range.id);
+        m_by_name.erase(found);
+        sync();
+        return true;
+    }
+
+    const FieldReference& BookmarkIndex::add_reference(pugi::xml_node paragraph, const FieldKind kind,
+                                                       const absl::string_view bookmark,
+                                                       const absl::string_view display_text)
+    {
+        refresh();
+        FieldReference ref;
+        ref.kind = kind;
+        ref.target = std::string(bookmark);
+        MutationJournal::before_change(m_journal, paragraph);
+
+        if (kind == FieldKind::HYPERLINK)
+        {
+            ref.node = paragraph.append_child("w:hyperlink");
+            ref.node.append_attribute("w:anchor").set_value(ref.target.c_str());
+        }
+        else
+        {
+            ref.node = paragraph.append_child("w:fldSimple");
+            ref.node.append_attribute("w:instr").set_value(
+                absl::StrCat(" ", kind == FieldKind::REF ? "REF " : "PAGEREF ", bookmark, " \\h ").c_str());
+        }
+        pugi::xml_node text = ref.node.append_child("w:r").append_child("w:t");
+        text.text().set(std::string(display_text).c_str());
+
+        m_references.push_back(std::move(ref));
+        sync();
+        return m_references.back();
+    }
+
+    void BookmarkIndex::remove(const pugi::xml_node node)
+    {
+        pugi::xml_node parent = node.parent();
+        if (!parent)
+            return;
+        refresh();
+        MutationJournal::before_remove(m_journal, node);
+
+        absl::flat_hash_set<pugi::xml_node_struct*> inside;
+        std::vector<pugi::xml_node> markers;
+        walk(node, [&](const pugi::xml_node child) {
+            inside.insert(child.internal_object());
+            if (std::strcmp(child.name(), "w:bookmarkStart") == 0 || std::strcmp(child.name(), "w:bookmarkEnd") == 0)
+                markers.push_back(child);
+        });
+
+        for (const pugi::xml_node marker: markers)
+        {
+            const auto found = m_key_by_id.find(bookmark_id(marker));
+            if (found == m_key_by_id.end())
+                continue;
+            const auto range = m_by_name.find(found->second);
+            if (range->second.start == marker)
+            {
+                if (range->second.end && !inside.contains(range->second.end.internal_object()))
+                {
+                    MutationJournal::before_change(m_journal, range->second.end);
+                    range->second.end.parent().remove_child(range->second.end);
+                }
+                m_by_name.erase(range);
+                m_key_by_id.erase(found);
+            }
+            else if (range->second.end == marker && !inside.contains(range->second.start.internal_object()))
+            {
+                range->second.end = parent.insert_move_before(marker, node);
+                MutationJournal::after_insert(m_journal, range->second.end);
+            }
+        }
+
+        m_references.erase(std::remove_if(m_references.begin(), m_references.end(),
+                                          [&inside](const FieldReference& ref) {
+                                              return inside.contains(ref.node.internal_object());
+                                          }),
+                           m_references.end());
+        parent.remove_child(node);
+        sync();
+    }
+} // namespace duckx
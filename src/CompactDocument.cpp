@@ -0,0 +1,761 @@
+/*!
+ * @file CompactDocument.cpp
+ * @brief Implementation of the compact read-only document representation
+ */
+#include "CompactDocument.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+#include "PropertyDecoder.hpp"
+#include "ZipArchive.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        // 与 atoms 枚举一一对应
+        const char* const kWellKnownAtoms[atoms::COUNT] = {
+            "",
+            "w:document", "w:body", "w:p", "w:r", "w:t", "w:tbl", "w:tr", "w:tc",
+            "w:pPr", "w:jc", "w:spacing", "w:ind", "w:numPr", "w:ilvl", "w:numId", "w:pStyle",
+            "w:rPr", "w:b", "w:i", "w:u", "w:strike", "w:smallCaps", "w:shadow", "w:vertAlign",
+            "w:rFonts", "w:sz", "w:color", "w:highlight", "w:rStyle",
+            "w:val", "w:line", "w:before", "w:after", "w:left", "w:right", "w:firstLine", "w:hanging", "w:ascii",
+        };
+
+        /*! @brief Values up to this length are shared in the arena */
+        constexpr std::size_t kMaxSharedValue = 15;
+
+        bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        bool ends_name(const char c)
+        {
+            return is_space(c) || c == '/' || c == '>' || c == '=';
+        }
+
+        void append_utf8(std::string& out, unsigned long code)
+        {
+            if (code < 0x80)
+            {
+                out += static_cast<char>(code);
+            }
+            else if (code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        /*! @brief Decode an entity starting at '&'; returns false to keep it verbatim */
+        bool decode_entity(const absl::string_view entity, std::string& out)
+        {
+            if (entity == "lt") out += '<';
+            else if (entity == "gt") out += '>';
+            else if (entity == "amp") out += '&';
+            else if (entity == "apos") out += '\'';
+            else if (entity == "quot") out += '"';
+            else if (entity.size() > 1 && entity[0] == '#')
+            {
+                const bool hex = entity[1] == 'x';
+                const absl::string_view digits = entity.substr(hex ? 2 : 1);
+                if (digits.empty()) return false;
+
+                unsigned long code = 0;
+                for (const char c: digits)
+                {
+                    unsigned digit;
+                    if (c >= '0' && c <= '9') digit = static_cast<unsigned>(c - '0');
+                    else if (hex && c >= 'a' && c <= 'f') digit = static_cast<unsigned>(c - 'a' + 10);
+                    else if (hex && c >= 'A' && c <= 'F') digit = static_cast<unsigned>(c - 'A' + 10);
+                    else return false;
+                    code = code * (hex ? 16 : 10) + digit;
+                    if (code > 0x10FFFF) return false;
+                }
+                append_utf8(out, code);
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        /*!
+         * @brief Append XML character data with entities decoded and line ends normalised
+         * @param attribute Also turn whitespace into spaces, as attribute values are normalised
+         */
+        void decode(const char* begin, const char* const end, const bool attribute, std::string& out)
+        {
+            while (begin != end)
+            {
+                const char c = *begin;
+                if (c == '&')
+                {
+                    const char* semicolon = static_cast<const char*>(std::memchr(begin, ';', end - begin));
+                    if (semicolon && decode_entity(absl::string_view(begin + 1, semicolon - begin - 1), out))
+                    {
+                        begin = semicolon + 1;
+                        continue;
+                    }
+                    out += c;
+                }
+                else if (c == '\r')
+                {
+                    out += attribute ? ' ' : '\n';
+                    if (begin + 1 != end && begin[1] == '\n') ++begin;
+                }
+                else
+                {
+                    out += attribute && is_space(c) ? ' ' : c;
+                }
+                ++begin;
+            }
+        }
+
+        /*! @brief Accessor over compact nodes for the shared property decoders */
+        struct CompactNodeAccess
+        {
+            using Node = CompactNode;
+
+            static properties::Tag tag(const CompactNode& node)
+            {
+                using properties::Tag;
+                switch (node.atom())
+                {
+                    case atoms::W_B: return Tag::BOLD;
+                    case atoms::W_I: return Tag::ITALIC;
+                    case atoms::W_U: return Tag::UNDERLINE;
+                    case atoms::W_STRIKE: return Tag::STRIKE;
+                    case atoms::W_SMALLCAPS: return Tag::SMALL_CAPS;
+                    case atoms::W_SHADOW: return Tag::SHADOW;
+                    case atoms::W_VERTALIGN: return Tag::VERT_ALIGN;
+                    case atoms::W_RFONTS: return Tag::FONTS;
+                    case atoms::W_SZ: return Tag::SIZE;
+                    case atoms::W_COLOR: return Tag::COLOR;
+                    case atoms::W_HIGHLIGHT: return Tag::HIGHLIGHT;
+                    case atoms::W_RSTYLE: return Tag::RUN_STYLE;
+                    case atoms::W_JC: return Tag::JC;
+                    case atoms::W_SPACING: return Tag::SPACING;
+                    case atoms::W_IND: return Tag::IND;
+                    case atoms::W_NUMPR: return Tag::NUM_PR;
+                    case atoms::W_ILVL: return Tag::ILVL;
+                    case atoms::W_NUMID: return Tag::NUM_ID;
+                    case atoms::W_PSTYLE: return Tag::PARAGRAPH_STYLE;
+                    default: return Tag::OTHER;
+                }
+            }
+
+            static const char* attribute(const CompactNode& node, const properties::Attr attr)
+            {
+                static const Atom kAtoms[] = {
+                    atoms::W_VAL, atoms::W_ASCII, atoms::W_LINE, atoms::W_BEFORE, atoms::W_AFTER,
+                    atoms::W_LEFT, atoms::W_RIGHT, atoms::W_FIRSTLINE, atoms::W_HANGING,
+                };
+                return node.attribute(kAtoms[static_cast<unsigned>(attr)]);
+            }
+
+            static CompactNode child(const CompactNode& node, const properties::Tag tag)
+            {
+                // 只有 numPr 的子节点按标签查找
+                return node.child(tag == properties::Tag::ILVL ? atoms::W_ILVL : atoms::W_NUMID);
+            }
+        };
+    } // namespace
+
+    constexpr Atom CompactRun::kAtom;
+    constexpr Atom CompactParagraph::kAtom;
+    constexpr Atom CompactTableCell::kAtom;
+    constexpr Atom CompactTableRow::kAtom;
+    constexpr Atom CompactTable::kAtom;
+    constexpr std::uint32_t CompactDocument::kNull;
+
+    // ============================================================================
+    // Builder
+    // ============================================================================
+
+    /*! @brief Single-pass parser filling the arrays of a CompactDocument */
+    class CompactDocument::Builder
+    {
+    public:
+        Builder(CompactDocument& doc, const absl::string_view xml)
+            : m_doc(doc), m_pos(xml.data()), m_end(xml.data() + xml.size()) {}
+
+        void run()
+        {
+            while (m_pos != m_end)
+            {
+                if (*m_pos == '<')
+                    parse_markup();
+                else
+                    parse_text();
+            }
+            if (!m_open.empty())
+                fail("unexpected end of document");
+            if (m_doc.m_nodes.empty())
+                fail("no document element");
+        }
+
+    private:
+        struct OpenElement
+        {
+            std::uint32_t index;
+            std::uint32_t last_child;
+        };
+
+        [[noreturn]] void fail(const char* what) const
+        {
+            throw std::runtime_error(std::string("Failed to parse XML: ") + what);
+        }
+
+        bool starts_with(const char* prefix) const
+        {
+            const std::size_t length = std::strlen(prefix);
+            return static_cast<std::size_t>(m_end - m_pos) >= length && std::memcmp(m_pos, prefix, length) == 0;
+        }
+
+        /*! @brief Move past the next occurrence of @p terminator */
+        void skip_past(const char* terminator)
+        {
+            const std::size_t length = std::strlen(terminator);
+            for (; m_end - m_pos >= static_cast<std::ptrdiff_t>(length); ++m_pos)
+            {
+                if (std::memcmp(m_pos, terminator, length) == 0)
+                {
+                    m_pos += length;
+                    return;
+                }
+            }
+            fail("unterminated markup");
+        }
+
+        void skip_space()
+        {
+            while (m_pos != m_end && is_space(*m_pos)) ++m_pos;
+        }
+
+        absl::string_view read_name()
+        {
+            const char* begin = m_pos;
+            while (m_pos != m_end && !ends_name(*m_pos)) ++m_pos;
+            if (m_pos == begin) fail("missing name");
+            return absl::string_view(begin, m_pos - begin);
+        }
+
+        void expect(const char c)
+        {
+            if (m_pos == m_end || *m_pos != c) fail("unexpected character");
+            ++m_pos;
+        }
+
+        void parse_markup()
+        {
+            if (starts_with("<?"))
+            {
+                skip_past("?>");
+            }
+            else if (starts_with("<!--"))
+            {
+                skip_past("-->");
+            }
+            else if (starts_with("<![CDATA["))
+            {
+                m_pos += 9;
+                const char* begin = m_pos;
+                skip_past("]]>");
+                // CDATA is kept even when it is only whitespace
+                if (!m_open.empty()) decode_cdata(begin, m_pos - 3);
+            }
+            else if (starts_with("<!"))
+            {
+                skip_doctype();
+            }
+            else if (starts_with("</"))
+            {
+                m_pos += 2;
+                const absl::string_view name = read_name();
+                skip_space();
+                expect('>');
+                if (m_open.empty() || m_doc.m_atom_names[m_doc.m_nodes[m_open.back().index].name] != name)
+                    fail("mismatched end tag");
+                close_element();
+            }
+            else
+            {
+                ++m_pos;
+                parse_start_tag();
+            }
+        }
+
+        void skip_doctype()
+        {
+            int depth = 0;
+            for (; m_pos != m_end; ++m_pos)
+            {
+                if (*m_pos == '[') ++depth;
+                else if (*m_pos == ']') --depth;
+                else if (*m_pos == '>' && depth <= 0)
+                {
+                    ++m_pos;
+                    return;
+                }
+            }
+            fail("unterminated DOCTYPE");
+        }
+
+        void parse_start_tag()
+        {
+            open_element(intern(read_name()));
+            for (;;)
+            {
+                skip_space();
+                if (m_pos == m_end) fail("unterminated start tag");
+                if (*m_pos == '/')
+                {
+                    ++m_pos;
+                    expect('>');
+                    close_element();
+                    return;
+                }
+                if (*m_pos == '>')
+                {
+                    ++m_pos;
+                    return;
+                }
+
+                Attribute attribute;
+                attribute.name = intern(read_name());
+                skip_space();
+                expect('=');
+                skip_space();
+                if (m_pos == m_end || (*m_pos != '"' && *m_pos != '\'')) fail("unquoted attribute value");
+                const char quote = *m_pos++;
+                const char* begin = m_pos;
+                const char* end = static_cast<const char*>(std::memchr(m_pos, quote, m_end - m_pos));
+                if (!end) fail("unterminated attribute value");
+                m_pos = end + 1;
+
+                m_scratch.clear();
+                decode(begin, end, true, m_scratch);
+                attribute.value = store(m_scratch);
+                m_doc.m_attributes.push_back(attribute);
+            }
+        }
+
+        void parse_text()
+        {
+            const char* begin = m_pos;
+            const char* end = static_cast<const char*>(std::memchr(m_pos, '<', m_end - m_pos));
+            m_pos = end ? end : m_end;
+            if (m_open.empty()) return;
+
+            // Whitespace-only character data is dropped, as by pugixml's default options
+            const char* first = begin;
+            while (first != m_pos && is_space(*first)) ++first;
+            if (first == m_pos) return;
+
+            decode(begin, m_pos, false, text_of_top());
+        }
+
+        void decode_cdata(const char* begin, const char* const end)
+        {
+            std::string& text = text_of_top();
+            for (; begin != end; ++begin)
+            {
+                if (*begin == '\r')
+                {
+                    text += '\n';
+                    if (begin + 1 != end && begin[1] == '\n') ++begin;
+                }
+                else
+                {
+                    text += *begin;
+                }
+            }
+        }
+
+        std::string& text_of_top()
+        {
+            return m_text[m_open.size() - 1];
+        }
+
+        void open_element(const Atom name)
+        {
+            if (m_doc.m_nodes.size() >= kNull || m_doc.m_attributes.size() >= kNull)
+                throw std::length_error("CompactDocument supports at most 2^32 - 1 nodes and attributes");
+
+            const auto index = static_cast<std::uint32_t>(m_doc.m_nodes.size());
+            Node node;
+            node.name = name;
+            node.parent = m_open.empty() ? kNull : m_open.back().index;
+            node.first_child = kNull;
+            node.next_sibling = kNull;
+            node.first_attribute = static_cast<std::uint32_t>(m_doc.m_attributes.size());
+            node.text = 0;
+            m_doc.m_nodes.push_back(node);
+
+            if (!m_open.empty())
+            {
+                OpenElement& parent = m_open.back();
+                if (parent.last_child == kNull)
+                    m_doc.m_nodes[parent.index].first_child = index;
+                else
+                    m_doc.m_nodes[parent.last_child].next_sibling = index;
+                parent.last_child = index;
+            }
+            else if (m_last_root != kNull)
+            {
+                m_doc.m_nodes[m_last_root].next_sibling = index;
+            }
+            if (m_open.empty()) m_last_root = index;
+
+            m_open.push_back({index, kNull});
+            if (m_text.size() < m_open.size()) m_text.emplace_back();
+        }
+
+        void close_element()
+        {
+            std::string& text = text_of_top();
+            if (!text.empty())
+            {
+                m_doc.m_nodes[m_open.back().index].text = store(text);
+                text.clear();
+            }
+            m_open.pop_back();
+        }
+
+        Atom intern(const absl::string_view name)
+        {
+            const auto found = m_doc.m_atom_index.find(name);
+            if (found != m_doc.m_atom_index.end()) return found->second;
+
+            const auto atom = static_cast<Atom>(m_doc.m_atom_names.size());
+            m_doc.m_atom_names.emplace_back(name);
+            m_doc.m_atom_index.emplace(std::string(name), atom);
+            return atom;
+        }
+
+        /*! @brief Copy a string into the arena, sharing short values */
+        std::uint32_t store(const std::string& value)
+        {
+            if (value.empty()) return 0;
+
+            const bool shared = value.size() <= kMaxSharedValue;
+            if (shared)
+            {
+                const auto found = m_values.find(value);
+                if (found != m_values.end()) return found->second;
+            }
+
+            std::string& arena = m_doc.m_arena;
+            if (arena.size() + value.size() + 1 > kNull)
+                throw std::length_error("CompactDocument text arena exceeds 4 GB");
+            const auto offset = static_cast<std::uint32_t>(arena.size());
+            arena.append(value.data(), value.size());
+            arena += '\0';
+            if (shared) m_values.emplace(value, offset);
+            return offset;
+        }
+
+        CompactDocument& m_doc;
+        const char* m_pos;
+        const char* const m_end;
+        std::vector<OpenElement> m_open;
+        std::vector<std::string> m_text; //!< Character data of each open element, reused across elements
+        std::uint32_t m_last_root = kNull;
+        std::string m_scratch;
+        absl::flat_hash_map<std::string, std::uint32_t> m_values;
+    };
+
+    // ============================================================================
+    // CompactDocument
+    // ============================================================================
+
+    CompactDocument::CompactDocument()
+        : m_arena(1, '\0')
+    {
+        m_atom_names.reserve(atoms::COUNT);
+        for (Atom atom = 0; atom < atoms::COUNT; ++atom)
+        {
+            m_atom_names.emplace_back(kWellKnownAtoms[atom]);
+            m_atom_index.emplace(m_atom_names.back(), atom);
+        }
+    }
+
+    CompactDocument CompactDocument::open(const std::string& path)
+    {
+        ZipReader zip;
+        if (!zip.open(path))
+        {
+            throw std::runtime_error("Failed to open DOCX package: " + path);
+        }
+        const ZipEntryInfo* entry = zip.find("word/document.xml");
+        std::string xml;
+        if (!entry || !zip.read(*entry, xml))
+        {
+            throw std::runtime_error("Failed to read word/document.xml");
+        }
+        zip.close();
+        return parse(xml);
+    }
+
+    CompactDocument CompactDocument::parse(const absl::string_view xml)
+    {
+        CompactDocument doc;
+        // 典型 WordprocessingML 约每 40 字节一个元素，预留后避免反复扩容
+        doc.m_nodes.reserve(xml.size() / 40);
+        doc.m_attributes.reserve(xml.size() / 40);
+
+        Builder(doc, xml).run();
+
+        doc.m_nodes.shrink_to_fit();
+        doc.m_attributes.shrink_to_fit();
+        doc.m_arena.shrink_to_fit();
+        return doc;
+    }
+
+    CompactNode CompactDocument::root() const
+    {
+        return m_nodes.empty() ? CompactNode() : CompactNode(this, 0);
+    }
+
+    CompactBody CompactDocument::body() const
+    {
+        const CompactNode document = root();
+        if (!document || document.atom() != atoms::W_DOCUMENT) return CompactBody();
+        return CompactBody(document.child(atoms::W_BODY));
+    }
+
+    Atom CompactDocument::find_atom(const absl::string_view name) const
+    {
+        const auto found = m_atom_index.find(name);
+        return found != m_atom_index.end() ? found->second : atoms::NONE;
+    }
+
+    const char* CompactDocument::atom_name(const Atom atom) const
+    {
+        return atom < m_atom_names.size() ? m_atom_names[atom].c_str() : "";
+    }
+
+    std::size_t CompactDocument::memory_usage() const
+    {
+        std::size_t bytes = m_nodes.capacity() * sizeof(Node) + m_attributes.capacity() * sizeof(Attribute) +
+                            m_arena.capacity() + m_atom_names.capacity() * sizeof(std::string) +
+                            m_atom_index.capacity() * (sizeof(std::pair<const std::string, Atom>) + 1);
+        for (const std::string& name: m_atom_names)
+            bytes += name.capacity() * 2; // the name and its index key
+        return bytes;
+    }
+
+    // ============================================================================
+    // CompactNode
+    // ============================================================================
+
+    Atom CompactNode::atom() const
+    {
+        return m_doc ? m_doc->m_nodes[m_index].name : atoms::NONE;
+    }
+
+    const char* CompactNode::name() const
+    {
+        return m_doc ? m_doc->m_atom_names[m_doc->m_nodes[m_index].name].c_str() : "";
+    }
+
+    const char* CompactNode::text() const
+    {
+        return m_doc ? m_doc->m_arena.data() + m_doc->m_nodes[m_index].text : "";
+    }
+
+    CompactNode CompactNode::parent() const
+    {
+        if (!m_doc) return {};
+        const std::uint32_t index = m_doc->m_nodes[m_index].parent;
+        return index == CompactDocument::kNull ? CompactNode() : CompactNode(m_doc, index);
+    }
+
+    CompactNode CompactNode::first_child() const
+    {
+        if (!m_doc) return {};
+        const std::uint32_t index = m_doc->m_nodes[m_index].first_child;
+        return index == CompactDocument::kNull ? CompactNode() : CompactNode(m_doc, index);
+    }
+
+    CompactNode CompactNode::next_sibling() const
+    {
+        if (!m_doc) return {};
+        const std::uint32_t index = m_doc->m_nodes[m_index].next_sibling;
+        return index == CompactDocument::kNull ? CompactNode() : CompactNode(m_doc, index);
+    }
+
+    CompactNode CompactNode::child(const Atom name) const
+    {
+        if (!m_doc) return {};
+        const auto& nodes = m_doc->m_nodes;
+        for (std::uint32_t index = nodes[m_index].first_child; index != CompactDocument::kNull;
+             index = nodes[index].next_sibling)
+        {
+            if (nodes[index].name == name) return {m_doc, index};
+        }
+        return {};
+    }
+
+    CompactNode CompactNode::next_sibling(const Atom name) const
+    {
+        if (!m_doc) return {};
+        const auto& nodes = m_doc->m_nodes;
+        for (std::uint32_t index = nodes[m_index].next_sibling; index != CompactDocument::kNull;
+             index = nodes[index].next_sibling)
+        {
+            if (nodes[index].name == name) return {m_doc, index};
+        }
+        return {};
+    }
+
+    const char* CompactNode::attribute(const Atom name) const
+    {
+        if (!m_doc) return nullptr;
+        const auto& nodes = m_doc->m_nodes;
+        const auto& attributes = m_doc->m_attributes;
+        const std::uint32_t end = m_index + 1 < nodes.size() ? nodes[m_index + 1].first_attribute
+                                                             : static_cast<std::uint32_t>(attributes.size());
+        for (std::uint32_t index = nodes[m_index].first_attribute; index != end; ++index)
+        {
+            if (attributes[index].name == name) return m_doc->m_arena.data() + attributes[index].value;
+        }
+        return nullptr;
+    }
+
+    const char* CompactNode::attribute(const absl::string_view name) const
+    {
+        if (!m_doc) return nullptr;
+        const Atom atom = m_doc->find_atom(name);
+        return atom == atoms::NONE ? nullptr : attribute(atom);
+    }
+
+    // ============================================================================
+    // Views
+    // ============================================================================
+
+    std::string CompactRun::get_text() const
+    {
+        return m_node.child(atoms::W_T).text();
+    }
+
+    RunProperties CompactRun::properties() const
+    {
+        return properties::decode_run<CompactNodeAccess>(m_node.child(atoms::W_RPR));
+    }
+
+    formatting_flag CompactRun::get_formatting() const
+    {
+        return properties().formatting;
+    }
+
+    bool CompactRun::is_bold() const
+    {
+        return (properties().formatting & bold) != 0;
+    }
+
+    bool CompactRun::is_italic() const
+    {
+        return (properties().formatting & italic) != 0;
+    }
+
+    bool CompactRun::is_underline() const
+    {
+        return (properties().formatting & underline) != 0;
+    }
+
+    bool CompactRun::get_font(std::string& font_name) const
+    {
+        const RunProperties props = properties();
+        if (!props.has_font) return false;
+
+        font_name = props.font;
+        return true;
+    }
+
+    bool CompactRun::get_font_size(double& size) const
+    {
+        const RunProperties props = properties();
+        if (!props.has_font_size) return false;
+
+        size = props.font_size;
+        return true;
+    }
+
+    bool CompactRun::get_color(std::string& color) const
+    {
+        const RunProperties props = properties();
+        if (!props.has_color) return false;
+
+        color = props.color;
+        return true;
+    }
+
+    CompactRange<CompactRun> CompactParagraph::runs() const
+    {
+        return CompactRange<CompactRun>(m_node.child(atoms::W_R));
+    }
+
+    ParagraphProperties CompactParagraph::properties() const
+    {
+        return properties::decode_paragraph<CompactNodeAccess>(m_node.child(atoms::W_PPR));
+    }
+
+    Alignment CompactParagraph::get_alignment() const
+    {
+        return properties().alignment;
+    }
+
+    std::string CompactParagraph::get_text() const
+    {
+        std::string text;
+        for (const CompactRun& run: runs())
+            text += run.get_node().child(atoms::W_T).text();
+        return text;
+    }
+
+    CompactRange<CompactParagraph> CompactTableCell::paragraphs() const
+    {
+        return CompactRange<CompactParagraph>(m_node.child(atoms::W_P));
+    }
+
+    CompactRange<CompactTableCell> CompactTableRow::cells() const
+    {
+        return CompactRange<CompactTableCell>(m_node.child(atoms::W_TC));
+    }
+
+    CompactRange<CompactTableRow> CompactTable::rows() const
+    {
+        return CompactRange<CompactTableRow>(m_node.child(atoms::W_TR));
+    }
+
+    CompactRange<CompactParagraph> CompactBody::paragraphs() const
+    {
+        return CompactRange<CompactParagraph>(m_node.child(atoms::W_P));
+    }
+
+    CompactRange<CompactTable> CompactBody::tables() const
+    {
+        return CompactRange<CompactTable>(m_node.child(atoms::W_TBL));
+    }
+} // namespace duckx
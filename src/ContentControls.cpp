@@ -0,0 +1,376 @@
+/*!
+ * @file ContentControls.cpp
+ * @brief Implementation of the content control index and form filling
+ */
+#include "ContentControls.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "DocxFile.hpp"
+#include "MutationJournal.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        struct xml_string_writer : pugi::xml_writer
+        {
+            std::string result;
+            void write(const void* data, size_t size) override
+            {
+                result.append(static_cast<const char*>(data), size);
+            }
+        };
+
+        absl::string_view local_name(const absl::string_view name)
+        {
+            const size_t colon = name.find(':');
+            return colon == absl::string_view::npos ? name : name.substr(colon + 1);
+        }
+
+        // root 子树内按文档顺序的下一个节点，走出子树时返回空节点
+        pugi::xml_node next_in_subtree(pugi::xml_node node, const pugi::xml_node root)
+        {
+            if (node.first_child())
+                return node.first_child();
+            while (node && node != root && !node.next_sibling())
+                node = node.parent();
+            return (node && node != root) ? node.next_sibling() : pugi::xml_node();
+        }
+
+        // 深度优先查找 root 下第一个指定名称的元素，只访问到命中为止
+        pugi::xml_node first_descendant(const pugi::xml_node root, const char* name)
+        {
+            for (pugi::xml_node node = next_in_subtree(root, root); node; node = next_in_subtree(node, root))
+            {
+                if (std::strcmp(node.name(), name) == 0)
+                    return node;
+            }
+            return pugi::xml_node();
+        }
+
+        void append_text(pugi::xml_node run, const absl::string_view text)
+        {
+            size_t begin = 0;
+            for (size_t i = 0; i <= text.size(); ++i)
+            {
+                if (i < text.size() && text[i] != '\n' && text[i] != '\t')
+                    continue;
+
+                if (i > begin)
+                {
+                    const std::string segment(text.substr(begin, i - begin));
+                    pugi::xml_node t = run.append_child("w:t");
+                    if (segment.front() == ' ' || segment.back() == ' ')
+                        t.append_attribute("xml:space").set_value("preserve");
+                    t.text().set(segment.c_str());
+                }
+                if (i < text.size())
+                    run.append_child(text[i] == '\n' ? "w:br" : "w:tab");
+                begin = i + 1;
+            }
+        }
+    } // namespace
+
+    void ContentControlIndex::add(const pugi::xml_node root)
+    {
+        pugi::xml_node node = root;
+        while (node)
+        {
+            if (std::strcmp(node.name(), "w:sdt") == 0)
+            {
+                const pugi::xml_node sdt_pr = node.child("w:sdtPr");
+                const absl::string_view tag = sdt_pr.child("w:tag").attribute("w:val").value();
+                const absl::string_view alias = sdt_pr.child("w:alias").attribute("w:val").value();
+                if (!tag.empty())
+                    m_by_key[tag].push_back(node);
+                if (!alias.empty() && alias != tag)
+                    m_by_key[alias].push_back(node);
+
+                const pugi::xml_node_struct* enclosing = nullptr;
+                for (pugi::xml_node ancestor = node.parent(); ancestor; ancestor = ancestor.parent())
+                {
+                    if (std::strcmp(ancestor.name(), "w:sdt") == 0)
+                    {
+                        enclosing = ancestor.internal_object();
+                        m_with_nested.insert(enclosing);
+                        break;
+                    }
+                }
+                m_enclosing[node.internal_object()] = enclosing;
+            }
+            node = next_in_subtree(node, root);
+        }
+    }
+
+    const std::vector<pugi::xml_node>& ContentControlIndex::find(const absl::string_view key) const
+    {
+        static const std::vector<pugi::xml_node> kNone;
+        const auto found = m_by_key.find(key);
+        return found == m_by_key.end() ? kNone : found->second;
+    }
+
+    bool ContentControlIndex::contains(const pugi::xml_node sdt) const
+    {
+        return m_enclosing.contains(sdt.internal_object());
+    }
+
+    void ContentControlIndex::prune(const pugi::xml_node sdt)
+    {
+        if (!m_with_nested.contains(sdt.internal_object()))
+            return;
+
+        // 子树中仍然存在的控件；已删除节点只比较指针，不解引用
+        absl::flat_hash_set<const pugi::xml_node_struct*> live;
+        for (pugi::xml_node node = next_in_subtree(sdt, sdt); node; node = next_in_subtree(node, sdt))
+        {
+            if (std::strcmp(node.name(), "w:sdt") == 0)
+                live.insert(node.internal_object());
+        }
+
+        absl::flat_hash_set<const pugi::xml_node_struct*> removed;
+        for (const auto& entry: m_enclosing)
+        {
+            if (live.contains(entry.first))
+                continue;
+            for (const pugi::xml_node_struct* outer = entry.second; outer;)
+            {
+                if (outer == sdt.internal_object())
+                {
+                    removed.insert(entry.first);
+                    break;
+                }
+                const auto next = m_enclosing.find(outer);
+                outer = next == m_enclosing.end() ? nullptr : next->second;
+            }
+        }
+        if (removed.empty())
+            return;
+
+        for (const pugi::xml_node_struct* node: removed)
+        {
+            m_enclosing.erase(node);
+            m_with_nested.erase(node);
+        }
+        for (auto& entry: m_by_key)
+        {
+            auto& nodes = entry.second;
+            nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+                                       [&removed](const pugi::xml_node node) {
+                                           return removed.contains(node.internal_object());
+                                       }),
+                        nodes.end());
+        }
+        m_with_nested.erase(sdt.internal_object());
+        for (const auto& entry: m_enclosing)
+        {
+            if (entry.second == sdt.internal_object())
+            {
+                m_with_nested.insert(sdt.internal_object());
+                break;
+            }
+        }
+    }
+
+    void ContentControlIndex::clear()
+    {
+        m_by_key.clear();
+        m_enclosing.clear();
+        m_with_nested.clear();
+    }
+
+    void set_content_control_text(pugi::xml_node sdt, const absl::string_view text, MutationJournal* journal)
+    {
+        MutationJournal::before_change(journal, sdt);
+        pugi::xml_node sdt_pr = sdt.child("w:sdtPr");
+        sdt_pr.remove_child("w:showingPlcHdr");
+
+        pugi::xml_node content = sdt.child("w:sdtContent");
+        if (!content)
+            content = sdt.append_child("w:sdtContent");
+
+        // 行内控件直接包含 w:r；块级/单元格级控件填充第一个段落
+        pugi::xml_node container = content;
+        const bool inline_control = std::strcmp(sdt.parent().name(), "w:p") == 0 || !content.child("w:r").empty();
+        if (!inline_control)
+        {
+            container = first_descendant(content, "w:p");
+            if (!container)
+            {
+                container = content.append_child("w:p");
+            }
+            else if (container.parent() == content)
+            {
+                for (pugi::xml_node p = container.next_sibling("w:p"); p;)
+                {
+                    const pugi::xml_node next = p.next_sibling("w:p");
+                    content.remove_child(p);
+                    p = next;
+                }
+            }
+        }
+
+        pugi::xml_node run = container.child("w:r");
+        if (!run)
+        {
+            run = container.append_child("w:r");
+            const pugi::xml_node mark_props = container.child("w:pPr").child("w:rPr");
+            if (mark_props)
+                run.append_copy(mark_props);
+        }
+        for (pugi::xml_node extra = run.next_sibling("w:r"); extra;)
+        {
+            const pugi::xml_node next = extra.next_sibling("w:r");
+            container.remove_child(extra);
+            extra = next;
+        }
+
+        for (pugi::xml_node child = run.first_child(); child;)
+        {
+            const pugi::xml_node next = child.next_sibling();
+            if (std::strcmp(child.name(), "w:rPr") != 0)
+                run.remove_child(child);
+            child = next;
+        }
+
+        pugi::xml_node run_props = run.child("w:rPr");
+        const pugi::xml_node style = run_props.child("w:rStyle");
+        if (style && std::strcmp(style.attribute("w:val").value(), "PlaceholderText") == 0)
+            run_props.remove_child(style);
+
+        append_text(run, text);
+    }
+
+    bool get_content_control_binding(const pugi::xml_node sdt, ContentControlBinding& binding)
+    {
+        const pugi::xml_node data_binding = sdt.child("w:sdtPr").child("w:dataBinding");
+        if (!data_binding)
+            return false;
+
+        binding.store_item_id = data_binding.attribute("w:storeItemID").value();
+        binding.xpath = data_binding.attribute("w:xpath").value();
+        return !binding.store_item_id.empty() && !binding.xpath.empty();
+    }
+
+    bool set_custom_xml_value(pugi::xml_document& data, const absl::string_view xpath, const absl::string_view value)
+    {
+        if (!absl::StartsWith(xpath, "/"))
+            return false;
+
+        pugi::xml_node node = data;
+        const std::vector<absl::string_view> steps = absl::StrSplit(xpath.substr(1), '/');
+        for (size_t i = 0; i < steps.size(); ++i)
+        {
+            absl::string_view step = steps[i];
+
+            if (absl::StartsWith(step, "@"))
+            {
+                if (i + 1 != steps.size())
+                    return false;
+                const absl::string_view name = local_name(step.substr(1));
+                for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute())
+                {
+                    if (local_name(attr.name()) == name)
+                        return attr.set_value(std::string(value).c_str());
+                }
+                return node.append_attribute(std::string(step.substr(1)).c_str()).set_value(std::string(value).c_str());
+            }
+
+            // name[n]：只支持 Word 生成的位置谓词
+            int position = 1;
+            const size_t bracket = step.find('[');
+            if (bracket != absl::string_view::npos)
+            {
+                if (step.back() != ']' ||
+                    !absl::SimpleAtoi(step.substr(bracket + 1, step.size() - bracket - 2), &position) || position < 1)
+                    return false;
+                step = step.substr(0, bracket);
+            }
+
+            const absl::string_view name = local_name(step);
+            pugi::xml_node match;
+            for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+            {
+                if (child.type() == pugi::node_element && local_name(child.name()) == name && --position == 0)
+                {
+                    match = child;
+                    break;
+                }
+            }
+            if (!match)
+                return false;
+            node = match;
+        }
+
+        if (node == data)
+            return false;
+        while (node.first_child())
+            node.remove_child(node.first_child());
+        return node.text().set(std::string(value).c_str());
+    }
+
+    std::size_t update_custom_xml_parts(DocxFile& file,
+                                        const std::vector<std::pair<ContentControlBinding, std::string>>& values)
+    {
+        if (values.empty())
+            return 0;
+
+        // 按数据项 ID（GUID，大小写不敏感）分组，每个部件只解析、写回一次
+        std::map<std::string, std::vector<const std::pair<ContentControlBinding, std::string>*>> by_item;
+        for (const auto& value: values)
+        {
+            by_item[absl::AsciiStrToUpper(value.first.store_item_id)].push_back(&value);
+        }
+
+        std::size_t stored = 0;
+        const std::string props_prefix = "customXml/itemProps";
+        for (const auto& name: file.entry_names())
+        {
+            if (!absl::StartsWith(name, props_prefix) || !absl::EndsWith(name, ".xml"))
+                continue;
+
+            pugi::xml_document props;
+            if (!props.load_string(file.read_entry(name).c_str()))
+                continue;
+
+            std::string item_id;
+            for (const pugi::xml_attribute attr: props.document_element().attributes())
+            {
+                if (local_name(attr.name()) == "itemID")
+                    item_id = absl::AsciiStrToUpper(attr.value());
+            }
+            const auto targets = by_item.find(item_id);
+            if (targets == by_item.end())
+                continue;
+
+            const std::string item_name = "customXml/item" + name.substr(props_prefix.size());
+            if (!file.has_entry(item_name))
+                continue;
+
+            pugi::xml_document data;
+            if (!data.load_string(file.read_entry(item_name).c_str()))
+                continue;
+
+            std::size_t changed = 0;
+            for (const auto* target: targets->second)
+            {
+                if (set_custom_xml_value(data, target->first.xpath, target->second))
+                    ++changed;
+            }
+            if (changed > 0)
+            {
+                xml_string_writer writer;
+                data.print(writer, "", pugi::format_raw);
+                file.write_entry(item_name, writer.result);
+                stored += changed;
+            }
+        }
+        return stored;
+    }
+} // namespace duckx
@@ -10,13 +10,20 @@
 #include "XmlStyleParser.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
 #include "StyleManager.hpp"
 #include "OutlineManager.hpp"
 #include "PageLayoutManager.hpp"
+#include "NumericCodec.hpp"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/match.h"
 
 namespace duckx
 {
@@ -31,8 +38,142 @@ namespace duckx
         }
     };
 
+    namespace
+    {
+        /*!
+         * @brief Background saves of one document
+         *
+         * Jobs run one after another in call order inside a single executor
+         * task, so no task ever blocks waiting for an earlier save.
+         */
+        class SaveQueue : public std::enable_shared_from_this<SaveQueue>
+        {
+        public:
+            std::shared_future<Result<void>> push(Executor& executor, std::function<Result<void>()> write)
+            {
+                Job job;
+                job.write = std::move(write);
+                std::shared_future<Result<void>> result = job.done.get_future().share();
+
+                bool start = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_jobs.push_back(std::move(job));
+                    start = !m_draining;
+                    m_draining = true;
+                }
+                if (start) {
+                    try {
+                        const std::shared_ptr<SaveQueue> self = shared_from_this();
+                        executor.submit([self]() { self->drain(); });
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_jobs.pop_back();
+                        m_draining = false;
+                        throw;
+                    }
+                }
+                return result;
+            }
+
+        private:
+            struct Job
+            {
+                std::function<Result<void>()> write;
+                std::promise<Result<void>> done;
+            };
+
+            void drain()
+            {
+                for (;;) {
+                    Job job;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (m_jobs.empty()) {
+                            m_draining = false;
+                            return;
+                        }
+                        job = std::move(m_jobs.front());
+                        m_jobs.pop_front();
+                    }
+                    job.done.set_value(job.write());
+                }
+            }
+
+            std::mutex m_mutex;
+            std::deque<Job> m_jobs;
+            bool m_draining = false;
+        };
+    } // namespace
+
+    /*!
+     * @brief Everything a Document owns, allocated once and never moved
+     *
+     * The managers and the mutation journal keep pointers to the XML trees
+     * and to m_handle, so moving a Document only hands over this object.
+     */
+    class Document::Impl
+    {
+    public:
+        Impl(std::unique_ptr<DocxFile> file, const OpenOptions& options)
+            : m_file(std::move(file)), m_options(options), m_handle(this)
+        {
+            // 文档根节点的地址在重新解析后不变，构造时登记一次即可
+            m_journal.watch(m_document_xml, DocumentPart::MAIN_DOCUMENT);
+            m_journal.watch(m_rels_xml, DocumentPart::RELATIONSHIPS);
+            m_journal.watch(m_content_types_xml, DocumentPart::CONTENT_TYPES);
+        }
+
+        Impl(const Impl&) = delete;
+        Impl& operator=(const Impl&) = delete;
+
+        std::unique_ptr<DocxFile> m_file;
+        MutationJournal m_journal; //!< Watches the parts below; handed to Body and the managers
+        pugi::xml_document m_document_xml;
+        pugi::xml_document m_rels_xml;          //!< Loaded by ensure_relationships()
+        pugi::xml_document m_content_types_xml; //!< Loaded by ensure_content_types()
+
+        Body m_body;
+        // Managers are created on first access
+        std::unique_ptr<MediaManager> m_media_manager;
+        std::unique_ptr<HeaderFooterManager> m_hf_manager;
+        std::unique_ptr<HyperlinkManager> m_link_manager;
+        std::unique_ptr<StyleManager> m_style_manager;
+        std::unique_ptr<OutlineManager> m_outline_manager;
+        std::unique_ptr<PageLayoutManager> m_page_layout_manager;
+        std::unique_ptr<NumberingManager> m_numbering_manager;
+        int m_rid_counter = 1;
+        std::uint32_t m_next_spliced_id = 0; //!< Next id for spliced drawings and bookmarks; 0 until the first splice
+
+        OpenOptions m_options;
+        bool m_rels_loaded = false;
+        bool m_content_types_loaded = false;
+
+        unsigned m_dirty_parts = 0;          //!< DocumentPart bits flagged by mark_dirty() since the last save
+        std::size_t m_written_styles_hash = 0; //!< Hash of the last styles.xml written, 0 if none
+        std::shared_future<Result<void>> m_pending_save; //!< Last background save, if any
+        std::shared_ptr<SaveQueue> m_save_queue;         //!< Created by the first save_async()
+        std::shared_ptr<Executor> m_executor;            //!< Null to use default_executor()
+
+        unsigned m_journal_dirty_parts = 0;         //!< m_dirty_parts when the transaction began
+
+        /*!
+         * @brief Non-owning Document over this state, handed to the managers
+         *
+         * Its deleter does not own the state, so destroying it (last, as the
+         * last member) never deletes this object.
+         */
+        Document m_handle;
+    };
+
     // Modern Result<T> API implementations
-    Result<Document> Document::open_safe(const std::string& path)
+    Result<Document> Document::open_safe(const std::string& path, const OpenOptions& options)
+    {
+        return open_safe(path, options, OperationOptions());
+    }
+
+    Result<Document> Document::open_safe(const std::string& path, const OpenOptions& options,
+                                         const OperationOptions& operation)
     {
         if (path.empty()) {
             return Result<Document>(errors::invalid_argument("path", "Path cannot be empty", 
@@ -45,7 +186,10 @@ namespace duckx
                 return Result<Document>(errors::file_not_found(path, 
                     ErrorContext{__FILE__, __FUNCTION__, __LINE__}));
             }
-            return Result<Document>(Document(std::move(file)));
+            return Result<Document>(Document(std::move(file), options, &operation));
+        } catch (const OperationCancelled&) {
+            return Result<Document>(errors::operation_cancelled("open",
+                ErrorContext{__FILE__, __FUNCTION__, __LINE__}.with_info("path", path)));
         } catch (const std::exception&) {
             return Result<Document>(errors::file_access_denied(path, 
                 ErrorContext{__FILE__, __FUNCTION__, __LINE__}));
@@ -72,28 +216,77 @@ namespace duckx
         }
     }
 
+    Result<Document> Document::fork_safe(const std::string& path) const
+    {
+        if (path.empty()) {
+            return Result<Document>(errors::invalid_argument("path", "Path cannot be empty",
+                ErrorContext{__FILE__, __FUNCTION__, __LINE__}));
+        }
+
+        try {
+            return Result<Document>(fork(path));
+        } catch (const std::exception& e) {
+            ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+            errorContext.with_info("operation", "fork");
+            errorContext.with_info("error", e.what());
+            return Result<Document>(errors::file_access_denied(path, errorContext));
+        }
+    }
+
     Result<void> Document::save_safe() const
     {
+        return save_safe(OperationOptions());
+    }
+
+    Result<void> Document::save_safe(const OperationOptions& operation) const
+    {
+        if (m_impl->m_options.read_only) {
+            return Result<void>(errors::validation_failed("read_only", "Document was opened read-only",
+                DUCKX_ERROR_CONTEXT()));
+        }
+
         try {
-            save();
+            save_package(&operation);
             return Result<void>();
+        } catch (const OperationCancelled&) {
+            return Result<void>(errors::operation_cancelled("save", DUCKX_ERROR_CONTEXT()));
+        } catch (const std::exception& e) {
+            const std::string path = m_impl->m_file ? m_impl->m_file->m_path : std::string();
+            ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+            errorContext.with_info("operation", "save");
+            errorContext.with_info("error", e.what());
+            errorContext.with_document_path(path);
+            return Result<void>(errors::file_access_denied(path, errorContext));
+        }
+    }
+
+    Result<void> Document::save_safe(const SaveOptions& options) const
+    {
+        if (m_impl->m_options.read_only) {
+            return Result<void>(errors::validation_failed("read_only", "Document was opened read-only",
+                DUCKX_ERROR_CONTEXT()));
+        }
+
+        try {
+            prepare_save(options);
         } catch (const std::exception& e) {
             ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
             errorContext.with_info("operation", "save");
             errorContext.with_info("error", e.what());
-            return Result<void>(errors::file_access_denied("", errorContext));
+            return Result<void>(errors::xml_manipulation_failed("prepare_save", errorContext));
         }
+        return save_safe();
     }
 
     // Legacy exception-based API (preserved for backward compatibility)
-    Document Document::open(const std::string& path)
+    Document Document::open(const std::string& path, const OpenOptions& options)
     {
         auto file = std::make_unique<DocxFile>();
         if (!file->open(path))
         {
             throw std::runtime_error("Failed to open file: " + path);
         }
-        return Document(std::move(file));
+        return Document(std::move(file), options);
     }
 
     Document Document::create(const std::string& path)
@@ -106,48 +299,93 @@ namespace duckx
         return Document(std::move(file));
     }
 
-    Document::Document(std::unique_ptr<DocxFile> file)
-        : m_file(std::move(file))
+    Document Document::fork(const std::string& path) const
     {
-        load();
+        if (!m_impl->m_file)
+            throw std::runtime_error("Document has no package to fork");
+
+        // 未保存的修改先写入包，分叉文档从共享的压缩包按需加载其余部件
+        settle_pending_save(true);
+        serialize_parts();
+
+        OpenOptions options = m_impl->m_options;
+        options.read_only = false;
+        Document variant(m_impl->m_file->fork(path), m_impl->m_document_xml, options);
+        variant.m_impl->m_executor = m_impl->m_executor;
+        return variant;
     }
 
-    void Document::load()
+    Document::Document(std::unique_ptr<DocxFile> file, const OpenOptions& options,
+                       const OperationOptions* operation)
+        : m_impl(new Impl(std::move(file), options), ImplDeleter{})
     {
-        if (!m_file)
+        load(operation);
+    }
+
+    Document::Document(std::unique_ptr<DocxFile> file, const pugi::xml_document& document_xml,
+                       const OpenOptions& options)
+        : m_impl(new Impl(std::move(file), options), ImplDeleter{})
+    {
+        // 复制已解析的主文档树，免去解压与解析
+        m_impl->m_document_xml.reset(document_xml);
+        m_impl->m_body = Body(m_impl->m_document_xml.child("w:document").child("w:body"), &m_impl->m_journal);
+    }
+
+    void Document::load(const OperationOptions* operation)
+    {
+        if (!m_impl->m_file)
             return;
 
-        const std::string xml_content = m_file->read_entry("word/document.xml");
-        if (!m_document_xml.load_string(xml_content.c_str()))
+        const std::string xml_content = operation
+                                            ? m_impl->m_file->read_entry("word/document.xml", *operation)
+                                            : m_impl->m_file->read_entry("word/document.xml");
+        if (!m_impl->m_document_xml.load_string(xml_content.c_str()))
         {
             throw std::runtime_error("Failed to parse word/document.xml");
         }
+        // 解析无法分段，完成后再检查一次
+        if (operation && operation->cancellation.is_cancelled())
+            throw OperationCancelled();
 
-        pugi::xml_node bodyNode = m_document_xml.child("w:document").child("w:body");
+        pugi::xml_node bodyNode = m_impl->m_document_xml.child("w:document").child("w:body");
         if (!bodyNode)
         {
             // 如果 body 节点不存在，创建一个
-            pugi::xml_node docNode = m_document_xml.child("w:document");
+            pugi::xml_node docNode = m_impl->m_document_xml.child("w:document");
             if (!docNode)
             {
-                docNode = m_document_xml.append_child("w:document");
+                docNode = m_impl->m_document_xml.append_child("w:document");
             }
             bodyNode = docNode.append_child("w:body");
+            mark_dirty(DocumentPart::MAIN_DOCUMENT);
+        }
+
+        m_impl->m_body = Body(bodyNode, &m_impl->m_journal);
+
+        // rels、[Content_Types].xml 与各管理器在首次使用时才解析/创建
+        if (!m_impl->m_file->has_entry("[Content_Types].xml"))
+        {
+            throw std::runtime_error("[Content_Types].xml is missing.");
         }
+    }
 
-        m_body = Body(bodyNode);
+    void Document::ensure_relationships() const
+    {
+        if (m_impl->m_rels_loaded)
+            return;
+        m_impl->m_rels_loaded = true;
 
-        if (m_file->has_entry("word/_rels/document.xml.rels"))
+        if (m_impl->m_file->has_entry("word/_rels/document.xml.rels"))
         {
-            m_rels_xml.load_string(m_file->read_entry("word/_rels/document.xml.rels").c_str());
+            m_impl->m_rels_xml.load_string(m_impl->m_file->read_entry("word/_rels/document.xml.rels").c_str());
         }
         else
         {
-            m_rels_xml.load_string(DocxFile::get_document_rels_xml().c_str());
+            m_impl->m_rels_xml.load_string(DocxFile::get_document_rels_xml().c_str());
         }
 
         int max_rid = 0;
-        const pugi::xml_node relationships = m_rels_xml.child("Relationships");
+        const pugi::xml_node relationships = m_impl->m_rels_xml.child("Relationships");
         if (relationships)
         {
             for (pugi::xml_node rel = relationships.child("Relationship"); rel; rel = rel.next_sibling("Relationship"))
@@ -155,184 +393,710 @@ namespace duckx
                 pugi::xml_attribute id_attr = rel.attribute("Id");
                 if (id_attr)
                 {
-                    std::string id_str = id_attr.as_string();
-                    if (id_str.rfind("rId", 0) == 0)
+                    const absl::string_view id_str = id_attr.value();
+                    unsigned long long current_id = 0;
+                    // Only ids of the form "rId<digits>" take part in numbering
+                    if (absl::StartsWith(id_str, "rId") && numeric::parse_uint(id_str.substr(3), current_id) &&
+                        current_id <= static_cast<unsigned long long>(std::numeric_limits<int>::max() - 1))
                     {
-                        // Check if it starts with "rId"
-                        std::string num_part = id_str.substr(3);
-                        if (!num_part.empty() && std::all_of(num_part.begin(), num_part.end(), ::isdigit))
-                        {
-                            try
-                            {
-                                int current_id = std::stoi(num_part);
-                                max_rid = std::max(max_rid, current_id);
-                            }
-                            catch (const std::out_of_range& e)
-                            {
-                                std::cerr << "Out of range error while parsing rId: " << e.what() << std::endl;
-                            }
-                        }
+                        max_rid = std::max(max_rid, static_cast<int>(current_id));
                     }
                 }
             }
         }
-        m_rid_counter = max_rid + 1;
+        m_impl->m_rid_counter = max_rid + 1;
+    }
 
-        if (m_file->has_entry("[Content_Types].xml"))
-        {
-            m_content_types_xml.load_string(m_file->read_entry("[Content_Types].xml").c_str());
+    void Document::ensure_content_types() const
+    {
+        if (m_impl->m_content_types_loaded)
+            return;
+        m_impl->m_content_types_loaded = true;
+
+        m_impl->m_content_types_xml.load_string(m_impl->m_file->read_entry("[Content_Types].xml").c_str());
+    }
+
+    StyleManager& Document::style_manager() const
+    {
+        if (!m_impl->m_style_manager)
+            m_impl->m_style_manager = std::make_unique<StyleManager>();
+        return *m_impl->m_style_manager;
+    }
+
+    HeaderFooterManager& Document::header_footer_manager() const
+    {
+        if (!m_impl->m_hf_manager) {
+            ensure_relationships();
+            ensure_content_types();
+            m_impl->m_hf_manager = std::make_unique<HeaderFooterManager>(&m_impl->m_handle, m_impl->m_file.get(),
+                                                                         &m_impl->m_document_xml, &m_impl->m_rels_xml,
+                                                                         &m_impl->m_content_types_xml);
         }
+        return *m_impl->m_hf_manager;
+    }
+
+    void Document::save() const
+    {
+        save_package(nullptr);
+    }
+
+    void Document::save(const SaveOptions& options) const
+    {
+        if (m_impl->m_file && m_impl->m_options.read_only)
+            throw std::runtime_error("Document was opened read-only: " + m_impl->m_file->m_path);
+        prepare_save(options);
+        save_package(nullptr);
+    }
+
+    void Document::prepare_save(const SaveOptions& options) const
+    {
+        if (options.update_fields)
+            update_fields();
+        if (options.collect_garbage) {
+            const GarbageCollectionReport report = collect_garbage();
+            if (options.on_garbage_collected)
+                options.on_garbage_collected(report);
+        }
+    }
+
+    void Document::save_package(const OperationOptions* operation) const
+    {
+        if (!m_impl->m_file)
+            return;
+        if (m_impl->m_options.read_only)
+            throw std::runtime_error("Document was opened read-only: " + m_impl->m_file->m_path);
+
+        settle_pending_save(true);
+        if (operation && operation->cancellation.is_cancelled())
+            throw OperationCancelled();
+        // 序列化结果留在包的待写条目中，取消后下次保存照常写出
+        serialize_parts();
+        if (operation)
+            m_impl->m_file->save(*operation);
         else
+            m_impl->m_file->save();
+    }
+
+    std::shared_future<Result<void>> Document::save_async(const SaveOptions& options) const
+    {
+        if (!m_impl->m_file)
         {
-            throw std::runtime_error("[Content_Types].xml is missing.");
+            std::promise<Result<void>> done;
+            done.set_value(Result<void>());
+            return done.get_future().share();
         }
 
-        m_media_manager =
-                std::make_unique<MediaManager>(this, m_file.get(), &m_rels_xml, &m_document_xml, &m_content_types_xml);
+        settle_pending_save(false);
 
-        m_hf_manager =
-                std::make_unique<HeaderFooterManager>(this, m_file.get(), &m_document_xml, &m_rels_xml,
-                                                      &m_content_types_xml);
+        if (!m_impl->m_save_queue)
+            m_impl->m_save_queue = std::make_shared<SaveQueue>();
+        const auto on_complete = options.on_complete;
+        // 提前失败同样经由执行器回调，on_complete 始终在后台任务中按调用顺序触发；
+        // 失败结果不记入 m_pending_save，之后的保存不受影响
+        const auto fail = [this, &on_complete](Result<void> failure) {
+            return m_impl->m_save_queue->push(*executor(), [failure, on_complete]() {
+                if (on_complete)
+                    on_complete(failure);
+                return failure;
+            });
+        };
 
-        m_link_manager = std::make_unique<HyperlinkManager>(this, &m_rels_xml);
+        const std::string& path = m_impl->m_file->m_path;
+        if (m_impl->m_options.read_only) {
+            ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+            errorContext.with_info("operation", "save_async");
+            errorContext.with_document_path(path);
+            return fail(Result<void>(errors::validation_failed("read_only", "Document was opened read-only",
+                                                               errorContext)));
+        }
 
-        // Initialize style manager
-        m_style_manager = std::make_unique<StyleManager>();
-        
-        // Initialize outline manager
-        m_outline_manager = std::make_unique<OutlineManager>(this, m_style_manager.get());
-        
-        // Initialize page layout manager
-        m_page_layout_manager = std::make_unique<PageLayoutManager>(this, &m_document_xml);
+        // 在调用线程上序列化所有部件并拍下快照，压缩与写盘交给后台线程
+        DocxSaveSnapshot snapshot;
+        const char* stage = "update_fields";
+        try {
+            if (options.update_fields)
+                update_fields();
+            stage = "collect_garbage";
+            if (options.collect_garbage) {
+                const GarbageCollectionReport report = collect_garbage();
+                if (options.on_garbage_collected)
+                    options.on_garbage_collected(report);
+            }
+            stage = "serialize_parts";
+            serialize_parts();
+            stage = "snapshot";
+            snapshot = m_impl->m_file->snapshot();
+        } catch (const std::exception& e) {
+            ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+            errorContext.with_info("operation", "save_async");
+            errorContext.with_info("stage", stage);
+            errorContext.with_info("error", e.what());
+            errorContext.with_document_path(path);
+            // 快照阶段的失败来自文件路径，其余阶段均为 XML 处理失败
+            const bool file_stage = std::strcmp(stage, "snapshot") == 0;
+            return fail(Result<void>(file_stage ? errors::file_access_denied(path, errorContext)
+                                                : errors::xml_manipulation_failed(stage, errorContext)));
+        }
+
+        const std::shared_future<Result<void>> previous = m_impl->m_pending_save;
+        m_impl->m_pending_save = m_impl->m_save_queue->push(*executor(),
+            [snapshot = std::move(snapshot), previous, on_complete]() {
+                // 队列按调用顺序执行，此时前一次保存已完成；前一次失败时本次快照不完整，同样视为失败
+                Result<void> result;
+                if (previous.valid() && !previous.get().ok()) {
+                    ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+                    errorContext.with_info("operation", "save_async");
+                    errorContext.with_info("error", "previous background save failed");
+                    result = Result<void>(errors::file_access_denied(snapshot.path, errorContext)
+                        .caused_by(previous.get().error()));
+                    if (on_complete)
+                        on_complete(result);
+                    return result;
+                }
+
+                try {
+                    DocxFile::write_snapshot(snapshot);
+                } catch (const std::exception& e) {
+                    ErrorContext errorContext{__FILE__, __FUNCTION__, __LINE__};
+                    errorContext.with_info("operation", "save_async");
+                    errorContext.with_info("error", e.what());
+                    result = Result<void>(errors::file_access_denied(snapshot.path, errorContext));
+                }
+
+                if (on_complete)
+                    on_complete(result);
+                return result;
+            });
+
+        return m_impl->m_pending_save;
     }
 
-    void Document::save() const
+    void Document::set_executor(std::shared_ptr<Executor> executor)
+    {
+        m_impl->m_executor = executor;
+        if (m_impl->m_file)
+            m_impl->m_file->set_executor(std::move(executor));
+    }
+
+    std::shared_ptr<Executor> Document::executor() const
+    {
+        return m_impl->m_executor ? m_impl->m_executor : default_executor();
+    }
+
+    void Document::set_deterministic(const bool enabled, const std::time_t timestamp)
+    {
+        if (m_impl->m_file)
+            m_impl->m_file->set_deterministic(enabled, timestamp);
+    }
+
+    void Document::set_incremental_save(const bool enabled, const double compaction_threshold)
+    {
+        if (m_impl->m_file)
+            m_impl->m_file->set_incremental(enabled, compaction_threshold);
+    }
+
+    std::string Document::content_hash() const
+    {
+        if (!m_impl->m_file)
+            return std::string();
+
+        serialize_parts();
+        return m_impl->m_file->content_hash();
+    }
+
+    GarbageCollectionReport Document::collect_garbage() const
+    {
+        if (!m_impl->m_file)
+            return GarbageCollectionReport();
+
+        serialize_parts();
+        const GarbageCollectionReport report = collect_package_garbage(*m_impl->m_file);
+
+        // 回收可能改写了 rels 与 [Content_Types].xml，同步内存中的副本
+        if (report.relationships_removed > 0 && m_impl->m_rels_loaded)
+            m_impl->m_rels_xml.load_string(m_impl->m_file->read_entry("word/_rels/document.xml.rels").c_str());
+        if (report.overrides_removed > 0 && m_impl->m_content_types_loaded)
+            m_impl->m_content_types_xml.load_string(m_impl->m_file->read_entry("[Content_Types].xml").c_str());
+        return report;
+    }
+
+    FormattingTable Document::extract_formatting_table() const
+    {
+        FormattingTable table;
+        extract_formatting_table(table);
+        return table;
+    }
+
+    void Document::extract_formatting_table(FormattingTable& table) const
+    {
+        table.clear();
+        table.extract(m_impl->m_document_xml.child("w:document").child("w:body"));
+    }
+
+    namespace
     {
-        if (!m_file)
+        bool is_spliced_id_holder(const char* name, const char*& id_attribute)
+        {
+            if (std::strcmp(name, "wp:docPr") == 0) {
+                id_attribute = "id";
+                return true;
+            }
+            if (std::strcmp(name, "w:bookmarkStart") == 0 || std::strcmp(name, "w:bookmarkEnd") == 0) {
+                id_attribute = "w:id";
+                return true;
+            }
+            return false;
+        }
+
+        /*!
+         * @brief Rewrite placeholder rIds and renumber drawing and bookmark ids of a spliced block
+         * @param renumbered Fragment id -> new id, shared by the blocks of one splice so that
+         *        a bookmark starting in one block and ending in another keeps one id
+         */
+        void rewrite_fragment_ids(const pugi::xml_node root,
+                                  const absl::flat_hash_map<std::string, std::string>& ids,
+                                  absl::flat_hash_map<long long, std::uint32_t>& renumbered,
+                                  std::uint32_t& next_id)
+        {
+            pugi::xml_node node = root;
+            while (node) {
+                if (!ids.empty()) {
+                    for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute()) {
+                        const char* name = attr.name();
+                        if (name[0] != 'r' || name[1] != ':')
+                            continue;
+                        const auto found = ids.find(absl::string_view(attr.value()));
+                        if (found != ids.end())
+                            attr.set_value(found->second.c_str());
+                    }
+                }
+
+                const char* id_attribute = nullptr;
+                if (is_spliced_id_holder(node.name(), id_attribute)) {
+                    pugi::xml_attribute id = node.attribute(id_attribute);
+                    long long old_id = 0;
+                    if (id && numeric::parse_int(id.value(), old_id)) {
+                        auto inserted = renumbered.emplace(old_id, next_id);
+                        if (inserted.second) {
+                            if (next_id == static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+                                throw std::length_error("Spliced drawing and bookmark ids exhausted");
+                            ++next_id;
+                        }
+                        numeric::write_int(id, inserted.first->second);
+                    }
+                }
+
+                if (node.first_child()) {
+                    node = node.first_child();
+                    continue;
+                }
+                while (node != root && !node.next_sibling())
+                    node = node.parent();
+                node = node == root ? pugi::xml_node() : node.next_sibling();
+            }
+        }
+
+        // 已有的拼接 ID 中最大值之后的第一个 ID；文档自身的编号都在 kFirstReservedId 之下
+        std::uint32_t first_free_spliced_id(const pugi::xml_node body)
+        {
+            long long next = DocumentFragment::kFirstReservedId;
+            for (pugi::xml_node node = body.first_child(); node;) {
+                const char* id_attribute = nullptr;
+                long long id = 0;
+                if (is_spliced_id_holder(node.name(), id_attribute) &&
+                    numeric::parse_int(node.attribute(id_attribute).value(), id) && id >= next)
+                    next = id + 1;
+
+                if (node.first_child()) {
+                    node = node.first_child();
+                    continue;
+                }
+                while (node != body && !node.next_sibling())
+                    node = node.parent();
+                node = node == body ? pugi::xml_node() : node.next_sibling();
+            }
+            return static_cast<std::uint32_t>(std::min<long long>(next, std::numeric_limits<int>::max()));
+        }
+    } // namespace
+
+    void Document::splice(const DocumentFragment& fragment)
+    {
+        absl::flat_hash_map<std::string, std::string> ids;
+        for (const FragmentRelationship& relationship: fragment.relationships()) {
+            ids[relationship.id] = relationship.image
+                                       ? media().add_image_part(relationship.content, relationship.extension)
+                                       : links().add_relationship(relationship.target);
+        }
+
+        pugi::xml_node body = m_impl->m_body.get_body_node();
+        pugi::xml_node sect_pr = body.last_child();
+        if (std::strcmp(sect_pr.name(), "w:sectPr") != 0)
+            sect_pr = pugi::xml_node();
+
+        // 片段的 ID 只在片段内唯一：按本文档的计数器重新编号，重复拼接或片段区间复用都不会冲突
+        MutationJournal::before_counter_change(&m_impl->m_journal, m_impl->m_next_spliced_id);
+        if (m_impl->m_next_spliced_id == 0)
+            m_impl->m_next_spliced_id = first_free_spliced_id(body);
+        absl::flat_hash_map<long long, std::uint32_t> renumbered;
+
+        for (pugi::xml_node block = fragment.body().get_body_node().first_child(); block;
+             block = block.next_sibling()) {
+            const pugi::xml_node copy = sect_pr ? body.insert_copy_before(block, sect_pr) : body.append_copy(block);
+            MutationJournal::after_insert(&m_impl->m_journal, copy);
+            rewrite_fragment_ids(copy, ids, renumbered, m_impl->m_next_spliced_id);
+        }
+        mark_dirty(DocumentPart::MAIN_DOCUMENT);
+    }
+
+    void Document::settle_pending_save(const bool wait) const
+    {
+        if (!m_impl->m_pending_save.valid())
+            return;
+        if (!wait && m_impl->m_pending_save.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
             return;
 
-        m_hf_manager->save_all();
+        // 后台保存失败时其快照中的修改尚未落盘，下次保存需重新写出
+        if (!m_impl->m_pending_save.get().ok())
+            m_impl->m_file->mark_all_modified();
+        m_impl->m_pending_save = std::shared_future<Result<void>>();
+    }
 
-        xml_string_writer writer;
-        m_document_xml.print(writer, "  ", pugi::format_default);
+    void Document::serialize_parts() const
+    {
+        if (m_impl->m_hf_manager)
+            m_impl->m_hf_manager->save_all();
+        if (m_impl->m_numbering_manager)
+            m_impl->m_numbering_manager->save();
 
-        m_file->write_entry("word/document.xml", writer.result);
+        // 只序列化被修改过的部件，其余部件保留原压缩数据
+        if (is_dirty(DocumentPart::MAIN_DOCUMENT)) {
+            xml_string_writer writer;
+            m_impl->m_document_xml.print(writer, "  ", pugi::format_default);
+            m_impl->m_file->write_entry("word/document.xml", writer.result);
+        }
 
         // Generate and save styles.xml if StyleManager has styles defined
-        if (m_style_manager && m_style_manager->style_count() > 0) {
-            auto styles_xml_result = m_style_manager->generate_styles_xml_safe();
+        if (m_impl->m_style_manager && m_impl->m_style_manager->style_count() > 0) {
+            // 样式通过 Style 指针直接修改，无法经由钩子追踪：重新生成后与上次写出的内容比较
+            auto styles_xml_result = m_impl->m_style_manager->generate_styles_xml_safe();
             if (styles_xml_result.ok()) {
-                m_file->write_entry("word/styles.xml", styles_xml_result.value());
+                const std::size_t hash = std::hash<std::string>()(styles_xml_result.value());
+                if (is_dirty(DocumentPart::STYLES) || hash != m_impl->m_written_styles_hash) {
+                    m_impl->m_file->write_entry("word/styles.xml", styles_xml_result.value());
+                    m_impl->m_written_styles_hash = hash;
+                }
             }
         }
 
-        xml_string_writer rels_writer;
-        m_rels_xml.print(rels_writer, "", pugi::format_raw);
-        m_file->write_entry("word/_rels/document.xml.rels", rels_writer.result);
+        if (is_dirty(DocumentPart::RELATIONSHIPS) && m_impl->m_rels_loaded) {
+            xml_string_writer rels_writer;
+            m_impl->m_rels_xml.print(rels_writer, "", pugi::format_raw);
+            m_impl->m_file->write_entry("word/_rels/document.xml.rels", rels_writer.result);
+        }
+
+        if (is_dirty(DocumentPart::CONTENT_TYPES) && m_impl->m_content_types_loaded) {
+            xml_string_writer content_types_writer;
+            m_impl->m_content_types_xml.print(content_types_writer, "", pugi::format_raw);
+            m_impl->m_file->write_entry("[Content_Types].xml", content_types_writer.result);
+        }
+
+        m_impl->m_dirty_parts = 0;
+        m_impl->m_journal.clear_modified();
+    }
+
+    void Document::mark_dirty(const DocumentPart part) const
+    {
+        m_impl->m_dirty_parts |= 1u << static_cast<unsigned>(part);
+    }
+
+    bool Document::is_dirty(const DocumentPart part) const
+    {
+        return (m_impl->m_dirty_parts & (1u << static_cast<unsigned>(part))) != 0 || m_impl->m_journal.modified(part);
+    }
+
+    void Document::begin_transaction()
+    {
+        if (in_transaction())
+            throw std::logic_error("A transaction is already open on this document");
+
+        // rels 与 content types 在事务开始前载入，事务中首次载入的内容不会被记录为修改
+        ensure_relationships();
+        ensure_content_types();
+        m_impl->m_journal.begin();
+        m_impl->m_journal_dirty_parts = m_impl->m_dirty_parts;
+    }
+
+    void Document::commit()
+    {
+        if (in_transaction())
+            m_impl->m_journal.commit();
+    }
+
+    void Document::rollback()
+    {
+        if (!in_transaction())
+            return;
 
-        xml_string_writer content_types_writer;
-        m_content_types_xml.print(content_types_writer, "", pugi::format_raw);
-        m_file->write_entry("[Content_Types].xml", content_types_writer.result);
+        // 撤销同样是修改，日志会把涉及的部件标记为已修改
+        m_impl->m_journal.rollback();
+        m_impl->m_dirty_parts = m_impl->m_journal_dirty_parts;
+        // 管理器由 XML 派生的状态随之恢复；页眉页脚按内容哈希判断是否回写
+        if (m_impl->m_numbering_manager && m_impl->m_journal.touched(DocumentPart::NUMBERING))
+            m_impl->m_numbering_manager->reload();
+        if (m_impl->m_hf_manager && m_impl->m_journal.touched(DocumentPart::RELATIONSHIPS))
+            m_impl->m_hf_manager->drop_unreferenced_parts();
+    }
 
-        m_file->save();
+    bool Document::in_transaction() const
+    {
+        return m_impl->m_journal.active();
+    }
+
+    const MutationJournal& Document::journal() const
+    {
+        return m_impl->m_journal;
+    }
+
+    MutationJournal& Document::journal()
+    {
+        return m_impl->m_journal;
     }
 
     Body& Document::body()
     {
-        return m_body;
+        return m_impl->m_body;
     }
 
     const Body& Document::body() const
     {
-        return m_body;
+        return m_impl->m_body;
     }
 
     MediaManager& Document::media() const
     {
-        return *m_media_manager;
+        if (!m_impl->m_media_manager) {
+            ensure_relationships();
+            ensure_content_types();
+            m_impl->m_media_manager = std::make_unique<MediaManager>(&m_impl->m_handle, m_impl->m_file.get(),
+                                                                     &m_impl->m_rels_xml, &m_impl->m_document_xml,
+                                                                     &m_impl->m_content_types_xml);
+        }
+        return *m_impl->m_media_manager;
     }
 
     HyperlinkManager& Document::links() const
     {
-        return *m_link_manager;
+        if (!m_impl->m_link_manager) {
+            ensure_relationships();
+            m_impl->m_link_manager = std::make_unique<HyperlinkManager>(&m_impl->m_handle, &m_impl->m_rels_xml);
+        }
+        return *m_impl->m_link_manager;
+    }
+
+    NumberingManager& Document::numbering() const
+    {
+        if (!m_impl->m_numbering_manager) {
+            ensure_relationships();
+            ensure_content_types();
+            m_impl->m_numbering_manager = std::make_unique<NumberingManager>(&m_impl->m_handle, m_impl->m_file.get(),
+                                                                             &m_impl->m_rels_xml,
+                                                                             &m_impl->m_content_types_xml);
+        }
+        return *m_impl->m_numbering_manager;
+    }
+
+    std::vector<ListLabel> Document::list_labels() const
+    {
+        return numbering().compute_labels(m_impl->m_document_xml.child("w:document").child("w:body"));
     }
 
     StyleManager& Document::styles() const
     {
-        return *m_style_manager;
+        return style_manager();
     }
 
     OutlineManager& Document::outline() const
     {
-        if (!m_outline_manager) {
-            // Try to reinitialize if it's null (defensive programming)
-            const_cast<Document*>(this)->m_outline_manager = std::make_unique<OutlineManager>(
-                const_cast<Document*>(this), m_style_manager.get());
+        if (!m_impl->m_outline_manager) {
+            m_impl->m_outline_manager = std::make_unique<OutlineManager>(&m_impl->m_handle, &style_manager());
         }
-        
-        return *m_outline_manager;
+        return *m_impl->m_outline_manager;
     }
 
     PageLayoutManager& Document::page_layout() const
     {
-        if (!m_page_layout_manager) {
-            throw std::runtime_error("PageLayoutManager not initialized. Call initialize_page_layout_structure_safe() first.");
+        if (!m_impl->m_page_layout_manager) {
+            m_impl->m_page_layout_manager = std::make_unique<PageLayoutManager>(&m_impl->m_handle, &m_impl->m_document_xml);
         }
-        return *m_page_layout_manager;
+        return *m_impl->m_page_layout_manager;
     }
 
     Result<PageLayoutManager*> Document::page_layout_safe() const
     {
-        if (!m_page_layout_manager) {
-            return Result<PageLayoutManager*>(
-                errors::validation_failed("page_layout", "PageLayoutManager not initialized. Call initialize_page_layout_structure_safe() first."));
-        }
-        return Result<PageLayoutManager*>(m_page_layout_manager.get());
+        return Result<PageLayoutManager*>(&page_layout());
     }
 
     std::string Document::get_next_relationship_id()
     {
-        return "rId" + std::to_string(m_rid_counter++);
+        // 新的关系 ID 总是伴随着对 rels 的修改
+        ensure_relationships();
+        mark_dirty(DocumentPart::RELATIONSHIPS);
+        MutationJournal::before_counter_change(&m_impl->m_journal, m_impl->m_rid_counter);
+        return "rId" + std::to_string(m_impl->m_rid_counter++);
     }
 
     unsigned int Document::get_unique_rid()
     {
-        return m_rid_counter++;
+        ensure_relationships();
+        MutationJournal::before_counter_change(&m_impl->m_journal, m_impl->m_rid_counter);
+        return m_impl->m_rid_counter++;
     }
 
     Header& Document::get_header(const HeaderFooterType type) const
     {
-        return m_hf_manager->get_header(type);
+        return header_footer_manager().get_header(type);
     }
 
     Footer& Document::get_footer(const HeaderFooterType type) const
     {
-        return m_hf_manager->get_footer(type);
+        return header_footer_manager().get_footer(type);
+    }
+
+    std::shared_ptr<const HeaderFooterTemplate> Document::header_template(const HeaderFooterType type) const
+    {
+        return header_footer_manager().header_template(type);
+    }
+
+    std::shared_ptr<const HeaderFooterTemplate> Document::footer_template(const HeaderFooterType type) const
+    {
+        return header_footer_manager().footer_template(type);
+    }
+
+    void Document::set_header_template(const HeaderFooterType type,
+                                       std::shared_ptr<const HeaderFooterTemplate> tmpl) const
+    {
+        header_footer_manager().set_header_template(type, std::move(tmpl));
+    }
+
+    void Document::set_footer_template(const HeaderFooterType type,
+                                       std::shared_ptr<const HeaderFooterTemplate> tmpl) const
+    {
+        header_footer_manager().set_footer_template(type, std::move(tmpl));
     }
     
+    BookmarkIndex Document::index_bookmarks() const
+    {
+        BookmarkIndex index(&m_impl->m_journal);
+        index.add(m_impl->m_document_xml.child("w:document").child("w:body"));
+        return index;
+    }
+
+    FieldEvaluationReport Document::update_fields(const FieldEvaluationOptions& options) const
+    {
+        const pugi::xml_node body = m_impl->m_document_xml.child("w:document").child("w:body");
+        FieldEvaluator evaluator(options);
+        evaluator.set_journal(&m_impl->m_journal);
+        evaluator.set_list_labels(numbering().compute_labels(body));
+
+        FieldEvaluationReport report = evaluator.evaluate(body);
+        if (report.fields_updated > 0)
+            mark_dirty(DocumentPart::MAIN_DOCUMENT);
+
+        // 页眉页脚按内容哈希判断是否回写
+        for (const pugi::xml_node root: header_footer_manager().load_all())
+        {
+            const FieldEvaluationReport part = evaluator.evaluate_page_part(root);
+            report.fields_updated += part.fields_updated;
+            report.unresolved_references += part.unresolved_references;
+        }
+        return report;
+    }
+
+    ContentControlIndex Document::index_content_controls() const
+    {
+        ContentControlIndex index;
+        index.add(m_impl->m_document_xml.child("w:document").child("w:body"));
+        for (const pugi::xml_node root: header_footer_manager().load_all())
+        {
+            index.add(root);
+        }
+        return index;
+    }
+
+    std::size_t Document::bind_content_controls(const std::map<std::string, std::string>& values)
+    {
+        ContentControlIndex index = index_content_controls();
+        return bind_content_controls(index, values);
+    }
+
+    std::size_t Document::bind_content_controls(ContentControlIndex& index,
+                                                const std::map<std::string, std::string>& values)
+    {
+        std::size_t filled = 0;
+        std::vector<std::pair<ContentControlBinding, std::string>> bound_values;
+        for (const auto& field: values)
+        {
+            // 填充外层控件可能删除同名的内层控件，遍历副本并跳过已移出索引的节点
+            const std::vector<pugi::xml_node> targets = index.find(field.first);
+            for (const pugi::xml_node sdt: targets)
+            {
+                if (!index.contains(sdt))
+                    continue;
+                set_content_control_text(sdt, field.second, &m_impl->m_journal);
+                index.prune(sdt);
+                ++filled;
+
+                ContentControlBinding binding;
+                if (get_content_control_binding(sdt, binding))
+                    bound_values.emplace_back(std::move(binding), field.second);
+            }
+        }
+
+        // 页眉页脚由 HeaderFooterManager 按内容哈希判断是否写回
+        if (filled > 0)
+            mark_dirty(DocumentPart::MAIN_DOCUMENT);
+        if (m_impl->m_file)
+            update_custom_xml_parts(*m_impl->m_file, bound_values);
+        return filled;
+    }
+
     // ============================================================================
     // Style Set Operations Implementation
     // ============================================================================
     
     Result<void> Document::apply_style_set_safe(const std::string& set_name)
     {
-        if (!m_style_manager) {
-            return Result<void>(errors::validation_failed("style_manager", 
-                "Style manager not initialized",
-                DUCKX_ERROR_CONTEXT()));
+        mark_dirty(DocumentPart::STYLES);
+        mark_dirty(DocumentPart::MAIN_DOCUMENT);
+        return style_manager().apply_style_set_safe(set_name, *this);
+    }
+
+    Result<void> Document::apply_style_set_safe(const std::string& set_name, const OperationOptions& operation)
+    {
+        mark_dirty(DocumentPart::STYLES);
+        mark_dirty(DocumentPart::MAIN_DOCUMENT);
+
+        // 未开启事务时自行开启；已在调用方事务中时撤销到保存点。取消或失败都不留下部分应用的样式
+        const bool own_transaction = !in_transaction();
+        if (own_transaction)
+            begin_transaction();
+        const std::size_t savepoint = m_impl->m_journal.savepoint();
+        Result<void> result = style_manager().apply_style_set_safe(set_name, *this, operation);
+        if (own_transaction) {
+            if (result.ok())
+                commit();
+            else
+                rollback();
+        } else if (!result.ok()) {
+            m_impl->m_journal.rollback_to(savepoint);
         }
-        
-        return m_style_manager->apply_style_set_safe(set_name, *this);
+        return result;
     }
     
     Result<void> Document::load_style_definitions_safe(const std::string& xml_file)
     {
-        if (!m_style_manager) {
-            return Result<void>(errors::validation_failed("style_manager", 
-                "Style manager not initialized",
-                DUCKX_ERROR_CONTEXT()));
-        }
-        
+        mark_dirty(DocumentPart::STYLES);
+
         // First load styles from the XML file
         XmlStyleParser parser;
         auto styles_result = parser.load_styles_from_file_safe(xml_file);
@@ -352,16 +1116,16 @@ namespace duckx
             Result<Style*> created_style = Result<Style*>(errors::invalid_argument("style_type", "Invalid initial value"));
             switch (style_type) {
                 case StyleType::PARAGRAPH:
-                    created_style = m_style_manager->create_paragraph_style_safe(style_name);
+                    created_style = style_manager().create_paragraph_style_safe(style_name);
                     break;
                 case StyleType::CHARACTER:
-                    created_style = m_style_manager->create_character_style_safe(style_name);
+                    created_style = style_manager().create_character_style_safe(style_name);
                     break;
                 case StyleType::TABLE:
-                    created_style = m_style_manager->create_table_style_safe(style_name);
+                    created_style = style_manager().create_table_style_safe(style_name);
                     break;
                 case StyleType::MIXED:
-                    created_style = m_style_manager->create_mixed_style_safe(style_name);
+                    created_style = style_manager().create_mixed_style_safe(style_name);
                     break;
                 default:
                     continue; // Skip unsupported types
@@ -369,7 +1133,7 @@ namespace duckx
             
             if (!created_style.ok()) {
                 // Style might already exist, try to get it
-                auto existing_style = m_style_manager->get_style_safe(style_name);
+                auto existing_style = style_manager().get_style_safe(style_name);
                 if (!existing_style.ok()) {
                     return Result<void>(errors::style_application_failed(
                         style_name,
@@ -404,7 +1168,7 @@ namespace duckx
         auto sets_result = parser.load_style_sets_from_file_safe(xml_file);
         if (sets_result.ok()) {
             for (const auto& style_set : sets_result.value()) {
-                m_style_manager->register_style_set_safe(style_set);
+                style_manager().register_style_set_safe(style_set);
             }
         }
         
@@ -413,33 +1177,25 @@ namespace duckx
     
     Result<void> Document::apply_style_mappings_safe(const std::map<std::string, std::string>& style_mappings)
     {
-        if (!m_style_manager) {
-            return Result<void>(errors::validation_failed("style_manager", 
-                "Style manager not initialized",
-                DUCKX_ERROR_CONTEXT()));
-        }
-        
-        return m_style_manager->apply_style_mappings_safe(*this, style_mappings);
+        mark_dirty(DocumentPart::STYLES);
+        mark_dirty(DocumentPart::MAIN_DOCUMENT);
+        return style_manager().apply_style_mappings_safe(*this, style_mappings);
     }
     
     Result<void> Document::register_style_set_safe(const StyleSet& style_set)
     {
-        if (!m_style_manager) {
-            return Result<void>(errors::validation_failed("style_manager", 
-                "Style manager not initialized",
-                DUCKX_ERROR_CONTEXT()));
-        }
-        
-        return m_style_manager->register_style_set_safe(style_set);
+        mark_dirty(DocumentPart::STYLES);
+        return style_manager().register_style_set_safe(style_set);
     }
     
     Result<void> Document::initialize_page_layout_structure_safe()
     {
         try {
             // Find or create the w:document root node
-            pugi::xml_node root = m_document_xml.child("w:document");
+            pugi::xml_node root = m_impl->m_document_xml.child("w:document");
             if (!root) {
-                root = m_document_xml.append_child("w:document");
+                mark_dirty(DocumentPart::MAIN_DOCUMENT);
+                root = m_impl->m_document_xml.append_child("w:document");
                 if (!root) {
                     return Result<void>(errors::xml_parse_error(
                         "Failed to create document root node"));
@@ -453,6 +1209,7 @@ namespace duckx
             // Find or create the w:body node
             pugi::xml_node body = root.child("w:body");
             if (!body) {
+                mark_dirty(DocumentPart::MAIN_DOCUMENT);
                 body = root.append_child("w:body");
                 if (!body) {
                     return Result<void>(errors::xml_parse_error(
@@ -468,6 +1225,7 @@ namespace duckx
                     return Result<void>(errors::xml_parse_error(
                         "Failed to create section properties node"));
                 }
+                MutationJournal::after_insert(&m_impl->m_journal, sect_pr);
                 
                 // Initialize with default page layout settings
                 
@@ -498,18 +1256,18 @@ namespace duckx
             }
             
             // Update the Body object to use the new structure
-            m_body = Body(body);
+            m_impl->m_body = Body(body, &m_impl->m_journal);
             
             // Debug: Print XML structure to verify it was created correctly
             #ifdef DEBUG
             xml_string_writer debug_writer;
-            m_document_xml.print(debug_writer, "  ", pugi::format_default);
+            m_impl->m_document_xml.print(debug_writer, "  ", pugi::format_default);
             std::cout << "DEBUG: Created XML structure:\n" << debug_writer.result << std::endl;
             #endif
             
             // Reinitialize all managers to use the updated XML structure
-            m_page_layout_manager = std::make_unique<PageLayoutManager>(this, &m_document_xml);
-            m_outline_manager = std::make_unique<OutlineManager>(this, m_style_manager.get());
+            m_impl->m_page_layout_manager = std::make_unique<PageLayoutManager>(&m_impl->m_handle, &m_impl->m_document_xml);
+            m_impl->m_outline_manager = std::make_unique<OutlineManager>(&m_impl->m_handle, &style_manager());
             
             return Result<void>();
         }
@@ -519,61 +1277,26 @@ namespace duckx
         }
     }
     
-    Document::Document(Document&& other) noexcept
-        : m_file(std::move(other.m_file)),
-          m_document_xml(std::move(other.m_document_xml)),
-          m_rels_xml(std::move(other.m_rels_xml)),
-          m_content_types_xml(std::move(other.m_content_types_xml)),
-          m_body(std::move(other.m_body)),
-          m_media_manager(std::move(other.m_media_manager)),
-          m_hf_manager(std::move(other.m_hf_manager)),
-          m_link_manager(std::move(other.m_link_manager)),
-          m_style_manager(std::move(other.m_style_manager)),
-          m_outline_manager(std::move(other.m_outline_manager)),
-          m_page_layout_manager(nullptr),  // Don't move, will recreate if needed
-          m_rid_counter(other.m_rid_counter)
-    {
-        // Critical: PageLayoutManager cannot be safely moved because it stores raw pointers
-        // to Document and xml_document. We need to recreate it if it existed.
-        if (other.m_page_layout_manager) {
-            // Clear the source to prevent double-delete issues
-            other.m_page_layout_manager.reset();
-            
-            // Recreate with correct pointers to this Document instance
-            m_page_layout_manager = std::make_unique<PageLayoutManager>(this, &m_document_xml);
-        }
-        
-        // Note: Other managers may need similar updates if they store Document pointers
+    void Document::ImplDeleter::operator()(const Impl* impl) const
+    {
+        if (owning)
+            delete impl;
     }
-    
-    Document& Document::operator=(Document&& other) noexcept
-    {
-        if (this != &other) {
-            // Move all members
-            m_file = std::move(other.m_file);
-            m_document_xml = std::move(other.m_document_xml);
-            m_rels_xml = std::move(other.m_rels_xml);
-            m_content_types_xml = std::move(other.m_content_types_xml);
-            m_body = std::move(other.m_body);
-            m_media_manager = std::move(other.m_media_manager);
-            m_hf_manager = std::move(other.m_hf_manager);
-            m_link_manager = std::move(other.m_link_manager);
-            m_style_manager = std::move(other.m_style_manager);
-            m_outline_manager = std::move(other.m_outline_manager);
-            m_rid_counter = other.m_rid_counter;
-            
-            // Critical: PageLayoutManager cannot be safely moved because it stores raw pointers
-            // Handle PageLayoutManager specially
-            if (other.m_page_layout_manager) {
-                other.m_page_layout_manager.reset();  // Clear source
-                m_page_layout_manager = std::make_unique<PageLayoutManager>(this, &m_document_xml);
-            } else {
-                m_page_layout_manager.reset();
-            }
-            
-            // Note: Other managers may need similar updates if they store Document pointers
-        }
-        return *this;
+
+    Document::Document(Impl* state) noexcept
+        : m_impl(state, ImplDeleter{false})
+    {
+    }
+
+    Document::Document(Document&& other) noexcept = default;
+
+    Document& Document::operator=(Document&& other) noexcept = default;
+
+    Document::~Document() = default;
+
+    bool Document::is_read_only() const
+    {
+        return m_impl->m_options.read_only;
     }
     
 } // namespace duckx
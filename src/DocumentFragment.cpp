@@ -0,0 +1,99 @@
+/*!
+ * @file DocumentFragment.cpp
+ * @brief Implementation of independently built body content
+ */
+#include "DocumentFragment.hpp"
+
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+#include "Image.hpp"
+#include "MediaManager.hpp"
+#include "TextBox.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        // 片段的 ID 区间位于文档自身编号之上，只需在片段内唯一，拼接时重新编号
+        constexpr std::uint32_t kFragmentSlots =
+            (static_cast<std::uint32_t>(std::numeric_limits<int>::max()) - DocumentFragment::kFirstReservedId + 1) /
+            DocumentFragment::kIdsPerFragment;
+
+        std::atomic<std::uint32_t> g_next_slot(0);
+    } // namespace
+
+    constexpr std::uint32_t DocumentFragment::kIdsPerFragment;
+    constexpr std::uint32_t DocumentFragment::kFirstReservedId;
+
+    DocumentFragment::DocumentFragment()
+    {
+        const std::uint32_t slot = g_next_slot.fetch_add(1, std::memory_order_relaxed) % kFragmentSlots;
+        m_first_id = kFirstReservedId + slot * kIdsPerFragment;
+        m_next_drawing_id = m_first_id;
+        m_rid_prefix = "rIdF" + std::to_string(slot) + "_";
+
+        m_body = Body(m_xml.append_child("w:body"));
+        m_bookmarks.set_next_id(static_cast<int>(m_first_id));
+    }
+
+    Run DocumentFragment::add_image(const Paragraph& p, const Image& image)
+    {
+        pugi::xml_node p_node = p.get_node();
+        if (!p_node)
+        {
+            throw std::runtime_error("Cannot add image to an invalid paragraph.");
+        }
+
+        FragmentRelationship relationship;
+        relationship.image = true;
+        relationship.content = MediaManager::read_image_file(image.get_path(), relationship.extension);
+        relationship.id = m_rid_prefix + std::to_string(m_relationships.size() + 1);
+
+        pugi::xml_node run_node = p_node.append_child("w:r");
+        image.generate_drawing_xml(run_node, relationship.id, next_drawing_id());
+        m_relationships.push_back(std::move(relationship));
+        return {p_node, run_node};
+    }
+
+    Run DocumentFragment::add_textbox(const Paragraph& p, const TextBox& textbox)
+    {
+        pugi::xml_node p_node = p.get_node();
+        if (!p_node)
+        {
+            return {};
+        }
+
+        pugi::xml_node run_node = p_node.append_child("w:r");
+        textbox.generate_drawing_xml(run_node, "", next_drawing_id());
+        return {p_node, run_node};
+    }
+
+    const BookmarkRange& DocumentFragment::add_bookmark(const Paragraph& p, const absl::string_view name)
+    {
+        if (static_cast<std::uint32_t>(m_bookmarks.next_id()) - m_first_id >= kIdsPerFragment)
+        {
+            throw std::length_error("DocumentFragment bookmark id range exhausted");
+        }
+        return m_bookmarks.add_bookmark(p.get_node(), name);
+    }
+
+    std::string DocumentFragment::add_hyperlink_relationship(const std::string& url)
+    {
+        FragmentRelationship relationship;
+        relationship.id = m_rid_prefix + std::to_string(m_relationships.size() + 1);
+        relationship.target = url;
+        m_relationships.push_back(std::move(relationship));
+        return m_relationships.back().id;
+    }
+
+    std::uint32_t DocumentFragment::next_drawing_id()
+    {
+        if (m_next_drawing_id - m_first_id >= kIdsPerFragment)
+        {
+            throw std::length_error("DocumentFragment drawing id range exhausted");
+        }
+        return m_next_drawing_id++;
+    }
+} // namespace duckx
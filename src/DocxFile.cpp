@@ -7,8 +7,11 @@
  */
 #include "DocxFile.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -16,10 +19,57 @@
 
 #include <ctime>
 
+#include "Executor.hpp"
+#include "OperationOptions.hpp"
+#include "Sha256.hpp"
 #include "zip.h"
+#include "ZipArchive.hpp"
 
 namespace duckx
 {
+    namespace
+    {
+        const char* const kContentTypesPart = "[Content_Types].xml";
+        const char* const kCorePropertiesPart = "docProps/core.xml";
+
+        // 规范条目顺序：[Content_Types].xml 在前，其余按名称排序
+        bool canonical_entry_less(const std::string& a, const std::string& b)
+        {
+            const bool a_types = a == kContentTypesPart;
+            const bool b_types = b == kContentTypesPart;
+            if (a_types != b_types)
+                return a_types;
+            return a < b;
+        }
+
+        std::string format_utc(const std::time_t timestamp)
+        {
+            std::tm utc{};
+#if defined(_WIN32)
+            gmtime_s(&utc, &timestamp);
+#else
+            gmtime_r(&timestamp, &utc);
+#endif
+            char datetime[32];
+            std::strftime(datetime, sizeof(datetime), "%Y-%m-%dT%H:%M:%SZ", &utc);
+            return datetime;
+        }
+
+        void replace_element_text(std::string& xml, const std::string& tag, const std::string& text)
+        {
+            const size_t open = xml.find("<" + tag);
+            if (open == std::string::npos)
+                return;
+            const size_t content_begin = xml.find('>', open);
+            if (content_begin == std::string::npos || xml[content_begin - 1] == '/')
+                return;
+            const size_t content_end = xml.find("</" + tag + ">", content_begin);
+            if (content_end == std::string::npos)
+                return;
+            xml.replace(content_begin + 1, content_end - content_begin - 1, text);
+        }
+    } // namespace
+
     DocxFile::DocxFile() = default;
 
     DocxFile::~DocxFile() = default;
@@ -27,18 +77,19 @@ namespace duckx
     bool DocxFile::open(const std::string& path)
     {
         m_path = path;
-        zip_t* zip = zip_open(m_path.c_str(), 0, 'r');
-        if (!zip)
-        {
-            return false;
-        }
-        zip_close(zip); // 仅检查文件是否存在且可读，不保持打开
-        return true;
+        m_archive.reset();
+        m_inherited_archive = false;
+        m_removed_entries.clear();
+        // 仅索引中央目录，条目内容按需读取
+        return archive() != nullptr;
     }
 
     bool DocxFile::create(const std::string& path)
     {
         m_path = path;
+        m_archive.reset();
+        m_inherited_archive = false;
+        m_removed_entries.clear();
         zip_t* zip = zip_open(path.c_str(), ZIP_DEFAULT_COMPRESSION_LEVEL, 'w');
         if (!zip)
         {
@@ -51,9 +102,55 @@ namespace duckx
 
     void DocxFile::close()
     {
-        // 因为我们不是一直保持文件打开，这个方法可以为空，或者用于清理资源
+        m_archive.reset();
+        m_inherited_archive = false;
         m_path.clear();
         m_dirty_entries.clear();
+        m_modified_entries.clear();
+        m_removed_entries.clear();
+        m_digests.clear();
+    }
+
+    std::unique_ptr<DocxFile> DocxFile::fork(const std::string& path) const
+    {
+        if (!archive())
+        {
+            throw std::runtime_error("Cannot fork a package without an archive: " + m_path);
+        }
+
+        // 共享原压缩包的索引与压缩数据，只复制待写入的条目
+        auto copy = std::make_unique<DocxFile>();
+        copy->m_path = path;
+        copy->m_archive = m_archive;
+        copy->m_inherited_archive = true;
+        copy->m_dirty_entries = m_dirty_entries;
+        copy->m_removed_entries = m_removed_entries;
+        copy->m_digests = m_digests;
+        for (const auto& pair: m_dirty_entries)
+        {
+            copy->m_modified_entries.insert(pair.first);
+        }
+        copy->m_deterministic = m_deterministic;
+        copy->m_timestamp = m_timestamp;
+        copy->m_incremental = m_incremental;
+        copy->m_compaction_threshold = m_compaction_threshold;
+        copy->m_executor = m_executor;
+        // 目标文件尚不存在，即使没有修改也需要写出
+        copy->m_rewrite_required = true;
+        return copy;
+    }
+
+    ZipReader* DocxFile::archive() const
+    {
+        if (!m_archive && !m_path.empty())
+        {
+            auto reader = std::make_unique<ZipReader>();
+            if (reader->open(m_path))
+            {
+                m_archive = std::move(reader);
+            }
+        }
+        return m_archive.get();
     }
 
     bool DocxFile::has_entry(const std::string& entry_name) const
@@ -62,30 +159,30 @@ namespace duckx
         {
             return true;
         }
-
-        zip_t* zip = zip_open(m_path.c_str(), 0, 'r');
-        if (!zip)
+        if (m_removed_entries.count(entry_name))
+        {
             return false;
+        }
 
-        const bool found = (zip_entry_open(zip, entry_name.c_str()) == 0);
-
-        if (found)
-            zip_entry_close(zip);
-        zip_close(zip);
-
-        return found;
+        const ZipReader* reader = archive();
+        return reader && reader->find(entry_name) != nullptr;
     }
 
     std::string DocxFile::read_entry(const std::string& entry_name)
     {
         // 优先从已修改的缓存中读取
-        if (m_dirty_entries.count(entry_name))
+        const auto dirty = m_dirty_entries.find(entry_name);
+        if (dirty != m_dirty_entries.end())
         {
-            return m_dirty_entries[entry_name];
+            return dirty->second;
+        }
+        if (m_removed_entries.count(entry_name))
+        {
+            throw std::runtime_error("Failed to open zip entry: " + entry_name);
         }
 
-        zip_t* zip = zip_open(m_path.c_str(), 0, 'r');
-        if (!zip)
+        ZipReader* reader = archive();
+        if (!reader)
         {
             // 如果文件不存在但我们想读取一个空文档，就返回空文档XML
             if (entry_name == "word/document.xml")
@@ -93,87 +190,566 @@ namespace duckx
             throw std::runtime_error("Failed to open zip file: " + m_path);
         }
 
-        if (zip_entry_open(zip, entry_name.c_str()) != 0)
+        const ZipEntryInfo* entry = reader->find(entry_name);
+        if (!entry)
         {
-            zip_close(zip);
             if (entry_name == "word/document.xml")
                 return get_empty_document_xml();
             throw std::runtime_error("Failed to open zip entry: " + entry_name);
         }
 
-        void* buf = nullptr;
-        size_t buf_size;
-        zip_entry_read(zip, &buf, &buf_size);
-        std::string content(static_cast<char*>(buf), buf_size);
+        std::string content;
+        if (!reader->read(*entry, content))
+        {
+            throw std::runtime_error("Failed to read zip entry: " + entry_name);
+        }
+        return content;
+    }
 
-        free(buf);
-        zip_entry_close(zip);
-        zip_close(zip);
+    std::string DocxFile::read_entry(const std::string& entry_name, const OperationOptions& options)
+    {
+        OperationProgress progress(options, 0);
+        ZipReader* reader = m_dirty_entries.count(entry_name) ? nullptr : archive();
+        const ZipEntryInfo* entry = reader ? reader->find(entry_name) : nullptr;
+        if (!entry)
+        {
+            // 缓存或默认内容无需解压，只在读取前后各检查一次
+            progress.checkpoint(0);
+            std::string content = read_entry(entry_name);
+            progress.set_total(content.size());
+            progress.checkpoint(content.size());
+            return content;
+        }
 
+        progress.set_total(entry->uncompressed_size);
+        progress.checkpoint(0);
+        std::string content;
+        content.reserve(static_cast<size_t>(entry->uncompressed_size));
+        const bool ok = reader->extract(*entry, [&content, &progress](const char* data, const size_t size)
+        {
+            content.append(data, size);
+            return progress.report(content.size());
+        });
+        if (progress.cancelled())
+        {
+            throw OperationCancelled();
+        }
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to read zip entry: " + entry_name);
+        }
         return content;
     }
 
     void DocxFile::write_entry(const std::string& entry_name, const std::string& content)
     {
+        // 内容未变化时不标记修改，保存时可直接拷贝原压缩数据
+        const auto dirty = m_dirty_entries.find(entry_name);
+        if (dirty != m_dirty_entries.end() && dirty->second == content)
+        {
+            return;
+        }
         m_dirty_entries[entry_name] = content;
+        m_modified_entries.insert(entry_name);
+        m_removed_entries.erase(entry_name);
+        m_digests.erase(entry_name);
+    }
+
+    std::uint64_t DocxFile::remove_entry(const std::string& entry_name)
+    {
+        std::uint64_t stored_size = 0;
+        bool existed = false;
+
+        const auto dirty = m_dirty_entries.find(entry_name);
+        if (dirty != m_dirty_entries.end())
+        {
+            stored_size = dirty->second.size();
+            existed = true;
+            m_dirty_entries.erase(dirty);
+            m_modified_entries.erase(entry_name);
+            m_digests.erase(entry_name);
+        }
+
+        // 原压缩包中的条目只记录删除，保存时跳过
+        const ZipReader* reader = archive();
+        const ZipEntryInfo* entry = reader ? reader->find(entry_name) : nullptr;
+        if (entry && m_removed_entries.insert(entry_name).second)
+        {
+            stored_size = entry->compressed_size;
+            existed = true;
+            m_rewrite_required = true;
+        }
+        return existed ? stored_size : 0;
+    }
+
+    std::vector<std::string> DocxFile::entry_names() const
+    {
+        std::vector<std::string> names;
+        const ZipReader* reader = archive();
+        if (reader)
+        {
+            for (const auto& entry: reader->entries())
+            {
+                if (!m_removed_entries.count(entry.name))
+                    names.push_back(entry.name);
+            }
+        }
+        for (const auto& pair: m_dirty_entries)
+        {
+            if (!reader || !reader->find(pair.first))
+                names.push_back(pair.first);
+        }
+        return names;
+    }
+
+    bool DocxFile::is_modified() const
+    {
+        return !m_modified_entries.empty();
+    }
+
+    void DocxFile::mark_all_modified()
+    {
+        for (const auto& pair: m_dirty_entries)
+        {
+            m_modified_entries.insert(pair.first);
+        }
+    }
+
+    void DocxFile::set_deterministic(const bool enabled, const std::time_t timestamp)
+    {
+        if (enabled != m_deterministic || timestamp != m_timestamp)
+        {
+            m_rewrite_required = true;
+        }
+        m_deterministic = enabled;
+        m_timestamp = timestamp;
+    }
+
+    bool DocxFile::is_deterministic() const
+    {
+        return m_deterministic;
+    }
+
+    void DocxFile::set_incremental(const bool enabled, const double compaction_threshold)
+    {
+        m_incremental = enabled;
+        m_compaction_threshold = compaction_threshold;
+    }
+
+    bool DocxFile::is_incremental() const
+    {
+        return m_incremental;
+    }
+
+    void DocxFile::set_executor(std::shared_ptr<Executor> executor)
+    {
+        m_executor = std::move(executor);
+    }
+
+    std::shared_ptr<Executor> DocxFile::executor() const
+    {
+        return m_executor ? m_executor : default_executor();
+    }
+
+    std::uint64_t DocxFile::dead_space() const
+    {
+        const ZipReader* reader = m_inherited_archive ? nullptr : archive();
+        return reader ? reader->unreferenced_bytes() : 0;
+    }
+
+    std::string DocxFile::content_hash()
+    {
+        if (m_deterministic)
+        {
+            normalize_core_properties();
+        }
+
+        // 按规范顺序汇总各条目的 (名称, 大小, SHA-256)；未修改条目先用中央目录中的大小与 CRC-32 校验缓存
+        std::vector<std::string> names;
+        ZipReader* reader = archive();
+        if (reader)
+        {
+            for (const auto& entry: reader->entries())
+            {
+                if (!m_dirty_entries.count(entry.name) && !m_removed_entries.count(entry.name))
+                    names.push_back(entry.name);
+            }
+        }
+        for (const auto& pair: m_dirty_entries)
+        {
+            names.push_back(pair.first);
+        }
+        std::sort(names.begin(), names.end(), canonical_entry_less);
+
+        Sha256 package;
+        for (const auto& name: names)
+        {
+            auto cached = m_digests.find(name);
+            const auto dirty = m_dirty_entries.find(name);
+            if (dirty != m_dirty_entries.end())
+            {
+                // 待写入条目的摘要在 write_entry() 时失效，此处按需计算一次
+                if (cached == m_digests.end())
+                {
+                    const std::string& content = dirty->second;
+                    PartDigest digest;
+                    digest.size = content.size();
+                    digest.crc32 = zip_crc32(content.data(), content.size());
+                    digest.sha256 = Sha256::digest(content.data(), content.size());
+                    cached = m_digests.emplace(name, digest).first;
+                }
+            }
+            else
+            {
+                // 大小与 CRC-32 都相符时沿用缓存（例如保存前计算过的条目），否则解压并计算
+                const ZipEntryInfo* entry = reader->find(name);
+                if (cached == m_digests.end() || cached->second.size != entry->uncompressed_size ||
+                    cached->second.crc32 != entry->crc32)
+                {
+                    Sha256 sha;
+                    const bool ok = reader->extract(*entry, [&sha](const char* data, const size_t size)
+                    {
+                        sha.update(data, size);
+                        return true;
+                    });
+                    if (!ok)
+                    {
+                        throw std::runtime_error("Failed to read zip entry: " + name);
+                    }
+                    PartDigest digest;
+                    digest.size = entry->uncompressed_size;
+                    digest.crc32 = entry->crc32;
+                    digest.sha256 = sha.finish();
+                    if (cached == m_digests.end())
+                        cached = m_digests.emplace(name, digest).first;
+                    else
+                        cached->second = digest;
+                }
+            }
+
+            unsigned char size_bytes[8];
+            for (size_t i = 0; i < sizeof(size_bytes); ++i)
+            {
+                size_bytes[i] = static_cast<unsigned char>(cached->second.size >> (8 * i));
+            }
+            package.update(name.c_str(), name.size() + 1);
+            package.update(size_bytes, sizeof(size_bytes));
+            package.update(cached->second.sha256.data(), cached->second.sha256.size());
+        }
+
+        return Sha256::to_hex(package.finish());
     }
 
     void DocxFile::save()
+    {
+        save_package(nullptr);
+    }
+
+    void DocxFile::save(const OperationOptions& options)
+    {
+        save_package(&options);
+    }
+
+    void DocxFile::save_package(const OperationOptions* operation)
+    {
+        if (m_path.empty())
+        {
+            throw std::runtime_error("File path is not set. Cannot save.");
+        }
+
+        if (m_deterministic)
+        {
+            normalize_core_properties();
+        }
+
+        // 没有任何修改且文件已存在时无需重写
+        ZipReader* reader = archive();
+        if (reader && m_modified_entries.empty() && !m_rewrite_required)
+        {
+            return;
+        }
+
+        DocxSaveSnapshot target;
+        target.path = m_path;
+        target.deterministic = m_deterministic;
+        target.timestamp = m_timestamp;
+        target.incremental = m_incremental && !m_deterministic && !m_inherited_archive;
+        target.compaction_threshold = m_compaction_threshold;
+        target.executor = m_executor;
+        target.operation = operation;
+        // 原文件不存在或读取的是分叉来源的压缩包时写出全部缓存条目
+        target.entries = reader && !m_inherited_archive ? modified_entries() : m_dirty_entries;
+        target.removed = m_removed_entries;
+
+        // 与分叉文档共享的读取器保持打开
+        write_archive(target, reader, m_archive.use_count() == 1);
+        m_archive.reset();
+        m_inherited_archive = false;
+        m_modified_entries.clear();
+        m_removed_entries.clear();
+        m_rewrite_required = false;
+    }
+
+    DocxSaveSnapshot DocxFile::snapshot()
     {
         if (m_path.empty())
         {
             throw std::runtime_error("File path is not set. Cannot save.");
         }
 
-        const std::string temp_file = m_path + ".tmp";
+        if (m_deterministic)
+        {
+            normalize_core_properties();
+        }
+
+        DocxSaveSnapshot result;
+        result.path = m_path;
+        result.deterministic = m_deterministic;
+        result.timestamp = m_timestamp;
+        result.incremental = m_incremental && !m_deterministic && !m_inherited_archive;
+        result.compaction_threshold = m_compaction_threshold;
+        result.executor = m_executor;
+        if (m_inherited_archive)
+        {
+            // 目标文件可能尚未写出，继续以分叉来源的压缩包为底本
+            result.source = m_archive;
+            result.entries = m_dirty_entries;
+        }
+        else
+        {
+            // 释放缓存的读取句柄，以便后台写入可以替换该文件
+            m_archive.reset();
+            result.entries = modified_entries();
+        }
+        // 删除记录保留到下次保存：后台写入完成前磁盘上仍是旧压缩包
+        result.removed = m_removed_entries;
+        m_modified_entries.clear();
+        m_rewrite_required = false;
+        return result;
+    }
+
+    std::map<std::string, std::string> DocxFile::modified_entries() const
+    {
+        std::map<std::string, std::string> entries;
+        for (const auto& name: m_modified_entries)
+        {
+            entries.emplace(name, m_dirty_entries.at(name));
+        }
+        return entries;
+    }
+
+    void DocxFile::normalize_core_properties()
+    {
+        if (!has_entry(kCorePropertiesPart))
+            return;
+
+        std::string core = read_entry(kCorePropertiesPart);
+        const std::string stamp = format_utc(m_timestamp);
+        replace_element_text(core, "dcterms:created", stamp);
+        replace_element_text(core, "dcterms:modified", stamp);
+        write_entry(kCorePropertiesPart, core);
+    }
+
+    void DocxFile::write_snapshot(const DocxSaveSnapshot& snapshot)
+    {
+        if (snapshot.source)
+        {
+            write_archive(snapshot, snapshot.source.get(), false);
+            return;
+        }
+
+        // 使用独立的读取器，不与创建快照的 DocxFile 共享文件句柄
+        ZipReader reader;
+        write_archive(snapshot, reader.open(snapshot.path) ? &reader : nullptr, true);
+    }
+
+    std::map<std::string, ZipCompressedData> DocxFile::compress_entries(const DocxSaveSnapshot& target)
+    {
+        // 先按名称建好所有结果槽位，各条目再并行压缩到各自的槽位中
+        std::map<std::string, ZipCompressedData> compressed;
+        std::vector<std::pair<const std::string*, ZipCompressedData*>> jobs;
+        jobs.reserve(target.entries.size());
+        for (const auto& pair: target.entries)
+            jobs.emplace_back(&pair.second, &compressed[pair.first]);
+
+        const std::shared_ptr<Executor> executor = target.executor ? target.executor : default_executor();
+        const OperationOptions* operation = target.operation;
+        executor->parallel_for(0, jobs.size(), [&jobs, operation](const std::size_t i) {
+            if (operation && operation->cancellation.is_cancelled())
+                throw OperationCancelled();
+            const std::string& content = *jobs[i].first;
+            if (!ZipWriter::compress(content.data(), content.size(), ZIP_DEFAULT_COMPRESSION_LEVEL, *jobs[i].second))
+                throw std::runtime_error("Failed to compress zip entry");
+        });
+        return compressed;
+    }
+
+    void DocxFile::write_archive(const DocxSaveSnapshot& target, ZipReader* source, const bool release_source)
+    {
+        if (target.incremental && source && append_archive(target, *source, release_source))
+        {
+            return;
+        }
+
+        const std::string& path = target.path;
+        const std::map<std::string, std::string>& entries = target.entries;
+        const std::string temp_file = path + ".tmp";
+
+        const std::map<std::string, ZipCompressedData> compressed = compress_entries(target);
 
         // 创建临时zip文件
-        zip_t* new_zip = zip_open(temp_file.c_str(), ZIP_DEFAULT_COMPRESSION_LEVEL, 'w');
-        if (!new_zip)
+        ZipWriter writer;
+        if (!writer.open(temp_file, ZIP_DEFAULT_COMPRESSION_LEVEL))
         {
             throw std::runtime_error("Failed to create temporary zip file.");
         }
+        if (target.deterministic)
+        {
+            writer.set_fixed_time(target.timestamp);
+        }
 
-        // 写入所有被修改或新添加的文件
-        for (const auto& pair: m_dirty_entries)
+        const auto fail = [&](const std::string& message)
+        {
+            writer.close();
+            remove(temp_file.c_str());
+            throw std::runtime_error(message);
+        };
+
+        // 默认保持原始顺序，新增条目追加在后；确定性模式下使用规范顺序
+        std::vector<std::string> order;
+        if (source)
         {
-            zip_entry_open(new_zip, pair.first.c_str());
-            zip_entry_write(new_zip, pair.second.c_str(), pair.second.length());
-            zip_entry_close(new_zip);
+            for (const auto& entry: source->entries())
+            {
+                if (!target.removed.count(entry.name))
+                    order.push_back(entry.name);
+            }
+        }
+        for (const auto& pair: entries)
+        {
+            if (!source || !source->find(pair.first))
+                order.push_back(pair.first);
+        }
+        if (target.deterministic)
+        {
+            std::sort(order.begin(), order.end(), canonical_entry_less);
         }
 
-        // 打开原始zip文件，拷贝所有未被修改的文件
-        zip_t* orig_zip = zip_open(m_path.c_str(), 0, 'r');
-        if (orig_zip)
+        // 进度按写入的条目数据字节计算，每个条目之后检查一次取消
+        std::uint64_t total = 0;
+        if (target.operation)
         {
-            const int entry_count = zip_total_entries(orig_zip);
-            for (int i = 0; i < entry_count; ++i)
+            for (const auto& name: order)
             {
-                zip_entry_openbyindex(orig_zip, i);
-                const char* name = zip_entry_name(orig_zip);
+                const auto dirty = compressed.find(name);
+                total += dirty != compressed.end() ? dirty->second.data.size() : source->find(name)->compressed_size;
+            }
+        }
+        std::uint64_t written = 0;
 
-                // 如果这个文件没被修改过，就从旧文件拷贝到新文件
-                if (m_dirty_entries.find(name) == m_dirty_entries.end())
+        // 被修改的条目重新压缩，未修改的直接拷贝压缩数据
+        for (const auto& name: order)
+        {
+            const auto dirty = compressed.find(name);
+            const bool ok = (dirty != compressed.end())
+                                ? writer.add_compressed_entry(name, dirty->second)
+                                : writer.add_raw_entry(*source, *source->find(name));
+            if (!ok)
+            {
+                fail("Failed to write zip entry: " + name);
+            }
+            if (target.operation)
+            {
+                written += dirty != compressed.end() ? dirty->second.data.size() : source->find(name)->compressed_size;
+                if (!OperationProgress(*target.operation, total).report(written))
                 {
-                    void* buf = nullptr;
-                    size_t buf_size;
-                    zip_entry_read(orig_zip, &buf, &buf_size);
-
-                    zip_entry_open(new_zip, name);
-                    zip_entry_write(new_zip, buf, buf_size);
-                    zip_entry_close(new_zip);
-                    free(buf);
+                    // 临时文件丢弃，原文件保持不变
+                    writer.close();
+                    remove(temp_file.c_str());
+                    throw OperationCancelled();
                 }
-                zip_entry_close(orig_zip);
             }
-            zip_close(orig_zip);
         }
 
-        zip_close(new_zip);
+        if (!writer.close())
+        {
+            remove(temp_file.c_str());
+            throw std::runtime_error("Failed to finalize temporary zip file.");
+        }
+
+        // 替换原始文件（先释放读取句柄）；rename 在 POSIX 上原子覆盖，失败时再先删除
+        if (source && release_source)
+        {
+            source->close();
+        }
+        if (rename(temp_file.c_str(), path.c_str()) != 0)
+        {
+            remove(path.c_str());
+            if (rename(temp_file.c_str(), path.c_str()) != 0)
+            {
+                throw std::runtime_error("Failed to replace file: " + path);
+            }
+        }
+    }
+
+    bool DocxFile::append_archive(const DocxSaveSnapshot& target, ZipReader& source, const bool release_source)
+    {
+        // 未被替换或删除的条目保留原位置，只追加修改过的条目和新的中央目录
+        std::vector<ZipEntryInfo> kept;
+        std::uint64_t live = 0;
+        for (const auto& entry: source.entries())
+        {
+            if (target.removed.count(entry.name) || target.entries.count(entry.name))
+                continue;
+            live += source.local_record_size(entry);
+            kept.push_back(entry);
+        }
+
+        // 旧的中央目录与被替换的条目都成为死区，超过阈值时改为完整重写以压缩文件
+        const std::uint64_t file_size = source.file_size();
+        const std::uint64_t dead = live < file_size ? file_size - live : 0;
+        if (static_cast<double>(dead) > target.compaction_threshold * static_cast<double>(file_size))
+        {
+            return false;
+        }
+
+        // 先压缩再打开文件追加，压缩期间的取消或失败不会触及原文件
+        const std::map<std::string, ZipCompressedData> compressed = compress_entries(target);
+        std::uint64_t total = 0;
+        for (const auto& pair: compressed)
+            total += pair.second.data.size();
+        std::uint64_t written = 0;
 
-        // 替换原始文件
-        remove(m_path.c_str());
-        rename(temp_file.c_str(), m_path.c_str());
+        ZipWriter writer;
+        if (!writer.open_append(target.path, std::move(kept), file_size, ZIP_DEFAULT_COMPRESSION_LEVEL))
+        {
+            return false;
+        }
+        for (const auto& pair: compressed)
+        {
+            if (!writer.add_compressed_entry(pair.first, pair.second))
+            {
+                writer.discard();
+                throw std::runtime_error("Failed to append zip entry: " + pair.first);
+            }
+            written += pair.second.data.size();
+            if (target.operation && !OperationProgress(*target.operation, total).report(written))
+            {
+                // 截断回原长度，追加的数据不留痕迹
+                writer.discard();
+                throw OperationCancelled();
+            }
+        }
+        if (!writer.close())
+        {
+            throw std::runtime_error("Failed to finalize appended zip file: " + target.path);
+        }
+
+        if (release_source)
+        {
+            source.close();
+        }
+        return true;
     }
 
     void DocxFile::create_basic_structure(zip_t* zip)
@@ -0,0 +1,507 @@
+/*!
+ * @file ElementSelector.cpp
+ * @brief Selector compilation and single-pass evaluation
+ */
+#include "ElementSelector.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "Body.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        enum class NodeRole
+        {
+            ELEMENT,     //!< One of the selectable element kinds
+            TRANSPARENT, //!< Wrapper searched through (w:hyperlink, w:sdt, w:sdtContent, ...)
+            SKIP         //!< Property containers and other subtrees without selectable content
+        };
+
+        NodeRole classify(const char* name, SelectorElement& kind)
+        {
+            if (name[0] != 'w' || name[1] != ':')
+                return NodeRole::SKIP;
+            const char* local = name + 2;
+            // 按首字母分派，常见元素只需比较一两个字符
+            switch (local[0])
+            {
+            case 'p':
+                if (local[1] == '\0')
+                {
+                    kind = SelectorElement::PARAGRAPH;
+                    return NodeRole::ELEMENT;
+                }
+                break;
+            case 'r':
+                if (local[1] == '\0')
+                {
+                    kind = SelectorElement::RUN;
+                    return NodeRole::ELEMENT;
+                }
+                break;
+            case 't':
+                if (std::strcmp(local + 1, "bl") == 0)
+                    kind = SelectorElement::TABLE;
+                else if (std::strcmp(local + 1, "r") == 0)
+                    kind = SelectorElement::ROW;
+                else if (std::strcmp(local + 1, "c") == 0)
+                    kind = SelectorElement::CELL;
+                else
+                    break;
+                return NodeRole::ELEMENT;
+            default:
+                break;
+            }
+
+            // w:pPr、w:rPr、w:sectPr、w:sdtPr 等属性节点下没有可选元素
+            const std::size_t length = std::strlen(local);
+            const bool properties = length > 2 && local[length - 2] == 'P' && local[length - 1] == 'r';
+            return properties || std::strcmp(local, "tblGrid") == 0 ? NodeRole::SKIP : NodeRole::TRANSPARENT;
+        }
+
+        bool parse_element(const absl::string_view name, SelectorElement& kind)
+        {
+            static const struct
+            {
+                const char* name;
+                SelectorElement kind;
+            } kElements[] = {
+                {"*", SelectorElement::ANY},    {"p", SelectorElement::PARAGRAPH}, {"r", SelectorElement::RUN},
+                {"tbl", SelectorElement::TABLE}, {"tr", SelectorElement::ROW},      {"tc", SelectorElement::CELL},
+            };
+            for (const auto& element: kElements)
+            {
+                if (name == element.name)
+                {
+                    kind = element.kind;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool parse_flag(const absl::string_view name, formatting_flag& flag)
+        {
+            static const struct
+            {
+                const char* name;
+                formatting_flag flag;
+            } kFlags[] = {
+                {"bold", bold},           {"italic", italic},         {"underline", underline},
+                {"strike", strikethrough}, {"superscript", superscript}, {"subscript", subscript},
+                {"smallcaps", smallcaps}, {"shadow", shadow},
+            };
+            for (const auto& entry: kFlags)
+            {
+                if (name == entry.name)
+                {
+                    flag = entry.flag;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const char* style_of(const SelectorElement kind, const pugi::xml_node node)
+        {
+            switch (kind)
+            {
+            case SelectorElement::PARAGRAPH:
+                return node.child("w:pPr").child("w:pStyle").attribute("w:val").value();
+            case SelectorElement::RUN:
+                return node.child("w:rPr").child("w:rStyle").attribute("w:val").value();
+            case SelectorElement::TABLE:
+                return node.child("w:tblPr").child("w:tblStyle").attribute("w:val").value();
+            default:
+                return "";
+            }
+        }
+
+        bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        bool is_name_char(const char c)
+        {
+            return absl::ascii_isalnum(static_cast<unsigned char>(c)) || c == '*' || c == '-' || c == '_';
+        }
+
+        // 逐字符扫描选择器；出错时 error 记录第一个错误的原因与位置
+        class Parser
+        {
+        public:
+            explicit Parser(const absl::string_view text) : m_text(text) {}
+
+            bool at_end() const { return m_pos >= m_text.size(); }
+            char peek() const { return at_end() ? '\0' : m_text[m_pos]; }
+            void advance() { ++m_pos; }
+
+            bool skip_space()
+            {
+                const std::size_t start = m_pos;
+                while (!at_end() && is_space(m_text[m_pos]))
+                    ++m_pos;
+                return m_pos != start;
+            }
+
+            absl::string_view name()
+            {
+                const std::size_t start = m_pos;
+                while (!at_end() && is_name_char(m_text[m_pos]))
+                    ++m_pos;
+                return m_text.substr(start, m_pos - start);
+            }
+
+            bool value(std::string& out)
+            {
+                if (peek() == '"')
+                {
+                    advance();
+                    const std::size_t end = m_text.find('"', m_pos);
+                    if (end == absl::string_view::npos)
+                        return fail("unterminated quoted value");
+                    out = std::string(m_text.substr(m_pos, end - m_pos));
+                    m_pos = end + 1;
+                    return true;
+                }
+                const std::size_t end = m_text.find(']', m_pos);
+                if (end == absl::string_view::npos)
+                    return fail("missing ']'");
+                out = std::string(absl::StripAsciiWhitespace(m_text.substr(m_pos, end - m_pos)));
+                m_pos = end;
+                return true;
+            }
+
+            bool fail(const absl::string_view reason)
+            {
+                if (m_error.empty())
+                    m_error = absl::StrCat(reason, " at offset ", m_pos);
+                return false;
+            }
+
+            const std::string& error() const { return m_error; }
+
+        private:
+            absl::string_view m_text;
+            std::size_t m_pos = 0;
+            std::string m_error;
+        };
+    } // namespace
+
+    struct ElementSelector::Decoded
+    {
+        bool has_run = false;
+        bool has_paragraph = false;
+        RunProperties run;
+        ParagraphProperties paragraph;
+    };
+
+    Result<ElementSelector> ElementSelector::compile_safe(const absl::string_view selector)
+    {
+        ElementSelector compiled;
+        Parser parser(selector);
+
+        const auto failed = [&parser, selector]() {
+            return Result<ElementSelector>(errors::invalid_argument(
+                "selector", absl::StrCat(parser.error(), " in \"", selector, "\"")));
+        };
+
+        parser.skip_space();
+        bool child = false;
+        if (parser.peek() == '>')
+        {
+            child = true;
+            parser.advance();
+            parser.skip_space();
+        }
+
+        while (!parser.at_end())
+        {
+            Step step;
+            step.child = child;
+            if (!parse_element(parser.name(), step.kind))
+            {
+                parser.fail("expected p, r, tbl, tr, tc or *");
+                return failed();
+            }
+
+            while (parser.peek() == '[')
+            {
+                parser.advance();
+                parser.skip_space();
+                Test test;
+                if (parser.peek() == '!')
+                {
+                    test.negate = true;
+                    parser.advance();
+                }
+                const absl::string_view property = parser.name();
+                parser.skip_space();
+                if (parser.peek() == '=')
+                {
+                    parser.advance();
+                    parser.skip_space();
+                    test.has_value = true;
+                    if (!parser.value(test.text))
+                        return failed();
+                    parser.skip_space();
+                }
+                if (parser.peek() != ']')
+                {
+                    parser.fail("expected ']'");
+                    return failed();
+                }
+                parser.advance();
+
+                // 值在编译期解码，匹配时只做整数/指针比较
+                bool valid = true;
+                if (parse_flag(property, test.flag))
+                {
+                    test.property = Property::FORMATTING;
+                    valid = !test.has_value;
+                }
+                else if (property == "highlight" || property == "list")
+                {
+                    test.property = property == "list" ? Property::LIST : Property::HIGHLIGHT;
+                    valid = !test.has_value;
+                }
+                else if (property == "style" || property == "font" || property == "color")
+                {
+                    test.property = property == "style" ? Property::STYLE
+                                    : property == "font" ? Property::FONT : Property::COLOR;
+                }
+                else if (property == "size")
+                {
+                    test.property = Property::SIZE;
+                    valid = !test.has_value || numeric::parse_decimal(test.text, test.number);
+                }
+                else if (property == "level")
+                {
+                    long long level = 0;
+                    test.property = Property::LEVEL;
+                    valid = test.has_value && numeric::parse_int(test.text, level);
+                    test.number = static_cast<double>(level);
+                }
+                else if (property == "align")
+                {
+                    test.property = Property::ALIGN;
+                    valid = test.has_value && ooxml::parse(test.text == "justify" ? "both" : test.text, test.alignment);
+                }
+                else
+                {
+                    parser.fail(absl::StrCat("unknown property '", property, "'"));
+                    return failed();
+                }
+                if (!valid)
+                {
+                    parser.fail(absl::StrCat("invalid test for property '", property, "'"));
+                    return failed();
+                }
+                step.tests.push_back(std::move(test));
+            }
+
+            if (compiled.m_steps.size() == kMaxSteps)
+            {
+                parser.fail("too many steps");
+                return failed();
+            }
+            if (step.child)
+                compiled.m_child_steps |= std::uint64_t{1} << compiled.m_steps.size();
+            for (std::size_t kind = 0; kind < kElementKinds; ++kind)
+            {
+                if (step.kind == SelectorElement::ANY || static_cast<std::size_t>(step.kind) == kind)
+                    compiled.m_kind_steps[kind] |= std::uint64_t{1} << compiled.m_steps.size();
+            }
+            compiled.m_steps.push_back(std::move(step));
+
+            const bool spaced = parser.skip_space();
+            child = parser.peek() == '>';
+            if (child)
+            {
+                parser.advance();
+                parser.skip_space();
+                if (parser.at_end())
+                {
+                    parser.fail("'>' must be followed by a step");
+                    return failed();
+                }
+            }
+            else if (!spaced && !parser.at_end())
+            {
+                parser.fail("unexpected character");
+                return failed();
+            }
+        }
+
+        if (compiled.m_steps.empty())
+        {
+            parser.fail("empty selector");
+            return failed();
+        }
+        return Result<ElementSelector>(std::move(compiled));
+    }
+
+    ElementSelector ElementSelector::compile(const absl::string_view selector)
+    {
+        auto result = compile_safe(selector);
+        if (!result.ok())
+            throw std::invalid_argument(result.error().message());
+        return std::move(result.value());
+    }
+
+    bool ElementSelector::matches(const Step& step, const SelectorElement kind, const pugi::xml_node node,
+                                  Decoded& decoded)
+    {
+        for (const Test& test: step.tests)
+        {
+            bool result = false;
+            if (test.property == Property::STYLE)
+            {
+                // 样式只需一次子节点查找，不必解码整个属性节点
+                const char* style = style_of(kind, node);
+                result = test.has_value ? test.text == style : *style != '\0';
+            }
+            else if (kind == SelectorElement::RUN)
+            {
+                if (!decoded.has_run)
+                {
+                    decoded.run = Run(node.parent(), node).properties();
+                    decoded.has_run = true;
+                }
+                const RunProperties& props = decoded.run;
+                switch (test.property)
+                {
+                case Property::FORMATTING:
+                    result = (props.formatting & test.flag) != 0;
+                    break;
+                case Property::HIGHLIGHT:
+                    result = props.has_highlight;
+                    break;
+                case Property::FONT:
+                    result = test.has_value ? test.text == props.font : props.has_font;
+                    break;
+                case Property::COLOR:
+                    result = test.has_value ? props.has_color && absl::EqualsIgnoreCase(test.text, props.color)
+                                            : props.has_color;
+                    break;
+                case Property::SIZE:
+                    result = props.has_font_size && (!test.has_value || std::fabs(props.font_size - test.number) < 1e-6);
+                    break;
+                default:
+                    break;
+                }
+            }
+            else if (kind == SelectorElement::PARAGRAPH)
+            {
+                if (!decoded.has_paragraph)
+                {
+                    decoded.paragraph = Paragraph(node.parent(), node).properties();
+                    decoded.has_paragraph = true;
+                }
+                const ParagraphProperties& props = decoded.paragraph;
+                switch (test.property)
+                {
+                case Property::LIST:
+                    result = props.has_numbering;
+                    break;
+                case Property::ALIGN:
+                    result = props.alignment == test.alignment;
+                    break;
+                case Property::LEVEL:
+                    result = props.has_numbering && props.list_level == static_cast<int>(test.number);
+                    break;
+                default:
+                    break;
+                }
+            }
+            if (result == test.negate)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    void ElementSelector::walk(const pugi::xml_node node, const std::uint64_t at, const std::uint64_t below,
+                               Visitor& visit) const
+    {
+        const std::size_t last = m_steps.size();
+        // 每个步骤 k 的前驱条件：子代组合要求上一步恰好匹配父元素，后代组合只要求匹配某个祖先
+        const std::uint64_t candidates =
+            ((at & m_child_steps) | (below & ~m_child_steps)) & ((std::uint64_t{1} << last) - 1);
+        Decoded decoded;
+
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() != pugi::node_element)
+                continue;
+
+            SelectorElement kind = SelectorElement::ANY;
+            const NodeRole role = classify(child.name(), kind);
+            if (role == NodeRole::SKIP)
+                continue;
+            if (role == NodeRole::TRANSPARENT)
+            {
+                walk(child, at, below, visit);
+                continue;
+            }
+
+            std::uint64_t matched = 0;
+            decoded.has_run = false;
+            decoded.has_paragraph = false;
+            for (std::uint64_t pending = candidates & m_kind_steps[static_cast<std::size_t>(kind)]; pending != 0;
+                 pending &= pending - 1)
+            {
+                std::size_t k = 0;
+                while (((pending >> k) & 1) == 0)
+                    ++k;
+                if (matches(m_steps[k], kind, child, decoded))
+                    matched |= std::uint64_t{1} << (k + 1);
+            }
+
+            if ((matched >> last) & 1)
+                visit(ElementMatch{child, kind});
+            // 不进入 w:r：其下只有文本与绘图内容。段落下只有 run，若下一步都不能匹配 run 则整段跳过
+            if (kind == SelectorElement::RUN)
+                continue;
+            if (kind == SelectorElement::PARAGRAPH &&
+                (((matched & m_child_steps) | ((below | matched) & ~m_child_steps)) &
+                 m_kind_steps[static_cast<std::size_t>(SelectorElement::RUN)]) == 0)
+                continue;
+            walk(child, matched, below | matched, visit);
+        }
+    }
+
+    std::vector<ElementMatch> ElementSelector::select(const pugi::xml_node root) const
+    {
+        std::vector<ElementMatch> result;
+        auto collect = [&result](const ElementMatch& match) { result.push_back(match); };
+        walk(root, 1, 1, collect);
+        return result;
+    }
+
+    std::vector<ElementMatch> ElementSelector::select(const Body& body) const
+    {
+        std::vector<ElementMatch> result = select(body.get_body_node());
+        for (ElementMatch& match: result)
+            match.journal = body.journal();
+        return result;
+    }
+
+    std::size_t ElementSelector::count(const pugi::xml_node root) const
+    {
+        std::size_t total = 0;
+        auto counter = [&total](const ElementMatch&) { ++total; };
+        walk(root, 1, 1, counter);
+        return total;
+    }
+} // namespace duckx
@@ -0,0 +1,305 @@
+/*!
+ * @file Executor.cpp
+ * @brief Implementation of the default executors and parallel_for
+ */
+#include "Executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace duckx
+{
+    // ============================================================================
+    // WaitGroup
+    // ============================================================================
+
+    void WaitGroup::add(const std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_count += count;
+    }
+
+    void WaitGroup::done()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count > 0 && --m_count == 0)
+            m_zero.notify_all();
+    }
+
+    void WaitGroup::wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_zero.wait(lock, [this]() { return m_count == 0; });
+    }
+
+    // ============================================================================
+    // parallel_for
+    // ============================================================================
+
+    namespace
+    {
+        /*! @brief State of one parallel_for, shared with helpers that may start after it returned */
+        struct LoopState
+        {
+            std::size_t end = 0;
+            std::size_t grain = 1;
+            const std::function<void(std::size_t)>* body = nullptr;
+            std::atomic<std::size_t> next{0};
+            std::atomic<bool> failed{false};
+
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::size_t remaining = 0; //!< Indices not yet completed or skipped
+            std::exception_ptr error;
+
+            /*! @brief Claim and run steps until the range is exhausted */
+            void run()
+            {
+                for (;;)
+                {
+                    const std::size_t first = next.fetch_add(grain, std::memory_order_relaxed);
+                    if (first >= end)
+                        return;
+                    const std::size_t last = std::min(end, first + grain);
+
+                    std::exception_ptr caught;
+                    if (!failed.load(std::memory_order_relaxed))
+                    {
+                        try
+                        {
+                            for (std::size_t i = first; i < last; ++i)
+                                (*body)(i);
+                        }
+                        catch (...)
+                        {
+                            caught = std::current_exception();
+                            failed.store(true, std::memory_order_relaxed);
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (caught && !error)
+                        error = caught;
+                    remaining -= last - first;
+                    if (remaining == 0)
+                        finished.notify_all();
+                }
+            }
+        };
+    } // namespace
+
+    void Executor::parallel_for(const std::size_t begin, const std::size_t end,
+                                const std::function<void(std::size_t)>& body, const std::size_t grain)
+    {
+        if (begin >= end)
+            return;
+
+        const std::size_t step = std::max<std::size_t>(grain, 1);
+        const std::size_t steps = (end - begin + step - 1) / step;
+        const std::size_t helpers = std::min(steps, std::max<std::size_t>(concurrency(), 1)) - 1;
+        if (helpers == 0)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                body(i);
+            return;
+        }
+
+        // body 按引用共享：调用方只等待已领取的区段完成，之后才启动的辅助任务领不到区段，不会再访问它
+        const std::function<void(std::size_t)> shifted = [begin, &body](const std::size_t i) { body(begin + i); };
+        auto state = std::make_shared<LoopState>();
+        state->end = end - begin;
+        state->grain = step;
+        state->body = &shifted;
+        state->remaining = end - begin;
+
+        for (std::size_t i = 0; i < helpers; ++i)
+            submit([state]() { state->run(); });
+        state->run();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state]() { return state->remaining == 0; });
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+    // ============================================================================
+    // InlineExecutor
+    // ============================================================================
+
+    void InlineExecutor::submit(std::function<void()> task)
+    {
+        task();
+    }
+
+    // ============================================================================
+    // ThreadPoolExecutor
+    // ============================================================================
+
+    struct ThreadPoolExecutor::State
+    {
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> next_worker{0};
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::size_t queued = 0; //!< Tasks in all deques, guarded by mutex
+        bool stopping = false;
+
+        void push(std::size_t index, std::function<void()> task, bool local);
+        bool take(std::size_t index, std::function<void()>& task);
+        void work(std::size_t index);
+    };
+
+    namespace
+    {
+        // 当前线程所属的线程池与工作线程序号，用于把任务压入自己的队列
+        thread_local const void* t_pool = nullptr;
+        thread_local std::size_t t_worker = 0;
+    } // namespace
+
+    void ThreadPoolExecutor::State::push(const std::size_t index, std::function<void()> task, const bool local)
+    {
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            if (local)
+                workers[index]->tasks.push_back(std::move(task));
+            else
+                workers[index]->tasks.push_front(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++queued;
+        }
+        wake.notify_one();
+    }
+
+    bool ThreadPoolExecutor::State::take(const std::size_t index, std::function<void()>& task)
+    {
+        // 先取自己队列的最新任务，再从其他队列的另一端窃取最旧的任务
+        const std::size_t count = workers.size();
+        for (std::size_t offset = 0; offset < count; ++offset)
+        {
+            Worker& worker = *workers[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (worker.tasks.empty())
+                continue;
+            if (offset == 0)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPoolExecutor::State::work(const std::size_t index)
+    {
+        t_pool = this;
+        t_worker = index;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return stopping || queued > 0; });
+                if (queued == 0)
+                    return;
+            }
+
+            std::function<void()> task;
+            if (!take(index, task))
+                continue;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --queued;
+            }
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                // 任务约定不抛出异常；逃逸的异常不能终止工作线程
+            }
+        }
+    }
+
+    ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threads)
+        : m_state(new State)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < threads; ++i)
+            m_state->workers.emplace_back(new State::Worker);
+        for (std::size_t i = 0; i < threads; ++i)
+            m_state->threads.emplace_back([state = m_state.get(), i]() { state->work(i); });
+    }
+
+    ThreadPoolExecutor::~ThreadPoolExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->stopping = true;
+        }
+        m_state->wake.notify_all();
+        for (std::thread& thread: m_state->threads)
+            thread.join();
+    }
+
+    void ThreadPoolExecutor::submit(std::function<void()> task)
+    {
+        State& state = *m_state;
+        if (t_pool == &state)
+        {
+            state.push(t_worker, std::move(task), true);
+            return;
+        }
+        const std::size_t index = state.next_worker.fetch_add(1, std::memory_order_relaxed) % state.workers.size();
+        state.push(index, std::move(task), false);
+    }
+
+    std::size_t ThreadPoolExecutor::concurrency() const
+    {
+        return m_state->workers.size();
+    }
+
+    // ============================================================================
+    // Default executor
+    // ============================================================================
+
+    namespace
+    {
+        std::mutex g_default_mutex;
+        std::shared_ptr<Executor> g_default_executor;
+    } // namespace
+
+    std::shared_ptr<Executor> default_executor()
+    {
+        std::lock_guard<std::mutex> lock(g_default_mutex);
+        if (!g_default_executor)
+            g_default_executor = std::make_shared<ThreadPoolExecutor>();
+        return g_default_executor;
+    }
+
+    void set_default_executor(std::shared_ptr<Executor> executor)
+    {
+        std::lock_guard<std::mutex> lock(g_default_mutex);
+        g_default_executor = std::move(executor);
+    }
+} // namespace duckx
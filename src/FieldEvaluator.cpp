@@ -0,0 +1,883 @@
+/*!
+ * @file FieldEvaluator.cpp
+ * @brief Implementation of the field evaluation pass
+ */
+#include "FieldEvaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        const char* const kMissingBookmark = "Error! Reference source not found.";
+        const char* const kNoTocEntries = "No table of contents entries found.";
+
+        bool is(const pugi::xml_node node, const char* name)
+        {
+            return std::strcmp(node.name(), name) == 0;
+        }
+
+        // 深度优先遍历；visit 返回 false 时跳过该节点的子树
+        template <typename Visit>
+        void walk(const pugi::xml_node root, Visit visit)
+        {
+            pugi::xml_node node = root;
+            while (node)
+            {
+                if (visit(node) && node.first_child())
+                {
+                    node = node.first_child();
+                    continue;
+                }
+                while (node && node != root && !node.next_sibling())
+                    node = node.parent();
+                node = (node && node != root) ? node.next_sibling() : pugi::xml_node();
+            }
+        }
+
+        // 按空白切分域代码，双引号内的内容视为一个参数
+        std::vector<std::string> tokenize(const absl::string_view instr)
+        {
+            std::vector<std::string> tokens;
+            size_t i = 0;
+            while (i < instr.size())
+            {
+                if (absl::ascii_isspace(static_cast<unsigned char>(instr[i])))
+                {
+                    ++i;
+                    continue;
+                }
+                if (instr[i] == '"')
+                {
+                    const size_t close = instr.find('"', i + 1);
+                    const size_t end = close == absl::string_view::npos ? instr.size() : close;
+                    tokens.emplace_back(instr.substr(i + 1, end - i - 1));
+                    i = end + 1;
+                    continue;
+                }
+                const size_t begin = i;
+                while (i < instr.size() && !absl::ascii_isspace(static_cast<unsigned char>(instr[i])))
+                    ++i;
+                tokens.emplace_back(instr.substr(begin, i - begin));
+            }
+            return tokens;
+        }
+
+        bool has_switch(const std::vector<std::string>& tokens, const char* name)
+        {
+            return std::find(tokens.begin(), tokens.end(), name) != tokens.end();
+        }
+
+        const std::string* switch_argument(const std::vector<std::string>& tokens, const char* name)
+        {
+            const auto found = std::find(tokens.begin(), tokens.end(), name);
+            return found == tokens.end() || found + 1 == tokens.end() ? nullptr : &*(found + 1);
+        }
+
+        bool on_off(const pugi::xml_node node)
+        {
+            if (!node)
+                return false;
+            const char* val = node.attribute("w:val").value();
+            return std::strcmp(val, "0") != 0 && std::strcmp(val, "false") != 0 && std::strcmp(val, "off") != 0;
+        }
+
+        // "Heading N" 样式或（TOC \u 使用的）大纲级别
+        int heading_level(const pugi::xml_node paragraph, bool& from_outline_level)
+        {
+            const pugi::xml_node props = paragraph.child("w:pPr");
+            std::string style = absl::AsciiStrToLower(props.child("w:pStyle").attribute("w:val").value());
+            style.erase(std::remove(style.begin(), style.end(), ' '), style.end());
+            if (style.size() == 8 && style.compare(0, 7, "heading") == 0 && style[7] >= '1' && style[7] <= '9')
+                return style[7] - '0';
+
+            const pugi::xml_node outline = props.child("w:outlineLvl");
+            const long long level = numeric::read_int_or(outline.attribute("w:val"), 9);
+            if (outline && level >= 0 && level < 9)
+            {
+                from_outline_level = true;
+                return static_cast<int>(level) + 1;
+            }
+            return 0;
+        }
+
+        // 拉丁字符按平均字宽，多字节（CJK 等）字符按全角估算
+        double text_width(const absl::string_view text, const double size, const double average)
+        {
+            double width = 0.0;
+            for (const char c: text)
+            {
+                const unsigned char byte = static_cast<unsigned char>(c);
+                if (byte < 0x80)
+                    width += size * average;
+                else if (byte >= 0xE0)
+                    width += size;
+                else if (byte >= 0xC0)
+                    width += size * average;
+            }
+            return width;
+        }
+
+        double run_font_size(const pugi::xml_node run)
+        {
+            return numeric::read_points_or(run.child("w:rPr").child("w:sz").attribute("w:val"),
+                                           numeric::kHalfPointsPerPoint, 0.0);
+        }
+
+        pugi::xml_node append_text(pugi::xml_node run, const std::string& text)
+        {
+            pugi::xml_node t = run.append_child("w:t");
+            if (!text.empty() && (text.front() == ' ' || text.back() == ' '))
+                t.append_attribute("xml:space").set_value("preserve");
+            t.text().set(text.c_str());
+            return t;
+        }
+
+        pugi::xml_node field_char(const pugi::xml_node run, const char* type)
+        {
+            const pugi::xml_node fld = run.child("w:fldChar");
+            return fld && std::strcmp(fld.attribute("w:fldCharType").value(), type) == 0 ? fld : pugi::xml_node();
+        }
+
+        // 在同一父节点内寻找与 separate 配对的 end（跳过嵌套域）
+        pugi::xml_node matching_end(const pugi::xml_node separate)
+        {
+            int depth = 0;
+            for (pugi::xml_node node = separate.next_sibling(); node; node = node.next_sibling())
+            {
+                if (field_char(node, "begin"))
+                    ++depth;
+                else if (field_char(node, "end") && depth-- == 0)
+                    return node;
+            }
+            return pugi::xml_node();
+        }
+    } // namespace
+
+    FieldEvaluator::FieldEvaluator(const FieldEvaluationOptions& options) : m_options(options) {}
+
+    void FieldEvaluator::set_list_labels(const std::vector<ListLabel>& labels)
+    {
+        m_labels.clear();
+        for (const ListLabel& label: labels)
+            m_labels[label.paragraph.internal_object()] = label.text;
+    }
+
+    void FieldEvaluator::reset()
+    {
+        m_y = 0.0;
+        m_page = 1;
+        m_page_count = 1;
+        m_updated = 0;
+        m_unresolved = 0;
+        m_fields.clear();
+        m_open_fields.clear();
+        m_bookmarks.clear();
+        m_open_bookmarks.clear();
+        m_headings.clear();
+        m_sequences.clear();
+        m_sequence_section.clear();
+        std::fill(std::begin(m_headings_by_level), std::end(m_headings_by_level), 0);
+        m_next_bookmark_id = 0;
+    }
+
+    FieldEvaluationReport FieldEvaluator::evaluate(const pugi::xml_node body)
+    {
+        reset();
+
+        const pugi::xml_node sect = body.child("w:sectPr");
+        const pugi::xml_node size = sect.child("w:pgSz");
+        const pugi::xml_node margins = sect.child("w:pgMar");
+        const auto twips = [](const pugi::xml_node node, const char* name, const double fallback) {
+            return numeric::read_points_or(node.attribute(name), numeric::kTwipsPerPoint, fallback);
+        };
+        m_page_width = std::max(72.0, twips(size, "w:w", 612.0) - twips(margins, "w:left", 72.0) -
+                                          twips(margins, "w:right", 72.0));
+        m_page_height = std::max(72.0, twips(size, "w:h", 792.0) - twips(margins, "w:top", 72.0) -
+                                           twips(margins, "w:bottom", 72.0));
+
+        // 第一遍：估算分页，收集标题、书签与 SEQ 计数，并直接写出 PAGE/SEQ
+        m_advancing = true;
+        layout_blocks(body);
+        m_page_count = m_page;
+
+        // 第二遍：依赖后文的 REF/PAGEREF/NUMPAGES/TOC
+        for (Field& field: m_fields)
+            fill(field);
+
+        FieldEvaluationReport report;
+        report.fields_updated = m_updated;
+        report.unresolved_references = m_unresolved;
+        report.page_count = m_page_count;
+        return report;
+    }
+
+    FieldEvaluationReport FieldEvaluator::evaluate_page_part(const pugi::xml_node root)
+    {
+        m_fields.clear();
+        m_open_fields.clear();
+        m_open_bookmarks.clear();
+        m_updated = 0;
+        m_unresolved = 0;
+        m_page = 1;
+        m_advancing = false;
+
+        visit_blocks(root);
+        for (Field& field: m_fields)
+        {
+            if (field.kind != Kind::TOC)
+                fill(field);
+        }
+        m_page = m_page_count;
+
+        FieldEvaluationReport report;
+        report.fields_updated = m_updated;
+        report.unresolved_references = m_unresolved;
+        report.page_count = m_page_count;
+        return report;
+    }
+
+    // ---- Layout pass ----
+
+    void FieldEvaluator::new_page()
+    {
+        ++m_page;
+        m_y = 0.0;
+    }
+
+    void FieldEvaluator::layout_blocks(const pugi::xml_node container)
+    {
+        for (pugi::xml_node child = container.first_child(); child; child = child.next_sibling())
+        {
+            if (is(child, "w:p"))
+                layout_paragraph(child, true);
+            else if (is(child, "w:tbl"))
+                layout_table(child);
+            else if (is(child, "w:sdt"))
+                layout_blocks(child.child("w:sdtContent"));
+            else if (!is(child, "w:sectPr"))
+                visit_inline(child, nullptr);
+        }
+    }
+
+    void FieldEvaluator::visit_blocks(const pugi::xml_node container)
+    {
+        for (pugi::xml_node child = container.first_child(); child; child = child.next_sibling())
+        {
+            if (is(child, "w:p"))
+                layout_paragraph(child, false);
+            else if (is(child, "w:tbl") || is(child, "w:tr") || is(child, "w:tc"))
+                visit_blocks(child);
+            else if (is(child, "w:sdt"))
+                visit_blocks(child.child("w:sdtContent"));
+            else
+                visit_inline(child, nullptr);
+        }
+    }
+
+    void FieldEvaluator::layout_table(const pugi::xml_node table)
+    {
+        for (const pugi::xml_node row: table.children("w:tr"))
+        {
+            const auto cells = row.children("w:tc");
+            const double cell_width =
+                m_page_width / static_cast<double>(std::max<std::ptrdiff_t>(1, std::distance(cells.begin(), cells.end())));
+            double height = 0.0;
+            for (const pugi::xml_node cell: cells)
+                height = std::max(height, measure_blocks(cell, cell_width));
+
+            if (m_y > 0.0 && m_y + height > m_page_height)
+                new_page();
+
+            // 单元格内的分页符不参与估算
+            const bool advancing = m_advancing;
+            m_advancing = false;
+            visit_blocks(row);
+            m_advancing = advancing;
+            m_y += height;
+        }
+    }
+
+    void FieldEvaluator::layout_paragraph(const pugi::xml_node paragraph, const bool advance)
+    {
+        const pugi::xml_node props = paragraph.child("w:pPr");
+        double height = 0.0;
+        if (advance)
+        {
+            if (on_off(props.child("w:pageBreakBefore")) && m_y > 0.0)
+                new_page();
+            height = measure_paragraph(paragraph, m_page_width);
+            if (m_y > 0.0 && m_y + height > m_page_height)
+                new_page();
+        }
+
+        Heading heading;
+        heading.paragraph = paragraph;
+        heading.level = heading_level(paragraph, heading.from_outline_level);
+        heading.page = m_page;
+
+        const int page = m_page;
+        m_paragraph = paragraph;
+        const bool collect = heading.level > 0 && !inside_rewritten_result();
+        visit_inline(paragraph, collect ? &heading : nullptr);
+
+        if (collect)
+        {
+            for (int level = heading.level; level < 10; ++level)
+                ++m_headings_by_level[level];
+            m_headings.push_back(std::move(heading));
+        }
+
+        if (advance)
+        {
+            // 段内分页后剩余高度无法精确估计，从新页顶部继续
+            if (m_page == page)
+                m_y += height;
+            const pugi::xml_node section = props.child("w:sectPr");
+            if (section && std::strcmp(section.child("w:type").attribute("w:val").value(), "continuous") != 0)
+                new_page();
+        }
+    }
+
+    double FieldEvaluator::measure_blocks(const pugi::xml_node container, const double width) const
+    {
+        double height = 0.0;
+        for (const pugi::xml_node child: container.children())
+        {
+            if (is(child, "w:p"))
+            {
+                height += measure_paragraph(child, width);
+            }
+            else if (is(child, "w:tbl"))
+            {
+                for (const pugi::xml_node row: child.children("w:tr"))
+                {
+                    const auto cells = row.children("w:tc");
+                    const double cell_width =
+                        width / static_cast<double>(std::max<std::ptrdiff_t>(1, std::distance(cells.begin(), cells.end())));
+                    double row_height = 0.0;
+                    for (const pugi::xml_node cell: cells)
+                        row_height = std::max(row_height, measure_blocks(cell, cell_width));
+                    height += row_height;
+                }
+            }
+            else if (is(child, "w:sdt"))
+            {
+                height += measure_blocks(child.child("w:sdtContent"), width);
+            }
+        }
+        return height;
+    }
+
+    double FieldEvaluator::measure_paragraph(const pugi::xml_node paragraph, double width) const
+    {
+        const pugi::xml_node props = paragraph.child("w:pPr");
+        const pugi::xml_node ind = props.child("w:ind");
+        width -= numeric::read_points_or(ind.attribute("w:left"), numeric::kTwipsPerPoint, 0.0) +
+                 numeric::read_points_or(ind.attribute("w:right"), numeric::kTwipsPerPoint, 0.0);
+        width = std::max(width, 36.0);
+
+        double size = numeric::read_points_or(props.child("w:rPr").child("w:sz").attribute("w:val"),
+                                              numeric::kHalfPointsPerPoint, 0.0);
+        double line_width = 0.0;
+        double images = 0.0;
+        int lines = 0;
+        walk(paragraph, [&](const pugi::xml_node node) {
+            if (is(node, "w:pPr") || is(node, "w:txbxContent") || is(node, "w:instrText"))
+                return false;
+            if (is(node, "w:t"))
+            {
+                const double run_size = run_font_size(node.parent());
+                const double text_size = run_size > 0.0 ? run_size : m_options.default_font_size;
+                size = std::max(size, run_size);
+                line_width += text_width(node.text().get(), text_size, m_options.average_char_width);
+                return false;
+            }
+            if (is(node, "w:tab"))
+            {
+                line_width += 36.0;
+            }
+            else if (is(node, "w:br") || is(node, "w:cr"))
+            {
+                lines += std::max(1, static_cast<int>(std::ceil(line_width / width)));
+                line_width = 0.0;
+            }
+            else if (is(node, "wp:extent"))
+            {
+                images += numeric::read_points_or(node.attribute("cy"), numeric::kEmuPerPoint, 0.0);
+                return false;
+            }
+            return true;
+        });
+        lines += std::max(1, static_cast<int>(std::ceil(line_width / width)));
+        if (size <= 0.0)
+            size = m_options.default_font_size;
+
+        const pugi::xml_node spacing = props.child("w:spacing");
+        double line_height = size * m_options.line_spacing;
+        const pugi::xml_attribute line = spacing.attribute("w:line");
+        if (line)
+        {
+            const absl::string_view rule = spacing.attribute("w:lineRule").value();
+            const double points = numeric::read_points_or(line, numeric::kTwipsPerPoint, 0.0);
+            if (rule == "exact")
+                line_height = points;
+            else if (rule == "atLeast")
+                line_height = std::max(line_height, points);
+            else
+                line_height *= numeric::read_int_or(line, numeric::kLineSpacingUnit) /
+                               static_cast<double>(numeric::kLineSpacingUnit);
+        }
+
+        return lines * line_height + images +
+               numeric::read_points_or(spacing.attribute("w:before"), numeric::kTwipsPerPoint, 0.0) +
+               numeric::read_points_or(spacing.attribute("w:after"), numeric::kTwipsPerPoint, 0.0);
+    }
+
+    bool FieldEvaluator::inside_rewritten_result() const
+    {
+        for (const std::size_t index: m_open_fields)
+        {
+            const Field& field = m_fields[index];
+            if (field.separate && (field.kind != Kind::OTHER || field.ignored))
+                return true;
+        }
+        return false;
+    }
+
+    void FieldEvaluator::visit_inline(const pugi::xml_node root, Heading* heading)
+    {
+        walk(root, [&](const pugi::xml_node node) {
+            if (is(node, "w:t"))
+            {
+                const char* text = node.text().get();
+                for (const auto& open: m_open_bookmarks)
+                    m_bookmarks[open.second].text += text;
+                if (heading)
+                    heading->text += text;
+                return false;
+            }
+            if (is(node, "w:bookmarkStart"))
+            {
+                const int id = static_cast<int>(numeric::read_int_or(node.attribute("w:id"), -1));
+                m_next_bookmark_id = std::max(m_next_bookmark_id, id + 1);
+                const absl::string_view name = node.attribute("w:name").value();
+                if (name.empty() || inside_rewritten_result())
+                    return false;
+
+                Bookmark bookmark;
+                bookmark.name = std::string(name);
+                bookmark.page = m_page;
+                bookmark.paragraph = m_paragraph;
+                std::string key = absl::AsciiStrToLower(name);
+                if (m_bookmarks.emplace(key, std::move(bookmark)).second)
+                    m_open_bookmarks[id] = std::move(key);
+                if (heading && heading->bookmark.empty())
+                    heading->bookmark = std::string(name);
+                return false;
+            }
+            if (is(node, "w:bookmarkEnd"))
+            {
+                m_open_bookmarks.erase(static_cast<int>(numeric::read_int_or(node.attribute("w:id"), -1)));
+                return false;
+            }
+            if (is(node, "w:br"))
+            {
+                if (m_advancing && std::strcmp(node.attribute("w:type").value(), "page") == 0)
+                    new_page();
+                return false;
+            }
+            if (is(node, "w:fldSimple"))
+            {
+                Field field;
+                field.simple = node;
+                field.instruction = node.attribute("w:instr").value();
+                field.ignored = inside_rewritten_result();
+                m_fields.push_back(std::move(field));
+                field_ready(m_fields.size() - 1);
+                return true;
+            }
+            if (is(node, "w:fldChar"))
+            {
+                const absl::string_view type = node.attribute("w:fldCharType").value();
+                if (type == "begin")
+                {
+                    Field field;
+                    field.begin = node.parent();
+                    field.ignored = inside_rewritten_result();
+                    m_fields.push_back(std::move(field));
+                    m_open_fields.push_back(m_fields.size() - 1);
+                }
+                else if (!m_open_fields.empty() && type == "separate")
+                {
+                    m_fields[m_open_fields.back()].separate = node.parent();
+                    field_ready(m_open_fields.back());
+                }
+                else if (!m_open_fields.empty() && type == "end")
+                {
+                    Field& field = m_fields[m_open_fields.back()];
+                    field.end = node.parent();
+                    if (!field.separate)
+                        field_ready(m_open_fields.back());
+                    m_open_fields.pop_back();
+                }
+                return false;
+            }
+            if (is(node, "w:instrText"))
+            {
+                if (!m_open_fields.empty() && !m_fields[m_open_fields.back()].separate)
+                    m_fields[m_open_fields.back()].instruction += node.text().get();
+                return false;
+            }
+            return true;
+        });
+    }
+
+    void FieldEvaluator::field_ready(const std::size_t index)
+    {
+        Field& field = m_fields[index];
+        const std::vector<std::string> tokens = tokenize(field.instruction);
+        if (tokens.empty())
+            return;
+
+        const std::string keyword = absl::AsciiStrToUpper(tokens[0]);
+        if (keyword == "PAGE")
+            field.kind = Kind::PAGE;
+        else if (keyword == "NUMPAGES")
+            field.kind = Kind::NUMPAGES;
+        else if (keyword == "SEQ" && tokens.size() > 1)
+            field.kind = Kind::SEQ;
+        else if (keyword == "REF" && tokens.size() > 1)
+            field.kind = Kind::REF;
+        else if (keyword == "PAGEREF" && tokens.size() > 1)
+            field.kind = Kind::PAGEREF;
+        else if (keyword == "TOC")
+            field.kind = Kind::TOC;
+        if (field.ignored)
+            return;
+
+        // PAGE 与 SEQ 只依赖前文，遍历到即可写出
+        if (field.kind == Kind::PAGE)
+        {
+            if (write_result(field, format_value(field, m_page)))
+                ++m_updated;
+        }
+        else if (field.kind == Kind::SEQ)
+        {
+            const std::string key = absl::AsciiStrToLower(tokens[1]);
+            int& value = m_sequences[key];
+
+            int level = 0;
+            const std::string* section = switch_argument(tokens, "\\s");
+            if (section && absl::SimpleAtoi(*section, &level) && level >= 1 && level <= 9)
+            {
+                int& serial = m_sequence_section[key];
+                if (serial != m_headings_by_level[level])
+                    value = 0;
+                serial = m_headings_by_level[level];
+            }
+
+            int reset = 0;
+            const std::string* restart = switch_argument(tokens, "\\r");
+            if (restart && absl::SimpleAtoi(*restart, &reset))
+                value = reset;
+            else if (!has_switch(tokens, "\\c"))
+                ++value;
+
+            if (write_result(field, has_switch(tokens, "\\h") ? std::string() : format_value(field, value)))
+                ++m_updated;
+        }
+    }
+
+    // ---- Result writing ----
+
+    bool FieldEvaluator::write_result(Field& field, const std::string& text)
+    {
+        if (field.simple)
+        {
+            MutationJournal::before_change(m_journal, field.simple);
+            pugi::xml_node run = field.simple.append_child("w:r");
+            const pugi::xml_node props = field.simple.child("w:r").child("w:rPr");
+            if (props)
+                run.append_copy(props);
+            while (field.simple.first_child() != run)
+                field.simple.remove_child(field.simple.first_child());
+            append_text(run, text);
+            return true;
+        }
+
+        if (!field.separate)
+        {
+            if (!field.end)
+                return false;
+            MutationJournal::before_change(m_journal, field.end);
+            field.separate = field.end.parent().insert_child_before("w:r", field.end);
+            if (const pugi::xml_node props = field.begin.child("w:rPr"))
+                field.separate.append_copy(props);
+            field.separate.append_child("w:fldChar").append_attribute("w:fldCharType").set_value("separate");
+        }
+
+        pugi::xml_node end = field.end ? field.end : matching_end(field.separate);
+        if (!end || end.parent() != field.separate.parent())
+            return false;
+
+        // 沿用第一个结果 run 的格式，否则沿用域起始 run 的格式
+        pugi::xml_node props = field.begin.child("w:rPr");
+        for (pugi::xml_node node = field.separate.next_sibling(); node != end; node = node.next_sibling())
+        {
+            if (is(node, "w:r") && node.child("w:rPr"))
+            {
+                props = node.child("w:rPr");
+                break;
+            }
+        }
+
+        pugi::xml_node parent = field.separate.parent();
+        MutationJournal::before_change(m_journal, parent);
+        pugi::xml_node run = parent.insert_child_before("w:r", end);
+        if (props)
+            run.append_copy(props);
+        for (pugi::xml_node node = field.separate.next_sibling(); node != run;)
+        {
+            const pugi::xml_node next = node.next_sibling();
+            if (!is(node, "w:bookmarkStart") && !is(node, "w:bookmarkEnd"))
+                parent.remove_child(node);
+            node = next;
+        }
+        append_text(run, text);
+        return true;
+    }
+
+    std::string FieldEvaluator::format_value(const Field& field, const int value) const
+    {
+        const std::vector<std::string> tokens = tokenize(field.instruction);
+        const std::string* format = switch_argument(tokens, "\\*");
+        if (!format)
+            return NumberingManager::format_number(value, "decimal");
+        if (*format == "roman")
+            return NumberingManager::format_number(value, "lowerRoman");
+        if (*format == "ROMAN")
+            return NumberingManager::format_number(value, "upperRoman");
+        if (*format == "alphabetic")
+            return NumberingManager::format_number(value, "lowerLetter");
+        if (*format == "ALPHABETIC")
+            return NumberingManager::format_number(value, "upperLetter");
+        return NumberingManager::format_number(value, "decimal");
+    }
+
+    const FieldEvaluator::Bookmark* FieldEvaluator::find_bookmark(const std::string& name) const
+    {
+        const auto found = m_bookmarks.find(absl::AsciiStrToLower(name));
+        return found == m_bookmarks.end() ? nullptr : &found->second;
+    }
+
+    void FieldEvaluator::fill(Field& field)
+    {
+        if (field.ignored)
+            return;
+
+        const std::vector<std::string> tokens = tokenize(field.instruction);
+        std::string text;
+        switch (field.kind)
+        {
+        case Kind::NUMPAGES:
+            text = format_value(field, m_page_count);
+            break;
+        case Kind::REF:
+        case Kind::PAGEREF:
+        {
+            const Bookmark* bookmark = find_bookmark(tokens[1]);
+            if (!bookmark)
+            {
+                ++m_unresolved;
+                text = kMissingBookmark;
+            }
+            else if (field.kind == Kind::PAGEREF)
+            {
+                text = format_value(field, bookmark->page);
+            }
+            else
+            {
+                text = bookmark->text;
+                // \n \r \w 取书签所在段落的编号
+                if (has_switch(tokens, "\\n") || has_switch(tokens, "\\r") || has_switch(tokens, "\\w"))
+                {
+                    const auto label = m_labels.find(bookmark->paragraph.internal_object());
+                    if (label != m_labels.end())
+                        text = label->second;
+                }
+            }
+            break;
+        }
+        case Kind::TOC:
+            if (build_toc(field))
+                ++m_updated;
+            return;
+        default:
+            return;
+        }
+
+        if (write_result(field, text))
+            ++m_updated;
+    }
+
+    // ---- Table of contents ----
+
+    std::string FieldEvaluator::add_toc_bookmark(Heading& heading)
+    {
+        std::string name;
+        do
+        {
+            name = absl::StrCat("_Toc", 900000000 + m_next_toc_bookmark++);
+        } while (m_bookmarks.contains(absl::AsciiStrToLower(name)));
+
+        const int id = m_next_bookmark_id++;
+        MutationJournal::before_change(m_journal, heading.paragraph);
+        const pugi::xml_node props = heading.paragraph.child("w:pPr");
+        pugi::xml_node start = props ? heading.paragraph.insert_child_after("w:bookmarkStart", props)
+                                     : heading.paragraph.prepend_child("w:bookmarkStart");
+        numeric::write_int(start.append_attribute("w:id"), id);
+        start.append_attribute("w:name").set_value(name.c_str());
+        numeric::write_int(heading.paragraph.append_child("w:bookmarkEnd").append_attribute("w:id"), id);
+
+        Bookmark bookmark;
+        bookmark.name = name;
+        bookmark.text = heading.text;
+        bookmark.page = heading.page;
+        bookmark.paragraph = heading.paragraph;
+        m_bookmarks.emplace(absl::AsciiStrToLower(name), std::move(bookmark));
+        heading.bookmark = name;
+        return name;
+    }
+
+    bool FieldEvaluator::build_toc(Field& field)
+    {
+        if (!field.begin || !field.end)
+            return false;
+        pugi::xml_node first = field.separate ? field.separate.parent() : field.begin.parent();
+        pugi::xml_node last = field.end.parent();
+        if (!is(first, "w:p") || !is(last, "w:p") || first.parent() != last.parent())
+            return false;
+
+        const std::vector<std::string> tokens = tokenize(field.instruction);
+        int min_level = 1;
+        int max_level = 9;
+        const std::string* range = switch_argument(tokens, "\\o");
+        if (range)
+        {
+            const size_t dash = range->find('-');
+            if (dash == std::string::npos || !absl::SimpleAtoi(range->substr(0, dash), &min_level) ||
+                !absl::SimpleAtoi(range->substr(dash + 1), &max_level))
+            {
+                min_level = 1;
+                max_level = 9;
+            }
+        }
+        const bool outline_levels = has_switch(tokens, "\\u");
+        const bool style_levels = range || !outline_levels;
+        const bool hyperlinks = has_switch(tokens, "\\h");
+        const bool page_numbers = !has_switch(tokens, "\\n");
+
+        // 第一段与最后一段原地修改，其间的结果段落整体删除
+        MutationJournal::before_change(m_journal, first);
+        MutationJournal::before_change(m_journal, last);
+        if (!field.separate)
+        {
+            field.separate = last.insert_child_before("w:r", field.end);
+            field.separate.append_child("w:fldChar").append_attribute("w:fldCharType").set_value("separate");
+            first = last;
+        }
+
+        // 清除旧结果：separate 之后、end 之前的全部内容
+        pugi::xml_node container = first.parent();
+        bool last_was_entry = false; // 上次生成的结果以最后一个条目结束
+        for (pugi::xml_node node = field.separate.next_sibling(); node && node != field.end;)
+        {
+            const pugi::xml_node next = node.next_sibling();
+            first.remove_child(node);
+            node = next;
+        }
+        if (first != last)
+        {
+            for (pugi::xml_node node = first.next_sibling(); node != last;)
+            {
+                const pugi::xml_node next = node.next_sibling();
+                MutationJournal::before_remove(m_journal, node);
+                container.remove_child(node);
+                node = next;
+            }
+            for (pugi::xml_node node = last.first_child(); node != field.end;)
+            {
+                const pugi::xml_node next = node.next_sibling();
+                if (!is(node, "w:pPr"))
+                {
+                    last.remove_child(node);
+                    last_was_entry = true;
+                }
+                node = next;
+            }
+        }
+
+        pugi::xml_node previous = first;
+        pugi::xml_node last_entry;
+        for (Heading& heading: m_headings)
+        {
+            if (heading.level < min_level || heading.level > max_level ||
+                (heading.from_outline_level ? !outline_levels : !style_levels))
+                continue;
+
+            pugi::xml_node entry = first == last ? container.insert_child_after("w:p", previous)
+                                                 : container.insert_child_before("w:p", last);
+            MutationJournal::after_insert(m_journal, entry);
+            previous = entry;
+            last_entry = entry;
+
+            pugi::xml_node props = entry.append_child("w:pPr");
+            props.append_child("w:pStyle").append_attribute("w:val").set_value(
+                absl::StrCat("TOC", heading.level).c_str());
+            pugi::xml_node tab = props.append_child("w:tabs").append_child("w:tab");
+            tab.append_attribute("w:val").set_value("right");
+            tab.append_attribute("w:leader").set_value("dot");
+            numeric::write_points(tab.append_attribute("w:pos"), m_page_width, numeric::kTwipsPerPoint);
+
+            pugi::xml_node target = entry;
+            if (hyperlinks)
+            {
+                const std::string anchor = heading.bookmark.empty() ? add_toc_bookmark(heading) : heading.bookmark;
+                target = entry.append_child("w:hyperlink");
+                target.append_attribute("w:anchor").set_value(anchor.c_str());
+                target.append_attribute("w:history").set_value("1");
+            }
+
+            const auto label = m_labels.find(heading.paragraph.internal_object());
+            append_text(target.append_child("w:r"),
+                        label == m_labels.end() ? heading.text : absl::StrCat(label->second, " ", heading.text));
+            if (page_numbers)
+            {
+                target.append_child("w:r").append_child("w:tab");
+                append_text(target.append_child("w:r"), NumberingManager::format_number(heading.page, "decimal"));
+            }
+        }
+
+        if (!last_entry)
+            append_text(first.insert_child_after("w:r", field.separate), kNoTocEntries);
+        else if (first == last)
+            last_entry.append_move(field.end);
+        else if (last_was_entry && !field.end.next_sibling())
+        {
+            last_entry.append_move(field.end);
+            MutationJournal::before_remove(m_journal, last);
+            container.remove_child(last);
+        }
+        return true;
+    }
+} // namespace duckx
@@ -0,0 +1,200 @@
+/*!
+ * @file FormattingTable.cpp
+ * @brief Implementation of the columnar formatting snapshot
+ *
+ * Walks a document body once and appends decoded run and paragraph
+ * properties to the FormattingTable columns.
+ */
+#include "FormattingTable.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "BaseElement.hpp"
+
+namespace duckx
+{
+    constexpr std::uint32_t FormattingTable::kNone;
+
+    namespace
+    {
+        /*! @brief Round a point value to the given fixed-point scale */
+        std::int32_t to_fixed(const double value, const double scale)
+        {
+            return static_cast<std::int32_t>(std::lround(value * scale));
+        }
+
+        /*! @brief Elements whose subtrees never contain paragraphs or runs */
+        bool is_leaf_container(const char* name)
+        {
+            return std::strcmp(name, "w:rPr") == 0 || std::strcmp(name, "w:pPr") == 0 ||
+                   std::strcmp(name, "w:t") == 0 || std::strcmp(name, "w:sectPr") == 0 ||
+                   std::strcmp(name, "w:tblPr") == 0 || std::strcmp(name, "w:tcPr") == 0 ||
+                   std::strcmp(name, "w:trPr") == 0 || std::strcmp(name, "w:tblGrid") == 0;
+        }
+
+        /*! @brief Count the rows visit() will append, without decoding any properties */
+        void count_rows(const pugi::xml_node& node, std::size_t& runs, std::size_t& paragraphs)
+        {
+            for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+            {
+                if (child.type() != pugi::node_element) continue;
+
+                const char* name = child.name();
+                if (std::strcmp(name, "w:p") == 0) ++paragraphs;
+                else if (std::strcmp(name, "w:r") == 0) ++runs;
+                else if (is_leaf_container(name)) continue;
+                count_rows(child, runs, paragraphs);
+            }
+        }
+    } // namespace
+
+    void FormattingTable::clear()
+    {
+        fonts.clear();
+        colors.clear();
+        styles.clear();
+
+        run_paragraph.clear();
+        run_font.clear();
+        run_color.clear();
+        run_style.clear();
+        run_size.clear();
+        run_flags.clear();
+        run_highlight.clear();
+        run_text_bytes.clear();
+
+        paragraph_style.clear();
+        paragraph_alignment.clear();
+        paragraph_spacing_before.clear();
+        paragraph_spacing_after.clear();
+        paragraph_line_spacing.clear();
+        paragraph_indent_left.clear();
+        paragraph_indent_first_line.clear();
+        paragraph_in_table.clear();
+        paragraph_in_list.clear();
+
+        m_font_ids.clear();
+        m_color_ids.clear();
+        m_style_ids.clear();
+    }
+
+    void FormattingTable::reserve(const std::size_t runs, const std::size_t paragraphs)
+    {
+        run_paragraph.reserve(runs);
+        run_font.reserve(runs);
+        run_color.reserve(runs);
+        run_style.reserve(runs);
+        run_size.reserve(runs);
+        run_flags.reserve(runs);
+        run_highlight.reserve(runs);
+        run_text_bytes.reserve(runs);
+
+        paragraph_style.reserve(paragraphs);
+        paragraph_alignment.reserve(paragraphs);
+        paragraph_spacing_before.reserve(paragraphs);
+        paragraph_spacing_after.reserve(paragraphs);
+        paragraph_line_spacing.reserve(paragraphs);
+        paragraph_indent_left.reserve(paragraphs);
+        paragraph_indent_first_line.reserve(paragraphs);
+        paragraph_in_table.reserve((paragraphs + 63) / 64);
+        paragraph_in_list.reserve((paragraphs + 63) / 64);
+    }
+
+    void FormattingTable::extract(const pugi::xml_node& body)
+    {
+        // 新表先数一遍行数一次分配到位；复用的表保留了容量，不再多走一遍
+        if (run_paragraph.capacity() == 0 && paragraph_style.capacity() == 0)
+        {
+            std::size_t runs = 0, paragraphs = 0;
+            count_rows(body, runs, paragraphs);
+            reserve(runs, paragraphs);
+        }
+        visit(body, kNone, false);
+    }
+
+    void FormattingTable::visit(const pugi::xml_node& node, const std::uint32_t paragraph, const bool in_table)
+    {
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() != pugi::node_element) continue;
+
+            const char* name = child.name();
+            if (std::strcmp(name, "w:p") == 0)
+            {
+                add_paragraph(child, in_table);
+                visit(child, static_cast<std::uint32_t>(paragraph_count() - 1), in_table);
+            }
+            else if (std::strcmp(name, "w:r") == 0)
+            {
+                add_run(child, paragraph);
+                // Text boxes and other drawings nest whole paragraphs inside a run
+                visit(child, paragraph, in_table);
+            }
+            else if (std::strcmp(name, "w:tbl") == 0)
+            {
+                visit(child, paragraph, true);
+            }
+            else if (!is_leaf_container(name))
+            {
+                // Hyperlinks, content controls, revisions, ...
+                visit(child, paragraph, in_table);
+            }
+        }
+    }
+
+    void FormattingTable::add_paragraph(const pugi::xml_node& paragraph, const bool in_table)
+    {
+        const ParagraphProperties props = Paragraph(paragraph.parent(), paragraph).properties();
+        const std::size_t index = paragraph_count();
+
+        paragraph_style.push_back(*props.style ? intern(props.style, styles, m_style_ids) : kNone);
+        paragraph_alignment.push_back(static_cast<std::uint8_t>(props.alignment));
+        paragraph_spacing_before.push_back(to_fixed(props.spacing_before, 20.0));
+        paragraph_spacing_after.push_back(to_fixed(props.spacing_after, 20.0));
+        paragraph_line_spacing.push_back(to_fixed(props.line_spacing, 240.0));
+        paragraph_indent_left.push_back(to_fixed(props.indent_left, 20.0));
+        paragraph_indent_first_line.push_back(to_fixed(props.indent_first_line, 20.0));
+        push_bit(paragraph_in_table, index, in_table);
+        push_bit(paragraph_in_list, index, props.has_numbering);
+    }
+
+    void FormattingTable::add_run(const pugi::xml_node& run, const std::uint32_t paragraph)
+    {
+        const RunProperties props = Run(run.parent(), run).properties();
+
+        std::size_t text_bytes = 0;
+        for (pugi::xml_node text = run.child("w:t"); text; text = text.next_sibling("w:t"))
+        {
+            text_bytes += std::strlen(text.text().get());
+        }
+
+        run_paragraph.push_back(paragraph);
+        run_font.push_back(props.has_font ? intern(props.font, fonts, m_font_ids) : kNone);
+        run_color.push_back(props.has_color ? intern(props.color, colors, m_color_ids) : kNone);
+        run_style.push_back(*props.style ? intern(props.style, styles, m_style_ids) : kNone);
+        run_size.push_back(props.has_font_size ? static_cast<std::uint16_t>(to_fixed(props.font_size, 2.0)) : 0);
+        run_flags.push_back(static_cast<std::uint16_t>(props.formatting));
+        run_highlight.push_back(static_cast<std::uint8_t>(props.highlight));
+        run_text_bytes.push_back(static_cast<std::uint32_t>(text_bytes));
+    }
+
+    std::uint32_t FormattingTable::intern(const absl::string_view value, std::vector<std::string>& pool,
+                                          absl::flat_hash_map<std::string, std::uint32_t>& ids)
+    {
+        // Heterogeneous lookup: no std::string is built for values already pooled
+        const auto it = ids.find(value);
+        if (it != ids.end()) return it->second;
+
+        const auto id = static_cast<std::uint32_t>(pool.size());
+        pool.emplace_back(value.data(), value.size());
+        ids.emplace(pool.back(), id);
+        return id;
+    }
+
+    void FormattingTable::push_bit(std::vector<std::uint64_t>& bits, const std::size_t index, const bool value)
+    {
+        if (index % 64 == 0) bits.push_back(0);
+        if (value) bits.back() |= std::uint64_t{1} << (index % 64);
+    }
+} // namespace duckx
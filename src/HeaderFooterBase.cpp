@@ -6,21 +6,26 @@
  * content management and XML node handling.
  */
 #include "HeaderFooterBase.hpp"
+#include "MutationJournal.hpp"
 
 namespace duckx
 {
-    HeaderFooterBase::HeaderFooterBase(const pugi::xml_node rootNode) : m_rootNode(rootNode)
+    HeaderFooterBase::HeaderFooterBase(const pugi::xml_node rootNode, MutationJournal* journal)
+        : m_rootNode(rootNode), m_journal(journal)
     {
         if (m_rootNode) {
             m_paragraph.set_parent(m_rootNode);
             m_table.set_parent(m_rootNode);
         }
+        m_paragraph.set_journal(m_journal);
+        m_table.set_journal(m_journal);
     }
 
     Paragraph HeaderFooterBase::add_paragraph(const std::string& text, formatting_flag f)
     {
         const pugi::xml_node new_p_node = m_rootNode.append_child("w:p");
-        Paragraph new_p(m_rootNode, new_p_node);
+        MutationJournal::after_insert(m_journal, new_p_node);
+        Paragraph new_p(m_rootNode, new_p_node, m_journal);
 
         if (!text.empty()) {
             new_p.add_run(text, f);
@@ -32,6 +37,7 @@ namespace duckx
     Table HeaderFooterBase::add_table(const int rows, const int cols)
     {
         pugi::xml_node new_tbl_node = m_rootNode.append_child("w:tbl");
+        MutationJournal::after_insert(m_journal, new_tbl_node);
 
         pugi::xml_node tbl_pr_node = new_tbl_node.append_child("w:tblPr");
         pugi::xml_node tbl_borders_node = tbl_pr_node.append_child("w:tblBorders");
@@ -55,14 +61,14 @@ namespace duckx
             }
         }
 
-        return {m_rootNode, new_tbl_node};
+        return {m_rootNode, new_tbl_node, m_journal};
     }
 
-    Header::Header(const pugi::xml_node rootNode)
-        : HeaderFooterBase(rootNode)
+    Header::Header(const pugi::xml_node rootNode, MutationJournal* journal)
+        : HeaderFooterBase(rootNode, journal)
     {}
 
-    Footer::Footer(const pugi::xml_node rootNode)
-        : HeaderFooterBase(rootNode)
+    Footer::Footer(const pugi::xml_node rootNode, MutationJournal* journal)
+        : HeaderFooterBase(rootNode, journal)
     {}
 }
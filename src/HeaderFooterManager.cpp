@@ -6,11 +6,18 @@
  * headers and footers with support for different page types.
  */
 #include "HeaderFooterManager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "Document.hpp"
 #include "DocxFile.hpp"
 #include "HeaderFooterBase.hpp"
+#include "MutationJournal.hpp"
+#include "OoxmlEnums.hpp"
 
 namespace duckx
 {
@@ -24,56 +31,265 @@ namespace duckx
         }
     };
 
+    namespace
+    {
+        std::uint64_t fnv1a_64(const std::string& data)
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (const char c: data)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::string print_part(const pugi::xml_document& xml)
+        {
+            xml_string_writer writer;
+            xml.print(writer, "", pugi::format_raw);
+            return std::move(writer.result);
+        }
+
+        std::shared_ptr<const HeaderFooterTemplate> empty_part_template(const bool is_header)
+        {
+            static const auto header = HeaderFooterTemplate::intern(
+                R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+                R"(<w:hdr xmlns:w="http://schemas.openxmlformats.org/wordprocessingml/2006/main"></w:hdr>)");
+            static const auto footer = HeaderFooterTemplate::intern(
+                R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>)"
+                R"(<w:ftr xmlns:w="http://schemas.openxmlformats.org/wordprocessingml/2006/main"></w:ftr>)");
+            return is_header ? header : footer;
+        }
+
+        // 节属性位于正文级段落的 w:pPr 中（含内容控件内的段落），最后一节位于 w:body 末尾
+        void collect_section_properties(const pugi::xml_node container, std::vector<pugi::xml_node>& sections)
+        {
+            for (pugi::xml_node child = container.first_child(); child; child = child.next_sibling())
+            {
+                const char* name = child.name();
+                if (std::strcmp(name, "w:p") == 0)
+                {
+                    if (const pugi::xml_node sectPr = child.child("w:pPr").child("w:sectPr"))
+                        sections.push_back(sectPr);
+                }
+                else if (std::strcmp(name, "w:sectPr") == 0)
+                {
+                    sections.push_back(child);
+                }
+                else if (std::strcmp(name, "w:sdt") == 0)
+                {
+                    collect_section_properties(child.child("w:sdtContent"), sections);
+                }
+            }
+        }
+
+        // 进程内模板池：相同内容的页眉/页脚只保留一份序列化字节
+        struct TemplatePool
+        {
+            std::mutex mutex;
+            std::unordered_map<std::uint64_t, std::weak_ptr<const HeaderFooterTemplate>> entries;
+            std::size_t prune_at = 64; //!< Size at which expired entries are next swept
+        };
+
+        TemplatePool& template_pool()
+        {
+            static TemplatePool pool;
+            return pool;
+        }
+
+        // 调用方需持有 pool.mutex
+        std::shared_ptr<const HeaderFooterTemplate> find_template(TemplatePool& pool, const std::uint64_t hash,
+                                                                  const std::string& xml)
+        {
+            const auto found = pool.entries.find(hash);
+            if (found == pool.entries.end())
+                return nullptr;
+            std::shared_ptr<const HeaderFooterTemplate> existing = found->second.lock();
+            return existing && existing->xml() == xml ? existing : nullptr;
+        }
+    } // namespace
+
+    HeaderFooterTemplate::HeaderFooterTemplate(std::string xml, const std::uint64_t hash, const bool is_header)
+        : m_xml(std::move(xml)), m_hash(hash), m_is_header(is_header)
+    {
+    }
+
+    std::shared_ptr<const HeaderFooterTemplate> HeaderFooterTemplate::intern(std::string xml)
+    {
+        // 命中时只需计算哈希并比较字节，解析校验留给真正的未命中
+        const std::uint64_t hash = fnv1a_64(xml);
+        TemplatePool& pool = template_pool();
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (std::shared_ptr<const HeaderFooterTemplate> existing = find_template(pool, hash, xml))
+                return existing;
+        }
+
+        pugi::xml_document probe;
+        if (!probe.load_string(xml.c_str()))
+            throw std::invalid_argument("Header/footer template is not well-formed XML");
+
+        const pugi::xml_node root = probe.document_element();
+        const std::string root_name = root.name();
+        if (root_name != "w:hdr" && root_name != "w:ftr")
+            throw std::invalid_argument("Header/footer template root must be <w:hdr> or <w:ftr>, got <" + root_name + ">");
+
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        // 解析期间其他线程可能已加入相同内容
+        if (std::shared_ptr<const HeaderFooterTemplate> existing = find_template(pool, hash, xml))
+            return existing;
+
+        // 池每增长一倍才清理一次已失效的条目，清理开销按插入摊销为常数
+        if (pool.entries.size() >= pool.prune_at)
+        {
+            for (auto it = pool.entries.begin(); it != pool.entries.end();)
+            {
+                if (it->second.expired())
+                    it = pool.entries.erase(it);
+                else
+                    ++it;
+            }
+            pool.prune_at = std::max<std::size_t>(64, 2 * pool.entries.size());
+        }
+
+        std::shared_ptr<const HeaderFooterTemplate> created(
+            new HeaderFooterTemplate(std::move(xml), hash, root_name == "w:hdr"));
+        pool.entries[hash] = created;
+        return created;
+    }
+
     HeaderFooterManager::HeaderFooterManager(Document* m_owner_doc, DocxFile* file, pugi::xml_document* doc_xml,
                                              pugi::xml_document* rels_xml,
                                              pugi::xml_document* content_types_xml)
         : m_file(file), m_doc_xml(doc_xml), m_rels_xml(rels_xml), m_content_types_xml(content_types_xml),
         m_doc(m_owner_doc)
     {
+        discover_parts();
     }
 
-    void HeaderFooterManager::save_all() const
+    void HeaderFooterManager::discover_parts()
     {
-        for (auto const& pair: m_headers)
+        // 只建立索引，不读取也不解析部件内容
+        const pugi::xml_node relationships = m_rels_xml->child("Relationships");
+        if (!relationships)
+            return;
+
+        std::vector<pugi::xml_node> sections;
+        collect_section_properties(m_doc_xml->child("w:document").child("w:body"), sections);
+
+        // 各节通常共用同一 rId，每个 rId 只解析一次；无法解析的记为空
+        std::map<std::string, std::string> entry_of_rid;
+
+        // 按文档顺序处理：没有某类型引用的节沿用前一节的部件，因此后出现的引用覆盖先前的
+        for (const pugi::xml_node sectPr: sections)
         {
-            HeaderFooterType type = pair.first;
-            if (m_hf_docs.count(type))
+            for (pugi::xml_node ref = sectPr.first_child(); ref; ref = ref.next_sibling())
             {
-                xml_string_writer writer;
-                m_hf_docs.at(type)->print(writer, "", pugi::format_raw);
-                m_file->write_entry(get_part_name_for_type(type, "header"), writer.result);
+                const std::string ref_name = ref.name();
+                const bool is_header = ref_name == "w:headerReference";
+                if (!is_header && ref_name != "w:footerReference")
+                    continue;
+
+                HeaderFooterType type = HeaderFooterType::DEFAULT;
+                const pugi::xml_attribute type_attr = ref.attribute("w:type");
+                if (type_attr && !ooxml::parse(type_attr.value(), type))
+                    continue;
+
+                const std::string rid = ref.attribute("r:id").value();
+                auto known = entry_of_rid.find(rid);
+                if (known == entry_of_rid.end())
+                {
+                    const pugi::xml_node rel = relationships.find_child_by_attribute("Relationship", "Id", rid.c_str());
+                    const std::string target = rel.attribute("Target").value();
+                    // Targets are relative to word/ unless given as an absolute part name
+                    std::string entry = target.empty() ? "" : target[0] == '/' ? target.substr(1) : "word/" + target;
+                    if (!entry.empty() && m_parts.count(entry) == 0)
+                    {
+                        // 不同 rId 指向同一目标时同样只建立一个部件
+                        if (m_file->has_entry(entry))
+                        {
+                            Part& part = m_parts[entry];
+                            part.entry = entry;
+                            part.is_header = is_header;
+                            part.in_archive = true;
+                        }
+                        else
+                        {
+                            entry.clear();
+                        }
+                    }
+                    known = entry_of_rid.emplace(rid, std::move(entry)).first;
+                }
+                if (!known->second.empty())
+                    (is_header ? m_header_entries : m_footer_entries)[type] = known->second;
             }
         }
+    }
+
+    HeaderFooterManager::Part* HeaderFooterManager::find_part(const TypeMap& types, const HeaderFooterType type)
+    {
+        const auto found = types.find(type);
+        return found != types.end() ? &m_parts.at(found->second) : nullptr;
+    }
 
-        for (auto const& pair: m_footers)
+    void HeaderFooterManager::save_all()
+    {
+        for (auto& pair: m_parts)
         {
-            HeaderFooterType type = pair.first;
-            if (m_hf_docs.count(type))
-            {
-                xml_string_writer writer;
-                m_hf_docs.at(type)->print(writer, "", pugi::format_raw);
-                m_file->write_entry(get_part_name_for_type(type, "footer"), writer.result);
-            }
+            save_part(pair.second);
         }
     }
 
-    std::string HeaderFooterManager::hf_type_to_string(const HeaderFooterType type)
+    void HeaderFooterManager::save_part(Part& part) const
     {
-        static const std::map<HeaderFooterType, std::string> type_map = {
-                {HeaderFooterType::DEFAULT, "default"},
-                {HeaderFooterType::FIRST, "first"},
-                {HeaderFooterType::EVEN, "even"},
-                {HeaderFooterType::ODD, "odd"}
-        };
-        return type_map.at(type);
+        if (part.xml)
+        {
+            std::string content = print_part(*part.xml);
+            const std::uint64_t hash = fnv1a_64(content);
+            if (part.in_archive && hash == part.archived_hash)
+                return;
+
+            m_file->write_entry(part.entry, content);
+            part.archived_hash = hash;
+            part.in_archive = true;
+        }
+        else if (part.shared && !part.in_archive)
+        {
+            // 未被访问的模板部件直接写出共享的字节，无需重新解析与打印
+            m_file->write_entry(part.entry, part.shared->xml());
+            part.in_archive = true;
+        }
+    }
+
+    pugi::xml_node HeaderFooterManager::materialize(Part& part, const char* root_tag) const
+    {
+        if (!part.xml)
+        {
+            auto xml = std::make_unique<pugi::xml_document>();
+            const std::string content = part.shared ? part.shared->xml() : m_file->read_entry(part.entry);
+            if (!xml->load_string(content.c_str()))
+                throw std::runtime_error("Failed to parse " + part.entry);
+
+            // 以重新打印后的哈希为基准，未修改的部件在保存时不会被写回
+            part.archived_hash = fnv1a_64(print_part(*xml));
+            part.xml = std::move(xml);
+            part.shared.reset();
+            m_doc->journal().watch(*part.xml, DocumentPart::HEADER_FOOTER);
+        }
+
+        const pugi::xml_node root = part.xml->child(root_tag);
+        if (!root)
+            throw std::runtime_error(part.entry + " has no <" + root_tag + "> root element");
+        return root;
     }
 
     Header& HeaderFooterManager::get_header(const HeaderFooterType type)
     {
         if (m_headers.find(type) == m_headers.end())
         {
-            pugi::xml_node root = create_hf_part("header", type);
-            m_headers[type] = std::make_unique<Header>(root);
+            Part* found = find_part(m_header_entries, type);
+            Part& part = found ? *found : create_hf_part("header", type);
+            m_headers[type] = std::make_unique<Header>(materialize(part, "w:hdr"), &m_doc->journal());
         }
         return *m_headers.at(type);
     }
@@ -82,67 +298,184 @@ namespace duckx
     {
         if (m_footers.find(type) == m_footers.end())
         {
-            pugi::xml_node root = create_hf_part("footer", type);
-            m_footers[type] = std::make_unique<Footer>(root);
+            Part* found = find_part(m_footer_entries, type);
+            Part& part = found ? *found : create_hf_part("footer", type);
+            m_footers[type] = std::make_unique<Footer>(materialize(part, "w:ftr"), &m_doc->journal());
         }
         return *m_footers.at(type);
     }
 
-    pugi::xml_node HeaderFooterManager::create_hf_part(const std::string& type_str, const HeaderFooterType type_enum)
+    std::vector<pugi::xml_node> HeaderFooterManager::load_all()
     {
-        // 1. Generate unique file name and relationship ID
-        int& id_counter = (type_str == "header") ? m_header_id_counter : m_footer_id_counter;
-        const std::string target_file = type_str + std::to_string(id_counter++) + ".xml";
+        std::vector<pugi::xml_node> roots;
+        roots.reserve(m_parts.size());
+        for (auto& pair: m_parts)
+        {
+            roots.push_back(materialize(pair.second, pair.second.is_header ? "w:hdr" : "w:ftr"));
+        }
+        return roots;
+    }
 
-        if (type_str == "header")
+    void HeaderFooterManager::drop_unreferenced_parts()
+    {
+        std::set<std::string> referenced;
+        for (const pugi::xml_node rel: m_rels_xml->child("Relationships").children("Relationship"))
         {
-            m_header_filenames[type_enum] = target_file;
+            const std::string target = rel.attribute("Target").value();
+            if (!target.empty())
+                referenced.insert(target[0] == '/' ? target.substr(1) : "word/" + target);
         }
-        else
+
+        for (auto it = m_parts.begin(); it != m_parts.end();)
         {
-            m_footer_filenames[type_enum] = target_file;
+            if (referenced.count(it->first) != 0)
+            {
+                ++it;
+                continue;
+            }
+            if (it->second.xml)
+                m_doc->journal().unwatch(*it->second.xml);
+            it = m_parts.erase(it);
         }
 
-        const std::string rId = add_hf_relationship("word/" + target_file, type_str);
+        // 重新按节属性确定各类型使用的部件；部件变化的 Header/Footer 对象随之销毁
+        const TypeMap old_headers = std::move(m_header_entries);
+        const TypeMap old_footers = std::move(m_footer_entries);
+        m_header_entries.clear();
+        m_footer_entries.clear();
+        discover_parts();
 
-        // 2. Add content type
-        const std::string part_name = "/word/" + target_file;
-        const std::string content_type = "application/vnd.openxmlformats-officedocument.wordprocessingml." + type_str +
-                                         "+xml";
-        add_content_type(part_name, content_type);
+        const auto drop = [](const TypeMap& old_types, const TypeMap& types, auto& instances) {
+            for (const auto& pair: old_types)
+            {
+                const auto found = types.find(pair.first);
+                if (found == types.end() || found->second != pair.second)
+                    instances.erase(pair.first);
+            }
+        };
+        drop(old_headers, m_header_entries, m_headers);
+        drop(old_footers, m_footer_entries, m_footers);
+    }
 
-        // 3. Create the XML content and write to a new entry in the zip
-        const std::string root_tag = (type_str == "header") ? "hdr" : "ftr";
-        const std::string xml_content = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?><w:)" + root_tag +
-                                        " xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"></w:"
-                                        +
-                                        root_tag + ">";
-        m_file->write_entry("word/" + target_file, xml_content);
+    bool HeaderFooterManager::has_header(const HeaderFooterType type) const
+    {
+        return m_header_entries.count(type) != 0;
+    }
 
-        // 4. Add reference to section properties
-        add_hf_reference_to_sect_pr(rId, type_str, type_enum);
+    bool HeaderFooterManager::has_footer(const HeaderFooterType type) const
+    {
+        return m_footer_entries.count(type) != 0;
+    }
 
-        // 5. Load the newly created XML into a pugixml document and return the root node
-        auto hf_doc = std::make_unique<pugi::xml_document>();
-        hf_doc->load_string(xml_content.c_str());
-        const pugi::xml_node root = hf_doc->child(("w:" + root_tag).c_str());
+    std::shared_ptr<const HeaderFooterTemplate> HeaderFooterManager::header_template(const HeaderFooterType type)
+    {
+        get_header(type);
+        return make_template(*find_part(m_header_entries, type), "w:hdr");
+    }
 
-        m_hf_docs[type_enum] = std::move(hf_doc); // Store the document to keep it in memory
-        return root;
+    std::shared_ptr<const HeaderFooterTemplate> HeaderFooterManager::footer_template(const HeaderFooterType type)
+    {
+        get_footer(type);
+        return make_template(*find_part(m_footer_entries, type), "w:ftr");
+    }
+
+    void HeaderFooterManager::set_header_template(const HeaderFooterType type,
+                                                  std::shared_ptr<const HeaderFooterTemplate> tmpl)
+    {
+        if (!tmpl || !tmpl->is_header())
+            throw std::invalid_argument("set_header_template requires a header template");
+
+        Part* found = find_part(m_header_entries, type);
+        Part& part = found ? *found : create_hf_part("header", type);
+        apply_template(part, "w:hdr", std::move(tmpl));
+    }
+
+    void HeaderFooterManager::set_footer_template(const HeaderFooterType type,
+                                                  std::shared_ptr<const HeaderFooterTemplate> tmpl)
+    {
+        if (!tmpl || tmpl->is_header())
+            throw std::invalid_argument("set_footer_template requires a footer template");
+
+        Part* found = find_part(m_footer_entries, type);
+        Part& part = found ? *found : create_hf_part("footer", type);
+        apply_template(part, "w:ftr", std::move(tmpl));
+    }
+
+    std::shared_ptr<const HeaderFooterTemplate> HeaderFooterManager::make_template(Part& part,
+                                                                                   const char* root_tag) const
+    {
+        materialize(part, root_tag);
+        return HeaderFooterTemplate::intern(print_part(*part.xml));
     }
 
-    std::string HeaderFooterManager::get_part_name_for_type(const HeaderFooterType type,
-                                                            const std::string& hf_keyword) const
+    void HeaderFooterManager::apply_template(Part& part, const char* root_tag,
+                                             std::shared_ptr<const HeaderFooterTemplate> tmpl) const
     {
-        if (hf_keyword == "header" && m_header_filenames.count(type))
+        if (!part.xml && !m_doc->in_transaction())
         {
-            return "word/" + m_header_filenames.at(type);
+            // 尚未解析的部件只记录模板，保存时直接复用其字节
+            part.shared = std::move(tmpl);
+            part.in_archive = false;
+            return;
         }
-        if (hf_keyword == "footer" && m_footer_filenames.count(type))
+
+        // 事务中先解析部件，替换内容才能被记录与撤销
+        materialize(part, root_tag);
+        MutationJournal* journal = &m_doc->journal();
+
+        // 已交出 Header/Footer 引用的部件需保留根节点，只替换其属性与子节点
+        pugi::xml_document source;
+        source.load_string(tmpl->xml().c_str());
+        const pugi::xml_node source_root = source.child(root_tag);
+
+        pugi::xml_node root = part.xml->child(root_tag);
+        MutationJournal::before_change(journal, root);
+        while (root.first_attribute())
+            root.remove_attribute(root.first_attribute());
+        while (root.first_child())
         {
-            return "word/" + m_footer_filenames.at(type);
+            MutationJournal::before_remove(journal, root.first_child());
+            root.remove_child(root.first_child());
         }
-        return "";
+        for (const pugi::xml_attribute attr: source_root.attributes())
+            root.append_attribute(attr.name()).set_value(attr.value());
+        for (const pugi::xml_node child: source_root.children())
+            MutationJournal::after_insert(journal, root.append_copy(child));
+    }
+
+    HeaderFooterManager::Part& HeaderFooterManager::create_hf_part(const std::string& type_str,
+                                                                  const HeaderFooterType type_enum)
+    {
+        // 1. Generate a file name not used by any existing part, and a relationship ID
+        const bool is_header = type_str == "header";
+        int& id_counter = is_header ? m_header_id_counter : m_footer_id_counter;
+        MutationJournal::before_counter_change(&m_doc->journal(), id_counter);
+        std::string target_file = type_str + std::to_string(id_counter++) + ".xml";
+        while (m_file->has_entry("word/" + target_file))
+        {
+            target_file = type_str + std::to_string(id_counter++) + ".xml";
+        }
+
+        const std::string rId = add_hf_relationship("word/" + target_file, type_str);
+
+        // 2. Add content type
+        const std::string part_name = "/word/" + target_file;
+        const std::string content_type = "application/vnd.openxmlformats-officedocument.wordprocessingml." + type_str +
+                                         "+xml";
+        add_content_type(part_name, content_type);
+
+        // 3. Add reference to section properties
+        add_hf_reference_to_sect_pr(rId, type_str, type_enum);
+
+        // 4. Start from an empty part; it is written to the archive on the next save
+        const std::string entry = "word/" + target_file;
+        Part& part = m_parts[entry];
+        part.entry = entry;
+        part.is_header = is_header;
+        part.shared = empty_part_template(is_header);
+        part.in_archive = false;
+        (is_header ? m_header_entries : m_footer_entries)[type_enum] = entry;
+        return part;
     }
 
     std::string HeaderFooterManager::add_hf_relationship(const std::string& target_file,
@@ -156,6 +489,7 @@ namespace duckx
         rel_node.append_attribute("Type").set_value(
                 ("http://schemas.openxmlformats.org/officeDocument/2006/relationships/" + hf_keyword_str).c_str());
         rel_node.append_attribute("Target").set_value(target_file.substr(target_file.find('/') + 1).c_str());
+        MutationJournal::after_insert(&m_doc->journal(), rel_node);
 
         return rId;
     }
@@ -166,17 +500,21 @@ namespace duckx
         pugi::xml_node override_node = types_node.append_child("Override");
         override_node.append_attribute("PartName").set_value(part_name.c_str());
         override_node.append_attribute("ContentType").set_value(content_type.c_str());
+        MutationJournal::after_insert(&m_doc->journal(), override_node);
+        m_doc->mark_dirty(DocumentPart::CONTENT_TYPES);
     }
 
     void HeaderFooterManager::add_hf_reference_to_sect_pr(const std::string& rId, const std::string& hf_keyword,
                                                           const HeaderFooterType type) const
     {
         pugi::xml_node sectPr = get_or_create_sect_pr();
+        MutationJournal::before_change(&m_doc->journal(), sectPr);
+        m_doc->mark_dirty(DocumentPart::MAIN_DOCUMENT);
         const std::string ref_tag = "w:" + hf_keyword + "Reference";
 
         pugi::xml_node ref_node = sectPr.append_child(ref_tag.c_str());
 
-        ref_node.append_attribute("w:type").set_value(hf_type_to_string(type).c_str());
+        ref_node.append_attribute("w:type").set_value(ooxml::to_string(type));
         ref_node.append_attribute("r:id").set_value(rId.c_str());
 
         if (type == HeaderFooterType::FIRST || type == HeaderFooterType::EVEN || type == HeaderFooterType::ODD)
@@ -198,6 +536,7 @@ namespace duckx
         if (!sectPr)
         {
             sectPr = body.append_child("w:sectPr");
+            MutationJournal::after_insert(&m_doc->journal(), sectPr);
         }
         return sectPr;
     }
@@ -7,6 +7,7 @@
  */
 #include "HyperlinkManager.hpp"
 #include "Document.hpp" // Include full header for get_unique_rid()
+#include "MutationJournal.hpp"
 
 namespace duckx
 {
@@ -32,6 +33,7 @@ namespace duckx
                 "http://schemas.openxmlformats.org/officeDocument/2006/relationships/hyperlink");
         rel_node.append_attribute("Target").set_value(url.c_str());
         rel_node.append_attribute("TargetMode").set_value("External");
+        MutationJournal::after_insert(&m_doc->journal(), rel_node);
 
         return rId;
     }
@@ -10,24 +10,14 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 namespace duckx
 {
-    std::string relative_from_to_string(RelativeFrom rel)
-    {
-        switch (rel)
-        {
-            case RelativeFrom::PAGE:
-                return "page";
-            case RelativeFrom::MARGIN:
-                return "margin";
-            default:
-                return "page";
-        }
-    }
-
     Image::Image(std::string path, const int max_width_px) : m_path(std::move(path))
     {
         if (m_path.empty())
@@ -80,8 +70,8 @@ namespace duckx
 
         // Convert numeric values to strings once
         const std::string docpr_id_str = std::to_string(drawing_id);
-        const std::string cx_str = std::to_string(m_width_emu);
-        const std::string cy_str = std::to_string(m_height_emu);
+        const std::string cx_str = numeric::format_int(m_width_emu).c_str();
+        const std::string cy_str = numeric::format_int(m_height_emu).c_str();
 
         // Choose between inline and anchor based on whether absolute position is set
         if (m_has_position)
@@ -136,15 +126,15 @@ namespace duckx
 
         // <wp:positionH relativeFrom="...">
         pugi::xml_node pos_h_node = anchor_node.append_child("wp:positionH");
-        pos_h_node.append_attribute("relativeFrom").set_value(relative_from_to_string(m_h_relative_from).c_str());
+        pos_h_node.append_attribute("relativeFrom").set_value(ooxml::to_string(m_h_relative_from));
         pugi::xml_node pos_h_offset = pos_h_node.append_child("wp:posOffset");
-        pos_h_offset.text().set(std::to_string(m_pos_x_emu).c_str());
+        pos_h_offset.text().set(numeric::format_int(m_pos_x_emu).c_str());
 
         // <wp:positionV relativeFrom="...">
         pugi::xml_node pos_v_node = anchor_node.append_child("wp:positionV");
-        pos_v_node.append_attribute("relativeFrom").set_value(relative_from_to_string(m_v_relative_from).c_str());
+        pos_v_node.append_attribute("relativeFrom").set_value(ooxml::to_string(m_v_relative_from));
         pugi::xml_node pos_v_offset = pos_v_node.append_child("wp:posOffset");
-        pos_v_offset.text().set(std::to_string(m_pos_y_emu).c_str());
+        pos_v_offset.text().set(numeric::format_int(m_pos_y_emu).c_str());
 
         // Add common content (extent, docPr, graphic, etc.)
         add_common_drawing_content(anchor_node, relationship_id, drawing_id, cx_str, cy_str, docpr_id_str);
@@ -11,10 +11,13 @@
 #include <algorithm>
 #include <cctype>
 #include <fstream>
-#include <sstream>
+#include <limits>
 
 #include "DocxFile.hpp"
 #include "Image.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
 
 #include "BaseElement.hpp"
 #include "Document.hpp"
@@ -26,22 +29,12 @@ namespace duckx
     {
         if (!str) return 0;
 
-        const std::string s(str);
-        if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos)
+        unsigned long long val = 0;
+        if (!numeric::parse_uint(str, val) || val > std::numeric_limits<unsigned int>::max())
         {
             return 0; // Not a valid positive number
         }
-
-        unsigned int val;
-        std::stringstream ss(s);
-        ss >> val;
-
-        if (ss.fail() || !ss.eof())
-        {
-            return 0; // Conversion failed or had extra character
-        }
-
-        return val;
+        return static_cast<unsigned int>(val);
     }
 
     MediaManager::MediaManager(Document* owner_doc, DocxFile* file, pugi::xml_document* rels_xml, pugi::xml_document* doc_xml,
@@ -72,8 +65,9 @@ namespace duckx
     Run MediaManager::add_image(const Paragraph& p, const Image& image)
     {
         // 1. Add the physical file to the zip and create the relationship
-        const std::string media_target = add_media_to_zip(image.get_path());
-        const std::string rId = add_image_relationship(media_target);
+        std::string extension;
+        const std::string content = read_image_file(image.get_path(), extension);
+        const std::string rId = add_image_part(content, extension);
         const unsigned int drawing_id = m_doc->get_unique_rid();
 
         // 2. Get the paragraph's XML node
@@ -84,11 +78,12 @@ namespace duckx
         }
 
         // 3. Create the XML structure for the image
+        MutationJournal::before_change(&m_doc->journal(), p_node);
         pugi::xml_node new_run_node = p_node.append_child("w:r");
         image.generate_drawing_xml(new_run_node, rId, drawing_id);
 
         // 4. Return a lightweight Run object
-        return {p_node, new_run_node};
+        return {p_node, new_run_node, &m_doc->journal()};
     }
 
     Run MediaManager::add_textbox(const Paragraph& p, const TextBox& textbox)
@@ -99,14 +94,19 @@ namespace duckx
             return {};
         }
 
+        MutationJournal::before_change(&m_doc->journal(), paragraph_node);
         pugi::xml_node run_node = paragraph_node.append_child("w:r");
         const unsigned int drawing_id = get_unique_docpr_id();
         textbox.generate_drawing_xml(run_node, "", drawing_id);
-        return {paragraph_node, run_node};
+        return {paragraph_node, run_node, &m_doc->journal()};
     }
 
-    // Private helper implementations
-    std::string MediaManager::add_media_to_zip(const std::string& file_path)
+    std::string MediaManager::add_image_part(const std::string& content, const std::string& extension)
+    {
+        return add_image_relationship(add_media_to_zip(content, extension));
+    }
+
+    std::string MediaManager::read_image_file(const std::string& file_path, std::string& extension)
     {
         // 1. 读取图片文件的二进制内容
         std::ifstream ifs(file_path, std::ios::binary);
@@ -114,7 +114,7 @@ namespace duckx
         {
             throw std::runtime_error("Cannot open image file: " + file_path);
         }
-        const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
 
         // 2. 提取文件扩展名并转换为小写
         size_t dot_pos = file_path.find_last_of('.');
@@ -122,23 +122,26 @@ namespace duckx
         {
             throw std::runtime_error("File has no extension: " + file_path);
         }
-        const std::string ext_with_dot = file_path.substr(dot_pos);
-        std::string ext_lower = ext_with_dot.substr(1);
-        std::transform(ext_lower.begin(), ext_lower.end(), ext_lower.begin(),
+        extension = file_path.substr(dot_pos + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
                        [](const unsigned char c) { return std::tolower(c); });
+        if (!ooxml::image_content_type(extension))
+        {
+            throw std::runtime_error("Unsupported image extension: " + extension);
+        }
+        return content;
+    }
 
+    // Private helper implementations
+    std::string MediaManager::add_media_to_zip(const std::string& content, const std::string& ext_lower)
+    {
         // 3. 检查并按需更新 [Content_Types].xml
-        // 静态映射表，用于查找扩展名对应的标准内容类型
-        static const std::map<std::string, std::string> content_type_map = {
-                {"png", "image/png"}, {"jpg", "image/jpeg"}, {"jpeg", "image/jpeg"},
-                {"gif", "image/gif"}, {"bmp", "image/bmp"},  {"tiff", "image/tiff"}};
-
-        auto it = content_type_map.find(ext_lower);
-        if (it == content_type_map.end())
+        // 查找扩展名对应的标准内容类型
+        const char* content_type = ooxml::image_content_type(ext_lower);
+        if (!content_type)
         {
             throw std::runtime_error("Unsupported image extension: " + ext_lower);
         }
-        const std::string& content_type = it->second;
 
         // 确保 m_content_types_xml 指针有效
         if (!m_content_types_xml)
@@ -156,12 +159,15 @@ namespace duckx
                 // 如果不存在，则添加一个新的 <Default> 标签
                 pugi::xml_node new_default = types_root.append_child("Default");
                 new_default.append_attribute("Extension").set_value(ext_lower.c_str());
-                new_default.append_attribute("ContentType").set_value(content_type.c_str());
+                new_default.append_attribute("ContentType").set_value(content_type);
+                MutationJournal::after_insert(&m_doc->journal(), new_default);
+                m_doc->mark_dirty(DocumentPart::CONTENT_TYPES);
             }
         }
 
         // 4. 将图片文件写入 ZIP 包
-        const std::string internal_path = "word/media/image" + std::to_string(m_media_id_counter++) + ext_with_dot;
+        MutationJournal::before_counter_change(&m_doc->journal(), m_media_id_counter);
+        const std::string internal_path = "word/media/image" + std::to_string(m_media_id_counter++) + "." + ext_lower;
         m_file->write_entry(internal_path, content);
 
         // 5. 返回在 .rels 文件中需要使用的相对路径
@@ -183,12 +189,14 @@ namespace duckx
         new_rel.append_attribute("Id") = new_rid.c_str();
         new_rel.append_attribute("Type") = IMAGE_REL_TYPE;
         new_rel.append_attribute("Target") = media_target.c_str();
+        MutationJournal::after_insert(&m_doc->journal(), new_rel);
 
         return new_rid;
     }
 
     unsigned int MediaManager::get_unique_docpr_id()
     {
+        MutationJournal::before_counter_change(&m_doc->journal(), m_docpr_id_counter);
         return m_docpr_id_counter++;
     }
 } // namespace duckx
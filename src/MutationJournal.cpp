@@ -0,0 +1,388 @@
+/*!
+ * @file MutationJournal.cpp
+ * @brief Implementation of the mutation journal
+ */
+#include "MutationJournal.hpp"
+
+#include <cstring>
+
+namespace duckx
+{
+    namespace
+    {
+        bool is_container(const pugi::xml_node node)
+        {
+            return node.type() == pugi::node_element &&
+                   (node.parent().type() == pugi::node_document || std::strcmp(node.name(), "w:body") == 0);
+        }
+
+        // 记录粒度：部件根节点或 w:body 的直接子节点；container 表示节点本身就是容器
+        pugi::xml_node block_of(pugi::xml_node node, bool& container)
+        {
+            container = false;
+            while (node)
+            {
+                if (is_container(node))
+                {
+                    container = true;
+                    return node;
+                }
+                const pugi::xml_node parent = node.parent();
+                if (!parent || parent.type() == pugi::node_document)
+                    return pugi::xml_node();
+                if (is_container(parent))
+                    return node;
+                node = parent;
+            }
+            return pugi::xml_node();
+        }
+
+        void copy_attributes(pugi::xml_node target, const pugi::xml_node source)
+        {
+            while (target.first_attribute())
+                target.remove_attribute(target.first_attribute());
+            for (const pugi::xml_attribute attr: source.attributes())
+                target.append_copy(attr);
+        }
+
+        unsigned part_bit(const DocumentPart part)
+        {
+            return 1u << static_cast<unsigned>(part);
+        }
+    } // namespace
+
+    void MutationJournal::begin()
+    {
+        m_records.clear();
+        m_slots.clear();
+        m_slot_of.clear();
+        m_covered.clear();
+        m_counters.clear();
+        m_touched_parts = 0;
+        m_saved.reset();
+        m_active = true;
+    }
+
+    void MutationJournal::watch(pugi::xml_document& doc, const DocumentPart part)
+    {
+        // 根节点位于 xml_document 对象内部，重新载入内容后地址不变
+        const void* root = doc.internal_object();
+        for (auto& watched: m_parts)
+        {
+            if (watched.first == root)
+            {
+                watched.second = part;
+                return;
+            }
+        }
+        m_parts.emplace_back(root, part);
+    }
+
+    void MutationJournal::unwatch(const pugi::xml_document& doc)
+    {
+        const void* root = doc.internal_object();
+        for (auto it = m_parts.begin(); it != m_parts.end(); ++it)
+        {
+            if (it->first == root)
+            {
+                m_parts.erase(it);
+                return;
+            }
+        }
+    }
+
+    bool MutationJournal::note_edit(const pugi::xml_node node, DocumentPart& part)
+    {
+        if (!node)
+            return false;
+
+        // 一个文档只有少数几个部件，线性查找即可；事务外只记下部件已修改
+        const void* root = node.root().internal_object();
+        for (const auto& watched: m_parts)
+        {
+            if (watched.first == root)
+            {
+                part = watched.second;
+                m_modified_parts |= part_bit(part);
+                ++m_generation;
+                return m_active;
+            }
+        }
+        return false;
+    }
+
+    void MutationJournal::commit()
+    {
+        m_active = false;
+    }
+
+    void MutationJournal::rollback()
+    {
+        m_active = false;
+        undo_to(0);
+        m_modified_parts |= m_touched_parts;
+        ++m_generation;
+
+        // 撤销后的记录不再描述任何修改，m_touched_parts 保留以便调用方重新序列化
+        m_slots.clear();
+        m_slot_of.clear();
+        m_covered.clear();
+        m_counters.clear();
+        m_saved.reset();
+    }
+
+    std::size_t MutationJournal::savepoint()
+    {
+        // 之后的修改重新记录各自的先前状态，撤销到保存点时才能恢复到此刻
+        m_covered.clear();
+        m_counters.clear();
+        return m_records.size();
+    }
+
+    void MutationJournal::rollback_to(const std::size_t savepoint)
+    {
+        if (!m_active || savepoint >= m_records.size())
+            return;
+
+        undo_to(savepoint);
+        m_covered.clear();
+        m_counters.clear();
+        m_modified_parts |= m_touched_parts;
+        ++m_generation;
+    }
+
+    void MutationJournal::undo_to(const std::size_t savepoint)
+    {
+        // 逆序撤销：处理每条记录时，其后的修改都已撤销，节点与位置与记录时一致
+        while (m_records.size() > savepoint)
+        {
+            const Record record = m_records.back();
+            m_records.pop_back();
+            Slot* slot = record.kind == MutationKind::COUNTER_CHANGED ? nullptr : &m_slots[record.slot];
+            switch (record.kind)
+            {
+            case MutationKind::NODE_INSERTED:
+                if (slot->live)
+                {
+                    // 事务继续时，被删节点的地址可能被新节点复用
+                    m_slot_of.erase(slot->node.internal_object());
+                    slot->node.parent().remove_child(slot->node);
+                    slot->live = false;
+                }
+                break;
+            case MutationKind::NODE_CHANGED:
+                if (slot->live)
+                {
+                    copy_attributes(slot->node, record.saved);
+                    while (slot->node.first_child())
+                        slot->node.remove_child(slot->node.first_child());
+                    for (const pugi::xml_node child: record.saved.children())
+                        slot->node.append_copy(child);
+                }
+                break;
+            case MutationKind::ATTRIBUTES_CHANGED:
+                if (slot->live)
+                    copy_attributes(slot->node, record.saved);
+                break;
+            case MutationKind::NODE_REMOVED:
+            {
+                const bool anchored = record.anchor != kNoSlot && m_slots[record.anchor].live;
+                pugi::xml_node container = record.container;
+                slot->node = anchored ? container.insert_copy_before(record.saved, m_slots[record.anchor].node)
+                                      : container.append_copy(record.saved);
+                slot->live = true;
+                m_slot_of[slot->node.internal_object()] = record.slot;
+                break;
+            }
+            case MutationKind::COUNTER_CHANGED:
+                if (record.counter_unsigned)
+                    *static_cast<unsigned int*>(record.counter) = static_cast<unsigned int>(record.counter_value);
+                else
+                    *static_cast<int*>(record.counter) = static_cast<int>(record.counter_value);
+                break;
+            }
+        }
+    }
+
+    std::vector<Mutation> MutationJournal::mutations() const
+    {
+        std::vector<Mutation> result;
+        result.reserve(m_records.size());
+        for (const Record& record: m_records)
+        {
+            Mutation mutation;
+            mutation.kind = record.kind;
+            mutation.part = record.part;
+            if (record.kind == MutationKind::NODE_REMOVED)
+                mutation.node = record.saved;
+            else if (record.kind != MutationKind::COUNTER_CHANGED && m_slots[record.slot].live)
+                mutation.node = m_slots[record.slot].node;
+            result.push_back(mutation);
+        }
+        return result;
+    }
+
+    bool MutationJournal::touched(const DocumentPart part) const
+    {
+        return (m_touched_parts & part_bit(part)) != 0;
+    }
+
+    bool MutationJournal::modified(const DocumentPart part) const
+    {
+        return (m_modified_parts & part_bit(part)) != 0;
+    }
+
+    std::size_t MutationJournal::slot_for(const pugi::xml_node node)
+    {
+        const auto found = m_slot_of.find(node.internal_object());
+        if (found != m_slot_of.end())
+            return found->second;
+
+        Slot slot;
+        slot.node = node;
+        m_slots.push_back(slot);
+        m_slot_of.emplace(node.internal_object(), m_slots.size() - 1);
+        return m_slots.size() - 1;
+    }
+
+    void MutationJournal::record_change(const pugi::xml_node node, const DocumentPart part)
+    {
+        bool container = false;
+        const pugi::xml_node block = block_of(node, container);
+        if (!block || !m_covered.insert(block.internal_object()).second)
+            return;
+
+        Record record;
+        record.part = part;
+        record.slot = slot_for(block);
+        if (container)
+        {
+            record.kind = MutationKind::ATTRIBUTES_CHANGED;
+            record.saved = m_saved.append_child(pugi::node_element);
+            copy_attributes(record.saved, block);
+        }
+        else
+        {
+            record.kind = MutationKind::NODE_CHANGED;
+            record.saved = m_saved.append_copy(block);
+        }
+        m_records.push_back(record);
+        m_touched_parts |= part_bit(part);
+    }
+
+    void MutationJournal::record_insert(const pugi::xml_node node, const DocumentPart part)
+    {
+        bool container = false;
+        const pugi::xml_node block = block_of(node, container);
+        if (!block || container || m_covered.contains(block.internal_object()))
+            return;
+
+        Record record;
+        record.part = part;
+        record.slot = slot_for(block);
+        if (block == node)
+        {
+            record.kind = MutationKind::NODE_INSERTED;
+        }
+        else
+        {
+            // 插入前没有调用 before_change：补记所在块的快照，并从副本中去掉新节点
+            std::vector<std::size_t> path;
+            for (pugi::xml_node child = node; child != block; child = child.parent())
+            {
+                std::size_t index = 0;
+                for (pugi::xml_node sibling = child.previous_sibling(); sibling; sibling = sibling.previous_sibling())
+                    ++index;
+                path.push_back(index);
+            }
+
+            record.kind = MutationKind::NODE_CHANGED;
+            record.saved = m_saved.append_copy(block);
+            pugi::xml_node copy = record.saved;
+            for (auto index = path.rbegin(); index != path.rend(); ++index)
+            {
+                copy = copy.first_child();
+                for (std::size_t i = 0; i < *index; ++i)
+                    copy = copy.next_sibling();
+            }
+            copy.parent().remove_child(copy);
+        }
+        m_covered.insert(block.internal_object());
+        m_records.push_back(record);
+        m_touched_parts |= part_bit(part);
+    }
+
+    void MutationJournal::record_remove(const pugi::xml_node node, const DocumentPart part)
+    {
+        bool container = false;
+        const pugi::xml_node block = block_of(node, container);
+        if (!block || container)
+            return;
+        if (block != node)
+        {
+            record_change(block, part);
+            return;
+        }
+
+        Record record;
+        record.kind = MutationKind::NODE_REMOVED;
+        record.part = part;
+        record.slot = slot_for(node);
+        record.saved = m_saved.append_copy(node);
+        record.container = node.parent();
+        record.anchor = node.next_sibling() ? slot_for(node.next_sibling()) : kNoSlot;
+
+        // 节点内存随删除释放，其地址可能被新节点复用
+        m_slots[record.slot].live = false;
+        m_slot_of.erase(node.internal_object());
+        m_covered.erase(node.internal_object());
+        m_records.push_back(record);
+        m_touched_parts |= part_bit(part);
+    }
+
+    void MutationJournal::record_counter(void* counter, const bool is_unsigned, const long long value)
+    {
+        if (!m_counters.insert(counter).second)
+            return;
+
+        Record record;
+        record.kind = MutationKind::COUNTER_CHANGED;
+        record.counter = counter;
+        record.counter_unsigned = is_unsigned;
+        record.counter_value = value;
+        m_records.push_back(record);
+    }
+
+    void MutationJournal::before_change(MutationJournal* journal, const pugi::xml_node node)
+    {
+        DocumentPart part = DocumentPart::MAIN_DOCUMENT;
+        if (journal && journal->note_edit(node, part))
+            journal->record_change(node, part);
+    }
+
+    void MutationJournal::after_insert(MutationJournal* journal, const pugi::xml_node node)
+    {
+        DocumentPart part = DocumentPart::MAIN_DOCUMENT;
+        if (journal && journal->note_edit(node, part))
+            journal->record_insert(node, part);
+    }
+
+    void MutationJournal::before_remove(MutationJournal* journal, const pugi::xml_node node)
+    {
+        DocumentPart part = DocumentPart::MAIN_DOCUMENT;
+        if (journal && journal->note_edit(node, part))
+            journal->record_remove(node, part);
+    }
+
+    void MutationJournal::before_counter_change(MutationJournal* journal, int& counter)
+    {
+        if (journal && journal->m_active)
+            journal->record_counter(&counter, false, counter);
+    }
+
+    void MutationJournal::before_counter_change(MutationJournal* journal, unsigned int& counter)
+    {
+        if (journal && journal->m_active)
+            journal->record_counter(&counter, true, counter);
+    }
+} // namespace duckx
@@ -0,0 +1,495 @@
+/*!
+ * @file NumberingManager.cpp
+ * @brief Implementation of the numbering model and list label computation
+ */
+#include "NumberingManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "Document.hpp"
+#include "DocxFile.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        struct xml_string_writer : pugi::xml_writer
+        {
+            std::string result;
+            void write(const void* data, size_t size) override
+            {
+                result.append(static_cast<const char*>(data), size);
+            }
+        };
+
+        const char* const kNumberingEntry = "word/numbering.xml";
+        const char* const kNumberingRelType =
+            "http://schemas.openxmlformats.org/officeDocument/2006/relationships/numbering";
+        const char* const kNumberingContentType =
+            "application/vnd.openxmlformats-officedocument.wordprocessingml.numbering+xml";
+        const char* const kEmptyNumbering =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+            "<w:numbering xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"/>";
+
+        int level_index(const pugi::xml_node node)
+        {
+            const long long ilvl = numeric::read_int_or(node.attribute("w:ilvl"), 0);
+            return ilvl < 0 || ilvl >= NumberingManager::kLevelCount ? -1 : static_cast<int>(ilvl);
+        }
+
+        bool on_off(const pugi::xml_node node)
+        {
+            if (!node)
+                return false;
+            const char* val = node.attribute("w:val").value();
+            return std::strcmp(val, "0") != 0 && std::strcmp(val, "false") != 0 && std::strcmp(val, "off") != 0;
+        }
+
+        NumberingLevel parse_level(const pugi::xml_node lvl)
+        {
+            NumberingLevel level;
+            // ECMA-376 默认起始值为 0，Word 生成的定义总会显式给出 w:start
+            level.start = static_cast<int>(numeric::read_int_or(lvl.child("w:start").attribute("w:val"), 0));
+            if (const pugi::xml_node fmt = lvl.child("w:numFmt"))
+                level.format = fmt.attribute("w:val").value();
+            level.text = lvl.child("w:lvlText").attribute("w:val").value();
+            if (const pugi::xml_node restart = lvl.child("w:lvlRestart"))
+                level.restart_after = static_cast<int>(numeric::read_int_or(restart.attribute("w:val"), -1));
+            level.legal = on_off(lvl.child("w:isLgl"));
+
+            const pugi::xml_node ind = lvl.child("w:pPr").child("w:ind");
+            pugi::xml_attribute left = ind.attribute("w:left");
+            if (!left)
+                left = ind.attribute("w:start");
+            level.indent_left = numeric::read_points_or(left, numeric::kTwipsPerPoint, 0.0);
+            level.hanging = numeric::read_points_or(ind.attribute("w:hanging"), numeric::kTwipsPerPoint, 0.0);
+            return level;
+        }
+
+        void write_level(pugi::xml_node lvl, const NumberingLevel& level)
+        {
+            numeric::write_int(lvl.append_child("w:start").append_attribute("w:val"), level.start);
+            lvl.append_child("w:numFmt").append_attribute("w:val").set_value(level.format.c_str());
+            if (level.restart_after >= 0)
+                numeric::write_int(lvl.append_child("w:lvlRestart").append_attribute("w:val"), level.restart_after);
+            if (level.legal)
+                lvl.append_child("w:isLgl");
+            lvl.append_child("w:lvlText").append_attribute("w:val").set_value(level.text.c_str());
+            lvl.append_child("w:lvlJc").append_attribute("w:val").set_value("left");
+            if (level.indent_left != 0.0 || level.hanging != 0.0)
+            {
+                pugi::xml_node ind = lvl.append_child("w:pPr").append_child("w:ind");
+                numeric::write_points(ind.append_attribute("w:left"), level.indent_left, numeric::kTwipsPerPoint);
+                numeric::write_points(ind.append_attribute("w:hanging"), level.hanging, numeric::kTwipsPerPoint);
+            }
+        }
+
+        void append_roman(std::string& out, int value, const bool upper)
+        {
+            static const int kValues[] = {1000, 900, 500, 400, 100, 90, 50, 40, 10, 9, 5, 4, 1};
+            static const char* const kLower[] = {"m", "cm", "d", "cd", "c", "xc", "l", "xl", "x", "ix", "v", "iv", "i"};
+            static const char* const kUpper[] = {"M", "CM", "D", "CD", "C", "XC", "L", "XL", "X", "IX", "V", "IV", "I"};
+            for (int i = 0; i < 13; ++i)
+            {
+                while (value >= kValues[i])
+                {
+                    out += upper ? kUpper[i] : kLower[i];
+                    value -= kValues[i];
+                }
+            }
+        }
+
+        // 按 w:numFmt 格式化计数值；未支持的格式退化为十进制
+        void append_number(std::string& out, const int value, const std::string& format)
+        {
+            if (format == "none" || format == "bullet")
+                return;
+            if (value > 0 && (format == "lowerLetter" || format == "upperLetter"))
+            {
+                // Word 的字母编号：a..z, aa..zz, aaa..
+                const char letter = static_cast<char>((format == "lowerLetter" ? 'a' : 'A') + (value - 1) % 26);
+                out.append(static_cast<size_t>((value - 1) / 26 + 1), letter);
+                return;
+            }
+            if (value > 0 && value < 4000 && (format == "lowerRoman" || format == "upperRoman"))
+            {
+                append_roman(out, value, format == "upperRoman");
+                return;
+            }
+            if (format == "decimalZero" && value >= 0 && value < 10)
+                out += '0';
+            const numeric::NumberBuffer digits = numeric::format_int(value);
+            out.append(digits.data, digits.size);
+        }
+    } // namespace
+
+    NumberingManager::NumberingManager(Document* owner_doc, DocxFile* file, pugi::xml_document* rels_xml,
+                                       pugi::xml_document* content_types_xml)
+        : m_doc(owner_doc), m_file(file), m_rels_xml(rels_xml), m_content_types_xml(content_types_xml)
+    {
+        m_has_part = m_file->has_entry(kNumberingEntry);
+        if (!m_has_part || !m_numbering_xml.load_string(m_file->read_entry(kNumberingEntry).c_str()) ||
+            !m_numbering_xml.child("w:numbering"))
+        {
+            m_numbering_xml.load_string(kEmptyNumbering);
+        }
+        m_doc->journal().watch(m_numbering_xml, DocumentPart::NUMBERING);
+        parse();
+    }
+
+    void NumberingManager::parse()
+    {
+        const pugi::xml_node numbering = m_numbering_xml.child("w:numbering");
+
+        for (const pugi::xml_node abstract_node: numbering.children("w:abstractNum"))
+        {
+            const int id = static_cast<int>(numeric::read_int_or(abstract_node.attribute("w:abstractNumId"), -1));
+            if (id < 0)
+                continue;
+
+            AbstractNum& abstract_num = m_abstracts[id];
+            for (const pugi::xml_node lvl: abstract_node.children("w:lvl"))
+            {
+                const int index = level_index(lvl);
+                if (index < 0)
+                    continue;
+                abstract_num.levels[index] = parse_level(lvl);
+                abstract_num.level_count = std::max(abstract_num.level_count, index + 1);
+            }
+            m_abstract_by_signature.emplace(signature(abstract_num), id);
+            m_next_abstract_id = std::max(m_next_abstract_id, id + 1);
+        }
+
+        for (const pugi::xml_node num_node: numbering.children("w:num"))
+        {
+            const int id = static_cast<int>(numeric::read_int_or(num_node.attribute("w:numId"), 0));
+            if (id <= 0)
+                continue;
+
+            Num& num = m_nums[id];
+            num.abstract_id =
+                static_cast<int>(numeric::read_int_or(num_node.child("w:abstractNumId").attribute("w:val"), -1));
+            num.start_override.fill(-1);
+            num.has_level_override.fill(false);
+            for (const pugi::xml_node override_node: num_node.children("w:lvlOverride"))
+            {
+                const int index = level_index(override_node);
+                if (index < 0)
+                    continue;
+                if (const pugi::xml_node start = override_node.child("w:startOverride"))
+                {
+                    num.start_override[index] = static_cast<int>(numeric::read_int_or(start.attribute("w:val"), 0));
+                    num.has_overrides = true;
+                }
+                if (const pugi::xml_node lvl = override_node.child("w:lvl"))
+                {
+                    num.level_override[index] = parse_level(lvl);
+                    num.has_level_override[index] = true;
+                    num.has_overrides = true;
+                }
+            }
+            m_next_num_id = std::max(m_next_num_id, id + 1);
+        }
+    }
+
+    const NumberingLevel* NumberingManager::level(const int num_id, const int level) const
+    {
+        if (level < 0 || level >= kLevelCount)
+            return nullptr;
+        const auto num = m_nums.find(num_id);
+        if (num == m_nums.end())
+            return nullptr;
+        if (num->second.has_level_override[level])
+            return &num->second.level_override[level];
+        const auto abstract_num = m_abstracts.find(num->second.abstract_id);
+        if (abstract_num == m_abstracts.end() || level >= abstract_num->second.level_count)
+            return nullptr;
+        return &abstract_num->second.levels[level];
+    }
+
+    ListType NumberingManager::list_type(const int num_id, const int level) const
+    {
+        const NumberingLevel* def = this->level(num_id, level);
+        if (!def || def->format == "none")
+            return ListType::NONE;
+        return def->format == "bullet" ? ListType::BULLET : ListType::NUMBER;
+    }
+
+    std::vector<ListLabel> NumberingManager::compute_labels(const pugi::xml_node root) const
+    {
+        // Word 的计数器属于抽象定义：共享同一 abstractNum 的实例连续编号
+        struct Counters
+        {
+            std::array<int, kLevelCount> value{};
+            std::array<bool, kLevelCount> started{};
+        };
+        absl::flat_hash_map<int, Counters> counters;
+        absl::flat_hash_set<int> seen_nums;
+
+        std::vector<ListLabel> labels;
+        pugi::xml_node node = root;
+        while (node)
+        {
+            const pugi::xml_node num_pr =
+                std::strcmp(node.name(), "w:p") == 0 ? node.child("w:pPr").child("w:numPr") : pugi::xml_node();
+            const int num_id = static_cast<int>(numeric::read_int_or(num_pr.child("w:numId").attribute("w:val"), 0));
+            const int ilvl = static_cast<int>(numeric::read_int_or(num_pr.child("w:ilvl").attribute("w:val"), 0));
+            const auto num = num_id > 0 ? m_nums.find(num_id) : m_nums.end();
+
+            if (num != m_nums.end() && level(num_id, ilvl))
+            {
+                Counters& state = counters[num->second.abstract_id];
+                const auto start_of = [&](const int lvl) {
+                    const int start = num->second.start_override[lvl];
+                    const NumberingLevel* def = level(num_id, lvl);
+                    return start >= 0 ? start : (def ? def->start : 0);
+                };
+
+                // 实例首次出现时，带 startOverride 的层级从覆盖值重新开始
+                if (seen_nums.insert(num_id).second && num->second.has_overrides)
+                {
+                    for (int lvl = 0; lvl < kLevelCount; ++lvl)
+                    {
+                        if (num->second.start_override[lvl] >= 0)
+                            state.started[lvl] = false;
+                    }
+                }
+
+                state.value[ilvl] = state.started[ilvl] ? state.value[ilvl] + 1 : start_of(ilvl);
+                state.started[ilvl] = true;
+                for (int deeper = ilvl + 1; deeper < kLevelCount; ++deeper)
+                {
+                    const NumberingLevel* def = level(num_id, deeper);
+                    const int restart = def ? def->restart_after : -1;
+                    if (restart < 0 || ilvl < restart)
+                        state.started[deeper] = false;
+                }
+
+                const NumberingLevel& current = *level(num_id, ilvl);
+                ListLabel label;
+                label.paragraph = node;
+                label.num_id = num_id;
+                label.level = ilvl;
+                const std::string& text = current.text;
+                for (size_t i = 0; i < text.size(); ++i)
+                {
+                    if (text[i] != '%' || i + 1 >= text.size() || text[i + 1] < '1' || text[i + 1] > '9')
+                    {
+                        label.text += text[i];
+                        continue;
+                    }
+                    const int ref = text[++i] - '1';
+                    const NumberingLevel* ref_def = level(num_id, ref);
+                    const int value = state.started[ref] ? state.value[ref] : start_of(ref);
+                    if (current.format == "bullet")
+                        continue;
+                    append_number(label.text, value,
+                                  current.legal ? std::string("decimal") : (ref_def ? ref_def->format : "decimal"));
+                }
+                labels.push_back(std::move(label));
+            }
+
+            if (node.first_child())
+            {
+                node = node.first_child();
+                continue;
+            }
+            while (node && node != root && !node.next_sibling())
+                node = node.parent();
+            node = (node && node != root) ? node.next_sibling() : pugi::xml_node();
+        }
+        return labels;
+    }
+
+    std::string NumberingManager::format_number(const int value, const std::string& format)
+    {
+        std::string text;
+        append_number(text, value, format);
+        return text;
+    }
+
+    std::string NumberingManager::signature(const std::vector<NumberingLevel>& levels)
+    {
+        std::string sig;
+        for (const NumberingLevel& level: levels)
+        {
+            absl::StrAppend(&sig, level.start, "|", level.format, "|", level.text, "|", level.restart_after, "|",
+                            level.legal ? 1 : 0, "|", numeric::to_fixed(level.indent_left, numeric::kTwipsPerPoint),
+                            "|", numeric::to_fixed(level.hanging, numeric::kTwipsPerPoint), ";");
+        }
+        return sig;
+    }
+
+    std::string NumberingManager::signature(const AbstractNum& abstract_num)
+    {
+        return signature(std::vector<NumberingLevel>(abstract_num.levels.begin(),
+                                                     abstract_num.levels.begin() + abstract_num.level_count));
+    }
+
+    int NumberingManager::define_list(const std::vector<NumberingLevel>& levels)
+    {
+        if (levels.empty() || levels.size() > static_cast<size_t>(kLevelCount))
+            throw std::invalid_argument("A list definition needs 1 to 9 levels");
+
+        const std::string sig = signature(levels);
+        int abstract_id = -1;
+        const auto existing = m_abstract_by_signature.find(sig);
+        if (existing != m_abstract_by_signature.end())
+        {
+            abstract_id = existing->second;
+            int reuse = 0;
+            for (const auto& num: m_nums)
+            {
+                if (num.second.abstract_id == abstract_id && !num.second.has_overrides &&
+                    (reuse == 0 || num.first < reuse))
+                    reuse = num.first;
+            }
+            if (reuse != 0)
+                return reuse;
+        }
+
+        ensure_part();
+        pugi::xml_node numbering = m_numbering_xml.child("w:numbering");
+
+        if (abstract_id < 0)
+        {
+            abstract_id = m_next_abstract_id++;
+            // 架构要求所有 w:abstractNum 位于 w:num 之前
+            const pugi::xml_node first_num = numbering.child("w:num");
+            pugi::xml_node abstract_node =
+                first_num ? numbering.insert_child_before("w:abstractNum", first_num) : numbering.append_child("w:abstractNum");
+            MutationJournal::after_insert(&m_doc->journal(), abstract_node);
+            numeric::write_int(abstract_node.append_attribute("w:abstractNumId"), abstract_id);
+            abstract_node.append_child("w:multiLevelType")
+                .append_attribute("w:val")
+                .set_value(levels.size() > 1 ? "multilevel" : "singleLevel");
+
+            AbstractNum& abstract_num = m_abstracts[abstract_id];
+            for (size_t i = 0; i < levels.size(); ++i)
+            {
+                pugi::xml_node lvl = abstract_node.append_child("w:lvl");
+                numeric::write_int(lvl.append_attribute("w:ilvl"), static_cast<long long>(i));
+                write_level(lvl, levels[i]);
+                abstract_num.levels[i] = levels[i];
+            }
+            abstract_num.level_count = static_cast<int>(levels.size());
+            m_abstract_by_signature.emplace(sig, abstract_id);
+        }
+
+        const int num_id = m_next_num_id++;
+        pugi::xml_node num_node = numbering.append_child("w:num");
+        MutationJournal::after_insert(&m_doc->journal(), num_node);
+        numeric::write_int(num_node.append_attribute("w:numId"), num_id);
+        numeric::write_int(num_node.append_child("w:abstractNumId").append_attribute("w:val"), abstract_id);
+
+        Num& num = m_nums[num_id];
+        num.abstract_id = abstract_id;
+        num.start_override.fill(-1);
+        num.has_level_override.fill(false);
+        m_dirty = true;
+        return num_id;
+    }
+
+    int NumberingManager::define_list(const ListType type)
+    {
+        if (type == ListType::NONE)
+            return 0;
+
+        // 与 DocxFile::get_default_numbering_xml() 中的定义一致，新建文档可直接复用
+        NumberingLevel level;
+        level.start = 1;
+        level.format = type == ListType::BULLET ? "bullet" : "decimal";
+        level.text = type == ListType::BULLET ? "\xE2\x80\xA2" : "%1.";
+        level.indent_left = 36.0;
+        level.hanging = 18.0;
+        return define_list(std::vector<NumberingLevel>{level});
+    }
+
+    int NumberingManager::restart_list(const int num_id, const int start)
+    {
+        const auto source = m_nums.find(num_id);
+        if (source == m_nums.end())
+            return 0;
+        const int abstract_id = source->second.abstract_id;
+
+        ensure_part();
+        const int new_id = m_next_num_id++;
+        pugi::xml_node num_node = m_numbering_xml.child("w:numbering").append_child("w:num");
+        MutationJournal::after_insert(&m_doc->journal(), num_node);
+        numeric::write_int(num_node.append_attribute("w:numId"), new_id);
+        numeric::write_int(num_node.append_child("w:abstractNumId").append_attribute("w:val"), abstract_id);
+        pugi::xml_node override_node = num_node.append_child("w:lvlOverride");
+        override_node.append_attribute("w:ilvl").set_value("0");
+        numeric::write_int(override_node.append_child("w:startOverride").append_attribute("w:val"), start);
+
+        Num& num = m_nums[new_id];
+        num.abstract_id = abstract_id;
+        num.start_override.fill(-1);
+        num.start_override[0] = start;
+        num.has_level_override.fill(false);
+        num.has_overrides = true;
+        m_dirty = true;
+        return new_id;
+    }
+
+    void NumberingManager::ensure_part()
+    {
+        if (m_has_part)
+            return;
+        m_has_part = true;
+
+        pugi::xml_node relationships = m_rels_xml->child("Relationships");
+        bool has_rel = false;
+        for (const pugi::xml_node rel: relationships.children("Relationship"))
+            has_rel = has_rel || std::strcmp(rel.attribute("Type").value(), kNumberingRelType) == 0;
+        if (!has_rel)
+        {
+            pugi::xml_node rel = relationships.append_child("Relationship");
+            rel.append_attribute("Id").set_value(m_doc->get_next_relationship_id().c_str());
+            rel.append_attribute("Type").set_value(kNumberingRelType);
+            rel.append_attribute("Target").set_value("numbering.xml");
+            MutationJournal::after_insert(&m_doc->journal(), rel);
+            m_doc->mark_dirty(DocumentPart::RELATIONSHIPS);
+        }
+
+        pugi::xml_node types = m_content_types_xml->child("Types");
+        if (!types.find_child_by_attribute("Override", "PartName", "/word/numbering.xml"))
+        {
+            pugi::xml_node override_node = types.append_child("Override");
+            override_node.append_attribute("PartName").set_value("/word/numbering.xml");
+            override_node.append_attribute("ContentType").set_value(kNumberingContentType);
+            MutationJournal::after_insert(&m_doc->journal(), override_node);
+            m_doc->mark_dirty(DocumentPart::CONTENT_TYPES);
+        }
+    }
+
+    void NumberingManager::save()
+    {
+        if (!m_dirty)
+            return;
+        xml_string_writer writer;
+        m_numbering_xml.print(writer, "", pugi::format_raw);
+        m_file->write_entry(kNumberingEntry, writer.result);
+        m_dirty = false;
+    }
+
+    void NumberingManager::reload()
+    {
+        m_abstracts.clear();
+        m_nums.clear();
+        m_abstract_by_signature.clear();
+        m_next_abstract_id = 0;
+        m_next_num_id = 1;
+        parse();
+
+        // 撤销也可能移除了部件的关系与内容类型，下次添加定义时由 ensure_part() 重新检查
+        m_has_part = false;
+        m_dirty = m_file->has_entry(kNumberingEntry);
+    }
+} // namespace duckx
@@ -0,0 +1,215 @@
+/*!
+ * @file NumericCodec.cpp
+ * @brief Implementation of the locale-free numeric attribute codec
+ */
+#include "NumericCodec.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace duckx
+{
+    namespace numeric
+    {
+        namespace
+        {
+            /*! @brief Powers of ten that are exact in a double */
+            constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            constexpr int kMaxExactPow10 = 22;
+
+            bool is_digit(const char c)
+            {
+                return c >= '0' && c <= '9';
+            }
+
+            double scale_pow10(double value, int exponent)
+            {
+                while (exponent > kMaxExactPow10)
+                {
+                    value *= kPow10[kMaxExactPow10];
+                    exponent -= kMaxExactPow10;
+                }
+                while (exponent < -kMaxExactPow10)
+                {
+                    value /= kPow10[kMaxExactPow10];
+                    exponent += kMaxExactPow10;
+                }
+                return exponent >= 0 ? value * kPow10[exponent] : value / kPow10[-exponent];
+            }
+        } // namespace
+
+        NumberBuffer format_int(const long long value)
+        {
+            NumberBuffer buffer;
+            char digits[24];
+            std::size_t count = 0;
+
+            // Work on the unsigned magnitude so LLONG_MIN does not overflow
+            unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value)
+                                                     : static_cast<unsigned long long>(value);
+            do
+            {
+                digits[count++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+
+            std::size_t pos = 0;
+            if (value < 0) buffer.data[pos++] = '-';
+            while (count > 0) buffer.data[pos++] = digits[--count];
+            buffer.data[pos] = '\0';
+            buffer.size = pos;
+            return buffer;
+        }
+
+        bool parse_uint(const absl::string_view text, unsigned long long& value)
+        {
+            if (text.empty()) return false;
+
+            unsigned long long result = 0;
+            for (const char c : text)
+            {
+                if (!is_digit(c)) return false;
+                const unsigned digit = static_cast<unsigned>(c - '0');
+                if (result > (std::numeric_limits<unsigned long long>::max() - digit) / 10) return false;
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
+        }
+
+        bool parse_int(absl::string_view text, long long& value)
+        {
+            bool negative = false;
+            if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+            {
+                negative = text.front() == '-';
+                text.remove_prefix(1);
+            }
+
+            unsigned long long magnitude = 0;
+            if (!parse_uint(text, magnitude)) return false;
+
+            const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+            if (magnitude > limit + (negative ? 1 : 0)) return false;
+
+            value = negative ? static_cast<long long>(0ull - magnitude) : static_cast<long long>(magnitude);
+            return true;
+        }
+
+        bool parse_decimal(const absl::string_view text, double& value)
+        {
+            std::size_t pos = 0;
+            const std::size_t size = text.size();
+
+            bool negative = false;
+            if (pos < size && (text[pos] == '-' || text[pos] == '+'))
+            {
+                negative = text[pos] == '-';
+                ++pos;
+            }
+
+            // Up to 19 significant digits are accumulated exactly, the rest only shift the exponent
+            unsigned long long mantissa = 0;
+            int significant = 0;
+            int exponent = 0;
+            bool any_digit = false;
+
+            for (; pos < size && is_digit(text[pos]); ++pos)
+            {
+                any_digit = true;
+                if (significant < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<unsigned>(text[pos] - '0');
+                    if (mantissa != 0) ++significant;
+                }
+                else
+                {
+                    ++exponent;
+                }
+            }
+
+            if (pos < size && text[pos] == '.')
+            {
+                ++pos;
+                for (; pos < size && is_digit(text[pos]); ++pos)
+                {
+                    any_digit = true;
+                    if (significant < 19)
+                    {
+                        mantissa = mantissa * 10 + static_cast<unsigned>(text[pos] - '0');
+                        if (mantissa != 0) ++significant;
+                        --exponent;
+                    }
+                }
+            }
+
+            if (!any_digit) return false;
+
+            if (pos < size && (text[pos] == 'e' || text[pos] == 'E'))
+            {
+                long long exp_value = 0;
+                const absl::string_view exp_text = text.substr(pos + 1);
+                if (!parse_int(exp_text, exp_value) || exp_value > 400 || exp_value < -400) return false;
+                exponent += static_cast<int>(exp_value);
+                pos = size;
+            }
+
+            if (pos != size) return false;
+
+            const double result = scale_pow10(static_cast<double>(mantissa), exponent);
+            value = negative ? -result : result;
+            return true;
+        }
+
+        long long to_fixed(const double points, const long long scale)
+        {
+            return std::llround(points * static_cast<double>(scale));
+        }
+
+        bool parse_points(const absl::string_view text, const long long scale, double& points)
+        {
+            // Integral values (the common case) avoid the decimal path entirely
+            long long units = 0;
+            if (parse_int(text, units))
+            {
+                points = from_fixed(units, scale);
+                return true;
+            }
+
+            double decimal = 0.0;
+            if (!parse_decimal(text, decimal)) return false;
+            points = decimal / static_cast<double>(scale);
+            return true;
+        }
+
+        bool read_points(const pugi::xml_attribute& attr, const long long scale, double& points)
+        {
+            return attr && parse_points(attr.value(), scale, points);
+        }
+
+        double read_points_or(const pugi::xml_attribute& attr, const long long scale, const double fallback)
+        {
+            double points = fallback;
+            read_points(attr, scale, points);
+            return points;
+        }
+
+        long long read_int_or(const pugi::xml_attribute& attr, const long long fallback)
+        {
+            long long value = fallback;
+            if (attr) parse_int(attr.value(), value);
+            return value;
+        }
+
+        void write_int(pugi::xml_attribute attr, const long long value)
+        {
+            attr.set_value(format_int(value).c_str());
+        }
+
+        void write_points(pugi::xml_attribute attr, const double points, const long long scale)
+        {
+            write_int(attr, to_fixed(points, scale));
+        }
+    } // namespace numeric
+} // namespace duckx
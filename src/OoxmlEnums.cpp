@@ -0,0 +1,142 @@
+/*!
+ * @file OoxmlEnums.cpp
+ * @brief Conversion tables between enumerations and OOXML attribute values
+ *
+ * All tables are constant-initialized; adding a value only requires a new
+ * entry, the perfect hash is recomputed by the compiler.
+ */
+#include "OoxmlEnums.hpp"
+
+namespace duckx
+{
+    namespace ooxml
+    {
+        namespace
+        {
+            using detail::Entry;
+            using detail::make_table;
+
+            // Entries naming an enumerator for the first time define its output
+            // spelling; later entries for the same enumerator are accepted on input only.
+
+            constexpr Entry<Alignment> kAlignmentEntries[] = {
+                {"left", Alignment::LEFT},
+                {"center", Alignment::CENTER},
+                {"right", Alignment::RIGHT},
+                {"both", Alignment::BOTH},
+                {"start", Alignment::LEFT}, // ISO/IEC 29500 strict spelling
+                {"end", Alignment::RIGHT}};
+            constexpr auto kAlignments = make_table(kAlignmentEntries);
+
+            constexpr Entry<HighlightColor> kHighlightEntries[] = {
+                {"none", HighlightColor::NONE},
+                {"black", HighlightColor::BLACK},
+                {"blue", HighlightColor::BLUE},
+                {"cyan", HighlightColor::CYAN},
+                {"green", HighlightColor::GREEN},
+                {"magenta", HighlightColor::MAGENTA},
+                {"red", HighlightColor::RED},
+                {"yellow", HighlightColor::YELLOW},
+                {"white", HighlightColor::WHITE},
+                {"darkBlue", HighlightColor::DARK_BLUE},
+                {"darkCyan", HighlightColor::DARK_CYAN},
+                {"darkGreen", HighlightColor::DARK_GREEN},
+                {"darkMagenta", HighlightColor::DARK_MAGENTA},
+                {"darkRed", HighlightColor::DARK_RED},
+                {"darkYellow", HighlightColor::DARK_YELLOW},
+                {"lightGray", HighlightColor::LIGHT_GRAY}};
+            constexpr auto kHighlights = make_table(kHighlightEntries);
+
+            constexpr Entry<HeaderFooterType> kHeaderFooterEntries[] = {
+                {"default", HeaderFooterType::DEFAULT},
+                {"first", HeaderFooterType::FIRST},
+                {"even", HeaderFooterType::EVEN},
+                {"odd", HeaderFooterType::ODD}};
+            constexpr auto kHeaderFooterTypes = make_table(kHeaderFooterEntries);
+
+            constexpr Entry<SectionBreakType> kSectionBreakEntries[] = {
+                {"nextPage", SectionBreakType::NEXT_PAGE},
+                {"evenPage", SectionBreakType::EVEN_PAGE},
+                {"oddPage", SectionBreakType::ODD_PAGE},
+                {"continuous", SectionBreakType::CONTINUOUS},
+                {"nextColumn", SectionBreakType::COLUMN}};
+            constexpr auto kSectionBreaks = make_table(kSectionBreakEntries);
+
+            constexpr Entry<PageOrientation> kOrientationEntries[] = {
+                {"portrait", PageOrientation::PORTRAIT},
+                {"landscape", PageOrientation::LANDSCAPE}};
+            constexpr auto kOrientations = make_table(kOrientationEntries);
+
+            constexpr Entry<RelativeFrom> kRelativeFromEntries[] = {
+                {"page", RelativeFrom::PAGE},
+                {"margin", RelativeFrom::MARGIN}};
+            constexpr auto kRelativeFroms = make_table(kRelativeFromEntries);
+
+            constexpr Entry<formatting_flag> kVerticalTextAlignmentEntries[] = {
+                {"baseline", none},
+                {"superscript", superscript},
+                {"subscript", subscript}};
+            constexpr auto kVerticalTextAlignments = make_table(kVerticalTextAlignmentEntries);
+
+            constexpr Entry<bool> kBorderStyleEntries[] = {
+                {"single", true}, {"double", true}, {"dashed", true}, {"dotted", true}, {"none", true}};
+            constexpr auto kBorderStyles = make_table(kBorderStyleEntries);
+
+            constexpr Entry<bool> kCellVerticalAlignmentEntries[] = {
+                {"top", true}, {"center", true}, {"bottom", true}};
+            constexpr auto kCellVerticalAlignments = make_table(kCellVerticalAlignmentEntries);
+
+            constexpr Entry<bool> kTableAlignmentEntries[] = {
+                {"left", true}, {"center", true}, {"right", true}};
+            constexpr auto kTableAlignments = make_table(kTableAlignmentEntries);
+
+            constexpr Entry<bool> kTextDirectionEntries[] = {
+                {"lrTb", true}, {"tbRl", true}, {"btLr", true}, {"lrTbV", true}, {"tbRlV", true}, {"tbLrV", true}};
+            constexpr auto kTextDirections = make_table(kTextDirectionEntries);
+
+            constexpr Entry<bool> kWidthTypeEntries[] = {
+                {"dxa", true}, {"pct", true}, {"auto", true}};
+            constexpr auto kWidthTypes = make_table(kWidthTypeEntries);
+
+            constexpr Entry<const char*> kImageContentTypeEntries[] = {
+                {"png", "image/png"},
+                {"jpg", "image/jpeg"},
+                {"jpeg", "image/jpeg"},
+                {"gif", "image/gif"},
+                {"bmp", "image/bmp"},
+                {"tiff", "image/tiff"}};
+            constexpr auto kImageContentTypes = make_table(kImageContentTypeEntries);
+        } // namespace
+
+        const char* to_string(const Alignment value) { return kAlignments.name_of(value, "left"); }
+        const char* to_string(const HighlightColor value) { return kHighlights.name_of(value, "none"); }
+        const char* to_string(const HeaderFooterType value) { return kHeaderFooterTypes.name_of(value, "default"); }
+        const char* to_string(const SectionBreakType value) { return kSectionBreaks.name_of(value, "nextPage"); }
+        const char* to_string(const PageOrientation value) { return kOrientations.name_of(value, "portrait"); }
+        const char* to_string(const RelativeFrom value) { return kRelativeFroms.name_of(value, "page"); }
+
+        bool parse(const absl::string_view name, Alignment& value) { return kAlignments.find(name, value); }
+        bool parse(const absl::string_view name, HighlightColor& value) { return kHighlights.find(name, value); }
+        bool parse(const absl::string_view name, HeaderFooterType& value) { return kHeaderFooterTypes.find(name, value); }
+        bool parse(const absl::string_view name, SectionBreakType& value) { return kSectionBreaks.find(name, value); }
+        bool parse(const absl::string_view name, PageOrientation& value) { return kOrientations.find(name, value); }
+        bool parse(const absl::string_view name, RelativeFrom& value) { return kRelativeFroms.find(name, value); }
+
+        bool parse_vertical_text_alignment(const absl::string_view name, formatting_flag& value)
+        {
+            return kVerticalTextAlignments.find(name, value);
+        }
+
+        bool is_border_style(const absl::string_view name) { return kBorderStyles.contains(name); }
+        bool is_cell_vertical_alignment(const absl::string_view name) { return kCellVerticalAlignments.contains(name); }
+        bool is_table_alignment(const absl::string_view name) { return kTableAlignments.contains(name); }
+        bool is_text_direction(const absl::string_view name) { return kTextDirections.contains(name); }
+        bool is_width_type(const absl::string_view name) { return kWidthTypes.contains(name); }
+
+        const char* image_content_type(const absl::string_view extension)
+        {
+            const char* content_type = nullptr;
+            return kImageContentTypes.find(extension, content_type) ? content_type : nullptr;
+        }
+    } // namespace ooxml
+} // namespace duckx
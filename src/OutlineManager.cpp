@@ -9,6 +9,8 @@
 #include "Document.hpp"
 #include "Body.hpp"
 #include "BaseElement.hpp"
+#include "BookmarkIndex.hpp"
+#include "MutationJournal.hpp"
 #include "StyleManager.hpp"
 #include "pugixml.hpp"
 
@@ -58,6 +60,45 @@ Result<std::vector<OutlineEntry>> OutlineManager::generate_outline_safe() {
     return Result<std::vector<OutlineEntry>>(m_outline);
 }
 
+Result<std::vector<OutlineEntry>> OutlineManager::generate_outline_safe(const OperationOptions& operation) {
+    if (!m_document || !m_style_manager) {
+        return Result<std::vector<OutlineEntry>>(
+            errors::validation_failed("outline_manager", "Document or StyleManager not initialized"));
+    }
+    
+    // 取消时恢复之前缓存的大纲
+    std::vector<OutlineEntry> previous = m_outline;
+    const auto cancelled = [this, &previous]() {
+        m_outline = std::move(previous);
+        return Result<std::vector<OutlineEntry>>(
+            errors::operation_cancelled("generate_outline", DUCKX_ERROR_CONTEXT()));
+    };
+    
+    OperationProgress progress(operation, 0);
+    if (progress.cancelled()) {
+        return cancelled();
+    }
+    
+    auto scan_result = scan_document_for_headings_safe(&progress);
+    if (progress.cancelled()) {
+        return cancelled();
+    }
+    if (!scan_result.ok()) {
+        return Result<std::vector<OutlineEntry>>(scan_result.error());
+    }
+    
+    progress.set_total(m_outline.size());
+    auto hierarchy_result = build_hierarchy_safe(m_outline, &progress);
+    if (progress.cancelled()) {
+        return cancelled();
+    }
+    if (!hierarchy_result.ok()) {
+        return Result<std::vector<OutlineEntry>>(hierarchy_result.error());
+    }
+    
+    return Result<std::vector<OutlineEntry>>(m_outline);
+}
+
 Result<std::vector<OutlineEntry>> OutlineManager::generate_outline_custom_safe(
     const std::vector<std::string>& heading_styles) {
         
@@ -278,12 +319,10 @@ bool OutlineManager::is_heading_style(const std::string& style_name) const {
 // ---- Outline Navigation ----
 
 const OutlineEntry* OutlineManager::find_entry_by_bookmark(const std::string& bookmark_id) const {
-    for (const auto& entry : m_outline) {
-        if (entry.bookmark_id == bookmark_id) {
-            return &entry;
+    for (const OutlineEntry* entry : get_flat_outline()) {
+        if (entry->bookmark_id == bookmark_id) {
+            return entry;
         }
-        // Recursively search children
-        // TODO: Implement recursive search in children
     }
     return nullptr;
 }
@@ -351,7 +390,7 @@ Result<std::string> OutlineManager::export_outline_as_html_safe() const {
 
 // ---- Private Helper Methods ----
 
-Result<void> OutlineManager::scan_document_for_headings_safe() {
+Result<void> OutlineManager::scan_document_for_headings_safe(const OperationProgress* progress) {
     if (!m_document) {
         return Result<void>(
             errors::validation_failed("outline_manager", "Document not initialized"));
@@ -564,6 +603,9 @@ Result<void> OutlineManager::scan_document_for_headings_safe() {
             // Actually iterate through XML paragraphs when XML access is safe
             while (para_node) {
                 ++paragraph_count;
+                if (progress && progress->cancelled()) {
+                    break;
+                }
                 
                 #ifdef _DEBUG
                 if (paragraph_count % 10 == 1) { // Log every 10th paragraph
@@ -709,7 +751,8 @@ Result<void> OutlineManager::scan_document_for_headings_safe() {
     return Result<void>();
 }
 
-Result<void> OutlineManager::build_hierarchy_safe(std::vector<OutlineEntry>& entries) {
+Result<void> OutlineManager::build_hierarchy_safe(std::vector<OutlineEntry>& entries,
+                                                  const OperationProgress* progress) {
     if (entries.empty()) {
         return Result<void>();
     }
@@ -717,8 +760,13 @@ Result<void> OutlineManager::build_hierarchy_safe(std::vector<OutlineEntry>& ent
     // Create a hierarchical structure from flat entries
     std::vector<OutlineEntry> hierarchical_entries;
     std::vector<OutlineEntry*> level_stack; // Stack to track parent entries at each level
+    std::uint64_t processed = 0;
     
     for (auto& entry : entries) {
+        // Entries stay flat until the loop completes, so stopping here leaves them untouched
+        if (progress && !progress->report(processed++)) {
+            return Result<void>();
+        }
         // Find the appropriate parent level
         while (!level_stack.empty() && level_stack.back()->level >= entry.level) {
             level_stack.pop_back();
@@ -737,6 +785,9 @@ Result<void> OutlineManager::build_hierarchy_safe(std::vector<OutlineEntry>& ent
     
     // Replace the flat entries with hierarchical ones
     entries = std::move(hierarchical_entries);
+    if (progress) {
+        progress->report(processed);
+    }
     
     return Result<void>();
 }
@@ -919,6 +970,10 @@ Result<void> OutlineManager::create_field_toc_safe(const TocOptions& options) {
 Result<void> OutlineManager::add_bookmarks_to_headings_safe() {
     Body& body = m_document->body();
     
+    // Allocate w:id values past the existing bookmarks so none collide
+    BookmarkIndex bookmarks(body.journal());
+    bookmarks.add(body.get_body_node());
+    
     int bookmark_id = 0;
     for (auto& paragraph : body.paragraphs()) {
         // Check if paragraph has heading style
@@ -952,15 +1007,9 @@ Result<void> OutlineManager::add_bookmarks_to_headings_safe() {
                 }
             }
             
-            if (!has_bookmark) {
-                // Add bookmark
-                pugi::xml_node bookmark_start = para_node.prepend_child("w:bookmarkStart");
-                bookmark_start.append_attribute("w:id").set_value(bookmark_id);
-                bookmark_start.append_attribute("w:name").set_value(
-                    ("_Toc" + std::to_string(204895566 + bookmark_id)).c_str());
-                
-                pugi::xml_node bookmark_end = para_node.append_child("w:bookmarkEnd");
-                bookmark_end.append_attribute("w:id").set_value(bookmark_id);
+            const std::string bookmark_name = "_Toc" + std::to_string(204895566 + bookmark_id);
+            if (!has_bookmark && !bookmarks.find(bookmark_name)) {
+                bookmarks.add_bookmark(para_node, bookmark_name);
             }
             
             bookmark_id++;
@@ -1020,6 +1069,7 @@ Result<pugi::xml_node> OutlineManager::create_sdt_toc_node_safe(
     
     // Create SDT (Structured Document Tag) for TOC
     pugi::xml_node sdt = parent_node.append_child("w:sdt");
+    MutationJournal::after_insert(body.journal(), sdt);
     
     // SDT properties
     pugi::xml_node sdtPr = sdt.append_child("w:sdtPr");
@@ -1101,6 +1151,9 @@ Result<pugi::xml_node> OutlineManager::create_sdt_toc_node_safe(
     pugi::xml_node fldChar2 = fieldR3.append_child("w:fldChar");
     fldChar2.append_attribute("w:fldCharType").set_value("separate");
     
+    // The entries are the field result, so the field ends in the last one
+    pugi::xml_node fieldEndPara = fieldPara;
+    
     // Generate current outline to include in TOC
     // Need to cast away const for this internal operation
     auto* non_const_this = const_cast<OutlineManager*>(this);
@@ -1113,6 +1166,7 @@ Result<pugi::xml_node> OutlineManager::create_sdt_toc_node_safe(
         for (const auto& entry : outline_entries) {
             // Create TOC entry paragraph
             pugi::xml_node tocEntryPara = sdtContent.append_child("w:p");
+            fieldEndPara = tocEntryPara;
             pugi::xml_node tocEntryPPr = tocEntryPara.append_child("w:pPr");
             
             // Set TOC style based on level
@@ -1199,7 +1253,7 @@ Result<pugi::xml_node> OutlineManager::create_sdt_toc_node_safe(
     }
     
     // Field end
-    pugi::xml_node fieldR4 = fieldPara.append_child("w:r");
+    pugi::xml_node fieldR4 = fieldEndPara.append_child("w:r");
     pugi::xml_node fldChar3 = fieldR4.append_child("w:fldChar");
     fldChar3.append_attribute("w:fldCharType").set_value("end");
     
@@ -1256,6 +1310,7 @@ Result<void> OutlineManager::create_field_toc_at_placeholder_safe(
     body_node.insert_move_before(sdt_node, placeholder_para);
     
     // Remove the placeholder paragraph
+    MutationJournal::before_remove(body.journal(), placeholder_para);
     body_node.remove_child(placeholder_para);
     
     m_toc_exists = true;
@@ -0,0 +1,268 @@
+/*!
+ * @file PackageGarbageCollector.cpp
+ * @brief Implementation of the package garbage collection pass
+ */
+#include "PackageGarbageCollector.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "DocxFile.hpp"
+#include "pugixml.hpp"
+
+namespace duckx
+{
+    namespace
+    {
+        const char* const kRootRelationships = "_rels/.rels";
+        const char* const kContentTypes = "[Content_Types].xml";
+
+        struct xml_string_writer : pugi::xml_writer
+        {
+            std::string result;
+            void write(const void* data, size_t size) override
+            {
+                result.append(static_cast<const char*>(data), size);
+            }
+        };
+
+        std::string print_raw(const pugi::xml_document& xml)
+        {
+            xml_string_writer writer;
+            xml.print(writer, "", pugi::format_raw);
+            return std::move(writer.result);
+        }
+
+        // 通过 r:id 显式引用的关系类型；其余类型（styles、settings、theme 等）按类型解析，始终保留
+        bool is_explicit_relationship(const absl::string_view type)
+        {
+            const size_t slash = type.rfind('/');
+            const absl::string_view kind = slash == absl::string_view::npos ? type : type.substr(slash + 1);
+            return kind == "image" || kind == "hyperlink" || kind == "header" || kind == "footer" ||
+                   kind == "oleObject" || kind == "chart";
+        }
+
+        std::string directory_of(const std::string& part)
+        {
+            const size_t slash = part.rfind('/');
+            return slash == std::string::npos ? std::string() : part.substr(0, slash + 1);
+        }
+
+        std::string relationships_of(const std::string& part)
+        {
+            const size_t slash = part.rfind('/');
+            const size_t name_begin = slash == std::string::npos ? 0 : slash + 1;
+            return part.substr(0, name_begin) + "_rels/" + part.substr(name_begin) + ".rels";
+        }
+
+        std::string normalize_path(const std::string& path)
+        {
+            std::vector<absl::string_view> segments;
+            for (const absl::string_view segment: absl::StrSplit(path, '/'))
+            {
+                if (segment.empty() || segment == ".")
+                    continue;
+                if (segment == "..")
+                {
+                    if (!segments.empty())
+                        segments.pop_back();
+                    continue;
+                }
+                segments.push_back(segment);
+            }
+            return absl::StrJoin(segments, "/");
+        }
+
+        /*! @brief Entry names of the package, looked up case-insensitively like OPC part names */
+        class PartIndex
+        {
+        public:
+            explicit PartIndex(const std::vector<std::string>& names)
+            {
+                m_parts.reserve(names.size());
+                for (const auto& name: names)
+                {
+                    m_parts.emplace(absl::AsciiStrToLower(name), name);
+                }
+            }
+
+            /*! @brief Actual entry name for a part name, or nullptr if absent */
+            const std::string* find(const std::string& part_name) const
+            {
+                const auto found = m_parts.find(absl::AsciiStrToLower(part_name));
+                return found == m_parts.end() ? nullptr : &found->second;
+            }
+
+            void erase(const std::string& name) { m_parts.erase(absl::AsciiStrToLower(name)); }
+
+        private:
+            std::unordered_map<std::string, std::string> m_parts;
+        };
+
+        // 任何属性值等于关系 ID 即视为引用（r:id、r:embed、r:link、o:relid ...）
+        void erase_referenced_ids(const pugi::xml_node root, std::unordered_set<std::string>& unreferenced)
+        {
+            pugi::xml_node node = root;
+            while (node && !unreferenced.empty())
+            {
+                for (const pugi::xml_attribute attr: node.attributes())
+                {
+                    unreferenced.erase(attr.value());
+                }
+
+                if (node.first_child())
+                {
+                    node = node.first_child();
+                    continue;
+                }
+                while (node && node != root && !node.next_sibling())
+                {
+                    node = node.parent();
+                }
+                node = (node && node != root) ? node.next_sibling() : pugi::xml_node();
+            }
+        }
+    } // namespace
+
+    GarbageCollectionReport collect_package_garbage(DocxFile& file)
+    {
+        const std::vector<std::string> names = file.entry_names();
+        PartIndex parts(names);
+
+        std::unordered_set<std::string> reachable;
+        std::vector<std::string> pending;
+        std::vector<std::pair<std::string, std::string>> rewritten_relationships;
+        std::size_t relationships_removed = 0;
+        bool complete = true;
+
+        reachable.insert(kContentTypes);
+
+        // 标记阶段：每个部件及其 .rels 至多解析一次
+        const auto visit = [&](const std::string& source_part, const std::string& rels_name)
+        {
+            const std::string* rels_entry = parts.find(rels_name);
+            if (!rels_entry)
+                return;
+            reachable.insert(*rels_entry);
+
+            pugi::xml_document rels;
+            if (!rels.load_string(file.read_entry(*rels_entry).c_str()))
+            {
+                complete = false;
+                return;
+            }
+            pugi::xml_node relationships = rels.child("Relationships");
+
+            std::unordered_set<std::string> unreferenced;
+            if (!source_part.empty())
+            {
+                for (const pugi::xml_node rel: relationships.children("Relationship"))
+                {
+                    if (is_explicit_relationship(rel.attribute("Type").value()))
+                        unreferenced.insert(rel.attribute("Id").value());
+                }
+            }
+            if (!unreferenced.empty())
+            {
+                pugi::xml_document source;
+                if (!source.load_string(file.read_entry(source_part).c_str()))
+                {
+                    complete = false;
+                    return;
+                }
+                erase_referenced_ids(source.document_element(), unreferenced);
+            }
+
+            const std::string base_dir = directory_of(source_part);
+            std::size_t dropped = 0;
+            for (pugi::xml_node rel = relationships.child("Relationship"); rel;)
+            {
+                const pugi::xml_node next = rel.next_sibling("Relationship");
+                const bool external = std::string(rel.attribute("TargetMode").value()) == "External";
+                const std::string target = rel.attribute("Target").value();
+                const std::string* target_entry = external
+                                                      ? nullptr
+                                                      : parts.find(normalize_path(
+                                                          !target.empty() && target[0] == '/' ? target
+                                                                                              : base_dir + target));
+                const bool dangling = !external && !target_entry;
+
+                if (is_explicit_relationship(rel.attribute("Type").value()) &&
+                    (dangling || unreferenced.count(rel.attribute("Id").value())))
+                {
+                    relationships.remove_child(rel);
+                    ++dropped;
+                }
+                else if (target_entry && reachable.insert(*target_entry).second)
+                {
+                    pending.push_back(*target_entry);
+                }
+                rel = next;
+            }
+
+            if (dropped > 0)
+            {
+                relationships_removed += dropped;
+                rewritten_relationships.emplace_back(*rels_entry, print_raw(rels));
+            }
+        };
+
+        visit(std::string(), kRootRelationships);
+        while (!pending.empty() && complete)
+        {
+            const std::string part = std::move(pending.back());
+            pending.pop_back();
+            visit(part, relationships_of(part));
+        }
+
+        // 任何 XML 无法解析时不做任何删除，避免误删仍被引用的部件
+        GarbageCollectionReport report;
+        if (!complete)
+            return report;
+
+        report.relationships_removed = relationships_removed;
+        for (const auto& rewrite: rewritten_relationships)
+        {
+            file.write_entry(rewrite.first, rewrite.second);
+        }
+
+        for (const auto& name: names)
+        {
+            if (reachable.count(name))
+                continue;
+            report.bytes_reclaimed += file.remove_entry(name);
+            ++report.parts_removed;
+            parts.erase(name);
+        }
+
+        if (const std::string* types_entry = parts.find(kContentTypes))
+        {
+            pugi::xml_document types;
+            if (types.load_string(file.read_entry(*types_entry).c_str()))
+            {
+                pugi::xml_node types_node = types.child("Types");
+                for (pugi::xml_node override_node = types_node.child("Override"); override_node;)
+                {
+                    const pugi::xml_node next = override_node.next_sibling("Override");
+                    const std::string part_name = override_node.attribute("PartName").value();
+                    if (!parts.find(normalize_path(part_name)))
+                    {
+                        types_node.remove_child(override_node);
+                        ++report.overrides_removed;
+                    }
+                    override_node = next;
+                }
+                if (report.overrides_removed > 0)
+                    file.write_entry(*types_entry, print_raw(types));
+            }
+        }
+
+        return report;
+    }
+} // namespace duckx
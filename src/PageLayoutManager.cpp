@@ -7,6 +7,9 @@
 
 #include "PageLayoutManager.hpp"
 #include "Document.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
 #include "pugixml.hpp"
 
 #include <cmath>
@@ -59,8 +62,8 @@ void PageSizeConfig::apply_standard_size() {
 // DocumentSection Implementation  
 // ============================================================================
 
-DocumentSection::DocumentSection(pugi::xml_node section_node)
-    : m_section_node(section_node) {
+DocumentSection::DocumentSection(pugi::xml_node section_node, MutationJournal* journal)
+    : m_section_node(section_node), m_journal(journal) {
 }
 
 Result<void> DocumentSection::set_properties_safe(const SectionProperties& props) {
@@ -131,12 +134,12 @@ Result<void> DocumentSection::set_margins_safe(const PageMargins& margins) {
     
     auto margins_node = margins_node_result.value();
     
-    margins_node.attribute("w:top") = std::to_string(PageLayoutManager::mm_to_twips(margins.top_mm)).c_str();
-    margins_node.attribute("w:bottom") = std::to_string(PageLayoutManager::mm_to_twips(margins.bottom_mm)).c_str();  
-    margins_node.attribute("w:left") = std::to_string(PageLayoutManager::mm_to_twips(margins.left_mm)).c_str();
-    margins_node.attribute("w:right") = std::to_string(PageLayoutManager::mm_to_twips(margins.right_mm)).c_str();
-    margins_node.attribute("w:header") = std::to_string(PageLayoutManager::mm_to_twips(margins.header_mm)).c_str();
-    margins_node.attribute("w:footer") = std::to_string(PageLayoutManager::mm_to_twips(margins.footer_mm)).c_str();
+    margins_node.attribute("w:top") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.top_mm)).c_str();
+    margins_node.attribute("w:bottom") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.bottom_mm)).c_str();  
+    margins_node.attribute("w:left") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.left_mm)).c_str();
+    margins_node.attribute("w:right") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.right_mm)).c_str();
+    margins_node.attribute("w:header") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.header_mm)).c_str();
+    margins_node.attribute("w:footer") = numeric::format_int(PageLayoutManager::mm_to_twips(margins.footer_mm)).c_str();
     
     return Result<void>();
 }
@@ -180,11 +183,11 @@ Result<void> DocumentSection::set_page_size_safe(const PageSizeConfig& config) {
     
     auto page_size_node = page_size_node_result.value();
     
-    page_size_node.attribute("w:w") = std::to_string(PageLayoutManager::mm_to_twips(config.width_mm)).c_str();
-    page_size_node.attribute("w:h") = std::to_string(PageLayoutManager::mm_to_twips(config.height_mm)).c_str();
+    page_size_node.attribute("w:w") = numeric::format_int(PageLayoutManager::mm_to_twips(config.width_mm)).c_str();
+    page_size_node.attribute("w:h") = numeric::format_int(PageLayoutManager::mm_to_twips(config.height_mm)).c_str();
     
     if (config.orientation == PageOrientation::LANDSCAPE) {
-        page_size_node.attribute("w:orient") = "landscape";
+        page_size_node.attribute("w:orient") = ooxml::to_string(config.orientation);
     } else {
         page_size_node.remove_attribute("w:orient");
     }
@@ -209,12 +212,8 @@ Result<PageSizeConfig> DocumentSection::get_page_size_safe() const {
         config.height_mm = PageLayoutManager::twips_to_mm(height_attr.as_int());
     }
     
-    auto orient_attr = page_size_node.attribute("w:orient");
-    if (orient_attr && std::string(orient_attr.value()) == "landscape") {
-        config.orientation = PageOrientation::LANDSCAPE;
-    } else {
-        config.orientation = PageOrientation::PORTRAIT;
-    }
+    config.orientation = PageOrientation::PORTRAIT;
+    ooxml::parse(page_size_node.attribute("w:orient").value(), config.orientation);
     
     // Detect standard page sizes based on dimensions (with small tolerance for rounding)
     const double tolerance = 1.0;  // 1mm tolerance
@@ -256,9 +255,9 @@ Result<void> DocumentSection::set_columns_safe(int column_count, double spacing_
     
     auto columns_node = columns_node_result.value();
     
-    columns_node.attribute("w:num") = std::to_string(column_count).c_str();
+    columns_node.attribute("w:num") = numeric::format_int(column_count).c_str();
     if (column_count > 1) {
-        columns_node.attribute("w:space") = std::to_string(PageLayoutManager::mm_to_twips(spacing_mm)).c_str();
+        columns_node.attribute("w:space") = numeric::format_int(PageLayoutManager::mm_to_twips(spacing_mm)).c_str();
     }
     
     return Result<void>();
@@ -279,6 +278,7 @@ Result<int> DocumentSection::get_column_count_safe() const {
 }
 
 Result<void> DocumentSection::set_different_first_page_safe(bool different) {
+    MutationJournal::before_change(m_journal, m_section_node);
     if (different) {
         auto title_pg_node = m_section_node.child("w:titlePg");
         if (!title_pg_node) {
@@ -310,6 +310,7 @@ Result<bool> DocumentSection::has_different_odd_even_safe() const {
 // Private helper methods for DocumentSection
 
 Result<pugi::xml_node> DocumentSection::get_or_create_page_size_node_safe() {
+    MutationJournal::before_change(m_journal, m_section_node);
     auto page_size_node = m_section_node.child("w:pgSz");
     if (!page_size_node) {
         page_size_node = m_section_node.append_child("w:pgSz");
@@ -318,6 +319,7 @@ Result<pugi::xml_node> DocumentSection::get_or_create_page_size_node_safe() {
 }
 
 Result<pugi::xml_node> DocumentSection::get_or_create_margins_node_safe() {
+    MutationJournal::before_change(m_journal, m_section_node);
     auto margins_node = m_section_node.child("w:pgMar");
     if (!margins_node) {
         margins_node = m_section_node.append_child("w:pgMar");
@@ -326,6 +328,7 @@ Result<pugi::xml_node> DocumentSection::get_or_create_margins_node_safe() {
 }
 
 Result<pugi::xml_node> DocumentSection::get_or_create_columns_node_safe() {
+    MutationJournal::before_change(m_journal, m_section_node);
     auto columns_node = m_section_node.child("w:cols");
     if (!columns_node) {
         columns_node = m_section_node.append_child("w:cols");
@@ -497,6 +500,7 @@ Result<void> PageLayoutManager::insert_section_break_safe(SectionBreakType break
     }
     
     auto sect_pr = sect_pr_result.value();
+    MutationJournal::before_change(&m_document->journal(), sect_pr);
     
     // Add section break type
     auto type_node = sect_pr.child("w:type");
@@ -504,7 +508,7 @@ Result<void> PageLayoutManager::insert_section_break_safe(SectionBreakType break
         type_node = sect_pr.append_child("w:type");
     }
     
-    type_node.attribute("w:val") = section_break_type_to_string(break_type).c_str();
+    type_node.attribute("w:val") = ooxml::to_string(break_type);
     
     return Result<void>();
 }
@@ -533,7 +537,7 @@ Result<std::vector<DocumentSection>> PageLayoutManager::get_all_sections_safe()
     // Check for sectPr at body level (last section)
     auto body_sect_pr = body.child("w:sectPr");
     if (body_sect_pr) {
-        sections.emplace_back(body_sect_pr);
+        sections.emplace_back(body_sect_pr, &m_document->journal());
     }
     
     // TODO: Find sectPr nodes in paragraphs (section breaks)
@@ -547,7 +551,7 @@ Result<DocumentSection> PageLayoutManager::get_current_section_safe() const {
         return Result<DocumentSection>(section_pr_result.error());
     }
     
-    return Result<DocumentSection>(DocumentSection(section_pr_result.value()));
+    return Result<DocumentSection>(DocumentSection(section_pr_result.value(), &m_document->journal()));
 }
 
 Result<DocumentSection> PageLayoutManager::get_section_safe(int section_index) const {
@@ -620,6 +624,7 @@ Result<void> PageLayoutManager::set_page_numbering_safe(
     }
     
     auto sect_pr = sect_pr_result.value();
+    MutationJournal::before_change(&m_document->journal(), sect_pr);
     
     // Add page numbering format
     auto pgNumType = sect_pr.child("w:pgNumType");
@@ -628,7 +633,7 @@ Result<void> PageLayoutManager::set_page_numbering_safe(
     }
     
     pgNumType.attribute("w:fmt") = format.c_str();
-    pgNumType.attribute("w:start") = std::to_string(start_number).c_str();
+    pgNumType.attribute("w:start") = numeric::format_int(start_number).c_str();
     
     return Result<void>();
 }
@@ -648,6 +653,7 @@ Result<void> PageLayoutManager::set_vertical_alignment_safe(bool center_vertical
     }
     
     auto sect_pr = sect_pr_result.value();
+    MutationJournal::before_change(&m_document->journal(), sect_pr);
     
     if (center_vertically) {
         auto vAlign = sect_pr.child("w:vAlign");
@@ -850,6 +856,7 @@ Result<pugi::xml_node> PageLayoutManager::get_current_section_pr_safe() const {
             std::cout << "DEBUG: Creating section properties node" << std::endl;
             #endif
             sect_pr = body.append_child("w:sectPr");
+            MutationJournal::after_insert(&m_document->journal(), sect_pr);
             #ifdef _DEBUG
             std::cout << "DEBUG: Created section properties node valid: " << (sect_pr ? "YES" : "NO") << std::endl;
             #endif
@@ -873,30 +880,4 @@ Result<pugi::xml_node> PageLayoutManager::create_section_pr_safe() {
     return get_current_section_pr_safe();
 }
 
-std::string PageLayoutManager::section_break_type_to_string(SectionBreakType type) {
-    switch (type) {
-        case SectionBreakType::NEXT_PAGE: return "nextPage";
-        case SectionBreakType::EVEN_PAGE: return "evenPage";
-        case SectionBreakType::ODD_PAGE: return "oddPage";
-        case SectionBreakType::CONTINUOUS: return "continuous";
-        case SectionBreakType::COLUMN: return "nextColumn";
-        default: return "nextPage";
-    }
-}
-
-std::string PageLayoutManager::page_orientation_to_string(PageOrientation orientation) {
-    switch (orientation) {
-        case PageOrientation::PORTRAIT: return "portrait";
-        case PageOrientation::LANDSCAPE: return "landscape";
-        default: return "portrait";
-    }
-}
-
-PageOrientation PageLayoutManager::string_to_page_orientation(const std::string& str) {
-    if (str == "landscape") {
-        return PageOrientation::LANDSCAPE;
-    }
-    return PageOrientation::PORTRAIT; // Default to portrait
-}
-
 } // namespace duckx
\ No newline at end of file
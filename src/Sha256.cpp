@@ -0,0 +1,152 @@
+/*!
+ * @file Sha256.cpp
+ * @brief SHA-256 implementation
+ *
+ * @date 2025.07
+ */
+
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckx
+{
+    namespace
+    {
+        constexpr std::uint32_t kRoundConstants[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        inline std::uint32_t rotr(const std::uint32_t x, const unsigned n)
+        {
+            return (x >> n) | (x << (32 - n));
+        }
+    } // namespace
+
+    Sha256::Sha256()
+        : m_state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+    {
+    }
+
+    void Sha256::compress(const std::uint8_t* block)
+    {
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+        {
+            w[i] = static_cast<std::uint32_t>(block[4 * i]) << 24 | static_cast<std::uint32_t>(block[4 * i + 1]) << 16 |
+                   static_cast<std::uint32_t>(block[4 * i + 2]) << 8 | static_cast<std::uint32_t>(block[4 * i + 3]);
+        }
+        for (int i = 16; i < 64; ++i)
+        {
+            const std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        std::uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        std::uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+        for (int i = 0; i < 64; ++i)
+        {
+            const std::uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                                     kRoundConstants[i] + w[i];
+            const std::uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+        m_state[5] += f;
+        m_state[6] += g;
+        m_state[7] += h;
+    }
+
+    void Sha256::update(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        m_length += size;
+
+        // 先补满缓冲区中的残块，再直接处理整块
+        if (m_buffered > 0)
+        {
+            const std::size_t take = std::min(size, sizeof(m_buffer) - m_buffered);
+            std::memcpy(m_buffer + m_buffered, bytes, take);
+            m_buffered += take;
+            bytes += take;
+            size -= take;
+            if (m_buffered < sizeof(m_buffer))
+                return;
+            compress(m_buffer);
+            m_buffered = 0;
+        }
+        for (; size >= sizeof(m_buffer); bytes += sizeof(m_buffer), size -= sizeof(m_buffer))
+        {
+            compress(bytes);
+        }
+        std::memcpy(m_buffer, bytes, size);
+        m_buffered = size;
+    }
+
+    Sha256::Digest Sha256::finish()
+    {
+        const std::uint64_t bit_length = m_length * 8;
+        m_buffer[m_buffered++] = 0x80;
+        if (m_buffered > 56)
+        {
+            std::memset(m_buffer + m_buffered, 0, sizeof(m_buffer) - m_buffered);
+            compress(m_buffer);
+            m_buffered = 0;
+        }
+        std::memset(m_buffer + m_buffered, 0, 56 - m_buffered);
+        for (int i = 0; i < 8; ++i)
+        {
+            m_buffer[63 - i] = static_cast<std::uint8_t>(bit_length >> (8 * i));
+        }
+        compress(m_buffer);
+
+        Digest digest;
+        for (int i = 0; i < 8; ++i)
+        {
+            digest[4 * i] = static_cast<std::uint8_t>(m_state[i] >> 24);
+            digest[4 * i + 1] = static_cast<std::uint8_t>(m_state[i] >> 16);
+            digest[4 * i + 2] = static_cast<std::uint8_t>(m_state[i] >> 8);
+            digest[4 * i + 3] = static_cast<std::uint8_t>(m_state[i]);
+        }
+        return digest;
+    }
+
+    Sha256::Digest Sha256::digest(const void* data, const std::size_t size)
+    {
+        Sha256 sha;
+        sha.update(data, size);
+        return sha.finish();
+    }
+
+    std::string Sha256::to_hex(const Digest& digest)
+    {
+        static const char kHex[] = "0123456789abcdef";
+        std::string hex(digest.size() * 2, '0');
+        for (std::size_t i = 0; i < digest.size(); ++i)
+        {
+            hex[2 * i] = kHex[digest[i] >> 4];
+            hex[2 * i + 1] = kHex[digest[i] & 0x0f];
+        }
+        return hex;
+    }
+} // namespace duckx
@@ -9,6 +9,9 @@
 #include "StyleManager.hpp"
 #include "BaseElement.hpp"
 #include "Document.hpp"
+#include "MutationJournal.hpp"
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
 #include "XmlStyleParser.hpp"
 
 #include "absl/strings/str_format.h"
@@ -227,14 +230,8 @@ namespace duckx
                 xml += "  <w:pPr>\n";
                 
                 if (m_paragraph_props.alignment.has_value()) {
-                    std::string align_val = "left";
-                    switch (m_paragraph_props.alignment.value()) {
-                        case Alignment::CENTER: align_val = "center"; break;
-                        case Alignment::RIGHT: align_val = "right"; break; 
-                        case Alignment::BOTH: align_val = "both"; break;
-                        default: break;
-                    }
-                    xml += absl::StrFormat("    <w:jc w:val=\"%s\"/>\n", align_val);
+                    xml += absl::StrFormat("    <w:jc w:val=\"%s\"/>\n",
+                                           ooxml::to_string(m_paragraph_props.alignment.value()));
                 }
                 
                 if (m_paragraph_props.space_before_pts.has_value() || 
@@ -242,16 +239,16 @@ namespace duckx
                     m_paragraph_props.line_spacing.has_value()) {
                     xml += "    <w:spacing";
                     if (m_paragraph_props.space_before_pts.has_value()) {
-                        int before_twips = static_cast<int>(m_paragraph_props.space_before_pts.value() * 20);
+                        const long long before_twips = numeric::to_fixed(m_paragraph_props.space_before_pts.value(), numeric::kTwipsPerPoint);
                         xml += absl::StrFormat(" w:before=\"%d\"", before_twips);
                     }
                     if (m_paragraph_props.space_after_pts.has_value()) {
-                        int after_twips = static_cast<int>(m_paragraph_props.space_after_pts.value() * 20);
+                        const long long after_twips = numeric::to_fixed(m_paragraph_props.space_after_pts.value(), numeric::kTwipsPerPoint);
                         xml += absl::StrFormat(" w:after=\"%d\"", after_twips);
                     }
                     if (m_paragraph_props.line_spacing.has_value()) {
                         // Convert line spacing to OOXML format (240 = single spacing)
-                        int line_twips = static_cast<int>(m_paragraph_props.line_spacing.value() * 240);
+                        const long long line_twips = numeric::to_fixed(m_paragraph_props.line_spacing.value(), numeric::kLineSpacingUnit);
                         xml += absl::StrFormat(" w:line=\"%d\" w:lineRule=\"auto\"", line_twips);
                     }
                     xml += "/>\n";
@@ -278,7 +275,7 @@ namespace duckx
                 }
                 
                 if (m_character_props.font_size_pts.has_value()) {
-                    int half_pts = static_cast<int>(m_character_props.font_size_pts.value() * 2);
+                    const long long half_pts = numeric::to_fixed(m_character_props.font_size_pts.value(), numeric::kHalfPointsPerPoint);
                     xml += absl::StrFormat("    <w:sz w:val=\"%d\"/>\n", half_pts);
                     xml += absl::StrFormat("    <w:szCs w:val=\"%d\"/>\n", half_pts);
                 }
@@ -711,12 +708,9 @@ namespace duckx
         pugi::xml_node jc_node = ppr_node.child("w:jc");
         if (jc_node) {
             pugi::xml_attribute val_attr = jc_node.attribute("w:val");
-            if (val_attr) {
-                std::string align_str = val_attr.as_string();
-                if (align_str == "left") props.alignment = Alignment::LEFT;
-                else if (align_str == "center") props.alignment = Alignment::CENTER;
-                else if (align_str == "right") props.alignment = Alignment::RIGHT;
-                else if (align_str == "both") props.alignment = Alignment::BOTH;
+            Alignment alignment = Alignment::LEFT;
+            if (val_attr && ooxml::parse(val_attr.value(), alignment)) {
+                props.alignment = alignment;
             }
         }
         
@@ -725,17 +719,17 @@ namespace duckx
         if (spacing_node) {
             pugi::xml_attribute before_attr = spacing_node.attribute("w:before");
             if (before_attr) {
-                props.space_before_pts = before_attr.as_double() / 20.0; // Convert from twips to points
+                props.space_before_pts = numeric::read_points_or(before_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
             
             pugi::xml_attribute after_attr = spacing_node.attribute("w:after");
             if (after_attr) {
-                props.space_after_pts = after_attr.as_double() / 20.0; // Convert from twips to points
+                props.space_after_pts = numeric::read_points_or(after_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
             
             pugi::xml_attribute line_attr = spacing_node.attribute("w:line");
             if (line_attr) {
-                props.line_spacing = line_attr.as_double() / 240.0; // Convert from OOXML format
+                props.line_spacing = numeric::read_points_or(line_attr, numeric::kLineSpacingUnit, 0.0); // Convert from OOXML format
             }
         }
         
@@ -744,17 +738,17 @@ namespace duckx
         if (ind_node) {
             pugi::xml_attribute left_attr = ind_node.attribute("w:left");
             if (left_attr) {
-                props.left_indent_pts = left_attr.as_double() / 20.0; // Convert from twips to points
+                props.left_indent_pts = numeric::read_points_or(left_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
             
             pugi::xml_attribute right_attr = ind_node.attribute("w:right");
             if (right_attr) {
-                props.right_indent_pts = right_attr.as_double() / 20.0; // Convert from twips to points
+                props.right_indent_pts = numeric::read_points_or(right_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
             
             pugi::xml_attribute first_line_attr = ind_node.attribute("w:firstLine");
             if (first_line_attr) {
-                props.first_line_indent_pts = first_line_attr.as_double() / 20.0; // Convert from twips to points
+                props.first_line_indent_pts = numeric::read_points_or(first_line_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
         }
         
@@ -765,7 +759,7 @@ namespace duckx
             if (ilvl_node) {
                 pugi::xml_attribute val_attr = ilvl_node.attribute("w:val");
                 if (val_attr) {
-                    props.list_level = val_attr.as_int();
+                    props.list_level = static_cast<int>(numeric::read_int_or(val_attr, 0));
                 }
             }
             
@@ -797,7 +791,7 @@ namespace duckx
         if (sz_node) {
             pugi::xml_attribute val_attr = sz_node.attribute("w:val");
             if (val_attr) {
-                props.font_size_pts = val_attr.as_double() / 2.0; // Convert from half-points to points
+                props.font_size_pts = numeric::read_points_or(val_attr, numeric::kHalfPointsPerPoint, 0.0); // Convert from half-points to points
             }
         }
         
@@ -814,14 +808,9 @@ namespace duckx
         pugi::xml_node highlight_node = rpr_node.child("w:highlight");
         if (highlight_node) {
             pugi::xml_attribute val_attr = highlight_node.attribute("w:val");
-            if (val_attr) {
-                std::string highlight_str = val_attr.as_string();
-                // Convert string to HighlightColor enum
-                if (highlight_str == "yellow") props.highlight_color = HighlightColor::YELLOW;
-                else if (highlight_str == "red") props.highlight_color = HighlightColor::RED;
-                else if (highlight_str == "blue") props.highlight_color = HighlightColor::BLUE;
-                else if (highlight_str == "green") props.highlight_color = HighlightColor::GREEN;
-                // Add more colors as needed
+            HighlightColor highlight = HighlightColor::NONE;
+            if (val_attr && ooxml::parse(val_attr.value(), highlight) && highlight != HighlightColor::NONE) {
+                props.highlight_color = highlight;
             }
         }
         
@@ -853,7 +842,7 @@ namespace duckx
         if (tblw_node) {
             pugi::xml_attribute w_attr = tblw_node.attribute("w:w");
             if (w_attr) {
-                props.table_width_pts = w_attr.as_double() / 20.0; // Convert from twips to points
+                props.table_width_pts = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
             }
         }
         
@@ -878,7 +867,7 @@ namespace duckx
                 
                 pugi::xml_attribute sz_attr = top_border.attribute("w:sz");
                 if (sz_attr) {
-                    props.border_width_pts = sz_attr.as_double() / 8.0; // Convert from eighths of a point
+                    props.border_width_pts = numeric::read_points_or(sz_attr, numeric::kEighthsPerPoint, 0.0); // Convert from eighths of a point
                 }
                 
                 pugi::xml_attribute color_attr = top_border.attribute("w:color");
@@ -895,7 +884,7 @@ namespace duckx
             if (left_mar) {
                 pugi::xml_attribute w_attr = left_mar.attribute("w:w");
                 if (w_attr) {
-                    props.cell_padding_pts = w_attr.as_double() / 20.0; // Convert from twips to points
+                    props.cell_padding_pts = numeric::read_points_or(w_attr, numeric::kTwipsPerPoint, 0.0); // Convert from twips to points
                 }
             }
         }
@@ -1449,6 +1438,7 @@ namespace duckx
             return Result<void>(errors::xml_parse_error("Invalid paragraph node",
                 DUCKX_ERROR_CONTEXT_STYLE("apply_paragraph_style", style_name)));
         }
+        MutationJournal::before_change(paragraph.journal(), para_node);
         
         pugi::xml_node ppr = para_node.child("w:pPr");
         if (!ppr) {
@@ -1505,6 +1495,7 @@ namespace duckx
         }
         
         // Apply the style properties
+        MutationJournal::before_change(run.journal(), run.get_node());
         auto apply_result = apply_character_properties_safe(run, style->character_properties());
         if (!apply_result.ok()) {
             return Result<void>(apply_result.error());
@@ -1531,6 +1522,7 @@ namespace duckx
         }
         
         // Apply the style properties
+        MutationJournal::before_change(table.journal(), table.get_node());
         auto apply_result = apply_table_properties_safe(table, style->table_properties());
         if (!apply_result.ok()) {
             return Result<void>(apply_result.error());
@@ -1572,6 +1564,12 @@ namespace duckx
     }
     
     Result<void> StyleManager::apply_style_set_safe(const std::string& set_name, Document& doc)
+    {
+        return apply_style_set_safe(set_name, doc, OperationOptions());
+    }
+
+    Result<void> StyleManager::apply_style_set_safe(const std::string& set_name, Document& doc,
+                                                    const OperationOptions& operation)
     {
         auto set_it = m_style_sets.find(set_name);
         if (set_it == m_style_sets.end()) {
@@ -1604,12 +1602,50 @@ namespace duckx
         // Get document body for applying styles
         auto& body = doc.body();
         
+        // Progress counts the elements visited by all three phases; polled per table and paragraph.
+        // The counting pass is skipped when nobody listens to the progress.
+        std::uint64_t total = 0;
+        if (operation.on_progress) {
+            std::uint64_t table_count = 0;
+            std::uint64_t paragraph_count = 0;
+            std::uint64_t run_count = 0;
+            for (auto& table : body.tables()) {
+                (void)table;
+                ++table_count;
+            }
+            for (auto& paragraph : body.paragraphs()) {
+                ++paragraph_count;
+                for (auto& run : paragraph.runs()) {
+                    (void)run;
+                    ++run_count;
+                }
+            }
+            for (const auto* style : styles_to_apply) {
+                const StyleType type = style->type();
+                if (type == StyleType::TABLE || type == StyleType::MIXED) total += table_count;
+                if (type == StyleType::PARAGRAPH || type == StyleType::MIXED) total += paragraph_count;
+                if (type == StyleType::CHARACTER || type == StyleType::MIXED) total += run_count;
+            }
+        }
+        const OperationProgress progress(operation, total);
+        std::uint64_t processed = 0;
+        const auto cancelled = [&set_name]() {
+            return Result<void>(errors::operation_cancelled("apply_style_set",
+                DUCKX_ERROR_CONTEXT_STYLE("apply_style_set", set_name)));
+        };
+        if (!progress.report(processed)) {
+            return cancelled();
+        }
+        
         // Phase 1: Apply table styles
         for (const auto* style : styles_to_apply) {
             if (style->type() == StyleType::TABLE || style->type() == StyleType::MIXED) {
                 // Apply to all tables in the document
                 auto tables = body.tables();
                 for (auto& table : tables) {
+                    if (!progress.report(++processed)) {
+                        return cancelled();
+                    }
                     auto apply_result = apply_table_style_safe(table, style->name());
                     if (!apply_result.ok()) {
                         // Log warning but continue with other elements
@@ -1625,6 +1661,9 @@ namespace duckx
                 // Apply to all paragraphs in the document
                 auto paragraphs = body.paragraphs();
                 for (auto& paragraph : paragraphs) {
+                    if (!progress.report(++processed)) {
+                        return cancelled();
+                    }
                     // Check if paragraph already has a specific style
                     // If not, apply the style from the set
                     auto current_style = paragraph.get_style_safe();
@@ -1644,8 +1683,12 @@ namespace duckx
                 // Apply to all runs in the document
                 auto paragraphs = body.paragraphs();
                 for (auto& paragraph : paragraphs) {
+                    if (!progress.report(processed)) {
+                        return cancelled();
+                    }
                     auto runs = paragraph.runs();
                     for (auto& run : runs) {
+                        ++processed;
                         // Check if run already has a specific style
                         auto current_style = run.get_style_safe();
                         if (!current_style.ok() || current_style.value().empty()) {
@@ -1660,6 +1703,7 @@ namespace duckx
         }
         
         // Style set application is complete
+        progress.report(total);
         return Result<void>{};
     }
     
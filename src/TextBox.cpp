@@ -7,6 +7,9 @@
  */
 #include "TextBox.hpp"
 
+#include "NumericCodec.hpp"
+#include "OoxmlEnums.hpp"
+
 namespace duckx
 {
     TextBox::TextBox()
@@ -35,20 +38,20 @@ namespace duckx
         pugi::xml_node drawing_root;
         const std::string drawing_id_str = std::to_string(drawing_id);
         const std::string textbox_name = "Text Box " + drawing_id_str;
-        const std::string width_str = std::to_string(m_width_emu);
-        const std::string height_str = std::to_string(m_height_emu);
+        const numeric::NumberBuffer width_str = numeric::format_int(m_width_emu);
+        const numeric::NumberBuffer height_str = numeric::format_int(m_height_emu);
 
         if (m_has_position)
         {
             drawing_root = drawing.append_child("wp:anchor");
             auto positionH = drawing_root.append_child("wp:positionH");
-            const char* h_rel_str = (m_h_relative_from == RelativeFrom::PAGE) ? "page" : "margin";
+            const char* h_rel_str = ooxml::to_string(m_h_relative_from);
             positionH.append_attribute("relativeFrom").set_value(h_rel_str);
-            positionH.append_child("wp:posOffset").text().set(std::to_string(m_pos_x_emu).c_str());
+            positionH.append_child("wp:posOffset").text().set(numeric::format_int(m_pos_x_emu).c_str());
             auto positionV = drawing_root.append_child("wp:positionV");
-            const char* v_rel_str = (m_v_relative_from == RelativeFrom::PAGE) ? "page" : "margin";
+            const char* v_rel_str = ooxml::to_string(m_v_relative_from);
             positionV.append_attribute("relativeFrom").set_value(v_rel_str);
-            positionV.append_child("wp:posOffset").text().set(std::to_string(m_pos_y_emu).c_str());
+            positionV.append_child("wp:posOffset").text().set(numeric::format_int(m_pos_y_emu).c_str());
             auto simplePos = drawing_root.append_child("wp:simplePos");
             simplePos.append_attribute("x").set_value("0");
             simplePos.append_attribute("y").set_value("0");
@@ -90,15 +93,15 @@ namespace duckx
 
             // Horizontal Position
             auto positionH = drawing_root.append_child("wp:positionH");
-            const char* h_rel_str = (m_h_relative_from == RelativeFrom::PAGE) ? "page" : "margin";
+            const char* h_rel_str = ooxml::to_string(m_h_relative_from);
             positionH.append_attribute("relativeFrom").set_value(h_rel_str);
-            positionH.append_child("wp:posOffset").text().set(std::to_string(m_pos_x_emu).c_str());
+            positionH.append_child("wp:posOffset").text().set(numeric::format_int(m_pos_x_emu).c_str());
 
             // Vertical Position
             auto positionV = drawing_root.append_child("wp:positionV");
-            const char* v_rel_str = (m_v_relative_from == RelativeFrom::PAGE) ? "page" : "margin";
+            const char* v_rel_str = ooxml::to_string(m_v_relative_from);
             positionV.append_attribute("relativeFrom").set_value(v_rel_str);
-            positionV.append_child("wp:posOffset").text().set(std::to_string(m_pos_y_emu).c_str());
+            positionV.append_child("wp:posOffset").text().set(numeric::format_int(m_pos_y_emu).c_str());
         }
 
         auto docPr = drawing_root.append_child("wp:docPr");
@@ -117,7 +120,7 @@ namespace duckx
         auto wsp = graphicData.append_child("wps:wsp");
 
         auto cNvPr = wsp.append_child("wps:cNvPr");
-        cNvPr.append_attribute("id").set_value(std::to_string(drawing_id + 1).c_str());
+        cNvPr.append_attribute("id").set_value(numeric::format_int(drawing_id + 1).c_str());
         cNvPr.append_attribute("name").set_value(textbox_name.c_str());
         wsp.append_child("wps:cNvSpPr");
 
@@ -127,8 +130,8 @@ namespace duckx
         auto xfrm = spPr.append_child("a:xfrm");
         xfrm.append_child("a:off").append_attribute("x").set_value("0");
         xfrm.child("a:off").append_attribute("y").set_value("0");
-        xfrm.append_child("a:ext").append_attribute("cx").set_value(std::to_string(m_width_emu).c_str());
-        xfrm.child("a:ext").append_attribute("cy").set_value(std::to_string(m_height_emu).c_str());
+        xfrm.append_child("a:ext").append_attribute("cx").set_value(numeric::format_int(m_width_emu).c_str());
+        xfrm.child("a:ext").append_attribute("cy").set_value(numeric::format_int(m_height_emu).c_str());
 
         auto prstGeom = spPr.append_child("a:prstGeom");
         prstGeom.append_attribute("prst").set_value("rect");
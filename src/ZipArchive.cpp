@@ -0,0 +1,942 @@
+/*!
+ * @file ZipArchive.cpp
+ * @brief Implementation of the streaming ZIP reader and writer
+ *
+ * Implements the ZIP container format (APPNOTE 6.3) including the Zip64
+ * extensions. Deflate and inflate are delegated to the bundled miniz
+ * tdefl/tinfl engines, while all container bookkeeping lives here.
+ */
+#include "ZipArchive.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.h"
+
+namespace duckx
+{
+    namespace
+    {
+        constexpr std::uint32_t kLocalHeaderSig = 0x04034b50;
+        constexpr std::uint32_t kCentralHeaderSig = 0x02014b50;
+        constexpr std::uint32_t kEndOfCentralDirSig = 0x06054b50;
+        constexpr std::uint32_t kZip64EndOfCentralDirSig = 0x06064b50;
+        constexpr std::uint32_t kZip64LocatorSig = 0x07064b50;
+        constexpr std::uint16_t kZip64ExtraTag = 0x0001;
+
+        constexpr size_t kLocalHeaderSize = 30;
+        constexpr size_t kCentralHeaderSize = 46;
+        constexpr size_t kEndOfCentralDirSize = 22;
+        constexpr size_t kZip64EndOfCentralDirSize = 56;
+        constexpr size_t kZip64LocatorSize = 20;
+
+        constexpr std::uint32_t kMax32 = 0xFFFFFFFFu;
+        constexpr std::uint16_t kMax16 = 0xFFFFu;
+        // Streamed entries switch to Zip64 before deflate overhead could overflow 32 bits
+        constexpr std::uint64_t kStreamZip64Threshold = 0xF0000000u;
+        constexpr size_t kChunkSize = 64 * 1024;
+
+        constexpr std::uint16_t kVersionDefault = 20;
+        constexpr std::uint16_t kVersionZip64 = 45;
+        constexpr std::uint16_t kFlagDataDescriptor = 0x0008;
+        constexpr std::uint32_t kDataDescriptorSig = 0x08074b50;
+
+        int seek64(std::FILE* fp, const std::uint64_t offset)
+        {
+#if defined(_WIN32)
+            return _fseeki64(fp, static_cast<__int64>(offset), SEEK_SET);
+#else
+            return fseeko(fp, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        }
+
+        bool truncate64(std::FILE* fp, const std::uint64_t size)
+        {
+            std::fflush(fp);
+#if defined(_WIN32)
+            return _chsize_s(_fileno(fp), static_cast<__int64>(size)) == 0;
+#else
+            return ftruncate(fileno(fp), static_cast<off_t>(size)) == 0;
+#endif
+        }
+
+        std::uint64_t file_size64(std::FILE* fp)
+        {
+#if defined(_WIN32)
+            _fseeki64(fp, 0, SEEK_END);
+            return static_cast<std::uint64_t>(_ftelli64(fp));
+#else
+            fseeko(fp, 0, SEEK_END);
+            return static_cast<std::uint64_t>(ftello(fp));
+#endif
+        }
+
+        std::uint16_t get16(const unsigned char* p)
+        {
+            return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        std::uint32_t get32(const unsigned char* p)
+        {
+            return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+                   (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+        }
+
+        std::uint64_t get64(const unsigned char* p)
+        {
+            return static_cast<std::uint64_t>(get32(p)) | (static_cast<std::uint64_t>(get32(p + 4)) << 32);
+        }
+
+        void put16(std::string& out, const std::uint16_t v)
+        {
+            out.push_back(static_cast<char>(v & 0xFF));
+            out.push_back(static_cast<char>((v >> 8) & 0xFF));
+        }
+
+        void put32(std::string& out, const std::uint32_t v)
+        {
+            put16(out, static_cast<std::uint16_t>(v & 0xFFFF));
+            put16(out, static_cast<std::uint16_t>(v >> 16));
+        }
+
+        void put64(std::string& out, const std::uint64_t v)
+        {
+            put32(out, static_cast<std::uint32_t>(v & 0xFFFFFFFFu));
+            put32(out, static_cast<std::uint32_t>(v >> 32));
+        }
+
+        std::uint32_t clamp32(const std::uint64_t v, const bool force)
+        {
+            return (force || v >= kMax32) ? kMax32 : static_cast<std::uint32_t>(v);
+        }
+
+        bool read_exact(std::FILE* fp, void* buf, const size_t size)
+        {
+            return std::fread(buf, 1, size, fp) == size;
+        }
+
+        struct CompressorDeleter
+        {
+            void operator()(tdefl_compressor* c) const { std::free(c); }
+        };
+        using CompressorPtr = std::unique_ptr<tdefl_compressor, CompressorDeleter>;
+
+        CompressorPtr make_compressor()
+        {
+            return CompressorPtr(static_cast<tdefl_compressor*>(std::malloc(sizeof(tdefl_compressor))));
+        }
+
+        mz_uint deflate_flags(const int level)
+        {
+            return tdefl_create_comp_flags_from_zip_params(level, -15, MZ_DEFAULT_STRATEGY);
+        }
+
+        mz_bool append_to_string(const void* buf, const int len, void* user)
+        {
+            static_cast<std::string*>(user)->append(static_cast<const char*>(buf), static_cast<size_t>(len));
+            return MZ_TRUE;
+        }
+
+        struct FileSinkState
+        {
+            std::FILE* fp;
+            std::uint64_t written;
+        };
+
+        mz_bool append_to_file(const void* buf, const int len, void* user)
+        {
+            auto* state = static_cast<FileSinkState*>(user);
+            if (std::fwrite(buf, 1, static_cast<size_t>(len), state->fp) != static_cast<size_t>(len))
+                return MZ_FALSE;
+            state->written += static_cast<std::uint64_t>(len);
+            return MZ_TRUE;
+        }
+        std::uint16_t dos_time_of(const std::tm& t)
+        {
+            return static_cast<std::uint16_t>((t.tm_hour << 11) | (t.tm_min << 5) | (t.tm_sec >> 1));
+        }
+
+        std::uint16_t dos_date_of(const std::tm& t)
+        {
+            return static_cast<std::uint16_t>(((t.tm_year + 1900 - 1980) << 9) | ((t.tm_mon + 1) << 5) | t.tm_mday);
+        }
+    } // namespace
+
+    std::uint32_t zip_crc32(const void* data, const size_t size, const std::uint32_t crc)
+    {
+        return static_cast<std::uint32_t>(mz_crc32(crc, static_cast<const unsigned char*>(data), size));
+    }
+
+    std::uint64_t zip_local_record_size(const ZipEntryInfo& entry)
+    {
+        const bool zip64 = entry.uncompressed_size >= kMax32 || entry.compressed_size >= kMax32;
+        return kLocalHeaderSize + entry.name.size() + (zip64 ? 20 : 0) + entry.compressed_size;
+    }
+
+    // ============================================================================
+    // ZipReader
+    // ============================================================================
+
+    ZipReader::~ZipReader()
+    {
+        close();
+    }
+
+    bool ZipReader::open(const std::string& path)
+    {
+        close();
+        m_fp = std::fopen(path.c_str(), "rb");
+        if (!m_fp)
+            return false;
+
+        if (!read_central_directory())
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void ZipReader::close()
+    {
+        if (m_fp)
+        {
+            std::fclose(m_fp);
+            m_fp = nullptr;
+        }
+        m_file_size = 0;
+        m_cd_offset = 0;
+        m_zip64 = false;
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    std::uint64_t ZipReader::unreferenced_bytes() const
+    {
+        std::uint64_t referenced = 0;
+        for (const auto& entry: m_entries)
+        {
+            referenced += local_record_size(entry);
+        }
+        return referenced < m_cd_offset ? m_cd_offset - referenced : 0;
+    }
+
+    std::uint64_t ZipReader::local_record_size(const ZipEntryInfo& entry) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        unsigned char header[kLocalHeaderSize];
+        if (!m_fp || seek64(m_fp, entry.local_header_offset) != 0 || !read_exact(m_fp, header, sizeof(header)) ||
+            get32(header) != kLocalHeaderSig)
+        {
+            return zip_local_record_size(entry);
+        }
+
+        std::uint64_t size = kLocalHeaderSize + get16(header + 26) + get16(header + 28) + entry.compressed_size;
+        if (get16(header + 6) & kFlagDataDescriptor)
+        {
+            // 数据描述符：CRC 与两个尺寸（Zip64 条目为 8 字节），签名可选
+            const bool zip64 = entry.uncompressed_size >= kMax32 || entry.compressed_size >= kMax32;
+            std::uint64_t descriptor = zip64 ? 20 : 12;
+            unsigned char signature[4];
+            if (seek64(m_fp, entry.local_header_offset + size) == 0 && read_exact(m_fp, signature, 4) &&
+                get32(signature) == kDataDescriptorSig)
+            {
+                descriptor += 4;
+            }
+            size += descriptor;
+        }
+        return size;
+    }
+
+    const ZipEntryInfo* ZipReader::find(const std::string& name) const
+    {
+        const auto it = m_index.find(name);
+        return it != m_index.end() ? &m_entries[it->second] : nullptr;
+    }
+
+    bool ZipReader::read_central_directory()
+    {
+        m_file_size = file_size64(m_fp);
+        if (m_file_size < kEndOfCentralDirSize)
+            return false;
+
+        // The EOCD record sits at the end, possibly followed by a comment of up to 64 KB
+        const std::uint64_t tail_size = std::min<std::uint64_t>(m_file_size, kEndOfCentralDirSize + kMax16);
+        const std::uint64_t tail_start = m_file_size - tail_size;
+        std::string tail(static_cast<size_t>(tail_size), '\0');
+        if (seek64(m_fp, tail_start) != 0 || !read_exact(m_fp, &tail[0], tail.size()))
+            return false;
+
+        const auto* bytes = reinterpret_cast<const unsigned char*>(tail.data());
+        size_t eocd_pos = std::string::npos;
+        for (size_t i = tail.size() - kEndOfCentralDirSize + 1; i-- > 0;)
+        {
+            if (get32(bytes + i) == kEndOfCentralDirSig)
+            {
+                eocd_pos = i;
+                break;
+            }
+        }
+        if (eocd_pos == std::string::npos)
+            return false;
+
+        const unsigned char* eocd = bytes + eocd_pos;
+        std::uint64_t total_entries = get16(eocd + 10);
+        std::uint64_t cd_size = get32(eocd + 12);
+        std::uint64_t cd_offset = get32(eocd + 16);
+
+        // A Zip64 locator immediately precedes the classic EOCD record when present
+        const std::uint64_t eocd_abs = tail_start + eocd_pos;
+        if (eocd_abs >= kZip64LocatorSize)
+        {
+            unsigned char locator[kZip64LocatorSize];
+            if (seek64(m_fp, eocd_abs - kZip64LocatorSize) == 0 && read_exact(m_fp, locator, sizeof(locator)) &&
+                get32(locator) == kZip64LocatorSig)
+            {
+                const std::uint64_t z64_offset = get64(locator + 8);
+                unsigned char record[kZip64EndOfCentralDirSize];
+                if (seek64(m_fp, z64_offset) != 0 || !read_exact(m_fp, record, sizeof(record)) ||
+                    get32(record) != kZip64EndOfCentralDirSig)
+                {
+                    return false;
+                }
+                total_entries = get64(record + 32);
+                cd_size = get64(record + 40);
+                cd_offset = get64(record + 48);
+                m_zip64 = true;
+            }
+        }
+
+        if (cd_offset > m_file_size || cd_size > m_file_size - cd_offset)
+            return false;
+        m_cd_offset = cd_offset;
+
+        std::string directory(static_cast<size_t>(cd_size), '\0');
+        if (cd_size > 0 && (seek64(m_fp, cd_offset) != 0 || !read_exact(m_fp, &directory[0], directory.size())))
+            return false;
+
+        // 条目数来自文件，可能被篡改；每条记录至少占 kCentralHeaderSize 字节，
+        // 预留空间不超过目录本身能容纳的条目数
+        const std::uint64_t reserved = std::min<std::uint64_t>(total_entries, cd_size / kCentralHeaderSize);
+        m_entries.reserve(static_cast<size_t>(reserved));
+        m_index.reserve(static_cast<size_t>(reserved));
+
+        const auto* p = reinterpret_cast<const unsigned char*>(directory.data());
+        const unsigned char* end = p + directory.size();
+        for (std::uint64_t n = 0; n < total_entries; ++n)
+        {
+            if (end - p < static_cast<std::ptrdiff_t>(kCentralHeaderSize) || get32(p) != kCentralHeaderSig)
+                return false;
+
+            ZipEntryInfo info;
+            info.flags = get16(p + 8);
+            info.method = get16(p + 10);
+            info.dos_time = get16(p + 12);
+            info.dos_date = get16(p + 14);
+            info.crc32 = get32(p + 16);
+            info.compressed_size = get32(p + 20);
+            info.uncompressed_size = get32(p + 24);
+            const std::uint16_t name_len = get16(p + 28);
+            const std::uint16_t extra_len = get16(p + 30);
+            const std::uint16_t comment_len = get16(p + 32);
+            info.local_header_offset = get32(p + 42);
+
+            const size_t record_size = kCentralHeaderSize + name_len + extra_len + comment_len;
+            if (static_cast<size_t>(end - p) < record_size)
+                return false;
+
+            info.name.assign(reinterpret_cast<const char*>(p + kCentralHeaderSize), name_len);
+
+            // Zip64 extended information only carries the fields saturated in the fixed header
+            const unsigned char* extra = p + kCentralHeaderSize + name_len;
+            const unsigned char* extra_end = extra + extra_len;
+            while (extra_end - extra >= 4)
+            {
+                const std::uint16_t tag = get16(extra);
+                const std::uint16_t size = get16(extra + 2);
+                const unsigned char* field = extra + 4;
+                if (extra_end - field < size)
+                    break;
+                if (tag == kZip64ExtraTag)
+                {
+                    const unsigned char* cursor = field;
+                    const unsigned char* field_end = field + size;
+                    if (info.uncompressed_size == kMax32 && field_end - cursor >= 8)
+                    {
+                        info.uncompressed_size = get64(cursor);
+                        cursor += 8;
+                    }
+                    if (info.compressed_size == kMax32 && field_end - cursor >= 8)
+                    {
+                        info.compressed_size = get64(cursor);
+                        cursor += 8;
+                    }
+                    if (info.local_header_offset == kMax32 && field_end - cursor >= 8)
+                    {
+                        info.local_header_offset = get64(cursor);
+                    }
+                }
+                extra = field + size;
+            }
+
+            m_index.emplace(info.name, m_entries.size());
+            m_entries.push_back(std::move(info));
+            p += record_size;
+        }
+
+        return true;
+    }
+
+    bool ZipReader::locate_data(const ZipEntryInfo& entry, std::uint64_t& data_offset)
+    {
+        if (!m_fp)
+            return false;
+
+        unsigned char header[kLocalHeaderSize];
+        if (seek64(m_fp, entry.local_header_offset) != 0 || !read_exact(m_fp, header, sizeof(header)) ||
+            get32(header) != kLocalHeaderSig)
+        {
+            return false;
+        }
+
+        data_offset = entry.local_header_offset + kLocalHeaderSize + get16(header + 26) + get16(header + 28);
+        if (data_offset > m_file_size || entry.compressed_size > m_file_size - data_offset)
+            return false;
+
+        return seek64(m_fp, data_offset) == 0;
+    }
+
+    bool ZipReader::read_raw(const ZipEntryInfo& entry, const DataSink& sink)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return copy_raw(entry, sink);
+    }
+
+    bool ZipReader::copy_raw(const ZipEntryInfo& entry, const DataSink& sink)
+    {
+        std::uint64_t data_offset = 0;
+        if (!locate_data(entry, data_offset))
+            return false;
+
+        std::string buffer(kChunkSize, '\0');
+        std::uint64_t remaining = entry.compressed_size;
+        while (remaining > 0)
+        {
+            const size_t chunk = static_cast<size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+            if (!read_exact(m_fp, &buffer[0], chunk) || !sink(buffer.data(), chunk))
+                return false;
+            remaining -= chunk;
+        }
+        return true;
+    }
+
+    bool ZipReader::extract(const ZipEntryInfo& entry, const DataSink& sink)
+    {
+        mz_ulong crc = MZ_CRC32_INIT;
+        std::uint64_t produced = 0;
+
+        const auto checked_sink = [&](const char* data, const size_t size)
+        {
+            crc = mz_crc32(crc, reinterpret_cast<const unsigned char*>(data), size);
+            produced += size;
+            return sink(data, size);
+        };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (entry.method == 0)
+        {
+            if (!copy_raw(entry, checked_sink))
+                return false;
+        }
+        else if (entry.method == MZ_DEFLATED)
+        {
+            std::uint64_t data_offset = 0;
+            if (!locate_data(entry, data_offset))
+                return false;
+
+            tinfl_decompressor inflator;
+            tinfl_init(&inflator);
+
+            std::string input(kChunkSize, '\0');
+            std::string dictionary(TINFL_LZ_DICT_SIZE, '\0');
+            auto* dict = reinterpret_cast<mz_uint8*>(&dictionary[0]);
+            size_t dict_ofs = 0;
+            size_t in_ofs = 0;
+            size_t in_avail = 0;
+            std::uint64_t comp_remaining = entry.compressed_size;
+
+            tinfl_status status;
+            do
+            {
+                if (in_avail == 0 && comp_remaining > 0)
+                {
+                    in_avail = static_cast<size_t>(std::min<std::uint64_t>(comp_remaining, input.size()));
+                    if (!read_exact(m_fp, &input[0], in_avail))
+                        return false;
+                    comp_remaining -= in_avail;
+                    in_ofs = 0;
+                }
+
+                size_t in_bytes = in_avail;
+                size_t out_bytes = TINFL_LZ_DICT_SIZE - dict_ofs;
+                status = tinfl_decompress(&inflator, reinterpret_cast<const mz_uint8*>(input.data()) + in_ofs,
+                                          &in_bytes, dict, dict + dict_ofs, &out_bytes,
+                                          comp_remaining > 0 ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+                in_avail -= in_bytes;
+                in_ofs += in_bytes;
+
+                if (out_bytes > 0)
+                {
+                    if (!checked_sink(reinterpret_cast<const char*>(dict + dict_ofs), out_bytes))
+                        return false;
+                    dict_ofs = (dict_ofs + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+                }
+            } while (status == TINFL_STATUS_NEEDS_MORE_INPUT || status == TINFL_STATUS_HAS_MORE_OUTPUT);
+
+            if (status != TINFL_STATUS_DONE)
+                return false;
+        }
+        else
+        {
+            return false; // Unsupported compression method
+        }
+
+        return produced == entry.uncompressed_size && static_cast<std::uint32_t>(crc) == entry.crc32;
+    }
+
+    bool ZipReader::read(const ZipEntryInfo& entry, std::string& out)
+    {
+        out.clear();
+        out.reserve(static_cast<size_t>(entry.uncompressed_size));
+        return extract(entry, [&out](const char* data, const size_t size)
+        {
+            out.append(data, size);
+            return true;
+        });
+    }
+
+    // ============================================================================
+    // ZipWriter
+    // ============================================================================
+
+    ZipWriter::~ZipWriter()
+    {
+        discard();
+    }
+
+    bool ZipWriter::open(const std::string& path, const int level)
+    {
+        if (m_fp)
+            return false;
+
+        m_fp = std::fopen(path.c_str(), "wb");
+        if (!m_fp)
+            return false;
+
+        m_level = level;
+        m_offset = 0;
+        m_appending = false;
+        m_entries.clear();
+        return true;
+    }
+
+    bool ZipWriter::open_append(const std::string& path, std::vector<ZipEntryInfo> kept,
+                                const std::uint64_t expected_size, const int level)
+    {
+        if (m_fp)
+            return false;
+
+        m_fp = std::fopen(path.c_str(), "r+b");
+        if (!m_fp)
+            return false;
+
+        // 文件在索引之后被改写过时拒绝追加，由调用方改为完整重写
+        const std::uint64_t size = file_size64(m_fp);
+        if (size != expected_size || seek64(m_fp, size) != 0)
+        {
+            std::fclose(m_fp);
+            m_fp = nullptr;
+            return false;
+        }
+
+        m_level = level;
+        m_offset = size;
+        m_append_base = size;
+        m_appending = true;
+        m_entries = std::move(kept);
+        return true;
+    }
+
+    bool ZipWriter::close()
+    {
+        if (!m_fp)
+            return false;
+
+        const bool ok = write_central_directory();
+        if (!ok && m_appending)
+        {
+            truncate64(m_fp, m_append_base);
+        }
+        const bool closed = std::fclose(m_fp) == 0;
+        m_fp = nullptr;
+        m_appending = false;
+        m_entries.clear();
+        return ok && closed;
+    }
+
+    void ZipWriter::discard()
+    {
+        if (!m_fp)
+            return;
+
+        // 追加失败时截回原长度，旧的中央目录重新成为文件末尾
+        if (m_appending)
+        {
+            truncate64(m_fp, m_append_base);
+        }
+        std::fclose(m_fp);
+        m_fp = nullptr;
+        m_appending = false;
+        m_entries.clear();
+    }
+
+    void ZipWriter::set_fixed_time(const std::time_t timestamp)
+    {
+        // UTC keeps the stamp independent of the machine's time zone; DOS dates start in 1980
+        std::tm utc{};
+#if defined(_WIN32)
+        gmtime_s(&utc, &timestamp);
+#else
+        gmtime_r(&timestamp, &utc);
+#endif
+        if (utc.tm_year < 80)
+        {
+            utc = std::tm{};
+            utc.tm_year = 80;
+            utc.tm_mday = 1;
+        }
+        m_fixed_time = true;
+        m_fixed_dos_time = dos_time_of(utc);
+        m_fixed_dos_date = dos_date_of(utc);
+    }
+
+    void ZipWriter::stamp_time(ZipEntryInfo& entry) const
+    {
+        if (m_fixed_time)
+        {
+            entry.dos_time = m_fixed_dos_time;
+            entry.dos_date = m_fixed_dos_date;
+            return;
+        }
+
+        const std::time_t now = std::time(nullptr);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        entry.dos_time = dos_time_of(local);
+        entry.dos_date = dos_date_of(local);
+    }
+
+    bool ZipWriter::write_local_header(const ZipEntryInfo& entry, const bool zip64)
+    {
+        std::string header;
+        header.reserve(kLocalHeaderSize + entry.name.size() + 20);
+        put32(header, kLocalHeaderSig);
+        put16(header, zip64 ? kVersionZip64 : kVersionDefault);
+        put16(header, entry.flags);
+        put16(header, entry.method);
+        put16(header, entry.dos_time);
+        put16(header, entry.dos_date);
+        put32(header, entry.crc32);
+        put32(header, zip64 ? kMax32 : static_cast<std::uint32_t>(entry.compressed_size));
+        put32(header, zip64 ? kMax32 : static_cast<std::uint32_t>(entry.uncompressed_size));
+        put16(header, static_cast<std::uint16_t>(entry.name.size()));
+        put16(header, zip64 ? 20 : 0);
+        header.append(entry.name);
+        if (zip64)
+        {
+            put16(header, kZip64ExtraTag);
+            put16(header, 16);
+            put64(header, entry.uncompressed_size);
+            put64(header, entry.compressed_size);
+        }
+
+        if (std::fwrite(header.data(), 1, header.size(), m_fp) != header.size())
+            return false;
+        m_offset += header.size();
+        return true;
+    }
+
+    bool ZipWriter::add_entry(const std::string& name, const void* data, const size_t size)
+    {
+        ZipCompressedData compressed;
+        return m_fp && compress(data, size, m_level, compressed) && add_compressed_entry(name, compressed);
+    }
+
+    bool ZipWriter::compress(const void* data, const size_t size, const int level, ZipCompressedData& out)
+    {
+        out.uncompressed_size = size;
+        out.crc32 = static_cast<std::uint32_t>(mz_crc32(MZ_CRC32_INIT, static_cast<const unsigned char*>(data), size));
+        out.data.clear();
+
+        if (level <= 0 || size == 0)
+        {
+            out.method = 0;
+            out.data.assign(static_cast<const char*>(data), size);
+            return true;
+        }
+
+        CompressorPtr compressor = make_compressor();
+        if (!compressor)
+            return false;
+        out.data.reserve(size / 2 + 64);
+        if (tdefl_init(compressor.get(), append_to_string, &out.data, static_cast<int>(deflate_flags(level))) !=
+            TDEFL_STATUS_OKAY ||
+            tdefl_compress_buffer(compressor.get(), data, size, TDEFL_FINISH) != TDEFL_STATUS_DONE)
+        {
+            return false;
+        }
+        out.method = MZ_DEFLATED;
+        return true;
+    }
+
+    bool ZipWriter::add_compressed_entry(const std::string& name, const ZipCompressedData& data)
+    {
+        if (!m_fp || name.size() > kMax16)
+            return false;
+
+        ZipEntryInfo entry;
+        entry.name = name;
+        entry.local_header_offset = m_offset;
+        entry.uncompressed_size = data.uncompressed_size;
+        entry.crc32 = data.crc32;
+        entry.method = data.method;
+        entry.compressed_size = data.data.size();
+        stamp_time(entry);
+
+        const bool zip64 = m_force_zip64 || entry.uncompressed_size >= kMax32 || entry.compressed_size >= kMax32;
+        if (!write_local_header(entry, zip64))
+            return false;
+        if (!data.data.empty() && std::fwrite(data.data.data(), 1, data.data.size(), m_fp) != data.data.size())
+            return false;
+        m_offset += data.data.size();
+
+        m_entries.push_back(std::move(entry));
+        return true;
+    }
+
+    bool ZipWriter::add_entry_stream(const std::string& name, const std::uint64_t size, const DataSource& source)
+    {
+        if (!m_fp || name.size() > kMax16)
+            return false;
+
+        ZipEntryInfo entry;
+        entry.name = name;
+        entry.local_header_offset = m_offset;
+        entry.uncompressed_size = size;
+        entry.method = (m_level > 0 && size > 0) ? MZ_DEFLATED : 0;
+        stamp_time(entry);
+
+        // Sizes and CRC are patched once the data has been streamed
+        const bool zip64 = m_force_zip64 || size >= kStreamZip64Threshold;
+        if (!write_local_header(entry, zip64))
+            return false;
+
+        CompressorPtr compressor;
+        FileSinkState file_state{m_fp, 0};
+        if (entry.method == MZ_DEFLATED)
+        {
+            compressor = make_compressor();
+            if (!compressor ||
+                tdefl_init(compressor.get(), append_to_file, &file_state, static_cast<int>(deflate_flags(m_level))) !=
+                TDEFL_STATUS_OKAY)
+            {
+                return false;
+            }
+        }
+
+        std::string buffer(kChunkSize, '\0');
+        mz_ulong crc = MZ_CRC32_INIT;
+        std::uint64_t remaining = size;
+        while (remaining > 0)
+        {
+            const size_t want = static_cast<size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+            const size_t got = source(&buffer[0], want);
+            if (got == 0 || got > want)
+                return false;
+
+            crc = mz_crc32(crc, reinterpret_cast<const unsigned char*>(buffer.data()), got);
+            remaining -= got;
+
+            if (compressor)
+            {
+                const tdefl_status status = tdefl_compress_buffer(compressor.get(), buffer.data(), got,
+                                                                  remaining > 0 ? TDEFL_NO_FLUSH : TDEFL_FINISH);
+                if (status != (remaining > 0 ? TDEFL_STATUS_OKAY : TDEFL_STATUS_DONE))
+                    return false;
+            }
+            else
+            {
+                if (std::fwrite(buffer.data(), 1, got, m_fp) != got)
+                    return false;
+                file_state.written += got;
+            }
+        }
+
+        entry.crc32 = static_cast<std::uint32_t>(crc);
+        entry.compressed_size = file_state.written;
+        if (!zip64 && entry.compressed_size >= kMax32)
+            return false;
+
+        const std::uint64_t end_offset = entry.local_header_offset + kLocalHeaderSize + entry.name.size() +
+                                         (zip64 ? 20 : 0) + entry.compressed_size;
+        const std::uint64_t saved_offset = m_offset;
+        if (seek64(m_fp, entry.local_header_offset) != 0)
+            return false;
+        m_offset = entry.local_header_offset;
+        if (!write_local_header(entry, zip64) || seek64(m_fp, end_offset) != 0)
+            return false;
+        m_offset = saved_offset + entry.compressed_size;
+
+        m_entries.push_back(std::move(entry));
+        return true;
+    }
+
+    bool ZipWriter::add_raw_entry(ZipReader& source, const ZipEntryInfo& entry)
+    {
+        if (!m_fp)
+            return false;
+
+        ZipEntryInfo copy = entry;
+        copy.local_header_offset = m_offset;
+        // Sizes are known up front, so a trailing data descriptor is never needed
+        copy.flags = static_cast<std::uint16_t>(copy.flags & ~kFlagDataDescriptor);
+        if (m_fixed_time)
+        {
+            stamp_time(copy);
+        }
+
+        const bool zip64 = m_force_zip64 || copy.uncompressed_size >= kMax32 || copy.compressed_size >= kMax32;
+        if (!write_local_header(copy, zip64))
+            return false;
+
+        std::uint64_t copied = 0;
+        const bool ok = source.read_raw(entry, [this, &copied](const char* data, const size_t size)
+        {
+            if (std::fwrite(data, 1, size, m_fp) != size)
+                return false;
+            copied += size;
+            return true;
+        });
+        m_offset += copied;
+        if (!ok || copied != copy.compressed_size)
+            return false;
+
+        m_entries.push_back(std::move(copy));
+        return true;
+    }
+
+    bool ZipWriter::write_central_directory()
+    {
+        const std::uint64_t cd_offset = m_offset;
+        std::string record;
+
+        for (const auto& entry: m_entries)
+        {
+            const bool big_usize = m_force_zip64 || entry.uncompressed_size >= kMax32;
+            const bool big_csize = m_force_zip64 || entry.compressed_size >= kMax32;
+            const bool big_offset = m_force_zip64 || entry.local_header_offset >= kMax32;
+            const std::uint16_t extra_len = static_cast<std::uint16_t>(
+                (big_usize ? 8 : 0) + (big_csize ? 8 : 0) + (big_offset ? 8 : 0));
+            const bool zip64 = extra_len > 0;
+
+            record.clear();
+            put32(record, kCentralHeaderSig);
+            put16(record, zip64 ? kVersionZip64 : kVersionDefault);
+            put16(record, zip64 ? kVersionZip64 : kVersionDefault);
+            put16(record, entry.flags);
+            put16(record, entry.method);
+            put16(record, entry.dos_time);
+            put16(record, entry.dos_date);
+            put32(record, entry.crc32);
+            put32(record, clamp32(entry.compressed_size, big_csize));
+            put32(record, clamp32(entry.uncompressed_size, big_usize));
+            put16(record, static_cast<std::uint16_t>(entry.name.size()));
+            put16(record, zip64 ? static_cast<std::uint16_t>(extra_len + 4) : 0);
+            put16(record, 0); // comment length
+            put16(record, 0); // disk number start
+            put16(record, 0); // internal attributes
+            put32(record, 0); // external attributes
+            put32(record, clamp32(entry.local_header_offset, big_offset));
+            record.append(entry.name);
+            if (zip64)
+            {
+                put16(record, kZip64ExtraTag);
+                put16(record, extra_len);
+                if (big_usize)
+                    put64(record, entry.uncompressed_size);
+                if (big_csize)
+                    put64(record, entry.compressed_size);
+                if (big_offset)
+                    put64(record, entry.local_header_offset);
+            }
+
+            if (std::fwrite(record.data(), 1, record.size(), m_fp) != record.size())
+                return false;
+            m_offset += record.size();
+        }
+
+        const std::uint64_t cd_size = m_offset - cd_offset;
+        const std::uint64_t count = m_entries.size();
+        const bool zip64 = m_force_zip64 || count >= kMax16 || cd_size >= kMax32 || cd_offset >= kMax32;
+
+        record.clear();
+        if (zip64)
+        {
+            const std::uint64_t z64_offset = m_offset;
+            put32(record, kZip64EndOfCentralDirSig);
+            put64(record, kZip64EndOfCentralDirSize - 12);
+            put16(record, kVersionZip64);
+            put16(record, kVersionZip64);
+            put32(record, 0); // this disk
+            put32(record, 0); // disk with central directory
+            put64(record, count);
+            put64(record, count);
+            put64(record, cd_size);
+            put64(record, cd_offset);
+
+            put32(record, kZip64LocatorSig);
+            put32(record, 0);
+            put64(record, z64_offset);
+            put32(record, 1); // total disks
+        }
+
+        const std::uint16_t count16 = zip64 ? kMax16 : static_cast<std::uint16_t>(count);
+        put32(record, kEndOfCentralDirSig);
+        put16(record, 0);
+        put16(record, 0);
+        put16(record, count16);
+        put16(record, count16);
+        put32(record, clamp32(cd_size, zip64 && m_force_zip64));
+        put32(record, clamp32(cd_offset, zip64 && m_force_zip64));
+        put16(record, 0); // comment length
+
+        if (std::fwrite(record.data(), 1, record.size(), m_fp) != record.size())
+            return false;
+        m_offset += record.size();
+        return true;
+    }
+} // namespace duckx
@@ -156,6 +156,62 @@ TEST_F(RunTest, FormattingOperations)
     EXPECT_EQ(highlight, dx::HighlightColor::YELLOW);
 }
 
+TEST_F(RunTest, PropertiesSinglePass)
+{
+    const auto para_node = body.child("w:p");
+    const dx::Run duckx_run(para_node, para_node.child("w:r"));
+
+    const dx::RunProperties props = duckx_run.properties();
+    EXPECT_EQ(props.formatting, duckx_run.get_formatting());
+    EXPECT_TRUE(props.has_font);
+    EXPECT_STREQ(props.font, "Arial");
+    EXPECT_TRUE(props.has_font_size);
+    EXPECT_EQ(props.font_size, 12.0);
+    EXPECT_TRUE(props.has_color);
+    EXPECT_STREQ(props.color, "FF0000");
+    EXPECT_TRUE(props.has_highlight);
+    EXPECT_EQ(props.highlight, dx::HighlightColor::YELLOW);
+
+    // 没有 w:rPr 的 run 返回默认值
+    const dx::Run plain_run(para_node, para_node.child("w:r").next_sibling("w:r"));
+    const dx::RunProperties plain = plain_run.properties();
+    EXPECT_EQ(plain.formatting, dx::none);
+    EXPECT_FALSE(plain.has_font);
+    EXPECT_FALSE(plain.has_color);
+    EXPECT_STREQ(plain.style, "");
+}
+
+TEST_F(RunTest, PropertiesToggleValues)
+{
+    pugi::xml_document local;
+    ASSERT_TRUE(local.load_string(R"(
+        <w:p xmlns:w="http://schemas.openxmlformats.org/wordprocessingml/2006/main">
+            <w:r>
+                <w:rPr>
+                    <w:rStyle w:val="Emphasis"/>
+                    <w:b w:val="0"/>
+                    <w:i/>
+                    <w:i w:val="false"/>
+                    <w:u w:val="none"/>
+                    <w:strike/>
+                    <w:vertAlign w:val="superscript"/>
+                    <w:color w:val="auto"/>
+                </w:rPr>
+                <w:t>x</w:t>
+            </w:r>
+        </w:p>
+    )"));
+
+    const auto para_node = local.child("w:p");
+    const dx::Run duckx_run(para_node, para_node.child("w:r"));
+    const dx::RunProperties props = duckx_run.properties();
+
+    // The first occurrence of a property wins, as with child()
+    EXPECT_EQ(props.formatting, dx::italic | dx::strikethrough | dx::superscript);
+    EXPECT_FALSE(props.has_color);
+    EXPECT_STREQ(props.style, "Emphasis");
+}
+
 TEST_F(RunTest, SetFormatting)
 {
     const auto para_node = body.child("w:p");
@@ -280,6 +336,48 @@ TEST_F(ParagraphTest, ParagraphFormatting)
     EXPECT_EQ(first_line, 18.0); // 360 twips = 18 points
 }
 
+TEST_F(ParagraphTest, PropertiesSinglePass)
+{
+    const auto para_node = body.child("w:p").next_sibling("w:p");
+    const dx::Paragraph para(body, para_node);
+
+    const dx::ParagraphProperties props = para.properties();
+    EXPECT_EQ(props.alignment, dx::Alignment::CENTER);
+    EXPECT_TRUE(props.has_spacing);
+    EXPECT_FALSE(props.has_line_spacing);
+    EXPECT_EQ(props.line_spacing, 1.0);
+    EXPECT_EQ(props.spacing_before, 12.0);
+    EXPECT_EQ(props.spacing_after, 6.0);
+    EXPECT_TRUE(props.has_indentation);
+    EXPECT_EQ(props.indent_left, 36.0);
+    EXPECT_EQ(props.indent_first_line, 18.0);
+    EXPECT_FALSE(props.has_numbering);
+
+    pugi::xml_document local;
+    ASSERT_TRUE(local.load_string(R"(
+        <w:p xmlns:w="http://schemas.openxmlformats.org/wordprocessingml/2006/main">
+            <w:pPr>
+                <w:pStyle w:val="ListParagraph"/>
+                <w:numPr><w:ilvl w:val="2"/><w:numId w:val="5"/></w:numPr>
+                <w:ind w:hanging="360" w:firstLine="720"/>
+            </w:pPr>
+        </w:p>
+    )"));
+    const dx::Paragraph list_para(local, local.child("w:p"));
+    const dx::ParagraphProperties list_props = list_para.properties();
+    EXPECT_STREQ(list_props.style, "ListParagraph");
+    EXPECT_TRUE(list_props.has_numbering);
+    EXPECT_EQ(list_props.list_level, 2);
+    EXPECT_EQ(list_props.list_num_id, 5);
+    EXPECT_EQ(list_props.indent_first_line, -18.0); // hanging wins over firstLine
+
+    dx::ListType type;
+    int level = 0, num_id = 0;
+    EXPECT_TRUE(list_para.get_list_style(type, level, num_id));
+    EXPECT_EQ(level, 2);
+    EXPECT_EQ(num_id, 5);
+}
+
 TEST_F(ParagraphTest, SetFormatting)
 {
     const auto para_node = body.child("w:p");
@@ -0,0 +1,163 @@
+/*!
+ * @file test_bookmark_index.cpp
+ * @brief Unit tests for the bookmark and cross-reference index
+ *
+ * Covers simple and complex REF/PAGEREF fields, hyperlink anchors,
+ * case-insensitive lookup, id allocation, index maintenance on insert
+ * and delete, and rebuilding after edits made outside the index.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "BookmarkIndex.hpp"
+#include "Document.hpp"
+
+namespace
+{
+    const char* const kBody =
+        "<w:body xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:p><w:pPr/><w:bookmarkStart w:id=\"3\" w:name=\"_Ref100\"/><w:r><w:t>Figure 1</w:t></w:r>"
+        "<w:bookmarkEnd w:id=\"3\"/></w:p>"
+        "<w:p><w:bookmarkStart w:id=\"7\" w:name=\"Spec\"/><w:r><w:t>Spec</w:t></w:r></w:p>"
+        "<w:p><w:r><w:t>tail</w:t></w:r><w:bookmarkEnd w:id=\"7\"/></w:p>"
+        "<w:p><w:fldSimple w:instr=\" REF _Ref100 \\h \"><w:r><w:t>Figure 1</w:t></w:r></w:fldSimple>"
+        "<w:r><w:fldChar w:fldCharType=\"begin\"/></w:r><w:r><w:instrText> PAGE</w:instrText></w:r>"
+        "<w:r><w:instrText>REF spec \\h </w:instrText></w:r><w:r><w:fldChar w:fldCharType=\"separate\"/></w:r>"
+        "<w:r><w:t>3</w:t></w:r><w:r><w:fldChar w:fldCharType=\"end\"/></w:r>"
+        "<w:hyperlink w:anchor=\"Missing\"><w:r><w:t>broken</w:t></w:r></w:hyperlink>"
+        "<w:fldSimple w:instr=\"HYPERLINK \\l &quot;_Ref100&quot;\"/>"
+        "<w:fldSimple w:instr=\" PAGE \"/></w:p>"
+        "</w:body>";
+} // namespace
+
+TEST(BookmarkIndexTest, IndexesBookmarksAndReferencesInOnePass)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+
+    duckx::BookmarkIndex index;
+    index.add(doc.document_element());
+    ASSERT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.next_id(), 8);
+
+    const duckx::BookmarkRange* figure = index.find("_ref100");
+    ASSERT_NE(figure, nullptr);
+    EXPECT_EQ(figure->name, "_Ref100");
+    EXPECT_EQ(figure->id, 3);
+    EXPECT_STREQ(figure->end.name(), "w:bookmarkEnd");
+    EXPECT_EQ(index.find_by_id(7)->name, "Spec");
+    EXPECT_EQ(index.find_by_id(7)->end.parent(), doc.document_element().child("w:p").next_sibling().next_sibling());
+
+    const std::vector<duckx::FieldReference>& refs = index.references();
+    ASSERT_EQ(refs.size(), 4u);
+    EXPECT_EQ(refs[0].kind, duckx::FieldKind::REF);
+    EXPECT_EQ(refs[1].kind, duckx::FieldKind::PAGEREF); // instruction split over two w:instrText runs
+    EXPECT_EQ(refs[1].target, "spec");
+    EXPECT_TRUE(refs[1].node.child("w:fldChar"));
+    EXPECT_EQ(refs[2].kind, duckx::FieldKind::HYPERLINK);
+    EXPECT_EQ(refs[3].target, "_Ref100");
+
+    const std::vector<const duckx::FieldReference*> unresolved = index.unresolved_references();
+    ASSERT_EQ(unresolved.size(), 1u);
+    EXPECT_EQ(unresolved[0]->target, "Missing");
+}
+
+TEST(BookmarkIndexTest, StaysCurrentOnInsertAndDelete)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+    pugi::xml_node body = doc.document_element();
+
+    duckx::BookmarkIndex index;
+    index.add(body);
+
+    pugi::xml_node paragraph = body.append_child("w:p");
+    paragraph.append_child("w:pPr");
+    const duckx::BookmarkRange& added = index.add_bookmark(paragraph, "Missing");
+    EXPECT_EQ(added.id, 8);
+    EXPECT_EQ(paragraph.first_child().next_sibling(), added.start);
+    EXPECT_THROW(index.add_bookmark(paragraph, "missing"), std::invalid_argument);
+    EXPECT_TRUE(index.unresolved_references().empty());
+
+    index.add_reference(paragraph, duckx::FieldKind::PAGEREF, "Gone", "1");
+    EXPECT_STREQ(paragraph.child("w:fldSimple").attribute("w:instr").value(), " PAGEREF Gone \\h ");
+    EXPECT_EQ(index.references().size(), 5u);
+    EXPECT_EQ(index.unresolved_references().size(), 1u);
+
+    // Deleting the paragraph holding the start of "Spec" drops the bookmark and its end marker
+    index.remove(body.child("w:p").next_sibling());
+    EXPECT_EQ(index.find("Spec"), nullptr);
+    EXPECT_FALSE(body.find_node([](const pugi::xml_node n) {
+        return std::string(n.name()) == "w:bookmarkEnd" && n.attribute("w:id").as_int() == 7;
+    }));
+
+    // Deleting the field paragraph drops its references
+    index.remove(body.child("w:p").next_sibling().next_sibling());
+    EXPECT_EQ(index.references().size(), 1u);
+
+    EXPECT_TRUE(index.remove_bookmark("MISSING"));
+    EXPECT_FALSE(paragraph.child("w:bookmarkStart"));
+    EXPECT_FALSE(index.remove_bookmark("Missing"));
+}
+
+TEST(BookmarkIndexTest, HeadingBookmarksGetFreshIds)
+{
+    const std::string path = "bookmark_index_test.docx";
+    remove(path.c_str());
+    {
+        auto doc = duckx::Document::create(path);
+        auto heading = doc.body().add_paragraph("Introduction");
+        heading.get_node().append_child("w:pPr").append_child("w:pStyle").append_attribute("w:val").set_value(
+            "Heading 1");
+        auto other = doc.body().add_paragraph("See above");
+
+        duckx::BookmarkIndex index = doc.index_bookmarks();
+        index.add_bookmark(other.get_node(), "Existing");
+        ASSERT_TRUE(doc.outline().create_field_toc_safe().ok());
+
+        index = doc.index_bookmarks();
+        ASSERT_EQ(index.size(), 2u);
+        const duckx::BookmarkRange* toc = index.find("_Toc204895566");
+        ASSERT_NE(toc, nullptr);
+        EXPECT_NE(toc->id, index.find("Existing")->id);
+        EXPECT_STREQ(toc->start.previous_sibling().name(), "w:pPr");
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(path);
+    EXPECT_EQ(doc.index_bookmarks().size(), 2u);
+    remove(path.c_str());
+}
+
+TEST(BookmarkIndexTest, RebuildsAfterEditsMadeElsewhere)
+{
+    auto doc = duckx::Document::create("bookmark_index_stale_test.docx");
+    auto first = doc.body().add_paragraph("First");
+    duckx::BookmarkIndex index = doc.index_bookmarks();
+
+    doc.begin_transaction();
+    index.add_bookmark(first.get_node(), "Rolled");
+    ASSERT_NE(index.find("Rolled"), nullptr);
+    doc.rollback();
+    EXPECT_EQ(index.find("Rolled"), nullptr);
+    EXPECT_TRUE(index.empty());
+
+    // The paragraph is added through Body, so the next lookup re-scans it
+    auto second = doc.body().add_paragraph("Second");
+    pugi::xml_node start = second.get_node().append_child("w:bookmarkStart");
+    start.append_attribute("w:id").set_value(4);
+    start.append_attribute("w:name").set_value("Later");
+    const duckx::BookmarkRange* later = index.find("later");
+    ASSERT_NE(later, nullptr);
+    EXPECT_EQ(later->id, 4);
+    EXPECT_EQ(index.next_id(), 5);
+
+    const duckx::BookmarkRange& added = index.add_bookmark(first.get_node(), "Kept");
+    EXPECT_EQ(added.id, 5);
+    EXPECT_EQ(index.find("Kept"), &added);
+    EXPECT_EQ(index.size(), 2u);
+}
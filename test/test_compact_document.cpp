@@ -0,0 +1,168 @@
+/*!
+ * @file test_compact_document.cpp
+ * @brief Unit tests for the compact read-only document representation
+ *
+ * Covers agreement with the pugixml-based read API on a saved document,
+ * XML decoding rules, malformed input, and the memory footprint.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CompactDocument.hpp"
+#include "Document.hpp"
+#include "ZipArchive.hpp"
+#include "duckxiterator.hpp"
+
+using namespace duckx;
+
+TEST(CompactDocumentTest, MatchesElementReadApi)
+{
+    const std::string path = "compact_document_test.docx";
+    {
+        auto doc = Document::create(path);
+        auto& body = doc.body();
+        auto heading = body.add_paragraph("Title", bold | italic);
+        heading.set_alignment(Alignment::CENTER);
+        heading.set_spacing(6.0, 12.0);
+        auto styled = body.add_paragraph("plain ");
+        styled.add_run("red", underline).set_font("Arial").set_font_size(10.5).set_color("FF0000");
+        body.add_paragraph("a < b & \"c\"");
+
+        auto table = body.add_table(2, 3);
+        int n = 0;
+        for (auto& row: table.rows())
+            for (auto& cell: row.cells())
+                cell.add_paragraph("cell" + std::to_string(n++));
+        doc.save();
+    }
+
+    auto doc = Document::open(path);
+    const auto compact = CompactDocument::open(path);
+
+    std::vector<std::string> expected;
+    for (auto& paragraph: doc.body().paragraphs())
+    {
+        std::string text;
+        for (auto& run: paragraph.runs())
+            text += run.get_text();
+        expected.push_back(text);
+    }
+    std::vector<std::string> actual;
+    for (const auto& paragraph: compact.body().paragraphs())
+        actual.push_back(paragraph.get_text());
+    EXPECT_EQ(actual, expected);
+
+    auto paragraphs = compact.body().paragraphs();
+    auto it = paragraphs.begin();
+    EXPECT_EQ(it->get_alignment(), Alignment::CENTER);
+    EXPECT_TRUE(it->runs().first().is_bold());
+    EXPECT_EQ(it->runs().first().get_formatting(), doc.body().paragraphs().first().runs().first().get_formatting());
+    const ParagraphProperties props = it->properties();
+    EXPECT_TRUE(props.has_spacing);
+    EXPECT_DOUBLE_EQ(props.spacing_before, 6.0);
+    EXPECT_DOUBLE_EQ(props.spacing_after, 12.0);
+
+    ++it;
+    auto runs = it->runs();
+    ASSERT_EQ(runs.size(), 2u);
+    const CompactRun red = *std::next(runs.begin());
+    std::string font, color;
+    double size = 0.0;
+    EXPECT_TRUE(red.is_underline());
+    EXPECT_FALSE(red.is_bold());
+    EXPECT_TRUE(red.get_font(font));
+    EXPECT_EQ(font, "Arial");
+    EXPECT_TRUE(red.get_font_size(size));
+    EXPECT_DOUBLE_EQ(size, 10.5);
+    EXPECT_TRUE(red.get_color(color));
+    EXPECT_EQ(color, "FF0000");
+    EXPECT_FALSE(runs.first().get_font(font));
+
+    std::string cells;
+    for (const auto& table: compact.body().tables())
+        for (const auto& row: table.rows())
+            for (const auto& cell: row.cells() | views::skip(1))
+            {
+                for (const auto& paragraph: cell.paragraphs())
+                    cells += paragraph.get_text();
+                cells += ",";
+            }
+    EXPECT_EQ(cells, "cell1,cell2,cell4,cell5,");
+
+    std::remove(path.c_str());
+}
+
+TEST(CompactDocumentTest, DecodesXmlLikePugixml)
+{
+    const auto doc = CompactDocument::parse(
+        "<?xml version=\"1.0\"?>\r\n<!DOCTYPE x [<!ENTITY e \"v\">]>"
+        "<w:document xmlns:w=\"urn:w\"><!-- note --><w:body>\r\n  "
+        "<w:p><w:r><w:t xml:space=\"preserve\">a&amp;b &#x4E2D;&#25991; &unknown;</w:t></w:r></w:p>"
+        "<w:p><w:r><w:t>line1\r\nline2</w:t><w:t><![CDATA[<raw> ]]></w:t></w:r></w:p>"
+        "<x:custom a='1\tb' b=\"&quot;\"/>\r\n</w:body></w:document>");
+
+    ASSERT_TRUE(doc.root());
+    EXPECT_STREQ(doc.root().name(), "w:document");
+    EXPECT_STREQ(doc.root().attribute("xmlns:w"), "urn:w");
+
+    auto paragraphs = doc.body().paragraphs();
+    ASSERT_EQ(paragraphs.size(), 2u);
+    EXPECT_EQ(paragraphs.first().get_text(), "a&b \xE4\xB8\xAD\xE6\x96\x87 &unknown;");
+    const CompactNode second_run = std::next(paragraphs.begin())->runs().first().get_node();
+    EXPECT_STREQ(second_run.child(atoms::W_T).text(), "line1\nline2");
+    EXPECT_STREQ(second_run.child(atoms::W_T).next_sibling(atoms::W_T).text(), "<raw> ");
+
+    const Atom custom = doc.find_atom("x:custom");
+    ASSERT_NE(custom, atoms::NONE);
+    const CompactNode node = doc.body().get_body_node().child(custom);
+    ASSERT_TRUE(node);
+    EXPECT_STREQ(node.attribute("a"), "1 b");
+    EXPECT_STREQ(node.attribute("b"), "\"");
+    EXPECT_EQ(node.attribute("c"), nullptr);
+    EXPECT_STREQ(node.text(), "");
+    EXPECT_EQ(node.parent(), doc.body().get_body_node());
+    EXPECT_FALSE(node.next_sibling());
+
+    EXPECT_THROW(CompactDocument::parse("<a><b></a>"), std::runtime_error);
+    EXPECT_THROW(CompactDocument::parse("<a x=1/>"), std::runtime_error);
+    EXPECT_THROW(CompactDocument::parse("<a>"), std::runtime_error);
+    EXPECT_THROW(CompactDocument::parse("  "), std::runtime_error);
+    EXPECT_THROW(CompactDocument::open("missing_compact_document.docx"), std::runtime_error);
+}
+
+TEST(CompactDocumentTest, StaysSmallerThanTheXml)
+{
+    const std::string path = "compact_document_test.docx";
+    {
+        auto doc = Document::create(path);
+        auto& body = doc.body();
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto paragraph = body.add_paragraph("Paragraph " + std::to_string(i), bold);
+            paragraph.add_run(" more", italic | underline).set_font("Calibri").set_font_size(11);
+            paragraph.set_spacing(0.0, 8.0);
+        }
+        doc.save();
+    }
+
+    ZipReader zip;
+    ASSERT_TRUE(zip.open(path));
+    std::string xml;
+    ASSERT_TRUE(zip.read(*zip.find("word/document.xml"), xml));
+    zip.close();
+
+    const auto compact = CompactDocument::parse(xml);
+    EXPECT_EQ(compact.body().paragraphs().size(), 2000u);
+    // pugixml keeps the whole text plus ~56 bytes per node and ~40 per attribute
+    const std::size_t pugi_estimate = xml.size() + compact.node_count() * 56 + compact.attribute_count() * 40;
+    EXPECT_LT(compact.memory_usage() * 3, pugi_estimate);
+    EXPECT_LT(compact.memory_usage(), xml.size());
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,206 @@
+/*!
+ * @file test_content_controls.cpp
+ * @brief Unit tests for content control indexing and form filling
+ *
+ * Covers inline, block and table-cell controls, lookup by tag and alias,
+ * formatting preservation and customXml data binding updates.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "ContentControls.hpp"
+#include "Document.hpp"
+#include "DocxFile.hpp"
+
+namespace
+{
+    const char* const kBody =
+        "<w:body xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:p><w:r><w:t>Dear </w:t></w:r>"
+        "<w:sdt><w:sdtPr><w:alias w:val=\"Customer\"/><w:tag w:val=\"customer_name\"/><w:showingPlcHdr/></w:sdtPr>"
+        "<w:sdtContent><w:r><w:rPr><w:rStyle w:val=\"PlaceholderText\"/><w:b/></w:rPr><w:t>Click here</w:t></w:r>"
+        "<w:r><w:t> to enter</w:t></w:r></w:sdtContent></w:sdt></w:p>"
+        "<w:sdt><w:sdtPr><w:tag w:val=\"terms\"/></w:sdtPr><w:sdtContent>"
+        "<w:p><w:pPr><w:jc w:val=\"both\"/></w:pPr><w:r><w:rPr><w:i/></w:rPr><w:t>Line one</w:t></w:r></w:p>"
+        "<w:p><w:r><w:t>Line two</w:t></w:r></w:p></w:sdtContent></w:sdt>"
+        "<w:tbl><w:tr><w:sdt><w:sdtPr><w:tag w:val=\"customer_name\"/></w:sdtPr><w:sdtContent>"
+        "<w:tc><w:p/></w:tc></w:sdtContent></w:sdt></w:tr></w:tbl>"
+        "</w:body>";
+
+    std::string text_of(const pugi::xml_node node)
+    {
+        std::string text;
+        for (const pugi::xpath_node t: node.select_nodes(".//w:t"))
+            text += t.node().text().get();
+        return text;
+    }
+} // namespace
+
+TEST(ContentControlsTest, IndexesByTagAndAliasInOnePass)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+
+    duckx::ContentControlIndex index;
+    index.add(doc.document_element());
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.find("customer_name").size(), 2u); // paragraph and table cell
+    EXPECT_EQ(index.find("Customer").size(), 1u);
+    EXPECT_EQ(index.find("terms").size(), 1u);
+    EXPECT_TRUE(index.find("missing").empty());
+}
+
+TEST(ContentControlsTest, FillingKeepsFormattingAndDropsPlaceholder)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+    duckx::ContentControlIndex index;
+    index.add(doc.document_element());
+
+    const pugi::xml_node inline_sdt = index.find("Customer").front();
+    duckx::set_content_control_text(inline_sdt, "ACME Corp");
+    EXPECT_FALSE(inline_sdt.child("w:sdtPr").child("w:showingPlcHdr"));
+    const pugi::xml_node content = inline_sdt.child("w:sdtContent");
+    ASSERT_EQ(std::distance(content.children("w:r").begin(), content.children("w:r").end()), 1);
+    EXPECT_TRUE(content.child("w:r").child("w:rPr").child("w:b"));
+    EXPECT_FALSE(content.child("w:r").child("w:rPr").child("w:rStyle"));
+    EXPECT_EQ(text_of(content), "ACME Corp");
+
+    const pugi::xml_node block_sdt = index.find("terms").front();
+    duckx::set_content_control_text(block_sdt, "Net 30\nNo refunds");
+    const pugi::xml_node block = block_sdt.child("w:sdtContent");
+    ASSERT_EQ(std::distance(block.children("w:p").begin(), block.children("w:p").end()), 1);
+    EXPECT_TRUE(block.child("w:p").child("w:pPr").child("w:jc"));
+    EXPECT_TRUE(block.child("w:p").child("w:r").child("w:rPr").child("w:i"));
+    EXPECT_TRUE(block.child("w:p").child("w:r").child("w:br"));
+    EXPECT_EQ(text_of(block), "Net 30No refunds");
+
+    const pugi::xml_node cell_sdt = index.find("customer_name").back();
+    duckx::set_content_control_text(cell_sdt, "ACME Corp");
+    EXPECT_EQ(text_of(cell_sdt.child("w:sdtContent").child("w:tc")), "ACME Corp");
+}
+
+TEST(ContentControlsTest, CustomXmlValuesFollowWordXPaths)
+{
+    pugi::xml_document data;
+    ASSERT_TRUE(data.load_string(
+        "<ns0:contract xmlns:ns0=\"urn:contract\"><ns0:party/><ns0:party/><ns0:amount currency=\"\"/></ns0:contract>"));
+
+    EXPECT_TRUE(duckx::set_custom_xml_value(data, "/ns0:contract[1]/ns0:party[2]", "Bob"));
+    EXPECT_TRUE(duckx::set_custom_xml_value(data, "/ns0:contract[1]/ns0:amount[1]/@currency", "EUR"));
+    EXPECT_FALSE(duckx::set_custom_xml_value(data, "/ns0:contract[1]/ns0:party[3]", "Eve"));
+    EXPECT_FALSE(duckx::set_custom_xml_value(data, "relative/path", "x"));
+
+    const pugi::xml_node root = data.document_element();
+    EXPECT_STREQ(root.first_child().text().get(), "");
+    EXPECT_STREQ(root.first_child().next_sibling().text().get(), "Bob");
+    EXPECT_STREQ(root.child("ns0:amount").attribute("currency").value(), "EUR");
+}
+
+TEST(ContentControlsTest, DocumentBindsBodyHeadersAndCustomXml)
+{
+    const std::string path = "content_controls_test.docx";
+    remove(path.c_str());
+
+    {
+        auto doc = duckx::Document::create(path);
+        auto header_paragraph = doc.get_header().add_paragraph();
+        pugi::xml_node sdt = header_paragraph.get_node().append_child("w:sdt");
+        sdt.append_child("w:sdtPr").append_child("w:tag").append_attribute("w:val").set_value("customer_name");
+        sdt.append_child("w:sdtContent");
+        doc.save();
+    }
+    {
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(path));
+        std::string document = file.read_entry("word/document.xml");
+        document.insert(document.find("<w:sectPr"),
+            "<w:p><w:sdt><w:sdtPr><w:tag w:val=\"customer_name\"/>"
+            "<w:dataBinding w:xpath=\"/ns0:root[1]/ns0:name[1]\" w:storeItemID=\"{1111-AAAA}\"/></w:sdtPr>"
+            "<w:sdtContent><w:r><w:t>[name]</w:t></w:r></w:sdtContent></w:sdt></w:p>");
+        file.write_entry("word/document.xml", document);
+        file.write_entry("customXml/item1.xml", "<ns0:root xmlns:ns0=\"urn:test\"><ns0:name/></ns0:root>");
+        file.write_entry("customXml/itemProps1.xml",
+            "<ds:datastoreItem ds:itemID=\"{1111-aaaa}\" "
+            "xmlns:ds=\"http://schemas.openxmlformats.org/officeDocument/2006/customXml\"/>");
+        file.save();
+    }
+
+    {
+        auto doc = duckx::Document::open(path);
+        EXPECT_EQ(doc.bind_content_controls({{"customer_name", "ACME Corp"}, {"unknown", "ignored"}}), 2u);
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_NE(file.read_entry("word/document.xml").find("ACME Corp"), std::string::npos);
+    EXPECT_EQ(file.read_entry("word/document.xml").find("[name]"), std::string::npos);
+    EXPECT_NE(file.read_entry("word/header1.xml").find("ACME Corp"), std::string::npos);
+
+    pugi::xml_document data;
+    ASSERT_TRUE(data.load_string(file.read_entry("customXml/item1.xml").c_str()));
+    EXPECT_STREQ(data.document_element().child("ns0:name").text().get(), "ACME Corp");
+    file.close();
+    remove(path.c_str());
+}
+
+TEST(ContentControlsTest, BindingParentAndNestedChildSkipsRemovedControls)
+{
+    const std::string path = "content_controls_nested.docx";
+    remove(path.c_str());
+    {
+        auto doc = duckx::Document::create(path);
+        doc.save();
+    }
+    {
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(path));
+        std::string document = file.read_entry("word/document.xml");
+        // 外层块级控件的第二段中嵌套一个行内控件，填充外层时会被删除
+        document.insert(document.find("</w:body>"),
+            "<w:sdt><w:sdtPr><w:tag w:val=\"a_outer\"/></w:sdtPr><w:sdtContent>"
+            "<w:p><w:r><w:t>Intro</w:t></w:r></w:p>"
+            "<w:p><w:sdt><w:sdtPr><w:tag w:val=\"z_inner\"/></w:sdtPr>"
+            "<w:sdtContent><w:r><w:t>[inner]</w:t></w:r></w:sdtContent></w:sdt></w:p>"
+            "</w:sdtContent></w:sdt>"
+            "<w:sdt><w:sdtPr><w:tag w:val=\"z_outer\"/></w:sdtPr><w:sdtContent>"
+            "<w:p><w:r><w:t>Intro</w:t></w:r></w:p>"
+            "<w:p><w:sdt><w:sdtPr><w:tag w:val=\"a_inner\"/></w:sdtPr>"
+            "<w:sdtContent><w:r><w:t>[inner]</w:t></w:r></w:sdtContent></w:sdt></w:p>"
+            "</w:sdtContent></w:sdt>");
+        file.write_entry("word/document.xml", document);
+        file.save();
+    }
+
+    {
+        auto doc = duckx::Document::open(path);
+        auto index = doc.index_content_controls();
+        EXPECT_EQ(index.size(), 4u);
+
+        // a_outer 先于其子控件填充，z_outer 晚于其子控件填充
+        EXPECT_EQ(doc.bind_content_controls(index, {{"a_outer", "First"}, {"z_inner", "ignored"},
+                                                    {"a_inner", "Child"}, {"z_outer", "Second"}}),
+                  3u);
+        EXPECT_EQ(index.size(), 2u);
+        EXPECT_TRUE(index.find("z_inner").empty());
+        EXPECT_TRUE(index.find("a_inner").empty());
+
+        // 复用索引不再访问已删除的控件
+        EXPECT_EQ(doc.bind_content_controls(index, {{"z_inner", "again"}, {"a_outer", "Third"}}), 1u);
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    const std::string document = file.read_entry("word/document.xml");
+    EXPECT_NE(document.find("Third"), std::string::npos);
+    EXPECT_NE(document.find("Second"), std::string::npos);
+    EXPECT_EQ(document.find("[inner]"), std::string::npos);
+    file.close();
+    remove(path.c_str());
+}
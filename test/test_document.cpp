@@ -15,8 +15,14 @@
 #include "Document.hpp"
 #include "Body.hpp"
 #include "BaseElement.hpp"
+#include "ZipArchive.hpp"
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Mock classes for dependencies that are not the focus of this test
 // We assume these are tested elsewhere and provide minimal implementations or mocks.
@@ -259,4 +265,325 @@ TEST_F(DocumentTest, AddContentAndSaveAndReopen) {
         // Here we'd need Table API to check rows/cols, which is beyond Document's scope
         // Just checking for existence is sufficient for this test.
     }
-}
\ No newline at end of file
+}
+
+// Test asynchronous save
+TEST_F(DocumentTest, SaveAsync_WritesSnapshotTakenAtCallTime) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Saved asynchronously");
+
+        auto pending = doc.save_async();
+
+        // Edits after save_async() returns must not leak into the pending write
+        doc.body().add_paragraph("Added after snapshot");
+
+        const duckx::Result<void>& result = pending.get();
+        ASSERT_TRUE(result.ok()) << result.error().to_string();
+    }
+
+    auto reopened_doc = duckx::Document::open(test_docx_path);
+    auto paragraphs = reopened_doc.body().paragraphs();
+    ASSERT_EQ(std::distance(paragraphs.begin(), paragraphs.end()), 1);
+    EXPECT_EQ(paragraphs.begin()->runs().begin()->get_text(), "Saved asynchronously");
+}
+
+TEST_F(DocumentTest, SaveAsync_ConsecutiveSavesApplyInOrderAndNotify) {
+    std::vector<int> completed;
+    std::mutex completed_mutex;
+    const auto record = [&](const int id) {
+        duckx::SaveOptions options;
+        options.on_complete = [&, id](const duckx::Result<void>& result) {
+            std::lock_guard<std::mutex> lock(completed_mutex);
+            EXPECT_TRUE(result.ok());
+            completed.push_back(id);
+        };
+        return options;
+    };
+
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("First");
+        doc.save_async(record(1));
+        doc.body().add_paragraph("Second");
+        doc.save_async(record(2));
+        doc.body().add_paragraph("Third");
+        doc.save_async(record(3)).wait();
+    }
+
+    EXPECT_EQ(completed, (std::vector<int>{1, 2, 3}));
+
+    auto reopened_doc = duckx::Document::open(test_docx_path);
+    auto paragraphs = reopened_doc.body().paragraphs();
+    EXPECT_EQ(std::distance(paragraphs.begin(), paragraphs.end()), 3);
+}
+
+// Test dirty tracking
+TEST_F(DocumentTest, Save_UnchangedDocumentIsNotRewritten) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Dirty tracking");
+        doc.save();
+    }
+
+    const auto read_bytes = [this]() {
+        std::ifstream in(test_docx_path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+    const std::string before = read_bytes();
+
+    const auto doc = duckx::Document::open(test_docx_path);
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::RELATIONSHIPS));
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::CONTENT_TYPES));
+    doc.save();
+
+    EXPECT_EQ(read_bytes(), before);
+}
+
+TEST_F(DocumentTest, Save_OnlyModifiedPartsAreReserialized) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Original");
+        doc.save();
+    }
+
+    duckx::ZipEntryInfo rels_before;
+    duckx::ZipEntryInfo document_before;
+    {
+        duckx::ZipReader reader;
+        ASSERT_TRUE(reader.open(test_docx_path));
+        rels_before = *reader.find("word/_rels/document.xml.rels");
+        document_before = *reader.find("word/document.xml");
+    }
+
+    {
+        auto doc = duckx::Document::open(test_docx_path);
+        doc.body().add_paragraph("Appended");
+        EXPECT_TRUE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+        EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::RELATIONSHIPS));
+        doc.save();
+    }
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(test_docx_path));
+    const duckx::ZipEntryInfo* rels_after = reader.find("word/_rels/document.xml.rels");
+    const duckx::ZipEntryInfo* document_after = reader.find("word/document.xml");
+    ASSERT_NE(rels_after, nullptr);
+    ASSERT_NE(document_after, nullptr);
+    EXPECT_EQ(rels_after->crc32, rels_before.crc32);
+    EXPECT_EQ(rels_after->compressed_size, rels_before.compressed_size);
+    EXPECT_NE(document_after->crc32, document_before.crc32);
+}
+
+TEST_F(DocumentTest, Save_ReadingPartsLeavesThemClean) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Read only");
+        ASSERT_TRUE(doc.page_layout().set_margins_safe(duckx::PageMargins(25.0)).ok());
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(test_docx_path);
+    for (auto& paragraph : doc.body().paragraphs())
+        EXPECT_EQ(paragraph.get_alignment(), duckx::Alignment::LEFT);
+    doc.styles();
+    ASSERT_TRUE(doc.page_layout().get_margins_safe().ok());
+    EXPECT_EQ(doc.index_bookmarks().size(), 0u);
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::STYLES));
+
+    // Edits through managers and elements flag the part, and saving clears it again
+    ASSERT_TRUE(doc.page_layout().set_margins_safe(duckx::PageMargins(20.0)).ok());
+    EXPECT_TRUE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+    doc.save();
+    EXPECT_FALSE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+    doc.body().paragraphs().first().set_alignment(duckx::Alignment::CENTER);
+    EXPECT_TRUE(doc.is_dirty(duckx::DocumentPart::MAIN_DOCUMENT));
+}
+
+// Test deterministic output
+TEST_F(DocumentTest, SaveDeterministic_IdenticalContentProducesIdenticalBytes) {
+    const auto build = [](const std::string& path) {
+        auto doc = duckx::Document::create(path);
+        doc.set_deterministic(true);
+        doc.body().add_paragraph("Reproducible");
+        doc.body().add_paragraph("Output");
+        doc.save();
+        return doc.content_hash();
+    };
+    const auto read_bytes = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+
+    const std::string first_hash = build(test_docx_path);
+    const std::string second_hash = build(another_test_docx_path);
+
+    EXPECT_EQ(first_hash.size(), 64u);
+    EXPECT_EQ(first_hash, second_hash);
+    EXPECT_EQ(read_bytes(test_docx_path), read_bytes(another_test_docx_path));
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(test_docx_path));
+    EXPECT_EQ(reader.entries().front().name, "[Content_Types].xml");
+    for (const auto& entry : reader.entries()) {
+        EXPECT_EQ(entry.dos_date, (0 << 9) | (1 << 5) | 1) << entry.name; // 1980-01-01
+        EXPECT_EQ(entry.dos_time, 0) << entry.name;
+    }
+    std::string core;
+    ASSERT_TRUE(reader.read(*reader.find("docProps/core.xml"), core));
+    EXPECT_NE(core.find("1980-01-01T00:00:00Z</dcterms:created>"), std::string::npos);
+}
+
+TEST_F(DocumentTest, SaveIncremental_AppendsEditsUntilCompaction) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Draft");
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(test_docx_path);
+    doc.set_incremental_save(true, 0.9);
+    doc.body().add_paragraph("Autosave 1");
+    doc.save();
+    doc.body().add_paragraph("Autosave 2");
+    ASSERT_TRUE(doc.save_async().get().ok());
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(test_docx_path));
+    EXPECT_GT(reader.unreferenced_bytes(), 0u);
+    reader.close();
+
+    // Dropping the threshold makes the next save rewrite the archive
+    doc.set_incremental_save(true, 0.0);
+    doc.body().add_paragraph("Final");
+    doc.save();
+    ASSERT_TRUE(reader.open(test_docx_path));
+    EXPECT_EQ(reader.unreferenced_bytes(), 0u);
+    reader.close();
+
+    auto reopened = duckx::Document::open(test_docx_path);
+    EXPECT_EQ(reopened.body().paragraphs().size(), 4u);
+}
+
+TEST_F(DocumentTest, ContentHash_TracksContentChanges) {
+    auto doc = duckx::Document::create(test_docx_path);
+    doc.body().add_paragraph("Hash me");
+
+    const std::string before = doc.content_hash();
+    EXPECT_EQ(doc.content_hash(), before);
+
+    doc.body().add_paragraph("Changed");
+    EXPECT_NE(doc.content_hash(), before);
+
+    // Saving does not change the content, so the hash stays stable across it
+    const std::string after_edit = doc.content_hash();
+    doc.save();
+    EXPECT_EQ(doc.content_hash(), after_edit);
+
+    // Parts read back from the archive hash to the same digests as when they were pending
+    EXPECT_EQ(duckx::Document::open(test_docx_path).content_hash(), after_edit);
+}
+
+// Test open options and lazily created managers
+TEST_F(DocumentTest, OpenReadOnly_RejectsSaving) {
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.body().add_paragraph("Read only");
+        doc.save();
+    }
+
+    duckx::OpenOptions options;
+    options.read_only = true;
+    auto result = duckx::Document::open_safe(test_docx_path, options);
+    ASSERT_TRUE(result.ok());
+    auto& doc = result.value();
+    EXPECT_TRUE(doc.is_read_only());
+
+    const duckx::Body& body = doc.body();
+    EXPECT_EQ(body.paragraphs().begin()->runs().begin()->get_text(), "Read only");
+
+    EXPECT_THROW(doc.save(), std::runtime_error);
+    EXPECT_FALSE(doc.save_safe().ok());
+    EXPECT_FALSE(doc.save_async().get().ok());
+
+    // 提前失败的回调同样在执行器上运行，而非调用线程
+    std::thread::id callback_thread;
+    duckx::SaveOptions save_options;
+    save_options.on_complete = [&callback_thread](const duckx::Result<void>& saved) {
+        EXPECT_FALSE(saved.ok());
+        callback_thread = std::this_thread::get_id();
+    };
+    EXPECT_FALSE(doc.save_async(save_options).get().ok());
+    EXPECT_NE(callback_thread, std::thread::id());
+    EXPECT_NE(callback_thread, std::this_thread::get_id());
+}
+
+TEST_F(DocumentTest, LazyManagers_ContinueRelationshipIdsAfterOpen) {
+    std::string header_rid;
+    {
+        auto doc = duckx::Document::create(test_docx_path);
+        doc.get_header().add_paragraph("Header");
+        header_rid = doc.links().add_relationship("https://example.com/first");
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(test_docx_path);
+    const std::string next_rid = doc.links().add_relationship("https://example.com/second");
+    EXPECT_NE(next_rid, header_rid);
+    doc.save();
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_docx_path));
+    const std::string rels = file.read_entry("word/_rels/document.xml.rels");
+    EXPECT_NE(rels.find("https://example.com/first"), std::string::npos);
+    EXPECT_NE(rels.find("https://example.com/second"), std::string::npos);
+    EXPECT_EQ(rels.find("Id=\"" + next_rid + "\""), rels.rfind("Id=\"" + next_rid + "\""));
+}
+
+TEST_F(DocumentTest, Move_KeepsManagersAndTransactionOfTheMovedState) {
+    auto doc = duckx::Document::create(test_docx_path);
+    doc.body().add_paragraph("Kept");
+    duckx::PageLayoutManager* layout = &doc.page_layout();
+    duckx::HyperlinkManager* links = &doc.links();
+    const std::string first_rid = links->add_relationship("https://example.com/first");
+    doc.begin_transaction();
+    doc.body().add_paragraph("Undone");
+
+    duckx::Document moved(std::move(doc));
+    EXPECT_EQ(&moved.page_layout(), layout);
+    EXPECT_EQ(&moved.links(), links);
+
+    // Managers created before the move still report to the moved document
+    const std::string second_rid = links->add_relationship("https://example.com/second");
+    EXPECT_NE(second_rid, first_rid);
+    EXPECT_TRUE(moved.is_dirty(duckx::DocumentPart::RELATIONSHIPS));
+
+    moved.rollback();
+    EXPECT_EQ(moved.body().paragraphs().size(), 1u);
+
+    auto assigned = duckx::Document::create(another_test_docx_path);
+    assigned = std::move(moved);
+    EXPECT_EQ(&assigned.links(), links);
+    EXPECT_NO_THROW(assigned.save());
+}
+
+TEST_F(DocumentTest, MovedFrom_CanBeReassignedAndDestroyed) {
+    auto source = duckx::Document::create(test_docx_path);
+    source.body().add_paragraph("Moved");
+    duckx::Document target(std::move(source));
+
+    // A moved-from document holds no state; assigning a new one makes it usable again
+    source = duckx::Document::create(another_test_docx_path);
+    source.body().add_paragraph("Reassigned");
+    EXPECT_NO_THROW(source.save());
+    EXPECT_EQ(source.body().paragraphs().size(), 1u);
+
+    // Moving back and forth leaves each state with exactly one owner
+    duckx::Document swapped(std::move(target));
+    target = std::move(source);
+    source = std::move(swapped);
+    EXPECT_EQ(target.body().paragraphs().first().runs().first().get_text(), "Reassigned");
+    EXPECT_EQ(source.body().paragraphs().first().runs().first().get_text(), "Moved");
+}
@@ -0,0 +1,158 @@
+/*!
+ * @file test_document_fork.cpp
+ * @brief Unit tests for Document::fork
+ *
+ * Covers variants saved from a shared archive, unsaved edits carried into
+ * a fork, independence of parent and fork after forking, forks of forks,
+ * background saves of a fork whose file does not exist yet, and lazy reads
+ * of a fork after its parent saved over the shared file.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Document.hpp"
+
+namespace
+{
+    std::string texts(const duckx::Document& doc)
+    {
+        std::string text;
+        for (const pugi::xpath_node t: doc.body().get_body_node().select_nodes(".//w:t"))
+            text += t.node().text().get();
+        return text;
+    }
+
+    std::vector<std::string> entries(const std::string& path)
+    {
+        duckx::DocxFile file;
+        EXPECT_TRUE(file.open(path));
+        return file.entry_names();
+    }
+} // namespace
+
+TEST(DocumentForkTest, VariantsShareUntouchedParts)
+{
+    const std::string base_path = "fork_base.docx";
+    remove(base_path.c_str());
+    {
+        auto base = duckx::Document::create(base_path);
+        base.body().add_paragraph("Base");
+        base.get_footer().add_paragraph("Footer");
+        base.save();
+    }
+
+    auto base = duckx::Document::open(base_path, duckx::OpenOptions{true});
+    std::vector<std::string> paths;
+    for (int i = 0; i < 20; ++i)
+    {
+        paths.push_back("fork_variant_" + std::to_string(i) + ".docx");
+        remove(paths.back().c_str());
+        auto variant = base.fork(paths.back());
+        EXPECT_FALSE(variant.is_read_only());
+        if (i % 2 == 0)
+            variant.body().add_paragraph("Variant " + std::to_string(i));
+        variant.save();
+    }
+    EXPECT_EQ(texts(base), "Base");
+
+    for (int i = 0; i < 20; ++i)
+    {
+        auto variant = duckx::Document::open(paths[i]);
+        EXPECT_EQ(texts(variant), i % 2 == 0 ? "BaseVariant " + std::to_string(i) : "Base");
+        EXPECT_EQ(entries(paths[i]), entries(base_path));
+        remove(paths[i].c_str());
+    }
+    remove(base_path.c_str());
+}
+
+TEST(DocumentForkTest, ForksAreIndependentOfTheirParent)
+{
+    const std::string base_path = "fork_parent.docx";
+    const std::string fork_path = "fork_child.docx";
+    const std::string grandchild_path = "fork_grandchild.docx";
+    remove(base_path.c_str());
+    remove(fork_path.c_str());
+    remove(grandchild_path.c_str());
+
+    auto parent = duckx::Document::create(base_path);
+    parent.body().add_paragraph("Unsaved");
+    ASSERT_TRUE(parent.fork_safe("").error().code() == duckx::ErrorCode::INVALID_ARGUMENT);
+
+    auto result = parent.fork_safe(fork_path);
+    ASSERT_TRUE(result.ok());
+    duckx::Document child = std::move(result.value());
+    parent.body().add_paragraph(" parent");
+    child.body().add_paragraph(" child");
+    duckx::Document grandchild = child.fork(grandchild_path);
+    grandchild.body().add_paragraph(" grandchild");
+
+    // The parent rewrites the archive the forks still read from
+    parent.save();
+
+    // First save of a fork runs in the background before its file exists
+    ASSERT_TRUE(child.save_async().get().ok());
+    child.body().add_paragraph(" again");
+    ASSERT_TRUE(child.save_async().get().ok());
+    grandchild.save();
+
+    EXPECT_EQ(texts(duckx::Document::open(base_path)), "Unsaved parent");
+    EXPECT_EQ(texts(duckx::Document::open(fork_path)), "Unsaved child again");
+    EXPECT_EQ(texts(duckx::Document::open(grandchild_path)), "Unsaved child grandchild");
+    EXPECT_EQ(entries(fork_path), entries(base_path));
+
+    remove(base_path.c_str());
+    remove(fork_path.c_str());
+    remove(grandchild_path.c_str());
+}
+
+TEST(DocumentForkTest, ForkReadsOriginalPartsAfterParentSavesOverTheFile)
+{
+    const std::string base_path = "fork_pinned_base.docx";
+    const std::string fork_path = "fork_pinned_child.docx";
+    remove(base_path.c_str());
+    remove(fork_path.c_str());
+    {
+        auto base = duckx::Document::create(base_path);
+        base.body().add_paragraph("Base");
+        base.get_footer().add_paragraph("Original footer");
+        base.save();
+    }
+
+    auto parent = duckx::Document::open(base_path);
+    duckx::Document child = parent.fork(fork_path);
+
+    // The parent replaces the file while the fork has not loaded its footer yet
+    parent.get_footer().add_paragraph("Parent footer");
+    parent.body().add_paragraph(" parent");
+    parent.save();
+
+    // The footer is read lazily from the archive the fork was created from
+    const std::string footer = child.footer_template(duckx::HeaderFooterType::DEFAULT)->xml();
+    EXPECT_NE(footer.find("Original footer"), std::string::npos);
+    EXPECT_EQ(footer.find("Parent footer"), std::string::npos);
+    child.save();
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(fork_path));
+    bool found = false;
+    for (const std::string& name: file.entry_names())
+    {
+        if (name.find("footer") == std::string::npos)
+            continue;
+        const std::string saved = file.read_entry(name);
+        EXPECT_EQ(saved.find("Parent footer"), std::string::npos);
+        found = found || saved.find("Original footer") != std::string::npos;
+    }
+    EXPECT_TRUE(found);
+    file.close();
+    EXPECT_EQ(texts(child), "Base");
+    EXPECT_EQ(texts(duckx::Document::open(base_path)), "Base parent");
+
+    remove(base_path.c_str());
+    remove(fork_path.c_str());
+}
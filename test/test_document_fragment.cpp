@@ -0,0 +1,170 @@
+/*!
+ * @file test_document_fragment.cpp
+ * @brief Unit tests for fragments built apart and spliced into a document
+ *
+ * Covers concurrent construction, splice order, reconciliation of
+ * image and hyperlink relationships, non-colliding drawing and bookmark
+ * ids (also when one fragment is spliced twice), a save/reopen round trip,
+ * and rollback of a splice.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Document.hpp"
+#include "DocumentFragment.hpp"
+#include "Image.hpp"
+#include "TextBox.hpp"
+
+namespace
+{
+    const char* const kImagePath = "document_fragment_test.png";
+
+    void write_png(const char* path)
+    {
+        const unsigned char png[] = {
+            0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+            0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x02, 0x00, 0x00, 0x00, 0x90, 0x77, 0x53,
+            0xDE, 0x00, 0x00, 0x00, 0x0C, 0x49, 0x44, 0x41, 0x54, 0x08, 0x99, 0x01, 0x01, 0x00, 0x00, 0x00,
+            0xFF, 0xFF, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
+            0xAE, 0x42, 0x60, 0x82};
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(png), sizeof(png));
+    }
+
+    void build_chapter(duckx::DocumentFragment& fragment, const int chapter)
+    {
+        auto& body = fragment.body();
+        auto heading = body.add_paragraph("Chapter " + std::to_string(chapter), duckx::bold);
+        fragment.add_bookmark(heading, "chapter" + std::to_string(chapter));
+        body.add_paragraph("Intro").add_hyperlink(fragment, "site", "https://example.com/" + std::to_string(chapter));
+        auto figure = body.add_paragraph();
+        fragment.add_image(figure, duckx::Image(kImagePath));
+        fragment.add_textbox(figure, duckx::TextBox());
+        body.add_table(2, 2);
+    }
+} // namespace
+
+TEST(DocumentFragmentTest, SplicesConcurrentlyBuiltFragmentsInOrder)
+{
+    write_png(kImagePath);
+    const std::string path = "document_fragment_test.docx";
+    {
+        auto doc = duckx::Document::create(path);
+        doc.body().add_paragraph("Title");
+        doc.links().add_relationship("https://example.com/existing");
+
+        std::vector<duckx::DocumentFragment> chapters(4);
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 4; ++i)
+            workers.emplace_back([&chapters, i]() { build_chapter(chapters[i], i); });
+        for (auto& worker: workers)
+            worker.join();
+
+        std::set<std::uint32_t> ranges;
+        for (const auto& chapter: chapters)
+        {
+            EXPECT_EQ(chapter.relationships().size(), 2u);
+            ranges.insert(chapter.first_id());
+            doc.splice(chapter);
+        }
+        EXPECT_EQ(ranges.size(), 4u);
+        doc.body().add_paragraph("End");
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(path);
+    std::string order;
+    for (auto& paragraph: doc.body().paragraphs())
+    {
+        auto runs = paragraph.runs();
+        if (!runs.empty() && runs.first().get_text().find("Chapter") == 0)
+            order += runs.first().get_text().back();
+    }
+    EXPECT_EQ(order, "0123");
+
+    // Every placeholder was replaced by a relationship of the document
+    const pugi::xml_node body = doc.body().get_body_node();
+    std::set<std::string> referenced;
+    std::set<std::string> docpr_ids;
+    for (const auto& found: body.select_nodes(".//w:hyperlink/@r:id | .//a:blip/@r:embed"))
+        referenced.insert(found.attribute().value());
+    for (const auto& found: body.select_nodes(".//wp:docPr/@id"))
+        docpr_ids.insert(found.attribute().value());
+    EXPECT_EQ(referenced.size(), 8u);
+    EXPECT_EQ(docpr_ids.size(), 8u);
+    for (const std::string& id: referenced)
+    {
+        EXPECT_EQ(id.find("rIdF"), std::string::npos);
+        EXPECT_NE(id.find("rId"), std::string::npos);
+    }
+
+    const auto bookmarks = doc.index_bookmarks();
+    EXPECT_EQ(bookmarks.size(), 4u);
+    ASSERT_NE(bookmarks.find("chapter2"), nullptr);
+
+    std::remove(path.c_str());
+    std::remove(kImagePath);
+}
+
+TEST(DocumentFragmentTest, SpliceIsUndoneByRollback)
+{
+    auto doc = duckx::Document::create("document_fragment_test.docx");
+    doc.body().add_paragraph("Kept");
+
+    duckx::DocumentFragment fragment;
+    fragment.body().add_paragraph("Spliced").add_hyperlink(fragment, "link", "https://example.com");
+
+    doc.begin_transaction();
+    doc.splice(fragment);
+    EXPECT_EQ(doc.body().paragraphs().size(), 2u);
+    doc.rollback();
+
+    EXPECT_EQ(doc.body().paragraphs().size(), 1u);
+    EXPECT_FALSE(doc.body().get_body_node().select_node(".//w:hyperlink"));
+}
+
+TEST(DocumentFragmentTest, SplicingTwiceRenumbersDrawingAndBookmarkIds)
+{
+    write_png(kImagePath);
+    const std::string path = "document_fragment_twice.docx";
+    const auto ids_of = [](const pugi::xml_node body, const char* query) {
+        std::vector<std::string> ids;
+        for (const auto& found: body.select_nodes(query))
+            ids.push_back(found.attribute().value());
+        return ids;
+    };
+    {
+        auto doc = duckx::Document::create(path);
+        duckx::DocumentFragment fragment;
+        build_chapter(fragment, 1);
+        doc.splice(fragment);
+        doc.splice(fragment);
+        doc.save();
+    }
+
+    // Reopened: the next splice continues after the ids already spliced
+    auto doc = duckx::Document::open(path);
+    duckx::DocumentFragment again;
+    build_chapter(again, 2);
+    doc.splice(again);
+
+    const pugi::xml_node body = doc.body().get_body_node();
+    const std::vector<std::string> docpr = ids_of(body, ".//wp:docPr/@id");
+    const std::vector<std::string> starts = ids_of(body, ".//w:bookmarkStart/@w:id");
+    const std::vector<std::string> ends = ids_of(body, ".//w:bookmarkEnd/@w:id");
+    EXPECT_EQ(docpr.size(), 6u);
+    EXPECT_EQ(std::set<std::string>(docpr.begin(), docpr.end()).size(), docpr.size());
+    EXPECT_EQ(starts.size(), 3u);
+    EXPECT_EQ(std::set<std::string>(starts.begin(), starts.end()).size(), starts.size());
+    EXPECT_EQ(ends, starts);
+
+    std::remove(path.c_str());
+    std::remove(kImagePath);
+}
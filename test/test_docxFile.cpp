@@ -12,9 +12,13 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "DocxFile.hpp"
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <cstdio>  // For remove()
+#include <cstdlib>
+
+#include "zip.h"
 
 #if defined(_WIN32)
 #include <direct.h> // For _mkdir
@@ -179,6 +183,32 @@ TEST_F(DocxFileTest, WriteAndReadEntryInMemory)
     doc.close();
 }
 
+TEST_F(DocxFileTest, OnlyChangedEntriesAreMarkedModified)
+{
+    duckx::DocxFile doc;
+    const std::string path = get_test_path("modified_tracking.docx");
+    ASSERT_TRUE(doc.create(path));
+    EXPECT_FALSE(doc.is_modified());
+
+    doc.write_entry("custom/data.txt", "v1");
+    EXPECT_TRUE(doc.is_modified());
+    doc.save();
+    EXPECT_FALSE(doc.is_modified());
+
+    // Rewriting identical content must not schedule the entry for recompression
+    doc.write_entry("custom/data.txt", "v1");
+    EXPECT_FALSE(doc.is_modified());
+
+    doc.write_entry("custom/data.txt", "v2");
+    EXPECT_TRUE(doc.is_modified());
+    doc.save();
+
+    duckx::DocxFile reopened;
+    ASSERT_TRUE(reopened.open(path));
+    EXPECT_EQ(reopened.read_entry("custom/data.txt"), "v2");
+    EXPECT_TRUE(reopened.has_entry("word/document.xml"));
+}
+
 TEST_F(DocxFileTest, WriteAndSaveAndReopen)
 {
     const std::string path = get_test_path("save_and_reopen.docx");
@@ -339,3 +369,104 @@ TEST_F(DocxFileTest, SaveWithNoChanges)
     EXPECT_TRUE(verifier.has_entry("word/document.xml"));
     verifier.close();
 }
+
+TEST_F(DocxFileTest, RemoveEntryDropsItOnSave)
+{
+    const std::string path = get_test_path("remove_entry.docx");
+    {
+        duckx::DocxFile writer;
+        ASSERT_TRUE(writer.create(path));
+        writer.write_entry("word/media/unused.png", "not really a png");
+        writer.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_GT(file.remove_entry("word/media/unused.png"), 0u);
+    EXPECT_EQ(file.remove_entry("word/media/unused.png"), 0u);
+    EXPECT_EQ(file.remove_entry("word/missing.xml"), 0u);
+    EXPECT_FALSE(file.has_entry("word/media/unused.png"));
+    EXPECT_THROW(file.read_entry("word/media/unused.png"), std::runtime_error);
+
+    const auto names = file.entry_names();
+    EXPECT_EQ(std::count(names.begin(), names.end(), "word/media/unused.png"), 0);
+    EXPECT_EQ(std::count(names.begin(), names.end(), "word/document.xml"), 1);
+    file.save();
+    file.close();
+
+    duckx::DocxFile reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_FALSE(reader.has_entry("word/media/unused.png"));
+    EXPECT_TRUE(reader.has_entry("word/document.xml"));
+
+    // Writing a removed entry brings it back
+    reader.remove_entry("word/settings.xml");
+    reader.write_entry("word/settings.xml", "<w:settings/>");
+    EXPECT_EQ(reader.read_entry("word/settings.xml"), "<w:settings/>");
+}
+
+TEST_F(DocxFileTest, IncrementalSaveAppendsChangedEntries)
+{
+    const std::string path = get_test_path("incremental.docx");
+    std::string media(256 * 1024, '\0');
+    std::uint32_t state = 12345;
+    for (char& c: media)
+    {
+        state = state * 1103515245u + 12345u;
+        c = static_cast<char>(state >> 24);
+    }
+    {
+        duckx::DocxFile writer;
+        ASSERT_TRUE(writer.create(path));
+        writer.write_entry("word/media/image1.bin", media);
+        writer.save();
+    }
+    const auto size_of = [&path]()
+    {
+        return static_cast<long>(std::ifstream(path, std::ios::binary | std::ios::ate).tellg());
+    };
+    const long full_size = size_of();
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    file.set_incremental(true, 0.5);
+    EXPECT_TRUE(file.is_incremental());
+    file.write_entry("word/document.xml", "<w:document>edit 1</w:document>");
+    file.remove_entry("word/settings.xml");
+    file.save();
+
+    // Only the edit and a new central directory were written
+    const long appended = size_of() - full_size;
+    EXPECT_GT(appended, 0);
+    EXPECT_LT(appended, 4096);
+    EXPECT_GT(file.dead_space(), 0u);
+
+    // The result is a valid archive for an independent reader
+    zip_t* zip = zip_open(path.c_str(), 0, 'r');
+    ASSERT_NE(zip, nullptr);
+    ASSERT_EQ(zip_entry_open(zip, "word/document.xml"), 0);
+    void* buffer = nullptr;
+    size_t buffer_size = 0;
+    ASSERT_GT(zip_entry_read(zip, &buffer, &buffer_size), 0);
+    EXPECT_EQ(std::string(static_cast<const char*>(buffer), buffer_size), "<w:document>edit 1</w:document>");
+    free(buffer);
+    zip_entry_close(zip);
+    EXPECT_NE(zip_entry_open(zip, "word/settings.xml"), 0);
+    zip_close(zip);
+
+    EXPECT_EQ(file.read_entry("word/media/image1.bin"), media);
+    EXPECT_FALSE(file.has_entry("word/settings.xml"));
+
+    // Replacing the large entry leaves more dead space than allowed: the save compacts
+    media[0] = static_cast<char>(media[0] + 1);
+    file.write_entry("word/media/image1.bin", media);
+    file.save();
+    EXPECT_EQ(file.dead_space(), 0u);
+    EXPECT_LE(size_of(), full_size);
+    file.close();
+
+    duckx::DocxFile reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.read_entry("word/document.xml"), "<w:document>edit 1</w:document>");
+    EXPECT_EQ(reader.read_entry("word/media/image1.bin"), media);
+}
@@ -0,0 +1,132 @@
+/*!
+ * @file test_element_selector.cpp
+ * @brief Unit tests for compiled selector queries
+ *
+ * Covers descendant and child combinators, run, paragraph and table
+ * property tests, wrappers searched through, agreement with hand-written
+ * loops, and syntax errors.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+#include "Document.hpp"
+#include "ElementSelector.hpp"
+
+namespace
+{
+    const char* const kBody =
+        "<w:body xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading2\"/></w:pPr>"
+        "<w:r><w:rPr><w:b/></w:rPr><w:t>top bold</w:t></w:r></w:p>"
+        "<w:tbl><w:tblPr><w:tblStyle w:val=\"Grid\"/></w:tblPr><w:tblGrid/>"
+        "<w:tr><w:tc><w:tcPr/>"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading2\"/><w:jc w:val=\"center\"/></w:pPr>"
+        "<w:r><w:rPr><w:b/><w:sz w:val=\"28\"/></w:rPr><w:t>cell bold</w:t></w:r>"
+        "<w:r><w:t>cell plain</w:t></w:r>"
+        "<w:hyperlink w:anchor=\"x\"><w:r><w:rPr><w:b/><w:color w:val=\"ff0000\"/></w:rPr>"
+        "<w:t>link bold</w:t></w:r></w:hyperlink></w:p></w:tc>"
+        "<w:tc><w:sdt><w:sdtContent><w:p><w:pPr><w:numPr><w:ilvl w:val=\"1\"/><w:numId w:val=\"3\"/></w:numPr></w:pPr>"
+        "<w:r><w:rPr><w:i/></w:rPr><w:t>list item</w:t></w:r></w:p></w:sdtContent></w:sdt>"
+        "<w:tbl><w:tr><w:tc><w:p><w:r><w:rPr><w:b/></w:rPr><w:t>nested</w:t></w:r></w:p></w:tc></w:tr></w:tbl>"
+        "</w:tc></w:tr></w:tbl>"
+        "</w:body>";
+
+    std::string texts(const std::vector<duckx::ElementMatch>& matches)
+    {
+        std::string text;
+        for (const duckx::ElementMatch& match: matches)
+        {
+            if (!text.empty())
+                text += '|';
+            text += match.node.child("w:t").text().get();
+        }
+        return text;
+    }
+} // namespace
+
+TEST(ElementSelectorTest, MatchesStepsAndPropertyTests)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+    const pugi::xml_node body = doc.document_element();
+
+    const auto select = [body](const char* selector) {
+        return texts(duckx::ElementSelector::compile(selector).select(body));
+    };
+
+    EXPECT_EQ(select("tbl p[style=Heading2] r[bold]"), "cell bold|link bold");
+    EXPECT_EQ(select("p[style=Heading2] > r[bold]"), "top bold|cell bold|link bold");
+    EXPECT_EQ(select("> p r"), "top bold");
+    EXPECT_EQ(select("tbl[style=Grid] > tr > tc > p r[!bold]"), "cell plain|list item");
+    EXPECT_EQ(select("tbl tbl r"), "nested");
+    EXPECT_EQ(select("tc tc r"), "nested");
+    EXPECT_EQ(select("r[color=FF0000]"), "link bold");
+    EXPECT_EQ(select("r[size=14]"), "cell bold");
+    EXPECT_EQ(select("p[align=center] r[ bold ][size]"), "cell bold");
+    EXPECT_EQ(select("p[list][level=1] r[italic]"), "list item");
+    EXPECT_EQ(select("p[style=\"Heading 2\"] r"), "");
+    EXPECT_EQ(select("p[!style] r"), "list item|nested");
+
+    const auto tables = duckx::ElementSelector::compile("tbl").select(body);
+    ASSERT_EQ(tables.size(), 2u);
+    EXPECT_EQ(tables[0].kind, duckx::SelectorElement::TABLE);
+    EXPECT_EQ(tables[0].as_table().row_count(), 1);
+    EXPECT_EQ(duckx::ElementSelector::compile("*").count(body), 17u);
+}
+
+TEST(ElementSelectorTest, AgreesWithHandWrittenLoops)
+{
+    auto doc = duckx::Document::create("element_selector_test.docx");
+    auto& body = doc.body();
+    for (int i = 0; i < 6; ++i)
+    {
+        auto table = body.add_table(2, 2);
+        for (auto& row: table.rows())
+        {
+            for (auto& cell: row.cells())
+            {
+                auto paragraph = cell.add_paragraph("cell", i % 2 == 0 ? duckx::bold : duckx::none);
+                if (i % 3 == 0)
+                    paragraph.set_alignment(duckx::Alignment::CENTER);
+                paragraph.add_run("plain");
+            }
+        }
+        body.add_paragraph("outside", duckx::bold);
+    }
+
+    std::size_t expected = 0;
+    for (auto& table: body.tables())
+        for (auto& row: table.rows())
+            for (auto& cell: row.cells())
+                for (auto& paragraph: cell.paragraphs())
+                {
+                    if (paragraph.properties().alignment != duckx::Alignment::CENTER)
+                        continue;
+                    for (auto& run: paragraph.runs())
+                        expected += run.is_bold() ? 1 : 0;
+                }
+
+    const auto selector = duckx::ElementSelector::compile("tbl p[align=center] r[bold]");
+    const auto matches = selector.select(body);
+    EXPECT_EQ(matches.size(), expected);
+    EXPECT_GT(expected, 0u);
+    for (const auto& match: matches)
+        EXPECT_TRUE(match.as_run().is_bold());
+}
+
+TEST(ElementSelectorTest, ReportsSyntaxErrors)
+{
+    for (const char* selector: {"", "para", "p[", "p[bold", "p[unknown]", "r[bold=1]", "p[align=middle]",
+                                "p[level]", "r[size=big]", "p >", "p,r", "p[style=\"Heading]"})
+    {
+        const auto result = duckx::ElementSelector::compile_safe(selector);
+        ASSERT_FALSE(result.ok()) << selector;
+        EXPECT_EQ(result.error().code(), duckx::ErrorCode::INVALID_ARGUMENT) << selector;
+    }
+    EXPECT_THROW(duckx::ElementSelector::compile("tbl >> p"), std::invalid_argument);
+    EXPECT_EQ(duckx::ElementSelector::compile("  tbl>p  r ").size(), 3u);
+}
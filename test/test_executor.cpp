@@ -0,0 +1,122 @@
+/*!
+ * @file test_executor.cpp
+ * @brief Unit tests for the executors and their use by document saves
+ *
+ * Covers parallel_for on the built-in executors, nested loops on a single
+ * worker, exception propagation, and routing of saves through a host
+ * executor.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Document.hpp"
+#include "Executor.hpp"
+
+using namespace duckx;
+
+namespace
+{
+    /*! @brief Host executor forwarding to a pool and counting submissions */
+    class CountingExecutor : public Executor
+    {
+    public:
+        void submit(std::function<void()> task) override
+        {
+            ++submitted;
+            m_pool.submit(std::move(task));
+        }
+        std::size_t concurrency() const override { return m_pool.concurrency(); }
+
+        std::atomic<int> submitted{0};
+
+    private:
+        ThreadPoolExecutor m_pool{2};
+    };
+} // namespace
+
+TEST(ExecutorTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPoolExecutor pool(4);
+    InlineExecutor inline_executor;
+    for (Executor* executor: std::vector<Executor*>{&pool, &inline_executor})
+    {
+        std::vector<std::atomic<int>> hits(1000);
+        executor->parallel_for(10, 1000, [&hits](const std::size_t i) { ++hits[i]; }, 7);
+        for (std::size_t i = 0; i < hits.size(); ++i)
+            EXPECT_EQ(hits[i].load(), i < 10 ? 0 : 1) << i;
+    }
+
+    WaitGroup group;
+    std::atomic<int> done{0};
+    group.add(50);
+    for (int i = 0; i < 50; ++i)
+        pool.submit([&]() {
+            ++done;
+            group.done();
+        });
+    group.wait();
+    EXPECT_EQ(done.load(), 50);
+}
+
+TEST(ExecutorTest, NestedLoopsAndErrorsOnASingleWorker)
+{
+    ThreadPoolExecutor pool(1);
+    std::atomic<int> total{0};
+    WaitGroup group;
+    group.add();
+    pool.submit([&]() {
+        // 唯一的工作线程在任务内再次调用 parallel_for，不能死锁
+        pool.parallel_for(0, 8, [&](std::size_t) {
+            pool.parallel_for(0, 8, [&](std::size_t) { ++total; });
+        });
+        group.done();
+    });
+    group.wait();
+    EXPECT_EQ(total.load(), 64);
+
+    ThreadPoolExecutor wide(4);
+    EXPECT_THROW(wide.parallel_for(0, 100, [](const std::size_t i) {
+        if (i == 42)
+            throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+TEST(ExecutorTest, DocumentSavesRunOnTheHostExecutor)
+{
+    const std::string path = "executor_test.docx";
+    const auto host = std::make_shared<CountingExecutor>();
+    {
+        auto doc = Document::create(path);
+        doc.set_executor(host);
+        EXPECT_EQ(doc.executor(), host);
+
+        doc.body().add_paragraph("first");
+        auto first = doc.save_async();
+        doc.body().add_paragraph("second");
+        auto second = doc.save_async();
+        EXPECT_TRUE(second.get().ok());
+        EXPECT_TRUE(first.get().ok());
+        EXPECT_GE(host->submitted.load(), 1);
+
+        doc.body().add_paragraph("third");
+        EXPECT_NO_THROW(doc.save());
+
+        doc.set_executor(nullptr);
+        EXPECT_EQ(doc.executor(), default_executor());
+    }
+
+    auto reopened = Document::open(path);
+    std::vector<std::string> texts;
+    for (auto& paragraph: reopened.body().paragraphs())
+        texts.push_back(paragraph.runs().first().get_text());
+    EXPECT_EQ(texts, (std::vector<std::string>{"first", "second", "third"}));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,189 @@
+/*!
+ * @file test_field_evaluator.cpp
+ * @brief Unit tests for the field evaluation pass
+ *
+ * Covers SEQ numbering and section resets, PAGE/NUMPAGES with explicit
+ * page breaks, REF/PAGEREF resolution, TOC generation with hyperlink
+ * bookmarks, and Document::update_fields on save.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Document.hpp"
+#include "DocxFile.hpp"
+#include "FieldEvaluator.hpp"
+
+namespace
+{
+    const char* const kBody =
+        "<w:body xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading1\"/></w:pPr><w:r><w:t>Intro</w:t></w:r></w:p>"
+        "<w:p><w:bookmarkStart w:id=\"4\" w:name=\"Fig\"/><w:r><w:t xml:space=\"preserve\">Figure </w:t></w:r>"
+        "<w:fldSimple w:instr=\" SEQ Figure \\* ARABIC \"><w:r><w:t>7</w:t></w:r></w:fldSimple>"
+        "<w:bookmarkEnd w:id=\"4\"/><w:fldSimple w:instr=\" SEQ Table \\s 1 \"/></w:p>"
+        "<w:p><w:r><w:br w:type=\"page\"/></w:r></w:p>"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading 1\"/></w:pPr><w:r><w:t>Results</w:t></w:r></w:p>"
+        "<w:p><w:fldSimple w:instr=\" SEQ Figure \"/><w:fldSimple w:instr=\" SEQ Table \\s 1 \"/>"
+        "<w:fldSimple w:instr=\" PAGE \"/><w:fldSimple w:instr=\" PAGE \\* ROMAN \"/>"
+        "<w:r><w:fldChar w:fldCharType=\"begin\"/></w:r><w:r><w:instrText> PAGEREF Fig \\h </w:instrText></w:r>"
+        "<w:r><w:fldChar w:fldCharType=\"separate\"/></w:r><w:r><w:rPr><w:b/></w:rPr><w:t>9</w:t></w:r>"
+        "<w:r><w:t>9</w:t></w:r><w:r><w:fldChar w:fldCharType=\"end\"/></w:r>"
+        "<w:fldSimple w:instr=\" REF fig \\h \"/><w:fldSimple w:instr=\" NUMPAGES \"/>"
+        "<w:fldSimple w:instr=\" REF Nope \"/></w:p>"
+        "</w:body>";
+
+    std::string texts(const pugi::xml_node node)
+    {
+        std::string text;
+        for (const pugi::xpath_node t: node.select_nodes(".//w:t"))
+            text += t.node().text().get();
+        return text;
+    }
+
+    std::size_t count(const pugi::xml_node node, const char* query)
+    {
+        return node.select_nodes(query).size();
+    }
+} // namespace
+
+TEST(FieldEvaluatorTest, ComputesSequencePageAndReferenceFields)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(kBody));
+    const pugi::xml_node body = doc.document_element();
+
+    duckx::FieldEvaluator evaluator;
+    const duckx::FieldEvaluationReport report = evaluator.evaluate(body);
+    EXPECT_EQ(report.page_count, 2);
+    EXPECT_EQ(report.fields_updated, 10u);
+    EXPECT_EQ(report.unresolved_references, 1u);
+
+    const pugi::xml_node figure = body.child("w:p").next_sibling();
+    const pugi::xml_node fields = figure.next_sibling().next_sibling().next_sibling();
+    EXPECT_EQ(texts(figure), "Figure 11");
+    // The second Figure continues the sequence; Table restarts after each level-1 heading
+    const std::string expected = "21" "2" "II" "1" "Figure 1" "2" "Error! Reference source not found.";
+    EXPECT_EQ(texts(fields), expected);
+    const pugi::xml_node separate = fields.find_child([](const pugi::xml_node run) {
+        return std::strcmp(run.child("w:fldChar").attribute("w:fldCharType").value(), "separate") == 0;
+    });
+    EXPECT_TRUE(separate.next_sibling().child("w:rPr").child("w:b")); // result keeps the first result run's format
+    EXPECT_STREQ(separate.next_sibling().next_sibling().child("w:fldChar").attribute("w:fldCharType").value(), "end");
+
+    // Re-evaluating is stable
+    EXPECT_EQ(evaluator.evaluate(body).fields_updated, 10u);
+    EXPECT_EQ(texts(fields), expected);
+}
+
+TEST(FieldEvaluatorTest, BuildsTocWithHyperlinkBookmarks)
+{
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(
+        "<w:body xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:p><w:r><w:fldChar w:fldCharType=\"begin\"/></w:r>"
+        "<w:r><w:instrText xml:space=\"preserve\"> TOC \\o \"1-3\" \\h \\z \\u </w:instrText></w:r>"
+        "<w:r><w:fldChar w:fldCharType=\"separate\"/></w:r><w:r><w:t>stale</w:t></w:r>"
+        "<w:r><w:fldChar w:fldCharType=\"end\"/></w:r></w:p>"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading 1\"/></w:pPr><w:bookmarkStart w:id=\"0\" w:name=\"_TocA\"/>"
+        "<w:r><w:t>Alpha</w:t></w:r><w:bookmarkEnd w:id=\"0\"/></w:p>"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading2\"/></w:pPr><w:r><w:t>Beta</w:t></w:r></w:p>"
+        "<w:p><w:pPr><w:pStyle w:val=\"Heading4\"/></w:pPr><w:r><w:t>Deep</w:t></w:r></w:p>"
+        "<w:p><w:pPr><w:outlineLvl w:val=\"0\"/></w:pPr><w:r><w:t>Appendix</w:t></w:r></w:p>"
+        "</w:body>"));
+    const pugi::xml_node body = doc.document_element();
+
+    duckx::FieldEvaluator evaluator;
+    EXPECT_EQ(evaluator.evaluate(body).fields_updated, 1u);
+
+    // Three entries follow the field paragraph; the field ends in the last one
+    ASSERT_EQ(count(body, "w:p"), 8u);
+    const pugi::xml_node entry = body.child("w:p").next_sibling();
+    EXPECT_STREQ(entry.child("w:pPr").child("w:pStyle").attribute("w:val").value(), "TOC1");
+    EXPECT_STREQ(entry.child("w:hyperlink").attribute("w:anchor").value(), "_TocA");
+    EXPECT_EQ(texts(entry), "Alpha1");
+    EXPECT_EQ(texts(entry.next_sibling()), "Beta1");
+    EXPECT_EQ(texts(entry.next_sibling().next_sibling()), "Appendix1");
+    EXPECT_EQ(count(entry.next_sibling().next_sibling(), "w:hyperlink/w:r/w:fldChar"), 0u);
+    EXPECT_EQ(count(entry.next_sibling().next_sibling(), "w:r/w:fldChar[@w:fldCharType='end']"), 1u);
+    EXPECT_EQ(texts(body.child("w:p")), "");
+
+    // Beta and Appendix had no bookmark, so one was added for each hyperlink
+    const pugi::xml_node beta = body.find_child([](const pugi::xml_node p) { return texts(p) == "Beta"; });
+    const char* anchor = entry.next_sibling().child("w:hyperlink").attribute("w:anchor").value();
+    EXPECT_STREQ(beta.child("w:bookmarkStart").attribute("w:name").value(), anchor);
+    EXPECT_STREQ(beta.child("w:bookmarkStart").attribute("w:id").value(), "1");
+
+    // Updating again replaces the entries instead of appending more
+    EXPECT_EQ(evaluator.evaluate(body).fields_updated, 1u);
+    EXPECT_EQ(count(body, "w:p"), 8u);
+    EXPECT_EQ(count(body, ".//w:bookmarkStart"), 3u);
+    EXPECT_EQ(count(body, "w:p/w:r/w:fldChar[@w:fldCharType='end']"), 1u);
+}
+
+TEST(FieldEvaluatorTest, DocumentUpdatesFieldsOnSave)
+{
+    const std::string path = "field_evaluator_test.docx";
+    remove(path.c_str());
+    {
+        auto doc = duckx::Document::create(path);
+        const auto heading = [&doc](const char* text) {
+            auto paragraph = doc.body().add_paragraph(text);
+            paragraph.get_node().prepend_child("w:pPr").append_child("w:pStyle").append_attribute("w:val").set_value(
+                "Heading 1");
+        };
+        heading("Overview");
+        doc.body().add_paragraph().get_node().append_child("w:r").append_child("w:br").append_attribute(
+            "w:type").set_value("page");
+        heading("Details");
+        ASSERT_TRUE(doc.outline().create_field_toc_safe().ok());
+        doc.body().add_paragraph().get_node().append_child("w:fldSimple").append_attribute("w:instr").set_value(
+            " NUMPAGES ");
+
+        pugi::xml_node footer = doc.get_footer().add_paragraph().get_node();
+        footer.append_child("w:fldSimple").append_attribute("w:instr").set_value(" NUMPAGES ");
+
+        duckx::SaveOptions options;
+        options.update_fields = true;
+        ASSERT_TRUE(doc.save_safe(options).ok());
+        EXPECT_EQ(texts(footer), "2");
+    }
+
+    const auto check_saved = [&path]() {
+        auto doc = duckx::Document::open(path);
+        const pugi::xml_node body = doc.body().get_body_node();
+        const pugi::xpath_node_set entries = body.select_nodes(".//w:sdtContent/w:p[w:hyperlink]");
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_EQ(texts(entries[0].node()), "Overview1");
+        EXPECT_EQ(texts(entries[1].node()), "Details2");
+        EXPECT_EQ(texts(body.select_node(".//w:fldSimple[@w:instr=' NUMPAGES ']").node()), "2");
+
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(path));
+        pugi::xml_document footer;
+        ASSERT_TRUE(footer.load_string(file.read_entry("word/footer1.xml").c_str()));
+        EXPECT_EQ(texts(footer.select_node("//w:fldSimple").node()), "2");
+    };
+    check_saved();
+
+    // The asynchronous save runs the same preparation
+    {
+        auto doc = duckx::Document::open(path);
+        doc.body().add_paragraph().get_node().append_child("w:r").append_child("w:br").append_attribute(
+            "w:type").set_value("page");
+        doc.body().add_paragraph("Tail");
+        duckx::SaveOptions options;
+        options.update_fields = true;
+        ASSERT_TRUE(doc.save_async(options).get().ok());
+    }
+    {
+        auto doc = duckx::Document::open(path);
+        EXPECT_EQ(texts(doc.body().get_body_node().select_node(".//w:fldSimple[@w:instr=' NUMPAGES ']").node()),
+                  "3");
+    }
+    remove(path.c_str());
+}
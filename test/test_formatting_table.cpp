@@ -0,0 +1,101 @@
+/*!
+ * @file test_formatting_table.cpp
+ * @brief Unit tests for the columnar FormattingTable extraction
+ *
+ * Validates string interning, fixed-point units, paragraph bitsets and
+ * reuse of a table across several documents.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "Document.hpp"
+#include "FormattingTable.hpp"
+
+namespace dx = duckx;
+
+class FormattingTableTest : public ::testing::Test
+{
+protected:
+    std::string path = "test_formatting_table.docx";
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(FormattingTableTest, ExtractsRunAndParagraphColumns)
+{
+    auto doc = dx::Document::create(path);
+    auto& body = doc.body();
+
+    auto first = body.add_paragraph("Title", dx::bold);
+    first.set_alignment(dx::Alignment::CENTER);
+    first.set_spacing(12.0, 6.0);
+    auto& run = first.add_run(" more", dx::italic);
+    run.set_font("Arial").set_font_size(10.5).set_color("FF0000");
+
+    auto second = body.add_paragraph("Body");
+    second.add_run(" again").set_font("Arial");
+
+    auto table = body.add_table(1, 1);
+    table.rows().begin()->cells().begin()->add_paragraph("Cell");
+
+    const dx::FormattingTable columns = doc.extract_formatting_table();
+
+    // New cells already hold an empty paragraph
+    ASSERT_EQ(columns.paragraph_count(), 4u);
+    ASSERT_EQ(columns.run_count(), 5u);
+
+    // Fonts are interned once no matter how many runs use them
+    ASSERT_EQ(columns.fonts.size(), 1u);
+    EXPECT_EQ(columns.fonts[0], "Arial");
+    EXPECT_EQ(columns.run_font[0], dx::FormattingTable::kNone);
+    EXPECT_EQ(columns.run_font[1], 0u);
+    EXPECT_EQ(columns.run_font[3], 0u);
+    ASSERT_EQ(columns.colors.size(), 1u);
+    EXPECT_EQ(columns.run_color[1], 0u);
+
+    EXPECT_EQ(columns.run_size[1], 21u); // 10.5pt = 21 half-points
+    EXPECT_EQ(columns.run_size[0], 0u);
+    EXPECT_EQ(columns.run_flags[0], dx::bold);
+    EXPECT_EQ(columns.run_flags[1], dx::italic);
+    EXPECT_EQ(columns.run_text_bytes[1], 5u);
+
+    EXPECT_EQ(columns.run_paragraph[1], 0u);
+    EXPECT_EQ(columns.run_paragraph[3], 1u);
+    EXPECT_EQ(columns.run_paragraph[4], 3u);
+
+    EXPECT_EQ(columns.paragraph_alignment[0], static_cast<std::uint8_t>(dx::Alignment::CENTER));
+    EXPECT_EQ(columns.paragraph_spacing_before[0], 240);
+    EXPECT_EQ(columns.paragraph_spacing_after[0], 120);
+    EXPECT_EQ(columns.paragraph_line_spacing[1], 240);
+
+    EXPECT_FALSE(dx::FormattingTable::test(columns.paragraph_in_table, 0));
+    EXPECT_TRUE(dx::FormattingTable::test(columns.paragraph_in_table, 2));
+    EXPECT_TRUE(dx::FormattingTable::test(columns.paragraph_in_table, 3));
+    EXPECT_FALSE(dx::FormattingTable::test(columns.paragraph_in_list, 1));
+}
+
+TEST_F(FormattingTableTest, ReusedTableIsClearedBetweenDocuments)
+{
+    auto doc = dx::Document::create(path);
+    doc.body().add_paragraph("One").add_run(" two").set_font("Calibri");
+
+    dx::FormattingTable columns;
+    doc.extract_formatting_table(columns);
+    EXPECT_EQ(columns.run_count(), 2u);
+    EXPECT_EQ(columns.fonts.size(), 1u);
+
+    auto other = dx::Document::create(path);
+    other.body().add_paragraph("Only");
+    other.extract_formatting_table(columns);
+    EXPECT_EQ(columns.run_count(), 1u);
+    EXPECT_EQ(columns.paragraph_count(), 1u);
+    EXPECT_TRUE(columns.fonts.empty());
+    EXPECT_EQ(columns.run_font[0], dx::FormattingTable::kNone);
+}
@@ -391,3 +391,160 @@ TEST_F(HeaderFooterTest, IdempotentFooterAccess)
     ASSERT_NE(p_it, paragraphs.end());
     EXPECT_EQ(std::string(p_it->child("w:r").child("w:t").text().as_string()), "Second footer access.");
 }
+
+// --- EXISTING PARTS AND TEMPLATES ---
+
+TEST_F(HeaderFooterTest, ExistingHeaderIsReusedAndOnlyWrittenWhenModified)
+{
+    {
+        auto doc = duckx::Document::create(test_filename);
+        doc.get_header(duckx::HeaderFooterType::DEFAULT).add_paragraph("Original");
+        doc.save();
+    }
+
+    // Re-indent the stored part so that any re-serialization would be visible
+    std::string header_entry;
+    const std::string indented =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<w:hdr xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">\n"
+        "  <w:p><w:r><w:t>Original</w:t></w:r></w:p>\n"
+        "</w:hdr>\n";
+    {
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(test_filename));
+        std::string rId;
+        ASSERT_TRUE(verify_hf_reference(file.read_entry("word/document.xml"), "w:headerReference", "default", rId));
+        header_entry = "word/" + getTargetFromRels(file.read_entry("word/_rels/document.xml.rels"), rId);
+        file.write_entry(header_entry, indented);
+        file.save();
+    }
+
+    {
+        auto doc = duckx::Document::open(test_filename);
+        doc.get_header(duckx::HeaderFooterType::DEFAULT); // parsed, but left untouched
+        doc.save();
+    }
+    {
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(test_filename));
+        EXPECT_EQ(file.read_entry(header_entry), indented);
+    }
+
+    {
+        auto doc = duckx::Document::open(test_filename);
+        doc.get_header(duckx::HeaderFooterType::DEFAULT).add_paragraph("Appended");
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    pugi::xml_document header_doc;
+    ASSERT_TRUE(header_doc.load_string(file.read_entry(header_entry).c_str()));
+    std::vector<std::string> texts;
+    for (const auto& p: header_doc.child("w:hdr").children("w:p"))
+    {
+        texts.emplace_back(p.child("w:r").child("w:t").text().as_string());
+    }
+    EXPECT_EQ(texts, (std::vector<std::string>{"Original", "Appended"}));
+
+    // The existing part was edited in place rather than a second header being added
+    pugi::xml_document main_doc;
+    ASSERT_TRUE(main_doc.load_string(file.read_entry("word/document.xml").c_str()));
+    const auto sect_pr = main_doc.child("w:document").child("w:body").child("w:sectPr");
+    EXPECT_EQ(std::distance(sect_pr.children("w:headerReference").begin(), sect_pr.children("w:headerReference").end()), 1);
+}
+
+TEST_F(HeaderFooterTest, TemplatesAreSharedByContent)
+{
+    std::shared_ptr<const duckx::HeaderFooterTemplate> header_template;
+    {
+        auto source = duckx::Document::create(test_filename);
+        source.get_header(duckx::HeaderFooterType::DEFAULT).add_paragraph("Company Confidential");
+        header_template = source.header_template(duckx::HeaderFooterType::DEFAULT);
+        EXPECT_EQ(source.header_template(duckx::HeaderFooterType::DEFAULT), header_template);
+    }
+    ASSERT_TRUE(header_template->is_header());
+    EXPECT_EQ(duckx::HeaderFooterTemplate::intern(header_template->xml()), header_template);
+
+    {
+        auto doc = duckx::Document::create(test_filename);
+        doc.set_header_template(duckx::HeaderFooterType::DEFAULT, header_template);
+        EXPECT_THROW(doc.set_footer_template(duckx::HeaderFooterType::DEFAULT, header_template),
+                     std::invalid_argument);
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    std::string rId;
+    ASSERT_TRUE(verify_hf_reference(file.read_entry("word/document.xml"), "w:headerReference", "default", rId));
+    const std::string header_filename = getTargetFromRels(file.read_entry("word/_rels/document.xml.rels"), rId);
+    EXPECT_EQ(file.read_entry("word/" + header_filename), header_template->xml());
+}
+
+TEST_F(HeaderFooterTest, PartsOfEverySectionAreDiscovered)
+{
+    std::string first_entry;
+    {
+        auto doc = duckx::Document::create(test_filename);
+        doc.get_header(duckx::HeaderFooterType::DEFAULT).add_paragraph("Final section");
+        auto first = doc.get_header(duckx::HeaderFooterType::FIRST).add_paragraph("Pages: ");
+        first.get_node().append_child("w:fldSimple").append_attribute("w:instr").set_value(" NUMPAGES ");
+        pugi::xml_node sdt = first.get_node().append_child("w:sdt");
+        sdt.append_child("w:sdtPr").append_child("w:tag").append_attribute("w:val").set_value("title");
+        sdt.append_child("w:sdtContent");
+
+        // Turn the first-page header into the default header of a first section ended by a section break
+        pugi::xml_node body = doc.body().get_body_node();
+        pugi::xml_node final_sect_pr = body.child("w:sectPr");
+        pugi::xml_node ref = final_sect_pr.find_child_by_attribute("w:headerReference", "w:type", "first");
+        pugi::xml_node section_break = body.insert_child_before("w:p", final_sect_pr);
+        pugi::xml_node sect_pr = section_break.append_child("w:pPr").append_child("w:sectPr");
+        sect_pr.append_copy(ref).attribute("w:type").set_value("default");
+        // A second reference to the same part is indexed once
+        sect_pr.append_copy(ref).attribute("w:type").set_value("even");
+        final_sect_pr.remove_child(ref);
+        final_sect_pr.remove_child("w:titlePg");
+        doc.mark_dirty(duckx::DocumentPart::MAIN_DOCUMENT);
+        doc.save();
+
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(test_filename));
+        first_entry = "word/" + getTargetFromRels(file.read_entry("word/_rels/document.xml.rels"),
+                                                  sect_pr.child("w:headerReference").attribute("r:id").value());
+    }
+
+    {
+        auto doc = duckx::Document::open(test_filename);
+        // The final section's own default header wins; the even header is inherited from the first section
+        EXPECT_NE(doc.header_template(duckx::HeaderFooterType::DEFAULT)->xml().find("Final section"),
+                  std::string::npos);
+        EXPECT_NE(doc.header_template(duckx::HeaderFooterType::EVEN)->xml().find("Pages: "), std::string::npos);
+
+        EXPECT_EQ(doc.update_fields().fields_updated, 1u);
+        EXPECT_EQ(doc.bind_content_controls({{"title", "Report"}}), 1u);
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    const std::string first_header = file.read_entry(first_entry);
+    EXPECT_NE(first_header.find("Report"), std::string::npos);
+    EXPECT_NE(first_header.find("NUMPAGES \"><w:r><w:t>"), std::string::npos);
+}
+
+TEST_F(HeaderFooterTest, InterningSurvivesPruningOfExpiredTemplates)
+{
+    const auto part = [](const int n) {
+        return "<w:hdr xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"><w:p><w:r><w:t>" +
+               std::to_string(n) + "</w:t></w:r></w:p></w:hdr>";
+    };
+    const auto kept = duckx::HeaderFooterTemplate::intern(part(-1));
+
+    // Enough expired entries to trigger several sweeps of the pool
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(duckx::HeaderFooterTemplate::intern(part(i))->xml(), part(i));
+
+    EXPECT_EQ(duckx::HeaderFooterTemplate::intern(part(-1)), kept);
+    EXPECT_THROW(duckx::HeaderFooterTemplate::intern("<w:p/>"), std::invalid_argument);
+}
@@ -0,0 +1,235 @@
+/*!
+ * @file test_mutation_journal.cpp
+ * @brief Unit tests for Document transactions and the mutation journal
+ *
+ * Covers rollback of paragraph, table and hyperlink edits together with the
+ * relationship ID counter, insert/change/remove sequences on raw nodes,
+ * the journal kept readable after commit, rollback to a savepoint, the
+ * independence of the journals of two documents, and rollback of field
+ * updates, headers, footers and numbering definitions.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "Document.hpp"
+
+namespace
+{
+    std::string dump(const pugi::xml_node node)
+    {
+        std::ostringstream out;
+        node.print(out, "", pugi::format_raw);
+        return out.str();
+    }
+} // namespace
+
+TEST(MutationJournalTest, RollbackRestoresBodyRelationshipsAndCounters)
+{
+    const std::string path = "mutation_journal_rollback.docx";
+    remove(path.c_str());
+    auto doc = duckx::Document::create(path);
+    auto first = doc.body().add_paragraph("First");
+    auto table = doc.body().add_table(2, 2);
+    doc.body().add_paragraph("Last");
+    const std::string before = dump(doc.body().get_body_node());
+    const std::string rels_before = doc.get_next_relationship_id();
+
+    doc.begin_transaction();
+    EXPECT_TRUE(doc.in_transaction());
+    EXPECT_THROW(doc.begin_transaction(), std::logic_error);
+
+    first.set_alignment(duckx::Alignment::CENTER).add_run(" more", duckx::bold);
+    table.set_width(300).get_row(1).get_cell(0).add_paragraph("Cell");
+    first.insert_paragraph_after("Inserted");
+    first.add_hyperlink(doc, "Link", "https://example.com");
+    doc.body().add_table(1, 1);
+    EXPECT_TRUE(doc.journal().touched(duckx::DocumentPart::RELATIONSHIPS));
+    EXPECT_NE(dump(doc.body().get_body_node()), before);
+
+    doc.rollback();
+    EXPECT_FALSE(doc.in_transaction());
+    EXPECT_EQ(doc.journal().size(), 0u);
+    EXPECT_EQ(dump(doc.body().get_body_node()), before);
+
+    // The hyperlink relationship is gone and its ID is handed out again
+    const std::string next = doc.get_next_relationship_id();
+    EXPECT_EQ(next, "rId" + std::to_string(std::stoi(rels_before.substr(3)) + 1));
+
+    doc.save();
+    auto reopened = duckx::Document::open(path);
+    EXPECT_EQ(dump(reopened.body().get_body_node()), before);
+    remove(path.c_str());
+}
+
+TEST(MutationJournalTest, RawNodeSequencesRollBackInReverse)
+{
+    auto doc = duckx::Document::create("mutation_journal_raw.docx");
+    pugi::xml_node body = doc.body().get_body_node();
+    for (const char* text: {"A", "B", "C"})
+        doc.body().add_paragraph(text);
+    const std::string before = dump(body);
+
+    doc.begin_transaction();
+    duckx::MutationJournal* journal = &doc.journal();
+    pugi::xml_node a = body.child("w:p");
+    pugi::xml_node b = a.next_sibling();
+
+    // Change then remove the same block, remove a neighbour, then insert and remove a new one
+    duckx::MutationJournal::before_change(journal, a);
+    a.child("w:r").child("w:t").text().set("changed");
+    duckx::MutationJournal::before_remove(journal, a);
+    body.remove_child(a);
+    duckx::MutationJournal::before_remove(journal, b);
+    body.remove_child(b);
+    pugi::xml_node added = body.prepend_child("w:p");
+    duckx::MutationJournal::after_insert(journal, added);
+    duckx::MutationJournal::before_remove(journal, added);
+    body.remove_child(added);
+
+    // Attributes of w:body itself are recorded without copying its children
+    duckx::MutationJournal::before_change(journal, body);
+    body.append_attribute("w:rsid").set_value("1");
+    EXPECT_EQ(doc.journal().size(), 6u);
+
+    doc.rollback();
+    EXPECT_EQ(dump(body), before);
+}
+
+TEST(MutationJournalTest, CommitKeepsChangesAndExposesJournal)
+{
+    auto doc = duckx::Document::create("mutation_journal_commit.docx");
+    auto paragraph = doc.body().add_paragraph("Kept");
+
+    doc.begin_transaction();
+    paragraph.add_run(" twice");
+    paragraph.add_run(" thrice");
+    auto added = doc.body().add_paragraph("New");
+    doc.commit();
+
+    // One entry per touched block, however many edits it received
+    const std::vector<duckx::Mutation> mutations = doc.journal().mutations();
+    ASSERT_EQ(mutations.size(), 2u);
+    EXPECT_EQ(mutations[0].kind, duckx::MutationKind::NODE_CHANGED);
+    EXPECT_EQ(mutations[0].node, paragraph.get_node());
+    EXPECT_EQ(mutations[1].kind, duckx::MutationKind::NODE_INSERTED);
+    EXPECT_EQ(mutations[1].node, added.get_node());
+    EXPECT_TRUE(doc.journal().touched(duckx::DocumentPart::MAIN_DOCUMENT));
+    EXPECT_FALSE(doc.journal().touched(duckx::DocumentPart::CONTENT_TYPES));
+
+    // Outside a transaction nothing is recorded and rollback is a no-op
+    doc.body().add_paragraph("After");
+    doc.rollback();
+    EXPECT_EQ(doc.journal().size(), 2u);
+    EXPECT_EQ(doc.body().get_body_node().select_nodes("w:p").size(), 3u);
+}
+
+TEST(MutationJournalTest, RollbackToSavepointKeepsEarlierChanges)
+{
+    pugi::xml_document xml;
+    ASSERT_TRUE(xml.load_string("<w:document><w:body><w:p><w:r><w:t>A</w:t></w:r></w:p>"
+                                "<w:p><w:r><w:t>B</w:t></w:r></w:p></w:body></w:document>"));
+    pugi::xml_node body = xml.child("w:document").child("w:body");
+    const std::string original = dump(body);
+
+    duckx::MutationJournal journal;
+    journal.begin();
+    journal.watch(xml, duckx::DocumentPart::MAIN_DOCUMENT);
+    pugi::xml_node a = body.child("w:p");
+    duckx::MutationJournal::before_change(&journal, a);
+    a.child("w:r").child("w:t").text().set("A1");
+    const std::string at_savepoint = dump(body);
+
+    // After the savepoint: change the same block again, remove a block and insert a new one
+    const std::size_t savepoint = journal.savepoint();
+    duckx::MutationJournal::before_change(&journal, a);
+    a.child("w:r").child("w:t").text().set("A2");
+    pugi::xml_node b = a.next_sibling();
+    duckx::MutationJournal::before_remove(&journal, b);
+    body.remove_child(b);
+    duckx::MutationJournal::after_insert(&journal, body.append_child("w:p"));
+
+    journal.rollback_to(savepoint);
+    EXPECT_EQ(dump(body), at_savepoint);
+    EXPECT_TRUE(journal.active());
+    EXPECT_EQ(journal.size(), savepoint);
+
+    // The restored block is tracked again, and a full rollback still reaches the original
+    duckx::MutationJournal::before_remove(&journal, a.next_sibling());
+    body.remove_child(a.next_sibling());
+    journal.rollback();
+    EXPECT_EQ(dump(body), original);
+}
+
+TEST(MutationJournalTest, DocumentsKeepSeparateJournals)
+{
+    auto first = duckx::Document::create("mutation_journal_first.docx");
+    auto second = duckx::Document::create("mutation_journal_second.docx");
+    auto paragraph = second.body().add_paragraph("Second");
+    const std::string first_before = dump(first.body().get_body_node());
+
+    // Edits of a document without an open transaction never reach another document's journal
+    first.begin_transaction();
+    first.body().add_paragraph("Undone");
+    paragraph.add_run(" kept");
+    second.body().add_paragraph("Also kept");
+    EXPECT_EQ(first.journal().size(), 1u);
+    EXPECT_EQ(second.journal().size(), 0u);
+    EXPECT_FALSE(second.in_transaction());
+
+    first.rollback();
+    EXPECT_EQ(dump(first.body().get_body_node()), first_before);
+    EXPECT_EQ(second.body().get_body_node().select_nodes("w:p").size(), 2u);
+    EXPECT_EQ(paragraph.get_node().select_nodes("w:r").size(), 2u);
+}
+
+TEST(MutationJournalTest, RollbackCoversFieldsHeadersFootersAndNumbering)
+{
+    const std::string path = "mutation_journal_parts.docx";
+    remove(path.c_str());
+    auto doc = duckx::Document::create(path);
+    doc.body().add_paragraph().get_node().append_child("w:fldSimple").append_attribute("w:instr").set_value(
+        " NUMPAGES ");
+    pugi::xml_node footer = doc.get_footer().add_paragraph("Page count ").get_node().parent();
+    footer.child("w:p").append_child("w:fldSimple").append_attribute("w:instr").set_value(" NUMPAGES ");
+    const int bullets = doc.numbering().define_list(duckx::ListType::BULLET);
+    doc.save();
+
+    const std::string body_before = dump(doc.body().get_body_node());
+    const std::string footer_before = dump(footer);
+    const std::string next_rid = doc.get_next_relationship_id();
+
+    doc.begin_transaction();
+    doc.update_fields();
+    doc.get_footer().add_paragraph("Added");
+    const int restarted = doc.numbering().restart_list(bullets, 3);
+    doc.get_header().add_paragraph("New header");
+    EXPECT_NE(dump(doc.body().get_body_node()), body_before);
+    EXPECT_NE(dump(footer), footer_before);
+    EXPECT_TRUE(doc.journal().touched(duckx::DocumentPart::HEADER_FOOTER));
+    EXPECT_TRUE(doc.journal().touched(duckx::DocumentPart::NUMBERING));
+
+    doc.rollback();
+    EXPECT_EQ(dump(doc.body().get_body_node()), body_before);
+    EXPECT_EQ(dump(footer), footer_before);
+    EXPECT_FALSE(doc.numbering().has_num(restarted));
+    EXPECT_TRUE(doc.numbering().has_num(bullets));
+    EXPECT_FALSE(doc.body().get_body_node().child("w:sectPr").child("w:headerReference"));
+
+    // The rolled back header is forgotten: requesting it again creates a fresh part
+    EXPECT_EQ(doc.numbering().restart_list(bullets, 3), restarted);
+    doc.get_header().add_paragraph("Header");
+    EXPECT_EQ(doc.get_next_relationship_id(),
+              "rId" + std::to_string(std::stoi(next_rid.substr(3)) + 2));
+    doc.save();
+
+    auto reopened = duckx::Document::open(path);
+    EXPECT_EQ(reopened.body().get_body_node().child("w:sectPr").select_nodes("w:headerReference").size(), 1u);
+    EXPECT_TRUE(reopened.numbering().has_num(restarted));
+    remove(path.c_str());
+}
@@ -0,0 +1,170 @@
+/*!
+ * @file test_numbering_manager.cpp
+ * @brief Unit tests for the numbering model and list label computation
+ *
+ * Covers multi-level labels, lvlRestart, instances sharing an abstract
+ * definition, startOverride restarts and de-duplicated list creation.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "Document.hpp"
+#include "DocxFile.hpp"
+#include "NumberingManager.hpp"
+
+namespace
+{
+    // abstractNum 5: "1." / "1.a)" / "1.a.i" with level 2 never restarting;
+    // num 7 and 8 share it, num 9 restarts it at 10
+    const char* const kNumbering =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+        "<w:numbering xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+        "<w:abstractNum w:abstractNumId=\"5\">"
+        "<w:lvl w:ilvl=\"0\"><w:start w:val=\"1\"/><w:numFmt w:val=\"decimal\"/><w:lvlText w:val=\"%1.\"/></w:lvl>"
+        "<w:lvl w:ilvl=\"1\"><w:start w:val=\"1\"/><w:numFmt w:val=\"lowerLetter\"/><w:lvlText w:val=\"%1.%2)\"/></w:lvl>"
+        "<w:lvl w:ilvl=\"2\"><w:start w:val=\"1\"/><w:numFmt w:val=\"lowerRoman\"/><w:lvlRestart w:val=\"0\"/>"
+        "<w:lvlText w:val=\"%1.%2.%3\"/></w:lvl>"
+        "</w:abstractNum>"
+        "<w:abstractNum w:abstractNumId=\"6\">"
+        "<w:lvl w:ilvl=\"0\"><w:start w:val=\"1\"/><w:numFmt w:val=\"upperRoman\"/><w:lvlText w:val=\"%1\"/></w:lvl>"
+        "<w:lvl w:ilvl=\"1\"><w:start w:val=\"1\"/><w:numFmt w:val=\"upperLetter\"/><w:isLgl/>"
+        "<w:lvlText w:val=\"%1.%2\"/></w:lvl>"
+        "</w:abstractNum>"
+        "<w:num w:numId=\"7\"><w:abstractNumId w:val=\"5\"/></w:num>"
+        "<w:num w:numId=\"8\"><w:abstractNumId w:val=\"5\"/></w:num>"
+        "<w:num w:numId=\"9\"><w:abstractNumId w:val=\"5\"/>"
+        "<w:lvlOverride w:ilvl=\"0\"><w:startOverride w:val=\"10\"/></w:lvlOverride></w:num>"
+        "<w:num w:numId=\"11\"><w:abstractNumId w:val=\"6\"/></w:num>"
+        "</w:numbering>";
+
+    std::string paragraph(const int num_id, const int level)
+    {
+        return "<w:p><w:pPr><w:numPr><w:ilvl w:val=\"" + std::to_string(level) + "\"/><w:numId w:val=\"" +
+               std::to_string(num_id) + "\"/></w:numPr></w:pPr><w:r><w:t>item</w:t></w:r></w:p>";
+    }
+} // namespace
+
+class NumberingManagerTest : public ::testing::Test
+{
+protected:
+    const std::string test_filename = "numbering_manager_test.docx";
+
+    void SetUp() override { remove(test_filename.c_str()); }
+    void TearDown() override { remove(test_filename.c_str()); }
+
+    void write_package(const std::string& body) const
+    {
+        duckx::Document::create(test_filename).save();
+
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(test_filename));
+        file.write_entry("word/numbering.xml", kNumbering);
+        std::string document = file.read_entry("word/document.xml");
+        document.insert(document.find("</w:body>"), body);
+        file.write_entry("word/document.xml", document);
+        file.save();
+    }
+};
+
+TEST_F(NumberingManagerTest, ComputesMultiLevelLabelsWithRestarts)
+{
+    write_package(paragraph(7, 0) + paragraph(7, 1) + paragraph(7, 2) + paragraph(7, 1) + paragraph(7, 2) +
+                  "<w:p><w:r><w:t>plain</w:t></w:r></w:p>" + paragraph(7, 0) + paragraph(7, 1) + paragraph(7, 2));
+
+    auto doc = duckx::Document::open(test_filename);
+    const std::vector<duckx::ListLabel> labels = doc.list_labels();
+    ASSERT_EQ(labels.size(), 8u);
+    EXPECT_EQ(labels[0].text, "1.");
+    EXPECT_EQ(labels[1].text, "1.a)");
+    EXPECT_EQ(labels[2].text, "1.a.i");
+    EXPECT_EQ(labels[3].text, "1.b)");
+    EXPECT_EQ(labels[4].text, "1.b.ii"); // w:lvlRestart 0: level 2 never restarts
+    EXPECT_EQ(labels[5].text, "2.");
+    EXPECT_EQ(labels[6].text, "2.a)");   // level 1 restarts after level 0
+    EXPECT_EQ(labels[7].text, "2.a.iii");
+    EXPECT_EQ(labels[7].num_id, 7);
+    EXPECT_EQ(labels[7].level, 2);
+    EXPECT_STREQ(labels[7].paragraph.name(), "w:p");
+}
+
+TEST_F(NumberingManagerTest, SharedDefinitionsContinueAndOverridesRestart)
+{
+    write_package(paragraph(7, 0) + paragraph(8, 0) + paragraph(9, 0) + paragraph(9, 0) + paragraph(7, 0) +
+                  paragraph(11, 0) + paragraph(11, 1) + paragraph(11, 0) + paragraph(11, 1));
+
+    auto doc = duckx::Document::open(test_filename);
+    const std::vector<duckx::ListLabel> labels = doc.list_labels();
+    ASSERT_EQ(labels.size(), 9u);
+    EXPECT_EQ(labels[0].text, "1.");
+    EXPECT_EQ(labels[1].text, "2.");  // num 8 continues num 7
+    EXPECT_EQ(labels[2].text, "10."); // num 9 restarts at its startOverride
+    EXPECT_EQ(labels[3].text, "11.");
+    EXPECT_EQ(labels[4].text, "12.");
+    EXPECT_EQ(labels[5].text, "I");
+    EXPECT_EQ(labels[6].text, "1.1"); // w:isLgl renders every level as decimal
+    EXPECT_EQ(labels[7].text, "II");
+    EXPECT_EQ(labels[8].text, "2.1");
+
+    EXPECT_EQ(doc.numbering().list_type(11, 0), duckx::ListType::NUMBER);
+    EXPECT_EQ(doc.numbering().list_type(11, 5), duckx::ListType::NONE);
+    EXPECT_FALSE(doc.numbering().has_num(42));
+}
+
+TEST_F(NumberingManagerTest, DefinesListsWithoutDuplicates)
+{
+    {
+        auto doc = duckx::Document::create(test_filename);
+        duckx::NumberingManager& numbering = doc.numbering();
+
+        // The built-in lists of a new document are reused as they are
+        EXPECT_EQ(numbering.define_list(duckx::ListType::BULLET), 1);
+        EXPECT_EQ(numbering.define_list(duckx::ListType::NUMBER), 2);
+        EXPECT_EQ(numbering.list_type(1, 0), duckx::ListType::BULLET);
+
+        duckx::NumberingLevel outer;
+        outer.format = "upperLetter";
+        outer.text = "%1.";
+        duckx::NumberingLevel inner;
+        inner.format = "decimal";
+        inner.text = "%1.%2";
+        const int custom = numbering.define_list({outer, inner});
+        EXPECT_EQ(custom, 3);
+        EXPECT_EQ(numbering.define_list({outer, inner}), custom);
+
+        const int restarted = numbering.restart_list(custom, 5);
+        EXPECT_EQ(restarted, 4);
+        EXPECT_EQ(numbering.restart_list(99), 0);
+
+        auto p1 = doc.body().add_paragraph("first");
+        p1.get_node().append_child("w:pPr").append_child("w:numPr").append_child("w:numId").append_attribute(
+            "w:val").set_value(custom);
+        auto p2 = doc.body().add_paragraph("second");
+        p2.get_node().append_child("w:pPr").append_child("w:numPr").append_child("w:numId").append_attribute(
+            "w:val").set_value(restarted);
+        doc.save();
+    }
+
+    auto doc = duckx::Document::open(test_filename);
+    const std::vector<duckx::ListLabel> labels = doc.list_labels();
+    ASSERT_EQ(labels.size(), 2u);
+    EXPECT_EQ(labels[0].text, "A.");
+    EXPECT_EQ(labels[1].text, "E.");
+
+    // Definitions survive the round trip and are still de-duplicated
+    duckx::NumberingLevel outer;
+    outer.format = "upperLetter";
+    outer.text = "%1.";
+    duckx::NumberingLevel inner;
+    inner.format = "decimal";
+    inner.text = "%1.%2";
+    EXPECT_EQ(doc.numbering().define_list({outer, inner}), 3);
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    const std::string xml = file.read_entry("word/numbering.xml");
+    EXPECT_LT(xml.rfind("<w:abstractNum "), xml.find("<w:num "));
+}
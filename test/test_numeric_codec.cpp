@@ -0,0 +1,145 @@
+/*!
+ * @file test_numeric_codec.cpp
+ * @brief Unit tests for the locale-free numeric attribute codec
+ *
+ * Covers integer and decimal parsing edge cases, formatting of extreme
+ * values and exhaustive fixed-point round trips for the OOXML units.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <clocale>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "NumericCodec.hpp"
+
+namespace numeric = duckx::numeric;
+
+TEST(NumericCodecTest, IntegersRoundTrip)
+{
+    const long long values[] = {0, 1, -1, 9, 10, 1440, -720, 12700, 2147483647LL, -2147483648LL,
+                                std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min()};
+    for (const long long value : values)
+    {
+        const numeric::NumberBuffer text = numeric::format_int(value);
+        EXPECT_EQ(std::string(text.c_str()), std::to_string(value));
+        EXPECT_EQ(text.size, std::to_string(value).size());
+
+        long long parsed = 0;
+        ASSERT_TRUE(numeric::parse_int(text.view(), parsed)) << text.c_str();
+        EXPECT_EQ(parsed, value);
+    }
+}
+
+TEST(NumericCodecTest, IntegerParsingIsStrict)
+{
+    long long value = 42;
+    EXPECT_FALSE(numeric::parse_int("", value));
+    EXPECT_FALSE(numeric::parse_int("-", value));
+    EXPECT_FALSE(numeric::parse_int(" 12", value));
+    EXPECT_FALSE(numeric::parse_int("12pt", value));
+    EXPECT_FALSE(numeric::parse_int("1.5", value));
+    EXPECT_FALSE(numeric::parse_int("9223372036854775808", value)); // LLONG_MAX + 1
+    EXPECT_EQ(value, 42);
+
+    EXPECT_TRUE(numeric::parse_int("+17", value));
+    EXPECT_EQ(value, 17);
+
+    unsigned long long unsigned_value = 0;
+    EXPECT_FALSE(numeric::parse_uint("-1", unsigned_value));
+    EXPECT_FALSE(numeric::parse_uint("18446744073709551616", unsigned_value));
+    EXPECT_TRUE(numeric::parse_uint("18446744073709551615", unsigned_value));
+    EXPECT_EQ(unsigned_value, std::numeric_limits<unsigned long long>::max());
+}
+
+TEST(NumericCodecTest, DecimalParsing)
+{
+    double value = 0.0;
+    EXPECT_TRUE(numeric::parse_decimal("12.5", value));
+    EXPECT_EQ(value, 12.5);
+    EXPECT_TRUE(numeric::parse_decimal("-0.25", value));
+    EXPECT_EQ(value, -0.25);
+    EXPECT_TRUE(numeric::parse_decimal(".5", value));
+    EXPECT_EQ(value, 0.5);
+    EXPECT_TRUE(numeric::parse_decimal("7.", value));
+    EXPECT_EQ(value, 7.0);
+    EXPECT_TRUE(numeric::parse_decimal("1.5e3", value));
+    EXPECT_EQ(value, 1500.0);
+    EXPECT_TRUE(numeric::parse_decimal("0.1", value));
+    EXPECT_EQ(value, 0.1);
+
+    value = 3.0;
+    EXPECT_FALSE(numeric::parse_decimal("", value));
+    EXPECT_FALSE(numeric::parse_decimal(".", value));
+    EXPECT_FALSE(numeric::parse_decimal("1,5", value));
+    EXPECT_FALSE(numeric::parse_decimal("1e", value));
+    EXPECT_EQ(value, 3.0);
+}
+
+TEST(NumericCodecTest, DecimalParsingIgnoresGlobalLocale)
+{
+    // Locales with ',' as decimal separator break strtod-based parsing
+    const char* const candidates[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "German_Germany.1252"};
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    bool switched = false;
+    for (const char* name : candidates)
+    {
+        if (std::setlocale(LC_NUMERIC, name))
+        {
+            switched = true;
+            break;
+        }
+    }
+
+    double value = 0.0;
+    EXPECT_TRUE(numeric::parse_decimal("12.5", value));
+    EXPECT_EQ(value, 12.5);
+
+    std::setlocale(LC_NUMERIC, previous.c_str());
+    if (!switched)
+    {
+        GTEST_SKIP() << "No comma-decimal locale installed";
+    }
+}
+
+TEST(NumericCodecTest, FixedPointRoundTrip)
+{
+    const long long scales[] = {numeric::kTwipsPerPoint, numeric::kHalfPointsPerPoint, numeric::kEighthsPerPoint,
+                                numeric::kLineSpacingUnit, numeric::kEmuPerPoint};
+    for (const long long scale : scales)
+    {
+        for (long long units = -50000; units <= 50000; ++units)
+        {
+            ASSERT_EQ(numeric::to_fixed(numeric::from_fixed(units, scale), scale), units) << "scale " << scale;
+        }
+    }
+
+    // Rounds instead of truncating: 14.35pt is 286.999... twips in binary floating point
+    EXPECT_EQ(numeric::to_fixed(14.35, numeric::kTwipsPerPoint), 287);
+    EXPECT_EQ(numeric::to_fixed(-0.5, numeric::kHalfPointsPerPoint), -1);
+}
+
+TEST(NumericCodecTest, AttributeHelpers)
+{
+    pugi::xml_document doc;
+    pugi::xml_node node = doc.append_child("w:spacing");
+
+    numeric::write_points(node.append_attribute("w:before"), 12.0, numeric::kTwipsPerPoint);
+    EXPECT_STREQ(node.attribute("w:before").value(), "240");
+
+    double points = 0.0;
+    EXPECT_TRUE(numeric::read_points(node.attribute("w:before"), numeric::kTwipsPerPoint, points));
+    EXPECT_EQ(points, 12.0);
+
+    node.append_attribute("w:after").set_value("90.5");
+    EXPECT_EQ(numeric::read_points_or(node.attribute("w:after"), numeric::kTwipsPerPoint, 0.0), 4.525);
+
+    node.append_attribute("w:line").set_value("auto");
+    EXPECT_EQ(numeric::read_points_or(node.attribute("w:line"), numeric::kLineSpacingUnit, 1.0), 1.0);
+    EXPECT_EQ(numeric::read_points_or(node.attribute("w:missing"), numeric::kTwipsPerPoint, -1.0), -1.0);
+    EXPECT_EQ(numeric::read_int_or(node.attribute("w:before"), 0), 240);
+    EXPECT_EQ(numeric::read_int_or(node.attribute("w:line"), 7), 7);
+}
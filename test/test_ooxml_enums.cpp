@@ -0,0 +1,91 @@
+/*!
+ * @file test_ooxml_enums.cpp
+ * @brief Unit tests for the OOXML enumeration conversion tables
+ *
+ * Checks that every enumerator round-trips through its attribute value,
+ * that aliases parse but are never emitted, and that unknown values are
+ * rejected without touching the output.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "OoxmlEnums.hpp"
+
+namespace dx = duckx;
+namespace ooxml = duckx::ooxml;
+
+namespace
+{
+    template <typename T>
+    void expect_round_trip(const T value, const char* expected)
+    {
+        EXPECT_STREQ(ooxml::to_string(value), expected);
+        T parsed{};
+        EXPECT_TRUE(ooxml::parse(ooxml::to_string(value), parsed)) << expected;
+        EXPECT_EQ(parsed, value) << expected;
+    }
+} // namespace
+
+TEST(OoxmlEnumsTest, EnumeratorsRoundTrip)
+{
+    expect_round_trip(dx::Alignment::LEFT, "left");
+    expect_round_trip(dx::Alignment::CENTER, "center");
+    expect_round_trip(dx::Alignment::RIGHT, "right");
+    expect_round_trip(dx::Alignment::BOTH, "both");
+
+    expect_round_trip(dx::HighlightColor::NONE, "none");
+    expect_round_trip(dx::HighlightColor::YELLOW, "yellow");
+    expect_round_trip(dx::HighlightColor::DARK_MAGENTA, "darkMagenta");
+    expect_round_trip(dx::HighlightColor::LIGHT_GRAY, "lightGray");
+
+    expect_round_trip(dx::HeaderFooterType::DEFAULT, "default");
+    expect_round_trip(dx::HeaderFooterType::EVEN, "even");
+    expect_round_trip(dx::SectionBreakType::COLUMN, "nextColumn");
+    expect_round_trip(dx::SectionBreakType::CONTINUOUS, "continuous");
+    expect_round_trip(dx::PageOrientation::LANDSCAPE, "landscape");
+    expect_round_trip(dx::RelativeFrom::MARGIN, "margin");
+}
+
+TEST(OoxmlEnumsTest, AliasesParseButAreNotEmitted)
+{
+    dx::Alignment alignment = dx::Alignment::CENTER;
+    EXPECT_TRUE(ooxml::parse("start", alignment));
+    EXPECT_EQ(alignment, dx::Alignment::LEFT);
+    EXPECT_TRUE(ooxml::parse("end", alignment));
+    EXPECT_EQ(alignment, dx::Alignment::RIGHT);
+    EXPECT_STREQ(ooxml::to_string(dx::Alignment::RIGHT), "right");
+}
+
+TEST(OoxmlEnumsTest, UnknownValuesAreRejected)
+{
+    dx::HighlightColor color = dx::HighlightColor::RED;
+    EXPECT_FALSE(ooxml::parse("", color));
+    EXPECT_FALSE(ooxml::parse("Yellow", color)); // OOXML values are case-sensitive
+    EXPECT_FALSE(ooxml::parse("yellowish", color));
+    EXPECT_FALSE(ooxml::parse(std::string("yel"), color));
+    EXPECT_EQ(color, dx::HighlightColor::RED);
+
+    dx::formatting_flag flag = dx::none;
+    EXPECT_TRUE(ooxml::parse_vertical_text_alignment("subscript", flag));
+    EXPECT_EQ(flag, dx::subscript);
+    EXPECT_FALSE(ooxml::parse_vertical_text_alignment("sub", flag));
+}
+
+TEST(OoxmlEnumsTest, ValueSetsAndContentTypes)
+{
+    EXPECT_TRUE(ooxml::is_border_style("dotted"));
+    EXPECT_FALSE(ooxml::is_border_style("wavy"));
+    EXPECT_TRUE(ooxml::is_cell_vertical_alignment("bottom"));
+    EXPECT_FALSE(ooxml::is_cell_vertical_alignment("both"));
+    EXPECT_TRUE(ooxml::is_table_alignment("right"));
+    EXPECT_TRUE(ooxml::is_text_direction("tbRlV"));
+    EXPECT_TRUE(ooxml::is_width_type("pct"));
+
+    EXPECT_STREQ(ooxml::image_content_type("jpg"), "image/jpeg");
+    EXPECT_STREQ(ooxml::image_content_type("jpeg"), "image/jpeg");
+    EXPECT_STREQ(ooxml::image_content_type("png"), "image/png");
+    EXPECT_EQ(ooxml::image_content_type("svg"), nullptr);
+}
@@ -0,0 +1,188 @@
+/*!
+ * @file test_operation_options.cpp
+ * @brief Unit tests for cancellation and progress reporting of long operations
+ *
+ * Covers open, save, style set application, outline generation and table
+ * builds: progress reaches the total, and a cancelled operation returns
+ * OPERATION_CANCELLED with the document and the file left as before.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Document.hpp"
+#include "OperationOptions.hpp"
+#include "OutlineManager.hpp"
+#include "StyleManager.hpp"
+
+using namespace duckx;
+
+namespace
+{
+    std::size_t count_paragraphs(const std::string& path)
+    {
+        auto doc = Document::open(path);
+        std::size_t count = 0;
+        for (auto& paragraph: doc.body().paragraphs())
+        {
+            (void)paragraph;
+            ++count;
+        }
+        return count;
+    }
+} // namespace
+
+TEST(OperationOptionsTest, SaveAndOpenReportProgressAndStopWhenCancelled)
+{
+    const std::string path = "operation_options_test.docx";
+    {
+        auto doc = Document::create(path);
+        for (int i = 0; i < 500; ++i)
+            doc.body().add_paragraph("Paragraph " + std::to_string(i));
+        doc.save();
+
+        doc.body().add_paragraph("pending");
+        OperationOptions options;
+        std::vector<std::uint64_t> reported;
+        options.on_progress = [&](const std::uint64_t processed, const std::uint64_t total) {
+            EXPECT_LE(processed, total);
+            reported.push_back(processed);
+            options.cancellation.cancel();
+        };
+        const auto cancelled = doc.save_safe(options);
+        ASSERT_FALSE(cancelled.ok());
+        EXPECT_EQ(cancelled.error().code(), ErrorCode::OPERATION_CANCELLED);
+        EXPECT_EQ(reported.size(), 1u);
+        EXPECT_EQ(count_paragraphs(path), 500u);
+
+        // 取消的修改仍待保存
+        OperationOptions resumed;
+        std::uint64_t last = 0, last_total = 0;
+        resumed.on_progress = [&](const std::uint64_t processed, const std::uint64_t total) {
+            EXPECT_GE(processed, last);
+            last = processed;
+            last_total = total;
+        };
+        ASSERT_TRUE(doc.save_safe(resumed).ok());
+        EXPECT_GT(last_total, 0u);
+        EXPECT_EQ(last, last_total);
+        EXPECT_EQ(count_paragraphs(path), 501u);
+    }
+
+    OperationOptions open_options;
+    std::uint64_t last = 0, last_total = 0;
+    open_options.on_progress = [&](const std::uint64_t processed, const std::uint64_t total) {
+        last = processed;
+        last_total = total;
+    };
+    auto opened = Document::open_safe(path, OpenOptions(), open_options);
+    ASSERT_TRUE(opened.ok());
+    EXPECT_GT(last_total, 0u);
+    EXPECT_EQ(last, last_total);
+
+    OperationOptions cancelled_open;
+    cancelled_open.cancellation.cancel();
+    const auto refused = Document::open_safe(path, OpenOptions(), cancelled_open);
+    ASSERT_FALSE(refused.ok());
+    EXPECT_EQ(refused.error().code(), ErrorCode::OPERATION_CANCELLED);
+
+    std::remove(path.c_str());
+}
+
+TEST(OperationOptionsTest, CancelledTableBuildAndStyleSetLeaveTheBodyUnchanged)
+{
+    const std::string path = "operation_options_table.docx";
+    auto doc = Document::create(path);
+    auto& body = doc.body();
+    body.add_paragraph("before");
+
+    OperationOptions options;
+    options.on_progress = [&options](const std::uint64_t processed, std::uint64_t) {
+        if (processed == 40)
+            options.cancellation.cancel();
+    };
+    const auto table = body.add_table_safe(100, 4, options);
+    ASSERT_FALSE(table.ok());
+    EXPECT_EQ(table.error().code(), ErrorCode::OPERATION_CANCELLED);
+    EXPECT_TRUE(body.tables().empty());
+
+    std::uint64_t rows = 0;
+    OperationOptions counted;
+    counted.on_progress = [&rows](const std::uint64_t processed, std::uint64_t) { rows = processed; };
+    ASSERT_TRUE(body.add_table_safe(100, 4, counted).ok());
+    EXPECT_EQ(rows, 100u);
+
+    for (int i = 0; i < 50; ++i)
+        body.add_paragraph("body " + std::to_string(i));
+    auto& styles = doc.styles();
+    ASSERT_TRUE(styles.load_all_built_in_styles_safe().ok());
+    StyleSet set("Body");
+    set.included_styles = {"Normal"};
+    ASSERT_TRUE(doc.register_style_set_safe(set).ok());
+
+    OperationOptions cancel_midway;
+    cancel_midway.on_progress = [&cancel_midway](const std::uint64_t processed, std::uint64_t) {
+        if (processed == 20)
+            cancel_midway.cancellation.cancel();
+    };
+    const auto applied = doc.apply_style_set_safe("Body", cancel_midway);
+    ASSERT_FALSE(applied.ok());
+    EXPECT_EQ(applied.error().code(), ErrorCode::OPERATION_CANCELLED);
+    for (auto& paragraph: body.paragraphs())
+        EXPECT_EQ(paragraph.get_style_safe().value_or(""), "");
+
+    // 调用方事务中取消：只撤销本次应用，之前的修改与事务保持不变
+    doc.begin_transaction();
+    body.add_paragraph("kept");
+    OperationOptions cancel_in_transaction;
+    cancel_in_transaction.on_progress = [&cancel_in_transaction](const std::uint64_t processed, std::uint64_t) {
+        if (processed == 20)
+            cancel_in_transaction.cancellation.cancel();
+    };
+    ASSERT_FALSE(doc.apply_style_set_safe("Body", cancel_in_transaction).ok());
+    EXPECT_TRUE(doc.in_transaction());
+    std::string last_text;
+    for (auto& paragraph: body.paragraphs())
+    {
+        EXPECT_EQ(paragraph.get_style_safe().value_or(""), "");
+        last_text = paragraph.runs().first().get_text();
+    }
+    EXPECT_EQ(last_text, "kept");
+    doc.commit();
+
+    ASSERT_TRUE(doc.apply_style_set_safe("Body", OperationOptions()).ok());
+    EXPECT_EQ(body.paragraphs().first().get_style_safe().value_or(""), "Normal");
+
+    std::remove(path.c_str());
+}
+
+TEST(OperationOptionsTest, CancelledOutlineKeepsTheCachedOutline)
+{
+    const std::string path = "operation_options_outline.docx";
+    auto doc = Document::create(path);
+    auto& outline = doc.outline();
+    ASSERT_TRUE(outline.generate_outline_safe().ok());
+    const std::size_t cached = outline.get_outline().size();
+
+    OperationOptions options;
+    options.cancellation.cancel();
+    const auto result = outline.generate_outline_safe(options);
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code(), ErrorCode::OPERATION_CANCELLED);
+    EXPECT_EQ(outline.get_outline().size(), cached);
+
+    std::uint64_t last = 0, last_total = 0;
+    OperationOptions counted;
+    counted.on_progress = [&](const std::uint64_t processed, const std::uint64_t total) {
+        last = processed;
+        last_total = total;
+    };
+    ASSERT_TRUE(outline.generate_outline_safe(counted).ok());
+    EXPECT_EQ(last, last_total);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,135 @@
+/*!
+ * @file test_package_garbage_collector.cpp
+ * @brief Unit tests for orphan part and relationship collection
+ *
+ * Builds packages with unreferenced media, stale relationships and
+ * overrides for missing parts, and checks that only those are dropped.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "Document.hpp"
+#include "DocxFile.hpp"
+#include "PackageGarbageCollector.hpp"
+
+namespace
+{
+    const char* const kImageType = "http://schemas.openxmlformats.org/officeDocument/2006/relationships/image";
+
+    std::string insert_before(std::string xml, const std::string& marker, const std::string& text)
+    {
+        const size_t pos = xml.find(marker);
+        return pos == std::string::npos ? xml : xml.insert(pos, text);
+    }
+} // namespace
+
+class PackageGarbageCollectorTest : public ::testing::Test
+{
+protected:
+    const std::string test_filename = "package_gc_test.docx";
+
+    void SetUp() override { remove(test_filename.c_str()); }
+    void TearDown() override { remove(test_filename.c_str()); }
+
+    // Adds word/media/kept.png (referenced), dropped.png (unreferenced relationship),
+    // stray.png (no relationship at all) and an override for a part that does not exist
+    void write_package_with_garbage() const
+    {
+        duckx::Document::create(test_filename).save();
+
+        duckx::DocxFile file;
+        ASSERT_TRUE(file.open(test_filename));
+        file.write_entry("word/media/kept.png", std::string(64, 'k'));
+        file.write_entry("word/media/dropped.png", std::string(64, 'd'));
+        file.write_entry("word/media/stray.png", std::string(64, 's'));
+
+        const std::string rels = file.read_entry("word/_rels/document.xml.rels");
+        file.write_entry("word/_rels/document.xml.rels", insert_before(rels, "</Relationships>",
+            std::string("<Relationship Id=\"rId100\" Type=\"") + kImageType + "\" Target=\"media/kept.png\"/>" +
+            "<Relationship Id=\"rId101\" Type=\"" + kImageType + "\" Target=\"media/dropped.png\"/>" +
+            "<Relationship Id=\"rId102\" Type=\"" + kImageType + "\" Target=\"media/gone.png\"/>"));
+
+        const std::string document = file.read_entry("word/document.xml");
+        file.write_entry("word/document.xml", insert_before(document, "</w:body>",
+            "<w:p><w:r><w:drawing><a:blip r:embed=\"rId100\"/></w:drawing></w:r></w:p>"));
+
+        const std::string types = file.read_entry("[Content_Types].xml");
+        file.write_entry("[Content_Types].xml", insert_before(types, "</Types>",
+            "<Override PartName=\"/word/ghost.xml\" ContentType=\"application/xml\"/>"));
+        file.save();
+    }
+};
+
+TEST_F(PackageGarbageCollectorTest, DropsUnreachablePartsRelationshipsAndOverrides)
+{
+    write_package_with_garbage();
+
+    {
+        auto doc = duckx::Document::open(test_filename);
+        const duckx::GarbageCollectionReport report = doc.collect_garbage();
+        EXPECT_EQ(report.parts_removed, 2u);         // dropped.png, stray.png
+        EXPECT_EQ(report.relationships_removed, 2u); // rId101 unreferenced, rId102 dangling
+        EXPECT_EQ(report.overrides_removed, 1u);     // /word/ghost.xml
+        EXPECT_GT(report.bytes_reclaimed, 0u);
+        doc.save();
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    EXPECT_TRUE(file.has_entry("word/media/kept.png"));
+    EXPECT_FALSE(file.has_entry("word/media/dropped.png"));
+    EXPECT_FALSE(file.has_entry("word/media/stray.png"));
+
+    // Relationships resolved by type are kept even though no r:id refers to them
+    EXPECT_TRUE(file.has_entry("word/styles.xml"));
+    EXPECT_TRUE(file.has_entry("word/numbering.xml"));
+    EXPECT_TRUE(file.has_entry("docProps/core.xml"));
+
+    const std::string rels = file.read_entry("word/_rels/document.xml.rels");
+    EXPECT_NE(rels.find("rId100"), std::string::npos);
+    EXPECT_EQ(rels.find("rId101"), std::string::npos);
+    EXPECT_EQ(rels.find("rId102"), std::string::npos);
+    EXPECT_NE(rels.find("styles.xml"), std::string::npos);
+
+    const std::string types = file.read_entry("[Content_Types].xml");
+    EXPECT_EQ(types.find("/word/ghost.xml"), std::string::npos);
+    EXPECT_NE(types.find("/word/styles.xml"), std::string::npos);
+}
+
+TEST_F(PackageGarbageCollectorTest, CleanPackageIsLeftUntouched)
+{
+    duckx::Document::create(test_filename).save();
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    const duckx::GarbageCollectionReport report = duckx::collect_package_garbage(file);
+    EXPECT_EQ(report.parts_removed, 0u);
+    EXPECT_EQ(report.relationships_removed, 0u);
+    EXPECT_EQ(report.overrides_removed, 0u);
+    EXPECT_EQ(report.bytes_reclaimed, 0u);
+    EXPECT_FALSE(file.is_modified());
+}
+
+TEST_F(PackageGarbageCollectorTest, RunsAsPartOfAsyncSave)
+{
+    write_package_with_garbage();
+
+    duckx::GarbageCollectionReport report;
+    {
+        auto doc = duckx::Document::open(test_filename);
+        duckx::SaveOptions options;
+        options.collect_garbage = true;
+        options.on_garbage_collected = [&report](const duckx::GarbageCollectionReport& r) { report = r; };
+        ASSERT_TRUE(doc.save_async(options).get().ok());
+    }
+    EXPECT_EQ(report.parts_removed, 2u);
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(test_filename));
+    EXPECT_FALSE(file.has_entry("word/media/stray.png"));
+    EXPECT_TRUE(file.has_entry("word/media/kept.png"));
+}
@@ -0,0 +1,102 @@
+/*!
+ * @file test_range_adaptors.cpp
+ * @brief Unit tests for lazy range adaptors
+ *
+ * Covers filter, transform, take, skip, chunk and enumerate over element
+ * ranges, composition with `|`, and early termination of take().
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "Document.hpp"
+#include "duckxiterator.hpp"
+
+using namespace duckx;
+
+namespace
+{
+    std::string text_of(Paragraph& paragraph)
+    {
+        std::string text;
+        for (auto& run: paragraph.runs())
+            text += run.get_text();
+        return text;
+    }
+} // namespace
+
+TEST(RangeAdaptorsTest, ComposesFilterTakeTransform)
+{
+    auto doc = Document::create("range_adaptors_test.docx");
+    auto& body = doc.body();
+    for (int i = 0; i < 10; ++i)
+        body.add_paragraph(i % 3 == 0 ? "" : "p" + std::to_string(i));
+
+    int tested = 0;
+    std::vector<std::string> texts;
+    for (const std::string& text: body.paragraphs()
+             | views::filter([&tested](Paragraph& p) { ++tested; return !p.runs().empty(); })
+             | views::take(3)
+             | views::transform(text_of))
+        texts.push_back(text);
+
+    EXPECT_EQ(texts, (std::vector<std::string>{"p1", "p2", "p4"}));
+    // p0..p4 only: take() stops without advancing past the third match
+    EXPECT_EQ(tested, 5);
+
+    std::vector<std::string> skipped;
+    for (auto& paragraph: body.paragraphs() | views::skip(8))
+        skipped.push_back(text_of(paragraph));
+    EXPECT_EQ(skipped, (std::vector<std::string>{"p8", ""}));
+
+    EXPECT_TRUE((body.paragraphs() | views::take(0)).begin() == (body.paragraphs() | views::take(0)).end());
+    EXPECT_TRUE((body.paragraphs() | views::skip(20)).begin() == (body.paragraphs() | views::skip(20)).end());
+}
+
+TEST(RangeAdaptorsTest, EnumeratesRunsAndCells)
+{
+    auto doc = Document::create("range_adaptors_test.docx");
+    auto& body = doc.body();
+    auto paragraph = body.add_paragraph("a");
+    paragraph.add_run("b", bold);
+    paragraph.add_run("c");
+
+    std::string indexed;
+    for (auto entry: paragraph.runs() | views::filter([](const duckx::Run& r) { return !r.is_bold(); }) | views::enumerate())
+        indexed += std::to_string(entry.index) + entry.value.get_text();
+    EXPECT_EQ(indexed, "0a1c");
+
+    auto table = body.add_table(2, 3);
+    std::size_t cells = 0;
+    for (auto& row: table.rows())
+        for (auto entry: row.cells() | views::enumerate())
+            cells += entry.index;
+    EXPECT_EQ(cells, 6u);
+}
+
+TEST(RangeAdaptorsTest, ChunksInOnePass)
+{
+    auto doc = Document::create("range_adaptors_test.docx");
+    auto& body = doc.body();
+    for (int i = 0; i < 7; ++i)
+        body.add_paragraph(std::to_string(i));
+
+    std::vector<std::string> chunks;
+    for (auto chunk: body.paragraphs() | views::chunk(3))
+    {
+        std::string text;
+        for (auto& paragraph: chunk)
+            text += text_of(paragraph);
+        chunks.push_back(text);
+    }
+    EXPECT_EQ(chunks, (std::vector<std::string>{"012", "345", "6"}));
+
+    // Unconsumed elements of a chunk are skipped
+    std::string firsts;
+    for (auto chunk: body.paragraphs() | views::chunk(2))
+        firsts += text_of(*chunk.begin());
+    EXPECT_EQ(firsts, "0246");
+}
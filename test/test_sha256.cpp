@@ -0,0 +1,49 @@
+/*!
+ * @file test_sha256.cpp
+ * @brief Unit tests for Sha256
+ *
+ * Checks the FIPS 180-4 test vectors, including messages that cross the
+ * padding boundary, and that incremental updates match one-shot digests.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+
+#include "Sha256.hpp"
+
+namespace
+{
+    std::string hex_digest(const std::string& message)
+    {
+        return duckx::Sha256::to_hex(duckx::Sha256::digest(message.data(), message.size()));
+    }
+} // namespace
+
+TEST(Sha256Test, MatchesStandardVectors)
+{
+    EXPECT_EQ(hex_digest(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hex_digest("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(hex_digest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(hex_digest(std::string(1000000, 'a')),
+              "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(Sha256Test, IncrementalUpdatesMatchOneShotDigest)
+{
+    std::string message;
+    for (int i = 0; i < 300; ++i)
+        message += static_cast<char>('a' + i % 26);
+
+    // Chunk sizes straddling the 64-byte block and the 56-byte padding limit
+    for (const std::size_t chunk: {1u, 7u, 55u, 56u, 63u, 64u, 65u, 200u})
+    {
+        duckx::Sha256 sha;
+        for (std::size_t offset = 0; offset < message.size(); offset += chunk)
+            sha.update(message.data() + offset, std::min(chunk, message.size() - offset));
+        EXPECT_EQ(duckx::Sha256::to_hex(sha.finish()), hex_digest(message)) << "chunk " << chunk;
+    }
+}
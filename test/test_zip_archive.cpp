@@ -0,0 +1,413 @@
+/*!
+ * @file test_zip_archive.cpp
+ * @brief Unit tests for the ZIP container layer and Zip64 handling
+ *
+ * Tests ZipReader/ZipWriter round trips, verbatim entry copying, and the
+ * Zip64 paths for entry counts, sizes and offsets through DocxFile.
+ * The multi-gigabyte round trip needs several GB of free disk space and
+ * only runs when DUCKX_ENABLE_LARGE_ZIP_TESTS is set in the environment.
+ *
+ * @date 2025.07
+ */
+
+#include <gtest/gtest.h>
+#include "DocxFile.hpp"
+#include "ZipArchive.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+class ZipArchiveTest : public ::testing::Test
+{
+protected:
+    std::string test_dir;
+
+    void SetUp() override
+    {
+        test_dir = "test_zip_temp_dir";
+#if defined(_WIN32)
+        _mkdir(test_dir.c_str());
+#else
+        mkdir(test_dir.c_str(), 0777);
+#endif
+    }
+
+    void TearDown() override
+    {
+#if defined(_WIN32)
+        std::string command = "rd /s /q " + test_dir;
+#else
+        std::string command = "rm -rf " + test_dir;
+#endif
+        system(command.c_str());
+    }
+
+    std::string get_test_path(const std::string& file_name) const
+    {
+        return test_dir + "/" + file_name;
+    }
+
+    static std::string make_payload(size_t size)
+    {
+        std::string payload(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            payload[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+        }
+        return payload;
+    }
+};
+
+TEST_F(ZipArchiveTest, WriteAndReadRoundTrip)
+{
+    const std::string path = get_test_path("roundtrip.zip");
+    const std::string text = "<w:document>Hello</w:document>";
+    const std::string payload = make_payload(200000);
+
+    duckx::ZipWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.add_entry("word/document.xml", text.data(), text.size()));
+    ASSERT_TRUE(writer.add_entry("word/media/blob.bin", payload.data(), payload.size()));
+    ASSERT_TRUE(writer.add_entry("empty.txt", "", 0));
+    ASSERT_TRUE(writer.close());
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_FALSE(reader.is_zip64());
+    ASSERT_EQ(reader.entries().size(), 3u);
+    EXPECT_EQ(reader.entries()[0].name, "word/document.xml");
+
+    std::string content;
+    ASSERT_TRUE(reader.read(*reader.find("word/document.xml"), content));
+    EXPECT_EQ(content, text);
+    ASSERT_TRUE(reader.read(*reader.find("word/media/blob.bin"), content));
+    EXPECT_EQ(content, payload);
+    EXPECT_LT(reader.find("word/media/blob.bin")->compressed_size, payload.size());
+    ASSERT_TRUE(reader.read(*reader.find("empty.txt"), content));
+    EXPECT_TRUE(content.empty());
+    EXPECT_EQ(reader.find("missing.xml"), nullptr);
+}
+
+TEST_F(ZipArchiveTest, RawCopyPreservesCompressedBytes)
+{
+    const std::string source_path = get_test_path("source.zip");
+    const std::string copy_path = get_test_path("copy.zip");
+    const std::string payload = make_payload(50000);
+
+    {
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(source_path));
+        ASSERT_TRUE(writer.add_entry("data.bin", payload.data(), payload.size()));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader source;
+    ASSERT_TRUE(source.open(source_path));
+    {
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(copy_path));
+        ASSERT_TRUE(writer.add_raw_entry(source, source.entries()[0]));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader copy;
+    ASSERT_TRUE(copy.open(copy_path));
+    const duckx::ZipEntryInfo* entry = copy.find("data.bin");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->crc32, source.entries()[0].crc32);
+    EXPECT_EQ(entry->compressed_size, source.entries()[0].compressed_size);
+
+    std::string content;
+    ASSERT_TRUE(copy.read(*entry, content));
+    EXPECT_EQ(content, payload);
+}
+
+TEST_F(ZipArchiveTest, ForeignLocalExtraFieldsAndDataDescriptorsAreCounted)
+{
+    // A stored entry laid out as other tools write it: local extra field, sizes in a signed data descriptor
+    const std::string path = get_test_path("foreign.zip");
+    const std::string name = "a.txt";
+    const std::string data = "hello";
+    const std::uint32_t crc = duckx::zip_crc32(data.data(), data.size());
+
+    std::string zip;
+    const auto put16 = [&zip](const unsigned v) { zip += static_cast<char>(v & 0xFF); zip += static_cast<char>(v >> 8 & 0xFF); };
+    const auto put32 = [&put16](const std::uint32_t v) { put16(v & 0xFFFF); put16(v >> 16); };
+
+    put32(0x04034b50); put16(20); put16(0x0008); put16(0); put16(0); put16(0x21);
+    put32(0); put32(0); put32(0); put16(static_cast<unsigned>(name.size())); put16(8);
+    zip += name;
+    put16(0xCAFE); put16(4); put32(0);
+    zip += data;
+    put32(0x08074b50); put32(crc); put32(static_cast<std::uint32_t>(data.size()));
+    put32(static_cast<std::uint32_t>(data.size()));
+    const std::uint32_t cd_offset = static_cast<std::uint32_t>(zip.size());
+
+    put32(0x02014b50); put16(20); put16(20); put16(0x0008); put16(0); put16(0); put16(0x21);
+    put32(crc); put32(static_cast<std::uint32_t>(data.size())); put32(static_cast<std::uint32_t>(data.size()));
+    put16(static_cast<unsigned>(name.size())); put16(0); put16(0); put16(0); put16(0); put32(0); put32(0);
+    zip += name;
+    const std::uint32_t cd_size = static_cast<std::uint32_t>(zip.size()) - cd_offset;
+    put32(0x06054b50); put16(0); put16(0); put16(1); put16(1); put32(cd_size); put32(cd_offset); put16(0);
+
+    std::FILE* fp = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    std::fwrite(zip.data(), 1, zip.size(), fp);
+    std::fclose(fp);
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(path));
+    const duckx::ZipEntryInfo* entry = reader.find(name);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(reader.local_record_size(*entry), cd_offset);
+    EXPECT_LT(duckx::zip_local_record_size(*entry), cd_offset);
+    EXPECT_EQ(reader.unreferenced_bytes(), 0u);
+
+    std::string content;
+    ASSERT_TRUE(reader.read(*entry, content));
+    EXPECT_EQ(content, data);
+}
+
+TEST_F(ZipArchiveTest, FixedTimeStampsNewAndCopiedEntries)
+{
+    const std::string source_path = get_test_path("timed_source.zip");
+    const std::string fixed_path = get_test_path("timed_fixed.zip");
+
+    {
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(source_path));
+        ASSERT_TRUE(writer.add_entry("copied.txt", "copied", 6));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader source;
+    ASSERT_TRUE(source.open(source_path));
+    {
+        duckx::ZipWriter writer;
+        writer.set_fixed_time(1262304000 + 3661); // 2010-01-01T01:01:01Z
+        ASSERT_TRUE(writer.open(fixed_path));
+        ASSERT_TRUE(writer.add_raw_entry(source, source.entries()[0]));
+        ASSERT_TRUE(writer.add_entry("new.txt", "new", 3));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(fixed_path));
+    for (const auto& entry: reader.entries())
+    {
+        EXPECT_EQ(entry.dos_date, (30 << 9) | (1 << 5) | 1) << entry.name;
+        EXPECT_EQ(entry.dos_time, (1 << 11) | (1 << 5) | 0) << entry.name;
+    }
+    EXPECT_EQ(duckx::zip_crc32("copied", 6), reader.find("copied.txt")->crc32);
+}
+
+TEST_F(ZipArchiveTest, ForcedZip64RecordsRoundTripThroughDocxFile)
+{
+    const std::string path = get_test_path("forced64.docx");
+    const std::string document = duckx::DocxFile::get_empty_document_xml();
+    const std::string types = duckx::DocxFile::get_content_types_xml();
+
+    {
+        duckx::ZipWriter writer;
+        writer.set_force_zip64(true);
+        ASSERT_TRUE(writer.open(path));
+        ASSERT_TRUE(writer.add_entry("[Content_Types].xml", types.data(), types.size()));
+        ASSERT_TRUE(writer.add_entry("word/document.xml", document.data(), document.size()));
+        ASSERT_TRUE(writer.close());
+    }
+
+    {
+        duckx::ZipReader reader;
+        ASSERT_TRUE(reader.open(path));
+        EXPECT_TRUE(reader.is_zip64());
+        EXPECT_EQ(reader.entries().size(), 2u);
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_EQ(file.read_entry("word/document.xml"), document);
+    file.write_entry("word/custom.xml", "<custom/>");
+    file.save();
+
+    duckx::DocxFile reopened;
+    ASSERT_TRUE(reopened.open(path));
+    EXPECT_EQ(reopened.read_entry("[Content_Types].xml"), types);
+    EXPECT_EQ(reopened.read_entry("word/custom.xml"), "<custom/>");
+}
+
+TEST_F(ZipArchiveTest, ForgedZip64EntryCountIsRejectedWithoutReserving)
+{
+    const std::string path = get_test_path("forged64.zip");
+    {
+        duckx::ZipWriter writer;
+        writer.set_force_zip64(true);
+        ASSERT_TRUE(writer.open(path));
+        ASSERT_TRUE(writer.add_entry("a.txt", "a", 1));
+        ASSERT_TRUE(writer.close());
+    }
+
+    std::string bytes;
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        ASSERT_NE(fp, nullptr);
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+            bytes.append(buffer, n);
+        fclose(fp);
+    }
+    const size_t record = bytes.rfind(std::string("PK\x06\x06", 4));
+    ASSERT_NE(record, std::string::npos);
+    // Entry counts (this disk and total) claim 2^50 entries
+    for (const size_t field: {record + 24, record + 32})
+    {
+        for (int i = 0; i < 8; ++i)
+            bytes[field + i] = static_cast<char>(i == 6 ? 0x04 : 0);
+    }
+    {
+        FILE* fp = fopen(path.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        fwrite(bytes.data(), 1, bytes.size(), fp);
+        fclose(fp);
+    }
+
+    duckx::ZipReader reader;
+    EXPECT_FALSE(reader.open(path));
+}
+
+TEST_F(ZipArchiveTest, MoreThan65535EntriesUseZip64Automatically)
+{
+    const std::string path = get_test_path("many_entries.zip");
+    const int entry_count = 70000;
+
+    {
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(path, 0));
+        for (int i = 0; i < entry_count; ++i)
+        {
+            const std::string value = std::to_string(i);
+            ASSERT_TRUE(writer.add_entry("parts/p" + value + ".txt", value.data(), value.size()));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.is_zip64());
+    ASSERT_EQ(reader.entries().size(), static_cast<size_t>(entry_count));
+
+    std::string content;
+    ASSERT_TRUE(reader.read(*reader.find("parts/p69999.txt"), content));
+    EXPECT_EQ(content, "69999");
+    reader.close();
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    file.write_entry("parts/p0.txt", "changed");
+    file.save();
+
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.entries().size(), static_cast<size_t>(entry_count));
+    ASSERT_TRUE(reader.read(*reader.find("parts/p0.txt"), content));
+    EXPECT_EQ(content, "changed");
+    ASSERT_TRUE(reader.read(*reader.find("parts/p65536.txt"), content));
+    EXPECT_EQ(content, "65536");
+}
+
+TEST_F(ZipArchiveTest, StreamedEntryMatchesInMemoryEntry)
+{
+    const std::string path = get_test_path("streamed.zip");
+    const std::string payload = make_payload(300000);
+
+    {
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        size_t position = 0;
+        ASSERT_TRUE(writer.add_entry_stream("streamed.bin", payload.size(),
+            [&](char* buf, size_t capacity)
+            {
+                const size_t n = std::min(capacity, payload.size() - position);
+                payload.copy(buf, n, position);
+                position += n;
+                return n;
+            }));
+        ASSERT_TRUE(writer.add_entry("after.txt", "after", 5));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(path));
+    std::string content;
+    ASSERT_TRUE(reader.read(*reader.find("streamed.bin"), content));
+    EXPECT_EQ(content, payload);
+    ASSERT_TRUE(reader.read(*reader.find("after.txt"), content));
+    EXPECT_EQ(content, "after");
+}
+
+TEST_F(ZipArchiveTest, MultiGigabyteArchiveRoundTrip)
+{
+    if (!std::getenv("DUCKX_ENABLE_LARGE_ZIP_TESTS"))
+    {
+        GTEST_SKIP() << "Set DUCKX_ENABLE_LARGE_ZIP_TESTS to run the >4 GB Zip64 round trip";
+    }
+
+    const std::string path = get_test_path("archive_4gb.docx");
+    const std::uint64_t big_size = 0x100000000ull + 12345; // > 4 GB forces Zip64 sizes
+    const std::string document = duckx::DocxFile::get_empty_document_xml();
+
+    {
+        // Store without compression so the archive itself crosses the 4 GB offset limit
+        duckx::ZipWriter writer;
+        ASSERT_TRUE(writer.open(path, 0));
+        ASSERT_TRUE(writer.add_entry("word/document.xml", document.data(), document.size()));
+        std::uint64_t produced = 0;
+        ASSERT_TRUE(writer.add_entry_stream("word/media/scan.bin", big_size,
+            [&](char* buf, size_t capacity)
+            {
+                for (size_t i = 0; i < capacity; ++i)
+                {
+                    buf[i] = static_cast<char>((produced + i) & 0xFF);
+                }
+                produced += capacity;
+                return capacity;
+            }));
+        ASSERT_TRUE(writer.add_entry("word/after.xml", "<after/>", 8));
+        ASSERT_TRUE(writer.close());
+    }
+
+    duckx::DocxFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_EQ(file.read_entry("word/after.xml"), "<after/>");
+    file.write_entry("word/new.xml", "<new/>");
+    file.save();
+
+    duckx::ZipReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.is_zip64());
+    const duckx::ZipEntryInfo* big = reader.find("word/media/scan.bin");
+    ASSERT_NE(big, nullptr);
+    EXPECT_EQ(big->uncompressed_size, big_size);
+    EXPECT_GT(reader.find("word/after.xml")->local_header_offset, 0xFFFFFFFFull);
+
+    std::uint64_t seen = 0;
+    ASSERT_TRUE(reader.extract(*big, [&](const char*, size_t size)
+    {
+        seen += size;
+        return true;
+    }));
+    EXPECT_EQ(seen, big_size);
+
+    std::string content;
+    ASSERT_TRUE(reader.read(*reader.find("word/new.xml"), content));
+    EXPECT_EQ(content, "<new/>");
+    ASSERT_TRUE(reader.read(*reader.find("word/after.xml"), content));
+    EXPECT_EQ(content, "<after/>");
+}